@@ -120,6 +120,31 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+@ Copy the CCM data initializers from flash, then zero fill the CCM bss (see bsp.h  MACRO'S  Note #1).
+  ldr  r0, =_sccmram
+  ldr  r1, =_eccmram
+  ldr  r2, =_siccmram
+  b  LoopCopyCcmInit
+
+CopyCcmInit:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyCcmInit:
+  cmp  r0, r1
+  bcc  CopyCcmInit
+  ldr  r0, =_sccmbss
+  ldr  r1, =_eccmbss
+  movs  r3, #0
+  b  LoopFillZeroCcm
+
+FillZeroCcm:
+  str  r3, [r0], #4
+
+LoopFillZeroCcm:
+  cmp  r0, r1
+  bcc  FillZeroCcm
+
 @ Call the clock system intitialization function.
 @ bl  SystemInit
 @ Call static constructors */
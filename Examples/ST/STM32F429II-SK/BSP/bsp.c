@@ -77,6 +77,8 @@
 *********************************************************************************************************
 */
 
+static  CPU_INT32U  BSP_CPU_ClkFreq_Hz;                         /* HCLK set up by BSP_Init(), 0 before.                 */
+
 
 /*
 *********************************************************************************************************
@@ -89,46 +91,6 @@
 #define  BSP_REG_DWT_CYCCNT                       (*(CPU_REG32 *)0xE0001004)
 #define  BSP_REG_DBGMCU_CR                        (*(CPU_REG32 *)0xE0042004)
 
-                                                                /* -         RCC REGISTER DEFINES                     - */
-#define  BSP_REG_RCC_BASE_ADDR                    ((CPU_INT32U)(0x40023800))
-
-#define  BSP_REG32_RCC_CR                         (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x00u ))
-#define  BSP_REG32_RCC_PLLCFGR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x04u ))
-#define  BSP_REG32_RCC_CFGR                       (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x08u ))
-#define  BSP_REG32_RCC_CIR                        (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x0Cu ))
-#define  BSP_REG32_RCC_AHB1RSTR                   (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x10u ))
-#define  BSP_REG32_RCC_AHB2RSTR                   (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x14u ))
-#define  BSP_REG32_RCC_AHB3RSTR                   (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x18u ))
-#define  BSP_REG32_RCC_APB1RSTR                   (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x20u ))
-#define  BSP_REG32_RCC_APB2RSTR                   (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x24u ))
-#define  BSP_REG32_RCC_AHB1ENR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x30u ))
-#define  BSP_REG32_RCC_AHB2ENR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x34u ))
-#define  BSP_REG32_RCC_AHB3ENR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x38u ))
-#define  BSP_REG32_RCC_APB1ENR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x40u ))
-#define  BSP_REG32_RCC_APB2ENR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x44u ))
-#define  BSP_REG32_RCC_AHB1LPENR                  (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x50u ))
-#define  BSP_REG32_RCC_AHB2LPENR                  (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x54u ))
-#define  BSP_REG32_RCC_AHB3LPENR                  (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x58u ))
-#define  BSP_REG32_RCC_APB1LPENR                  (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x60u ))
-#define  BSP_REG32_RCC_APB2LPENR                  (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x64u ))
-#define  BSP_REG32_RCC_BDCR                       (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x70u ))
-#define  BSP_REG32_RCC_CSR                        (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x74u ))
-#define  BSP_REG32_RCC_SSCGR                      (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x80u ))
-#define  BSP_REG32_RCC_PLLI2SCFGR                 (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x84u ))
-#define  BSP_REG32_RCC_PLLSAICFGR                 (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x88u ))
-#define  BSP_REG32_RCC_DCKCFGR                    (*(CPU_REG32 *)( BSP_REG_RCC_BASE_ADDR + 0x8Cu ))
-
-                                                                /* -               FLASH REGISTER DEFINES             - */
-#define  BSP_REG_FLASH_BASE_ADDR                  (( CPU_INT32U )(0x40023C00))
-
-#define  BSP_REG32_FLASH_ACR                      (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x00u ))
-#define  BSP_REG32_FLASH_KEYR                     (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x04u ))
-#define  BSP_REG32_FLASH_OPTKEYR                  (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x08u ))
-#define  BSP_REG32_FLASH_SR                       (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x0Cu ))
-#define  BSP_REG32_FLASH_CR                       (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x10u ))
-#define  BSP_REG32_FLASH_OPTCR                    (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x14u ))
-#define  BSP_REG32_FLASH_OPTCR1                   (*(CPU_REG32 *)( BSP_REG_FLASH_BASE_ADDR + 0x18u ))
-
 
 
 /*
@@ -148,72 +110,6 @@
 #define  BSP_BIT_DWT_CR_CYCCNTENA                 DEF_BIT_00
 
 
-                                                                /* -                    RCC BLOCK                     - */
-#define  HSE_TIMEOUT_VAL                              0x0500u
-#define  BSP_MSK_HSECFG                           0x00FF0000u
-#define  BSP_BIT_RCC_CR_HSION                     DEF_BIT_00
-#define  BSP_BIT_RCC_CR_HSEBYP                    DEF_BIT_18
-#define  BSP_BIT_RCC_CR_HSEON                     DEF_BIT_16
-#define  BSP_BIT_RCC_CR_HSERDY                    DEF_BIT_17
-#define  BSP_MSK_RCC_CFGR_HPRE                    0x000000F0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV1              0x00000000u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV2              0x00000080u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV4              0x00000090u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV8              0x000000A0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV16             0x000000B0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV64             0x000000C0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV128            0x000000D0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV256            0x000000E0u
-#define  BSP_MSK_RCC_CFGR_SYSCLKDIV512            0x000000F0u
-#define  BSP_MSK_RCC_CFGR_PPRE1                   0x00001C00u
-#define  BSP_MSK_RCC_CFGR_PPRE2                   0x0000E000u
-#define  BSP_MSK_RCC_CFGR_HCLK_DIV1               0x00000000u
-#define  BSP_MSK_RCC_CFGR_HCLK_DIV2               0x00001000u
-#define  BSP_MSK_RCC_CFGR_HCLK_DIV4               0x00001400u
-#define  BSP_MSK_RCC_CFGR_HCLK_DIV8               0x00001800u
-#define  BSP_MSK_RCC_CFGR_HCLK_DIV16              0x00001C00u
-#define  BSP_MSK_RCC_CFGR_SWS_HSI                 0x00000000u
-#define  BSP_MSK_RCC_CFGR_SWS_HSE                 0x00000004u
-#define  BSP_MSK_RCC_CFGR_SWS_PLL                 0x00000008u
-#define  BSP_MSK_RCC_CFGR_SWS                     0x0000000Cu
-#define  BSP_MSK_RCC_CFGR_SW_HSI                  0x00000000u
-#define  BSP_MSK_RCC_CFGR_SW_HSE                  0x00000001u
-#define  BSP_MSK_RCC_CFGR_SW_PLL                  0x00000002u
-#define  BSP_MSK_RCC_CFGR_SW                      0x00000003u
-                                                                /* -                     PLL BLOCK                    - */
-#define  BSP_BIT_RCC_PLLCFGR_PLLM                          8u
-#define  BSP_BIT_RCC_PLLCFGR_PLLN                        336u
-#define  BSP_BIT_RCC_PLLCFGR_PLLP                          2u
-#define  BSP_BIT_RCC_PLLCFGR_PLLQ                          7u
-#define  BSP_BIT_RCC_CR_PLLON                     DEF_BIT_24
-#define  BSP_BIT_RCC_CR_PLLRDY                    DEF_BIT_25
-#define  BSP_MSK_RCC_PLLCFGR_PLLSRC_HSE           0x00400000u
-#define  BSP_MSK_RCC_PLLCFGR_RST                  0x24003010u
-#define  BSP_MSK_SYSCLK_SRC_PLLCLK                0x00000002u
-#define  BSP_MSK_PLLCFGR_PLLSRC_HSE               0x00400000u
-#define  BSP_MSK_PLLCFGR_PLLSRC_HSI               0x00000000u
-                                                                /* -                    FLASH BLOCK                   - */
-#define  BSP_BIT_FLASH_ACR_PRFTEN                 DEF_BIT_08
-#define  BSP_BIT_FLASH_ACR_ICEN                   DEF_BIT_09
-#define  BSP_BIT_FLASH_ACR_DCEN                   DEF_BIT_10
-#define  BSP_MSK_FLASHLATENCY_0WS                 0x00000000u
-#define  BSP_MSK_FLASHLATENCY_1WS                 0x00000001u
-#define  BSP_MSK_FLASHLATENCY_2WS                 0x00000002u
-#define  BSP_MSK_FLASHLATENCY_3WS                 0x00000003u
-#define  BSP_MSK_FLASHLATENCY_4WS                 0x00000004u
-#define  BSP_MSK_FLASHLATENCY_5WS                 0x00000005u
-#define  BSP_MSK_FLASHLATENCY_6WS                 0x00000006u
-#define  BSP_MSK_FLASHLATENCY_7WS                 0x00000007u
-#define  BSP_MSK_FLASHLATENCY_8WS                 0x00000008u
-#define  BSP_MSK_FLASHLATENCY_9WS                 0x00000009u
-#define  BSP_MSK_FLASHLATENCY_10WS                0x0000000Au
-#define  BSP_MSK_FLASHLATENCY_11WS                0x0000000Bu
-#define  BSP_MSK_FLASHLATENCY_12WS                0x0000000Cu
-#define  BSP_MSK_FLASHLATENCY_13WS                0x0000000Du
-#define  BSP_MSK_FLASHLATENCY_14WS                0x0000000Eu
-#define  BSP_MSK_FLASHLATENCY_15WS                0x0000000Fu
-
-
 /*
 *********************************************************************************************************
 *                                      LOCAL FUNCTION PROTOTYPES
@@ -245,107 +141,31 @@ static  void  BSP_LED_Init  (void);
 *
 *                   (c) The application may wish to adjust the trace bus width depending on I/O
 *                       requirements.
+*
+*               (3) The clock tree comes up from a clock profile (see 'bsp_clk.c'): 180 MHz from the HSE,
+*                   or from the HSI if the HSE does not start.  BSP_CPU_ClkFreq() and CPU_TS follow here;
+*                   SysTick (BSP_Tick_Init()) and the USART baud rates read the clock when they are set
+*                   up, so they MUST be set up after this call.  If neither profile can be applied, the
+*                   CPU stays on the 16 MHz HSI.
 *********************************************************************************************************
 */
 
 void  BSP_Init (void)
 {
-    CPU_INT32U reg_val;
-    CPU_INT32U hse_rdyctr;
+    CPU_INT32U   hclk_hz;
+    BSP_CLK_ERR  clk_err;
 
     BSP_IntInit();
-                                                                /* ---------- RESET CLOCK CONFIG. REGISTERS ----------- */
-
-    DEF_BIT_SET(BSP_REG32_RCC_CR,BSP_BIT_RCC_CR_HSION);         /* Set HSION bit                                        */
-
-    BSP_REG32_RCC_CFGR  = (CPU_INT32U)0u;                       /* Reset CFGR register                                  */
-
-    BSP_REG32_RCC_CR    &= 0xFEF6FFFFu;                         /* Reset HSEON, CSSON and PLLON bits                    */
-
-    BSP_REG32_RCC_PLLCFGR = BSP_MSK_RCC_PLLCFGR_RST;            /* Reset PLLCFGR register                               */
-
-    DEF_BIT_CLR(BSP_REG32_RCC_CR, BSP_BIT_RCC_CR_HSEBYP);       /* Reset HSEBYP bit                                     */
-
-                                                                /* ----------- HSE OSCILLATOR CONFIGURATION ----------- */
-                                                                /* HSE = 8MHz Ext. crystal.                             */
-    DEF_BIT_CLR(BSP_REG32_RCC_CR,BSP_MSK_HSECFG);
-
-    DEF_BIT_SET(BSP_REG32_RCC_CR,BSP_BIT_RCC_CR_HSEON);
-                                                                /* Wait for HSE to Start Up                             */
-    do {
-        hse_rdyctr++;
-    } while ((hse_rdyctr < HSE_TIMEOUT_VAL)  &&
-              DEF_BIT_IS_CLR(BSP_REG32_RCC_CR, BSP_BIT_RCC_CR_HSERDY));
-
-
-    if (hse_rdyctr == HSE_TIMEOUT_VAL) {
-        return;
-    }
-                                                                /* --------------- SET UP THE AHB PRESCALER ----------- */
-                                                                /* HCLK = AHBCLK  = PLL / AHBPRES(1) = 168MHz.          */
-    reg_val = (CPU_INT32U)0u;
-    reg_val = BSP_REG32_RCC_CFGR;
-
-    DEF_BIT_CLR(reg_val, BSP_MSK_RCC_CFGR_HPRE);                /* Clear HPRE[3:0] bits                                 */
-
-    DEF_BIT_SET(reg_val, BSP_MSK_RCC_CFGR_SYSCLKDIV1);          /* Set HPRE[3:0] bits according to RCC_SYSCLK value     */
-
-    BSP_REG32_RCC_CFGR = reg_val;                               /* Store the new value in RCC_CFGR register             */
-
-                                                                /* ---------------- CONFIGURE APB2 CLOCK -------------- */
-                                                                /*   APB2CLK = AHBCLK  / APB2DIV(2) = 84MHz.            */
-    reg_val = BSP_REG32_RCC_CFGR;
-
-    DEF_BIT_CLR(reg_val, BSP_MSK_RCC_CFGR_PPRE2);                /* Clear PPRE2[2:0] bits                                */
-
-    DEF_BIT_SET(reg_val, BSP_MSK_RCC_CFGR_HCLK_DIV2 << 3u);     /* Set PPRE2[2:0] bits according to RCC_HCLK value      */
-
-    BSP_REG32_RCC_CFGR = reg_val;                               /* Store the new value                                  */
-
-                                                                /* ---------------- CONFIGURE APB1 CLOCK -------------- */
-                                                                /* APB1CLK = AHBCLK  / APB1DIV(4) = 42MHz (max).        */
-    reg_val = BSP_REG32_RCC_CFGR;
-
-    DEF_BIT_CLR(reg_val,BSP_MSK_RCC_CFGR_PPRE1);                /* Clear PPRE1[2:0] bits                                */
-
-    DEF_BIT_SET(reg_val, BSP_MSK_RCC_CFGR_HCLK_DIV4);           /* Set PPRE1[2:0] bits according to RCC_HCLK value      */
-
-                                                                /* Store the new value in RCC_CFGR register             */
-    BSP_REG32_RCC_CFGR    =     reg_val;
-                                                                /* ------------- CONFIGURE AND ENABLE PLL ------------- */
-                                                                /* PLL_M = 8, PLL_N = 336, PLL_P = 2, PLL_Q = 7         */
-                                                                /* PLLCLK    = HSE * (PLLN / PLLM)      = 336MHz.       */
-                                                                /* SYSCLK    = PLLCLK / PLLP            = 168MHz.       */
-                                                                /* OTG_FSCLK = PLLCLK / PLLQ            =  48MHz.       */
-
-    BSP_REG32_RCC_PLLCFGR = ( BSP_BIT_RCC_PLLCFGR_PLLM       )               |
-                            ( BSP_BIT_RCC_PLLCFGR_PLLN << 6u )               |
-                            ( BSP_MSK_PLLCFGR_PLLSRC_HSE     )               |
-                            ((BSP_BIT_RCC_PLLCFGR_PLLP >> 1u ) -1u ) << 16u  |
-                            ( BSP_BIT_RCC_PLLCFGR_PLLQ << 24u);
-
-    DEF_BIT_SET( BSP_REG32_RCC_CR, BSP_BIT_RCC_CR_PLLON);
-                                                                /* Wait for PLL to lock.                                */
-    while ( DEF_BIT_IS_CLR( BSP_REG32_RCC_CR,
-                            BSP_BIT_RCC_CR_PLLRDY)) {
-        ;
+                                                                /* -------------- CLOCK TREE (see Note #3) ------------ */
+    hclk_hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSE_180MHz, &BSP_ClkRegs, &clk_err);
+    if (clk_err != BSP_CLK_ERR_NONE) {
+        hclk_hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSI_180MHz, &BSP_ClkRegs, &clk_err);
     }
-                                                                /* ------------- CONFIGURE FLASH MEMORY --------------- */
-
-    DEF_BIT_SET(BSP_REG32_FLASH_ACR, BSP_MSK_FLASHLATENCY_5WS); /* Allow 5 Flash Wait States when HCLK > 120MHz.        */
-
-                                                                /* Enable Prefetch, Instruction Cache, and Data Cache.  */
-    DEF_BIT_SET(BSP_REG32_FLASH_ACR, (BSP_BIT_FLASH_ACR_PRFTEN  |
-                                      BSP_BIT_FLASH_ACR_ICEN    |
-                                      BSP_BIT_FLASH_ACR_DCEN));
-                                                                /* -------- SELECT PLL OUTPUT AS SYSTEM CLOCK --------- */
-                                                                /* HCLK = SYSCLK = PLL = 168MHz.                        */
-    DEF_BIT_SET(BSP_REG32_RCC_CFGR, BSP_MSK_SYSCLK_SRC_PLLCLK);
-
-
-    while((BSP_REG32_RCC_CFGR & BSP_MSK_RCC_CFGR_SWS)             /* Wait until PLL is selected as system clock source    */
-                              != BSP_MSK_RCC_CFGR_SWS_PLL){
-        ;
+    if (clk_err == BSP_CLK_ERR_NONE) {
+        BSP_CPU_ClkFreq_Hz = hclk_hz;
+#if (CPU_CFG_TS_TMR_EN == DEF_ENABLED)
+        CPU_TS_TmrFreqSet((CPU_TS_TMR_FREQ)hclk_hz);            /* CPU_Init() set it up at the reset clock.             */
+#endif
     }
 
     BSP_LED_Init();                                             /* Initialize user LEDs                                 */
@@ -370,7 +190,8 @@ void  BSP_Init (void)
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : none.
+* Note(s)     : (1) BSP_Init() records the frequency it set up, so the registers are only decoded before
+*                   then, e.g. for CPU_TS_TmrInit() from CPU_Init().
 *********************************************************************************************************
 */
 
@@ -379,6 +200,10 @@ CPU_INT32U  BSP_CPU_ClkFreq (void)
     RCC_ClocksTypeDef  rcc_clocks;
 
 
+    if (BSP_CPU_ClkFreq_Hz != 0u) {                             /* See Note #1.                                         */
+        return (BSP_CPU_ClkFreq_Hz);
+    }
+
     RCC_GetClocksFreq(&rcc_clocks);
 
     return ((CPU_INT32U)rcc_clocks.HCLK_Frequency);
@@ -397,7 +222,8 @@ CPU_INT32U  BSP_CPU_ClkFreq (void)
 *
 * Caller(s)   : Application.
 *
-* Note(s)     : none.
+* Note(s)     : (1) With OS_CFG_TICK_VIRT_EN the idle task advances time itself ('os_tick.c'
+*                   OS_TickVirtAdvance()), so SysTick is not started.
 *********************************************************************************************************
 */
 
@@ -415,7 +241,11 @@ void  BSP_Tick_Init (void)
     cnts = (cpu_clk_freq / (CPU_INT32U)OS_TICKS_PER_SEC);       /* Determine nbr SysTick increments.                    */
 #endif
     
+#if (OS_VERSION >= 30000u) && (OS_CFG_TICK_VIRT_EN > 0u)
+    (void)&cnts;                                                /* See Note #1.                                         */
+#else
     OS_CPU_SysTickInit(cnts);                                   /* Init uC/OS periodic time src (SysTick).              */
+#endif
 }
 
 
@@ -102,19 +102,83 @@ typedef CPU_INT16S s16_t;
 typedef CPU_INT32U u32_t;
 typedef CPU_INT32S s32_t;
 
+                                                                /* ------------ CLOCK TREE (see bsp_clk.c) ------------ */
+typedef  enum  bsp_clk_err {
+    BSP_CLK_ERR_NONE = 0u,
+    BSP_CLK_ERR_CFG,                                            /* Profile outside the device limits.                   */
+    BSP_CLK_ERR_HSE_TIMEOUT,                                    /* HSE never became ready.                              */
+    BSP_CLK_ERR_PLL_TIMEOUT,                                    /* PLL did not stop or did not lock.                    */
+    BSP_CLK_ERR_OD_TIMEOUT,                                     /* Over-drive did not become ready.                     */
+    BSP_CLK_ERR_FLASH,                                          /* Flash latency did not read back.                     */
+    BSP_CLK_ERR_SW_TIMEOUT                                      /* SYSCLK source switch did not complete.               */
+} BSP_CLK_ERR;
+
+typedef  struct  bsp_clk_cfg {                                  /* Declarative clock profile.                           */
+    const  CPU_CHAR     *NamePtr;
+           CPU_INT32U    SrcFreq_Hz;                            /* PLL input: HSE frequency, or 0 for the 16 MHz HSI.   */
+           CPU_BOOLEAN   SrcBypass;                             /* HSE is an external clock, not a crystal.             */
+           CPU_INT08U    PLL_M;                                 /* VCO input  = src / M, 1 .. 2 MHz.                    */
+           CPU_INT16U    PLL_N;                                 /* VCO output = VCO input * N, 100 .. 432 MHz.          */
+           CPU_INT08U    PLL_P;                                 /* SYSCLK     = VCO output / P (2, 4, 6 or 8).          */
+           CPU_INT08U    PLL_Q;                                 /* PLL48CLK   = VCO output / Q, 48 MHz max.             */
+           CPU_INT16U    AHB_Div;                               /* HCLK = SYSCLK / AHB_Div (1, 2, 4 .. 512).            */
+           CPU_INT08U    APB1_Div;                              /* PCLK1 = HCLK / APB1_Div (1 .. 16), 45 MHz max.       */
+           CPU_INT08U    APB2_Div;                              /* PCLK2 = HCLK / APB2_Div (1 .. 16), 90 MHz max.       */
+           CPU_BOOLEAN   OverDrive;                             /* Needed above 168 MHz.                                */
+           CPU_BOOLEAN   Prefetch;                              /* ART accelerator: flash prefetch ...                  */
+           CPU_BOOLEAN   ICache;                                /* ... instruction cache ...                            */
+           CPU_BOOLEAN   DCache;                                /* ... and data cache.                                  */
+} BSP_CLK_CFG;
+
+typedef  struct  bsp_clk_regs {                                 /* Register blocks BSP_ClkCfgApply() programs.          */
+    RCC_TypeDef    *RCC_Ptr;
+    FLASH_TypeDef  *FLASH_Ptr;
+    PWR_TypeDef    *PWR_Ptr;
+} BSP_CLK_REGS;
+
 /*
 *********************************************************************************************************
 *                                            GLOBAL VARIABLES
 *********************************************************************************************************
 */
 
+extern  const  BSP_CLK_CFG   BSP_ClkCfg_HSE_180MHz;
+extern  const  BSP_CLK_CFG   BSP_ClkCfg_HSI_180MHz;
+extern  const  BSP_CLK_REGS  BSP_ClkRegs;
+
 
 /*
 *********************************************************************************************************
 *                                                 MACRO'S
+*
+* Note(s) : (1) BSP_CCM_DATA places a zero-initialized variable in the 64 KB core coupled memory (CCM) at
+*               0x10000000, which the core reaches over its D-bus without going through the bus matrix.
+*               Put it in front of the declaration :
+*
+*                   BSP_CCM_DATA  static  CPU_STK  AppTaskXxxStk[APP_CFG_TASK_XXX_STK_SIZE];
+*
+*               The startup code zeroes the section.  The kernel's own globals, its task stacks and its
+*               scheduler and context switch code are placed by object file in the linker files :
+*
+*                   GNU        'OS3/TrueSTUDIO/Debug_STM32F429ZI_FLASH.ld'
+*                   IAR        'BSP/IAR/STM32F429II_FLASH2M_RAM192K.icf'
+*                   RealView   'BSP/KeilMDK/STM32F429II_FLASH2M_RAM192K.sct'
+*
+*           (2) The DMA controllers cannot reach CCM.  Never tag a DMA buffer, and never hand a buffer
+*               on a CCM task stack to DMA.  CCM cannot hold code either.
 *********************************************************************************************************
 */
 
+#if   defined(__GNUC__)
+#define  BSP_CCM_DATA                   __attribute__((section(".ccmbss")))
+#elif defined(__ICCARM__)
+#define  BSP_CCM_DATA                   _Pragma("location=\".ccmbss\"")
+#elif defined(__CC_ARM)
+#define  BSP_CCM_DATA                   __attribute__((section(".ccmbss"), zero_init))
+#else
+#define  BSP_CCM_DATA
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -333,6 +397,16 @@ void        BSP_IntClr                        (CPU_DATA       int_id);
 void        BSP_IntVectSet                    (CPU_DATA       int_id,
                                                CPU_FNCT_VOID  isr);
 
+void        BSP_IntZeroLatSet                 (CPU_DATA       int_id,
+                                               CPU_FNCT_VOID  isr,
+                                               CPU_INT08U     prio);
+
+#if (OS_STAT_CYCLES_EN > 0u)
+void        BSP_IntLoadSet                    (CPU_DATA       int_id,
+                                               OS_LOAD       *p_load,
+                                               CPU_CHAR      *p_name);
+#endif
+
 void        BSP_IntPrioSet                    (CPU_DATA       int_id,
                                                CPU_INT08U     prio);
 
@@ -429,6 +503,18 @@ void         BSP_IntHandlerLTDC_ER            (void);
 void         BSP_IntHandlerDMA2D              (void);
 
 
+/*
+*********************************************************************************************************
+*                                             CLOCK SERVICES
+*********************************************************************************************************
+*/
+
+CPU_INT32U   BSP_ClkCfgFreqGet           (const  BSP_CLK_CFG   *p_cfg);
+
+CPU_INT32U   BSP_ClkCfgApply             (const  BSP_CLK_CFG   *p_cfg,
+                                          const  BSP_CLK_REGS  *p_regs,
+                                                 BSP_CLK_ERR   *p_err);
+
 /*
 *********************************************************************************************************
 *                                     PERIPHERAL POWER/CLOCK SERVICES
@@ -453,6 +539,58 @@ void        BSP_LED_Off                       (CPU_INT08U     led);
 
 void        BSP_LED_Toggle                    (CPU_INT08U     led);
 
+/*
+*********************************************************************************************************
+*                                        ZERO LATENCY ISR FILES
+*
+* Note(s) : (1) A file that holds zero latency ISRs (see BSP_IntZeroLatSet()) #define's BSP_INT_ZERO_LAT_FILE
+*               before including 'includes.h'.  The kernel services an ISR could call, and the critical
+*               section macros that would not mask such an ISR anyway, then expand to an undeclared
+*               identifier, so calling one from that file is a build error rather than a corrupted kernel.
+*
+*           (2) Keep such a file to the ISR and what only it uses.  Data shared with tasks is read and
+*               written as single aligned words, or under CPU_IntDis()/CPU_IntEn().
+*********************************************************************************************************
+*/
+
+#ifdef   BSP_INT_ZERO_LAT_FILE
+#define  OSIntEnter                  BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSIntExit                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSSched                     BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSSchedLock                 BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSSchedUnlock               BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTimeTick                  BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTimeDly                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTimeGet                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSSemPost                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSSemPend                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskSemPost               BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskSemPend               BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSQPost                     BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSQPend                     BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskQPost                 BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskQPend                 BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSFlagPost                  BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSFlagPend                  BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSMutexPost                 BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSMutexPend                 BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSMemGet                    BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSMemPut                    BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskSuspend               BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTaskResume                BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTmrStart                  BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#define  OSTmrStop                   BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#undef   OS_CRITICAL_ENTER
+#define  OS_CRITICAL_ENTER           BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#undef   OS_CRITICAL_EXIT
+#define  OS_CRITICAL_EXIT            BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#undef   CPU_CRITICAL_ENTER
+#define  CPU_CRITICAL_ENTER          BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#undef   CPU_CRITICAL_EXIT
+#define  CPU_CRITICAL_EXIT           BSP_INT_ZERO_LAT_FILE_CALLS_THE_KERNEL[-1]
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
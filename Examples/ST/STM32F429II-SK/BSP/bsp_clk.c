@@ -0,0 +1,521 @@
+/*
+*********************************************************************************************************
+*                                     MICIRUM BOARD SUPPORT PACKAGE
+*
+*                             (c) Copyright 2013; Micrium, Inc.; Weston, FL
+*
+*               All rights reserved.  Protected by international copyright laws.
+*               Knowledge of the source code may NOT be used to develop a similar product.
+*               Please help us continue to provide the Embedded community with the finest
+*               software available.  Your honesty is greatly appreciated.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        BOARD SUPPORT PACKAGE
+*                                             CLOCK TREE
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : bsp_clk.c
+* Version       : V1.00
+*
+* Note(s)       : (1) A clock profile (BSP_CLK_CFG) states the PLL source, the PLL factors, the bus dividers,
+*                     over-drive and the ART accelerator settings.  The flash wait states follow from HCLK
+*                     (30 MHz per wait state at 2.7 .. 3.6 V, see RM0090).
+*
+*                 (2) BSP_ClkCfgApply() only touches the registers through the BSP_CLK_REGS it is given,
+*                     and only through BSP_CLK_REG_RD() and BSP_CLK_REG_WR().  BSP_ClkRegs points at the
+*                     device; a host build can hand it RCC, FLASH and PWR blocks in RAM and #define both
+*                     macros before including this file to log the writes in order and play the ready
+*                     flags ('Tools/test/test_bsp_clk.c').  Every wait polls a ready flag with a bounded
+*                     count, so a mock that never sets a flag ends in a timeout error, not a hang.
+*
+*                 (3) Sequence (RM0090, over-drive entry and flash read access latency) :
+*
+*                         (a) Back to the HSI if the PLL drives SYSCLK, the PLL cannot change while in use
+*                         (b) Power interface clock on
+*                         (c) HSE on (crystal or bypass) when the profile uses it
+*                         (d) PLL off, regulator voltage scale 1 (only writable with the PLL off), factors,
+*                             PLL on, wait for lock
+*                         (e) Over-drive on, then switched in, when the profile asks for it
+*                         (f) Flash wait states for the new HCLK, read back; ART caches reset, then enabled
+*                         (g) AHB and APB dividers, then SYSCLK from the PLL
+*
+*                     Wait states go up before the clock does, and the APB dividers are in place before the
+*                     PLL drives the buses, so no bus is ever clocked above its limit.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                             INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define  BSP_CLK_MODULE
+#include  <bsp.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  BSP_CLK_TIMEOUT_CNT                      0x00010000u   /* Ready flag polls before giving up.                   */
+
+#define  BSP_CLK_HSI_FREQ_HZ                        16000000u
+#define  BSP_CLK_VCO_IN_MIN_HZ                       1000000u
+#define  BSP_CLK_VCO_IN_MAX_HZ                       2000000u
+#define  BSP_CLK_VCO_OUT_MIN_HZ                    100000000u
+#define  BSP_CLK_VCO_OUT_MAX_HZ                    432000000u
+#define  BSP_CLK_PLL48_MAX_HZ                       48000000u
+#define  BSP_CLK_HCLK_MAX_HZ                       168000000u
+#define  BSP_CLK_HCLK_OD_MAX_HZ                    180000000u
+#define  BSP_CLK_PCLK1_MAX_HZ                       45000000u
+#define  BSP_CLK_PCLK2_MAX_HZ                       90000000u
+#define  BSP_CLK_FLASH_WS_HZ                        30000000u   /* HCLK per flash wait state (see Note #1).             */
+
+                                                                /* Register access (see Note #2).                       */
+#ifndef  BSP_CLK_REG_RD
+#define  BSP_CLK_REG_RD(reg)                      (reg)
+#define  BSP_CLK_REG_WR(reg, val)                 ((reg) = (val))
+#endif
+#define  BSP_CLK_REG_SET(reg, bits)               BSP_CLK_REG_WR((reg), BSP_CLK_REG_RD(reg) |  (bits))
+#define  BSP_CLK_REG_CLR(reg, bits)               BSP_CLK_REG_WR((reg), BSP_CLK_REG_RD(reg) & ~(bits))
+
+                                                                /* -------------------- RCC BITS ---------------------- */
+#define  BSP_CLK_BIT_RCC_CR_HSION                 DEF_BIT_00
+#define  BSP_CLK_BIT_RCC_CR_HSIRDY                DEF_BIT_01
+#define  BSP_CLK_BIT_RCC_CR_HSEON                 DEF_BIT_16
+#define  BSP_CLK_BIT_RCC_CR_HSERDY                DEF_BIT_17
+#define  BSP_CLK_BIT_RCC_CR_HSEBYP                DEF_BIT_18
+#define  BSP_CLK_BIT_RCC_CR_PLLON                 DEF_BIT_24
+#define  BSP_CLK_BIT_RCC_CR_PLLRDY                DEF_BIT_25
+
+#define  BSP_CLK_BIT_RCC_PLLCFGR_PLLSRC_HSE       DEF_BIT_22
+
+#define  BSP_CLK_MSK_RCC_CFGR_SW                  0x00000003u
+#define  BSP_CLK_MSK_RCC_CFGR_SW_HSI              0x00000000u
+#define  BSP_CLK_MSK_RCC_CFGR_SW_PLL              0x00000002u
+#define  BSP_CLK_MSK_RCC_CFGR_SWS                 0x0000000Cu
+#define  BSP_CLK_MSK_RCC_CFGR_SWS_HSI             0x00000000u
+#define  BSP_CLK_MSK_RCC_CFGR_SWS_PLL             0x00000008u
+#define  BSP_CLK_MSK_RCC_CFGR_HPRE                0x000000F0u
+#define  BSP_CLK_MSK_RCC_CFGR_PPRE1               0x00001C00u
+#define  BSP_CLK_MSK_RCC_CFGR_PPRE2               0x0000E000u
+
+#define  BSP_CLK_BIT_RCC_APB1ENR_PWREN            DEF_BIT_28
+
+                                                                /* -------------------- PWR BITS ---------------------- */
+#define  BSP_CLK_MSK_PWR_CR_VOS                   0x0000C000u
+#define  BSP_CLK_MSK_PWR_CR_VOS_SCALE1            0x0000C000u
+#define  BSP_CLK_BIT_PWR_CR_ODEN                  DEF_BIT_16
+#define  BSP_CLK_BIT_PWR_CR_ODSWEN                DEF_BIT_17
+#define  BSP_CLK_BIT_PWR_CSR_ODRDY                DEF_BIT_16
+#define  BSP_CLK_BIT_PWR_CSR_ODSWRDY              DEF_BIT_17
+
+                                                                /* ------------------- FLASH BITS --------------------- */
+#define  BSP_CLK_MSK_FLASH_ACR_LATENCY            0x0000000Fu
+#define  BSP_CLK_BIT_FLASH_ACR_PRFTEN             DEF_BIT_08
+#define  BSP_CLK_BIT_FLASH_ACR_ICEN               DEF_BIT_09
+#define  BSP_CLK_BIT_FLASH_ACR_DCEN               DEF_BIT_10
+#define  BSP_CLK_BIT_FLASH_ACR_ICRST              DEF_BIT_11
+#define  BSP_CLK_BIT_FLASH_ACR_DCRST              DEF_BIT_12
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL TABLES
+*********************************************************************************************************
+*/
+
+                                                                /* HPRE[3:0] for AHB_Div 2, 4 .. 512 (no /32).          */
+static  const  CPU_INT16U  BSP_ClkAHB_DivTbl[] = { 2u, 4u, 8u, 16u, 64u, 128u, 256u, 512u };
+
+
+/*
+*********************************************************************************************************
+*                                            CLOCK PROFILES
+*
+* Note(s) : (1) 180 MHz from the 8 MHz HSE.  On the Nucleo-144 board the HSE is the ST-LINK's MCO output,
+*               hence the bypass.  VCO input 2 MHz, VCO output 360 MHz, PLL48CLK 45 MHz (the RNG needs no
+*               more than 48 MHz; USB is not used).
+*
+*           (2) The same frequencies from the 16 MHz HSI, for a board whose HSE does not start.
+*********************************************************************************************************
+*/
+
+const  BSP_CLK_CFG  BSP_ClkCfg_HSE_180MHz = {                   /* See Note #1.                                         */
+    "HSE 180 MHz",
+    HSE_VALUE,
+    DEF_YES,
+    4u, 180u, 2u, 8u,
+    1u, 4u, 2u,                                                 /* HCLK 180 MHz, PCLK1 45 MHz, PCLK2 90 MHz.            */
+    DEF_ENABLED,
+    DEF_ENABLED, DEF_ENABLED, DEF_ENABLED
+};
+
+const  BSP_CLK_CFG  BSP_ClkCfg_HSI_180MHz = {                   /* See Note #2.                                         */
+    "HSI 180 MHz",
+    0u,
+    DEF_NO,
+    8u, 180u, 2u, 8u,
+    1u, 4u, 2u,
+    DEF_ENABLED,
+    DEF_ENABLED, DEF_ENABLED, DEF_ENABLED
+};
+
+const  BSP_CLK_REGS  BSP_ClkRegs = {
+    RCC,
+    FLASH,
+    PWR
+};
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  BSP_ClkWait     (__IO  uint32_t    *p_reg,
+                                            CPU_INT32U   msk,
+                                            CPU_INT32U   val);
+
+static  CPU_INT32U   BSP_ClkHPRE     (CPU_INT16U  div);
+
+static  CPU_INT32U   BSP_ClkPPRE     (CPU_INT08U  div);
+
+
+/*
+*********************************************************************************************************
+*                                         BSP_ClkCfgFreqGet()
+*
+* Description : Check a clock profile against the device limits and compute its HCLK.
+*
+* Argument(s) : p_cfg       Clock profile.
+*
+* Return(s)   : HCLK, in Hz, or 0 if the profile breaks a limit.
+*
+* Caller(s)   : BSP_ClkCfgApply(),
+*               Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  BSP_ClkCfgFreqGet (const  BSP_CLK_CFG  *p_cfg)
+{
+    CPU_INT32U  src_hz;
+    CPU_INT32U  vco_in_hz;
+    CPU_INT32U  vco_out_hz;
+    CPU_INT32U  hclk_hz;
+    CPU_INT32U  hclk_max_hz;
+
+
+    src_hz = (p_cfg->SrcFreq_Hz != 0u) ? p_cfg->SrcFreq_Hz : BSP_CLK_HSI_FREQ_HZ;
+
+    if ((p_cfg->PLL_M <   2u) || (p_cfg->PLL_M >  63u) ||
+        (p_cfg->PLL_N <  50u) || (p_cfg->PLL_N > 432u) ||
+        (p_cfg->PLL_P <   2u) || (p_cfg->PLL_P >   8u) || ((p_cfg->PLL_P & 1u) != 0u) ||
+        (p_cfg->PLL_Q <   2u) || (p_cfg->PLL_Q >  15u)) {
+        return (0u);
+    }
+    if ((BSP_ClkHPRE(p_cfg->AHB_Div)  == DEF_INT_32U_MAX_VAL) ||
+        (BSP_ClkPPRE(p_cfg->APB1_Div) == DEF_INT_32U_MAX_VAL) ||
+        (BSP_ClkPPRE(p_cfg->APB2_Div) == DEF_INT_32U_MAX_VAL)) {
+        return (0u);
+    }
+
+    vco_in_hz  = src_hz / p_cfg->PLL_M;
+    vco_out_hz = vco_in_hz * p_cfg->PLL_N;
+    if ((vco_in_hz  < BSP_CLK_VCO_IN_MIN_HZ)  || (vco_in_hz  > BSP_CLK_VCO_IN_MAX_HZ)  ||
+        (vco_out_hz < BSP_CLK_VCO_OUT_MIN_HZ) || (vco_out_hz > BSP_CLK_VCO_OUT_MAX_HZ) ||
+        (vco_out_hz / p_cfg->PLL_Q > BSP_CLK_PLL48_MAX_HZ)) {
+        return (0u);
+    }
+
+    hclk_hz     = vco_out_hz / p_cfg->PLL_P / p_cfg->AHB_Div;
+    hclk_max_hz = (p_cfg->OverDrive == DEF_ENABLED) ? BSP_CLK_HCLK_OD_MAX_HZ : BSP_CLK_HCLK_MAX_HZ;
+    if ((hclk_hz                    > hclk_max_hz)          ||
+        (hclk_hz / p_cfg->APB1_Div  > BSP_CLK_PCLK1_MAX_HZ) ||
+        (hclk_hz / p_cfg->APB2_Div  > BSP_CLK_PCLK2_MAX_HZ)) {
+        return (0u);
+    }
+
+    return (hclk_hz);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          BSP_ClkCfgApply()
+*
+* Description : Bring the clock tree up from a clock profile.
+*
+* Argument(s) : p_cfg       Clock profile.
+*
+*               p_regs      Register blocks to program (see Note #2 at the top), BSP_ClkRegs on the target.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               BSP_CLK_ERR_NONE            Clock tree running from the profile.
+*                               BSP_CLK_ERR_CFG             Profile outside the device limits, nothing changed.
+*                               BSP_CLK_ERR_HSE_TIMEOUT     HSE did not start; SYSCLK is the HSI.
+*                               BSP_CLK_ERR_PLL_TIMEOUT     PLL did not stop or lock; SYSCLK is the HSI.
+*                               BSP_CLK_ERR_OD_TIMEOUT      Over-drive not ready; SYSCLK is the HSI.
+*                               BSP_CLK_ERR_FLASH           Wait states not taken; SYSCLK is the HSI.
+*                               BSP_CLK_ERR_SW_TIMEOUT      SYSCLK did not switch to the PLL.
+*
+* Return(s)   : HCLK, in Hz, on success; otherwise 0.
+*
+* Caller(s)   : BSP_Init(),
+*               Application.
+*
+* Note(s)     : (1) Called with interrupts off or before any peripheral depends on its clock.  Whatever
+*                   derives a rate from HCLK, PCLK1 or PCLK2 (SysTick, baud rates, CPU_TS) must be set up
+*                   again afterwards; see BSP_Init().
+*********************************************************************************************************
+*/
+
+CPU_INT32U  BSP_ClkCfgApply (const  BSP_CLK_CFG   *p_cfg,
+                             const  BSP_CLK_REGS  *p_regs,
+                                    BSP_CLK_ERR   *p_err)
+{
+    RCC_TypeDef    *p_rcc;
+    FLASH_TypeDef  *p_flash;
+    PWR_TypeDef    *p_pwr;
+    CPU_INT32U      hclk_hz;
+    CPU_INT32U      ws;
+    CPU_INT32U      reg_val;
+
+
+    hclk_hz = BSP_ClkCfgFreqGet(p_cfg);
+    if (hclk_hz == 0u) {
+       *p_err = BSP_CLK_ERR_CFG;
+        return (0u);
+    }
+    p_rcc   = p_regs->RCC_Ptr;
+    p_flash = p_regs->FLASH_Ptr;
+    p_pwr   = p_regs->PWR_Ptr;
+
+                                                                /* ------------- BACK TO THE HSI (Note #3a) ----------- */
+    BSP_CLK_REG_SET(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSION);
+    if (BSP_ClkWait(&p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSIRDY, BSP_CLK_BIT_RCC_CR_HSIRDY) == DEF_FAIL) {
+       *p_err = BSP_CLK_ERR_SW_TIMEOUT;
+        return (0u);
+    }
+    if ((BSP_CLK_REG_RD(p_rcc->CFGR) & BSP_CLK_MSK_RCC_CFGR_SWS) != BSP_CLK_MSK_RCC_CFGR_SWS_HSI) {
+        BSP_CLK_REG_WR(p_rcc->CFGR, (BSP_CLK_REG_RD(p_rcc->CFGR) & ~BSP_CLK_MSK_RCC_CFGR_SW) | BSP_CLK_MSK_RCC_CFGR_SW_HSI);
+        if (BSP_ClkWait(&p_rcc->CFGR, BSP_CLK_MSK_RCC_CFGR_SWS, BSP_CLK_MSK_RCC_CFGR_SWS_HSI) == DEF_FAIL) {
+           *p_err = BSP_CLK_ERR_SW_TIMEOUT;
+            return (0u);
+        }
+    }
+
+                                                                /* --------------- PWR CLOCK (Note #3b) --------------- */
+    BSP_CLK_REG_SET(p_rcc->APB1ENR, BSP_CLK_BIT_RCC_APB1ENR_PWREN);
+
+                                                                /* -------------------- HSE (Note #3c) ---------------- */
+    if (p_cfg->SrcFreq_Hz != 0u) {
+        BSP_CLK_REG_CLR(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSEON);   /* HSEBYP only changes with the HSE off.                */
+        if (BSP_ClkWait(&p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSERDY, 0u) == DEF_FAIL) {
+           *p_err = BSP_CLK_ERR_HSE_TIMEOUT;
+            return (0u);
+        }
+        if (p_cfg->SrcBypass == DEF_YES) {
+            BSP_CLK_REG_SET(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSEBYP);
+        } else {
+            BSP_CLK_REG_CLR(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSEBYP);
+        }
+        BSP_CLK_REG_SET(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSEON);
+        if (BSP_ClkWait(&p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSERDY, BSP_CLK_BIT_RCC_CR_HSERDY) == DEF_FAIL) {
+            BSP_CLK_REG_CLR(p_rcc->CR, BSP_CLK_BIT_RCC_CR_HSEON);
+           *p_err = BSP_CLK_ERR_HSE_TIMEOUT;
+            return (0u);
+        }
+    }
+
+                                                                /* -------------------- PLL (Note #3d) ---------------- */
+    BSP_CLK_REG_CLR(p_rcc->CR, BSP_CLK_BIT_RCC_CR_PLLON);
+    if (BSP_ClkWait(&p_rcc->CR, BSP_CLK_BIT_RCC_CR_PLLRDY, 0u) == DEF_FAIL) {
+       *p_err = BSP_CLK_ERR_PLL_TIMEOUT;
+        return (0u);
+    }
+    BSP_CLK_REG_WR(p_pwr->CR, (BSP_CLK_REG_RD(p_pwr->CR) & ~BSP_CLK_MSK_PWR_CR_VOS) | BSP_CLK_MSK_PWR_CR_VOS_SCALE1);
+    reg_val = ((CPU_INT32U)p_cfg->PLL_M)                     |
+              ((CPU_INT32U)p_cfg->PLL_N            <<  6u)   |
+              ((CPU_INT32U)(p_cfg->PLL_P / 2u - 1u) << 16u)  |
+              ((CPU_INT32U)p_cfg->PLL_Q            << 24u);
+    if (p_cfg->SrcFreq_Hz != 0u) {
+        reg_val |= BSP_CLK_BIT_RCC_PLLCFGR_PLLSRC_HSE;
+    }
+    BSP_CLK_REG_WR(p_rcc->PLLCFGR, reg_val);
+    BSP_CLK_REG_SET(p_rcc->CR, BSP_CLK_BIT_RCC_CR_PLLON);
+    if (BSP_ClkWait(&p_rcc->CR, BSP_CLK_BIT_RCC_CR_PLLRDY, BSP_CLK_BIT_RCC_CR_PLLRDY) == DEF_FAIL) {
+       *p_err = BSP_CLK_ERR_PLL_TIMEOUT;
+        return (0u);
+    }
+
+                                                                /* ----------------- OVER-DRIVE (Note #3e) ------------ */
+    if (p_cfg->OverDrive == DEF_ENABLED) {
+        BSP_CLK_REG_SET(p_pwr->CR, BSP_CLK_BIT_PWR_CR_ODEN);
+        if (BSP_ClkWait(&p_pwr->CSR, BSP_CLK_BIT_PWR_CSR_ODRDY, BSP_CLK_BIT_PWR_CSR_ODRDY) == DEF_FAIL) {
+           *p_err = BSP_CLK_ERR_OD_TIMEOUT;
+            return (0u);
+        }
+        BSP_CLK_REG_SET(p_pwr->CR, BSP_CLK_BIT_PWR_CR_ODSWEN);
+        if (BSP_ClkWait(&p_pwr->CSR, BSP_CLK_BIT_PWR_CSR_ODSWRDY, BSP_CLK_BIT_PWR_CSR_ODSWRDY) == DEF_FAIL) {
+           *p_err = BSP_CLK_ERR_OD_TIMEOUT;
+            return (0u);
+        }
+    }
+
+                                                                /* ------------- FLASH AND ART (Note #3f) ------------- */
+    ws           = (hclk_hz - 1u) / BSP_CLK_FLASH_WS_HZ;
+    BSP_CLK_REG_WR(p_flash->ACR, ws);                           /* Caches off: they may only be reset when disabled.    */
+    if ((BSP_CLK_REG_RD(p_flash->ACR) & BSP_CLK_MSK_FLASH_ACR_LATENCY) != ws) {
+       *p_err = BSP_CLK_ERR_FLASH;
+        return (0u);
+    }
+    BSP_CLK_REG_WR(p_flash->ACR, ws | BSP_CLK_BIT_FLASH_ACR_ICRST | BSP_CLK_BIT_FLASH_ACR_DCRST);
+    reg_val      = ws;
+    if (p_cfg->Prefetch == DEF_ENABLED) {
+        reg_val |= BSP_CLK_BIT_FLASH_ACR_PRFTEN;
+    }
+    if (p_cfg->ICache == DEF_ENABLED) {
+        reg_val |= BSP_CLK_BIT_FLASH_ACR_ICEN;
+    }
+    if (p_cfg->DCache == DEF_ENABLED) {
+        reg_val |= BSP_CLK_BIT_FLASH_ACR_DCEN;
+    }
+    BSP_CLK_REG_WR(p_flash->ACR, reg_val);
+
+                                                                /* ------------ BUSES AND SYSCLK (Note #3g) ----------- */
+    reg_val  = BSP_CLK_REG_RD(p_rcc->CFGR);
+    reg_val &= ~(BSP_CLK_MSK_RCC_CFGR_HPRE | BSP_CLK_MSK_RCC_CFGR_PPRE1 | BSP_CLK_MSK_RCC_CFGR_PPRE2);
+    reg_val |=  (BSP_ClkHPRE(p_cfg->AHB_Div)   <<  4u)
+            |   (BSP_ClkPPRE(p_cfg->APB1_Div)  << 10u)
+            |   (BSP_ClkPPRE(p_cfg->APB2_Div)  << 13u);
+    BSP_CLK_REG_WR(p_rcc->CFGR, reg_val);
+
+    BSP_CLK_REG_WR(p_rcc->CFGR, (BSP_CLK_REG_RD(p_rcc->CFGR) & ~BSP_CLK_MSK_RCC_CFGR_SW) | BSP_CLK_MSK_RCC_CFGR_SW_PLL);
+    if (BSP_ClkWait(&p_rcc->CFGR, BSP_CLK_MSK_RCC_CFGR_SWS, BSP_CLK_MSK_RCC_CFGR_SWS_PLL) == DEF_FAIL) {
+       *p_err = BSP_CLK_ERR_SW_TIMEOUT;
+        return (0u);
+    }
+
+   *p_err = BSP_CLK_ERR_NONE;
+    return (hclk_hz);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            BSP_ClkWait()
+*
+* Description : Poll a register until the masked bits read a value.
+*
+* Argument(s) : p_reg       Register.
+*
+*               msk         Bits to test.
+*
+*               val         Expected value of those bits.
+*
+* Return(s)   : DEF_OK,   if the bits read 'val' within BSP_CLK_TIMEOUT_CNT polls,
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : BSP_ClkCfgApply().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  BSP_ClkWait (__IO  uint32_t    *p_reg,
+                                        CPU_INT32U   msk,
+                                        CPU_INT32U   val)
+{
+    CPU_INT32U  ctr;
+
+
+    for (ctr = 0u; ctr < BSP_CLK_TIMEOUT_CNT; ctr++) {
+        if ((BSP_CLK_REG_RD(*p_reg) & msk) == val) {
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            BSP_ClkHPRE()
+*                                            BSP_ClkPPRE()
+*
+* Description : Encode an AHB or an APB divider.
+*
+* Argument(s) : div         Divider.
+*
+* Return(s)   : HPRE[3:0] or PPREx[2:0], or DEF_INT_32U_MAX_VAL if the bus has no such divider.
+*
+* Caller(s)   : BSP_ClkCfgFreqGet(),
+*               BSP_ClkCfgApply().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  BSP_ClkHPRE (CPU_INT16U  div)
+{
+    CPU_INT32U  ix;
+
+
+    if (div == 1u) {
+        return (0u);
+    }
+    for (ix = 0u; ix < sizeof(BSP_ClkAHB_DivTbl) / sizeof(BSP_ClkAHB_DivTbl[0]); ix++) {
+        if (BSP_ClkAHB_DivTbl[ix] == div) {
+            return (0x8u | ix);
+        }
+    }
+
+    return (DEF_INT_32U_MAX_VAL);
+}
+
+
+static  CPU_INT32U  BSP_ClkPPRE (CPU_INT08U  div)
+{
+    switch (div) {
+        case 1u:
+             return (0u);
+
+        case 2u:
+             return (4u);
+
+        case 4u:
+             return (5u);
+
+        case 8u:
+             return (6u);
+
+        case 16u:
+             return (7u);
+
+        default:
+             return (DEF_INT_32U_MAX_VAL);
+    }
+}
@@ -67,6 +67,10 @@
 */
 
 static  CPU_FNCT_VOID  BSP_IntVectTbl[BSP_INT_SRC_NBR];
+#if (OS_STAT_CYCLES_EN > 0u)
+static  OS_LOAD       *BSP_IntLoadTbl[BSP_INT_SRC_NBR];
+#endif
+static  CPU_INT32U     BSP_IntZeroLatTbl[(BSP_INT_SRC_NBR + 31) / 32];  /* One bit per int, see BSP_IntZeroLatSet().    */
 
 
 /*
@@ -212,11 +216,100 @@ void  BSP_IntVectSet (CPU_DATA       int_id,
     if (int_id < BSP_INT_SRC_NBR) {
         CPU_CRITICAL_ENTER();
         BSP_IntVectTbl[int_id] = isr;
+        DEF_BIT_CLR(BSP_IntZeroLatTbl[int_id / 32u], DEF_BIT(int_id % 32u));
         CPU_CRITICAL_EXIT();
     }
 }
 
 
+/*
+*********************************************************************************************************
+*                                          BSP_IntZeroLatSet()
+*
+* Description : Assign a zero latency ISR handler and its priority.
+*
+* Argument(s) : int_id      Interrupt for which vector will be set.
+*
+*               isr         Handler to assign.  It MUST NOT call any kernel service (see Note #2).
+*
+*               prio        NVIC priority level, 0 = highest (see Note #1).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) With CPU_CFG_KA_IPL_BOUNDARY #define'd in 'cpu_cfg.h', a level below the boundary is
+*                   never masked by a kernel critical section.  Otherwise every critical section still
+*                   masks it and only the kernel entry/exit below is saved.
+*
+*               (2) The handler is called without OSIntEnter()/OSIntExit().  Put it in a file that
+*                   #define's BSP_INT_ZERO_LAT_FILE so that a kernel call fails to compile (see 'bsp.h').
+*
+*               (3) Call with the interrupt disabled.  BSP_IntVectSet() turns it back into a kernel aware
+*                   handler, but does not change its priority.
+*********************************************************************************************************
+*/
+
+void  BSP_IntZeroLatSet (CPU_DATA       int_id,
+                         CPU_FNCT_VOID  isr,
+                         CPU_INT08U     prio)
+{
+    CPU_SR_ALLOC();
+
+
+    if (int_id < BSP_INT_SRC_NBR) {
+        CPU_CRITICAL_ENTER();
+        BSP_IntVectTbl[int_id] = isr;
+        DEF_BIT_SET(BSP_IntZeroLatTbl[int_id / 32u], DEF_BIT(int_id % 32u));
+        CPU_IntSrcPrioSet(int_id + 16, (CPU_INT08U)(prio << (8u - CPU_CFG_NVIC_PRIO_BITS)));
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            BSP_IntLoadSet()
+*
+* Description : Account for the cycles of an interrupt handler in a kernel load account.
+*
+* Argument(s) : int_id      Interrupt to account for.
+*
+*               p_load      Load account (see 'os.h  LOAD ACCOUNT').
+*
+*               p_name      Name of the load account.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The cycles are those of the handler assigned with BSP_IntVectSet(), including any
+*                   higher priority interrupt that nests in it.  Kernel entry and exit are counted in
+*                   the ISR total (OSIntCPUUsage) only.
+*********************************************************************************************************
+*/
+
+#if (OS_STAT_CYCLES_EN > 0u)
+void  BSP_IntLoadSet (CPU_DATA   int_id,
+                      OS_LOAD   *p_load,
+                      CPU_CHAR  *p_name)
+{
+    OS_ERR  err;
+    CPU_SR_ALLOC();
+
+
+    if (int_id < BSP_INT_SRC_NBR) {
+        OSStatLoadAdd(p_load, p_name, &err);
+        if (err == OS_ERR_NONE) {
+            CPU_CRITICAL_ENTER();
+            BSP_IntLoadTbl[int_id] = p_load;
+            CPU_CRITICAL_EXIT();
+        }
+    }
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                            BSP_IntPrioSet()
@@ -269,7 +362,9 @@ void  BSP_IntPrioSet (CPU_DATA    int_id,
 *
 * Caller(s)   : BSP_Init().
 *
-* Note(s)     : none.
+* Note(s)     : (1) The NVIC resets every priority to 0, the highest level.  With BASEPRI critical sections
+*                   (CPU_CFG_KA_IPL_BOUNDARY #define'd in 'cpu_cfg.h') that level is never masked by the
+*                   kernel, so every interrupt starts on the highest kernel aware level instead.
 *********************************************************************************************************
 */
 
@@ -280,6 +375,9 @@ void  BSP_IntInit (void)
 
     for (int_id = 0; int_id < BSP_INT_SRC_NBR; int_id++) {
         BSP_IntVectSet(int_id, BSP_IntHandlerDummy);
+#ifdef  CPU_CFG_KA_IPL_BOUNDARY                                 /* See Note #1.                                         */
+        CPU_IntSrcPrioSet(int_id + 16, (CPU_INT08U)CPU_CFG_KA_BASEPRI);
+#endif
     }
 }
 
@@ -420,9 +518,19 @@ void  BSP_IntHandlerDMA2D              (void)  { BSP_IntHandler(BSP_INT_ID_DMA2D
 static  void  BSP_IntHandler (CPU_DATA  int_id)
 {
     CPU_FNCT_VOID  isr;
+#if (OS_STAT_CYCLES_EN > 0u)
+    OS_LOAD       *p_load;
+    CPU_TS         ts;
+#endif
     CPU_SR_ALLOC();
 
 
+    if ((int_id < BSP_INT_SRC_NBR) &&                           /* Zero latency ISR: no kernel entry/exit.            */
+        (DEF_BIT_IS_SET(BSP_IntZeroLatTbl[int_id / 32u], DEF_BIT(int_id % 32u)) == DEF_YES)) {
+        BSP_IntVectTbl[int_id]();
+        return;
+    }
+
     CPU_CRITICAL_ENTER();                                       /* Tell the OS that we are starting an ISR            */
 
     OSIntEnter();
@@ -432,7 +540,18 @@ static  void  BSP_IntHandler (CPU_DATA  int_id)
     if (int_id < BSP_INT_SRC_NBR) {
         isr = BSP_IntVectTbl[int_id];
         if (isr != (CPU_FNCT_VOID)0) {
+#if (OS_STAT_CYCLES_EN > 0u)
+            p_load = BSP_IntLoadTbl[int_id];
+            if (p_load != (OS_LOAD *)0) {                       /* See BSP_IntLoadSet() Note #1                       */
+                ts  = OS_TS_GET();
+                isr();
+                p_load->Cycles += (OS_CYCLES)(OS_TS_GET() - ts);
+            } else {
+                isr();
+            }
+#else
             isr();
+#endif
         }
     }
 
@@ -7,85 +7,38 @@
 #include "stm32f4xx_rcc.h"
 #include "stm32f4xx_rng.h" /* 하드웨어 RNG */
 
-typedef enum {
-    PHASE_SELECT,  // 1단계: 문 선택 대기
-    PHASE_REVEAL,  // 2단계: 호스트 문 공개 및 교체 선택 대기
-    PHASE_RESULT   // 3단계: 최종 결과 표시
-} GamePhase_t;
-
-static volatile GamePhase_t gamePhase;
-static volatile uint8_t prizeDoor;
-static volatile uint8_t userChoice;
-static volatile uint8_t hostChoice;
-static volatile bool switchChoice;
-static volatile bool gameWin;
-static volatile uint8_t finalDoorChoice = 0; /* RESULT 단계에서 ▲ 표시용 */
-static volatile uint8_t cursorDoor = 1;      /* 1 ~ 3 */
-static volatile uint8_t cursorSwitch = 0;    /* 0=Stay, 1=Switch */
+#include "app.h"
+#include "app_batch.h"
+#include "app_bench.h"
+#include "app_bg.h"
+#include "app_console.h"
+#include "app_frame.h"
+#include "app_init.h"
+#include "app_led.h"
+#include "app_period.h"
+#include "app_replay.h"
+#include "app_stats.h"
+#include "app_telem.h"
 
 // UCOS-III binary semaphore (입력 대기용)
 static OS_SEM Sem_UserSelectDone;
-static OS_SEM Sem_DisplaySelectDone;
 static OS_SEM Sem_SwitchSelectDone;
-static OS_SEM Sem_DisplaySwitchDone;
-static OS_SEM Sem_ResultReady;
-static OS_SEM Sem_LedShow;
-static OS_SEM Sem_NextRoundDisp;  /* 화면(Task_GAME)용 */
 static OS_SEM Sem_NextRoundLogic; /* 로직(Task_GameLogic)용 */
-
-// 몬티홀 통계 (모두 AppTask_GAME에서만 업데이트)
-volatile uint16_t g_roundCount = 0;
-volatile uint16_t g_winCount = 0;
-volatile uint16_t g_loseCount = 0;
+/* 화면 갱신 요청은 Task_GAME 의 태스크 메시지 큐로 (Render_Request) */
 
 /* ANSI Escape helpers */
 #define ESC "\033"
 #define CSI "\033[" /* Control Sequence Introducer */
 
-typedef enum {
-    DOOR_CLOSED,     /* ? 표시  */
-    DOOR_OPEN_GOAT,  /* GOAT!  */
-    DOOR_OPEN_PRIZE, /* $$$$$  */
-    DOOR_OPEN_FAIL   /* XX!!   */
-} DoorState_t;
-
 typedef enum { JOY_IDLE = 0,
                JOY_LEFT = -1,
                JOY_RIGHT = +1 } JoyDir_t;
 
-/* ─── 화면 모델 ─────────────────────────────────────────── */
-static const char *doorArt[4][5] = {
-    /* DOOR_CLOSED */
-    {
-        " ┌─────┐ ",
-        " │     │ ",
-        " │  ?  │ ",
-        " │     │ ",
-        " └─────┘ "},
-    /* DOOR_OPEN_GOAT */
-    {
-        " ┌─────┐ ",
-        " │     │ ",
-        " │\033[34mGOAT!\033[0m│ ",
-        " │     │ ",
-        " └─────┘ "},
-    /* DOOR_OPEN_PRIZE */
-    {
-        " ┌─────┐ ",
-        " │\033[33m$$$$$\033[0m│ ",
-        " │\033[33m$$$$$\033[0m│ ",
-        " │\033[33m$$$$$\033[0m│ ",
-        " └─────┘ "},
-    /* DOOR_OPEN_FAIL  ★ */
-    {
-        " ┌─────┐ ",
-        " │\033[31mXXXXX\033[0m│ ",
-        " │\033[31mEMPTY\033[0m│ ",
-        " │\033[31mXXXXX\033[0m│ ",
-        " └─────┘ "}};
-
-static DoorState_t doors[4]; /* 1 ~ 3 사용 */
-static char footer[64];      /* 하단 안내 메시지 */
+static GameState_t gameState = {.cursorDoor = 1, .footer = ""};
+static APP_STATS gameStats; /* 전략(Stay/Switch) × 첫 선택 문 별 승패, gameStateLock 으로 함께 발행 */
+static SEQLOCK gameStateLock;
+static OS_MUTEX termMutex;                               /* COM1 여러 줄 출력 직렬화 (화면 ↔ 콘솔) */
+static volatile APP_RENDER_MODE renderMode = APP_RENDER_FULL;
 
 typedef enum {
     COM1 = 0,
@@ -129,23 +82,17 @@ const uint16_t COM_RX_AF[COMn] = {Nucleo_COM1_RX_AF};
 static void AppTask_GAME(void *p_arg);
 static void AppTask_GameLogic(void *p_arg);
 
-static OS_TCB AppTaskStartTCB;
-static CPU_STK AppTaskStartStk[APP_CFG_TASK_START_STK_SIZE];
-
-static OS_TCB Task_GAME_TCB;
-static CPU_STK Task_GAME_Stack[APP_CFG_TASK_START_STK_SIZE * 10];
-
-static OS_TCB Task_GameLogic_TCB;
-static CPU_STK Task_GameLogic_Stack[APP_CFG_TASK_START_STK_SIZE];
+BSP_CCM_DATA static OS_TCB AppTaskStartTCB;
+BSP_CCM_DATA static CPU_STK AppTaskStartStk[APP_CFG_TASK_START_STK_SIZE];
 
-static OS_TCB Task_LED_TCB;
-static CPU_STK Task_LED_Stk[APP_CFG_TASK_START_STK_SIZE];
+BSP_CCM_DATA static OS_TCB Task_GAME_TCB;
+BSP_CCM_DATA static CPU_STK Task_GAME_Stack[APP_CFG_TASK_GAME_STK_SIZE];
 
-static OS_TCB Task_INPUT_TCB;
-static CPU_STK Task_INPUT_Stack[APP_CFG_TASK_START_STK_SIZE * 10];
+BSP_CCM_DATA static OS_TCB Task_GameLogic_TCB;
+BSP_CCM_DATA static CPU_STK Task_GameLogic_Stack[APP_CFG_TASK_GAME_LOGIC_STK_SIZE];
 
-#define LED_GREEN_PIN GPIO_Pin_0 /* PB0  */
-#define LED_RED_PIN GPIO_Pin_14  /* PB14 */
+BSP_CCM_DATA static OS_TCB Task_INPUT_TCB;
+BSP_CCM_DATA static CPU_STK Task_INPUT_Stack[APP_CFG_TASK_INPUT_STK_SIZE];
 
 static void AppTaskStart(void *p_arg);
 static void AppTaskCreate(void);
@@ -156,112 +103,277 @@ static void AppTask_INPUT(void *p_arg);
 static void Setup_Gpio(void);
 static void Setup_InputHw(void);
 
+/* 초기화 단계 번호 = AppInitTbl[] 의 순서 */
+#define INIT_BSP 0u
+#define INIT_COM1 1u
+#define INIT_STAT 2u
+#define INIT_BENCH 3u
+#define INIT_OBJ 4u
+#define INIT_TASKS 5u
+#define INIT_RNG 6u
+#define INIT_INPUT 7u
+#define INIT_COM1_RX 8u
+#define INIT_LED 9u
+#define INIT_NBR 10u
+
 static inline void Term_ClearScreen(void) { send_string(CSI "2J" CSI "H"); }
 static inline void Term_CursorHome(void) { send_string(CSI "H"); }
 
-static void MakeStatsLine(char *buf, size_t n) {
-    CPU_SR_ALLOC();
-    OS_CRITICAL_ENTER();
-    uint16_t r = g_roundCount;
-    uint16_t w = g_winCount;
-    uint16_t l = g_loseCount;
-    OS_CRITICAL_EXIT();
-    int winRate = (r ? (w * 100) / r : 0);
-    snprintf(buf, n,
-             "[Round:%3u | \033[32mWin:%3u\033[0m | \033[31mLose:%3u\033[0m | \033[34mWin Rate:%3d%%\033[0m]",
-             r, w, l, winRate);
+/*-------------------------------------------------------------*/
+/*  게임 상태 발행 / 스냅샷                                       */
+/*-------------------------------------------------------------*/
+/* 쓰기 시작: 스케줄러 잠금으로 쓰는 태스크끼리 직렬화하고, 더 높은
+ * 우선순위의 읽는 태스크가 갱신 도중에 끼어들지 못하게 한다
+ * (lib_seqlock.h Note #3). 인터럽트는 막지 않는다. */
+static GameState_t *GameState_WrBegin(void) {
+    OS_ERR err;
+
+    OSSchedLock(&err);
+    SeqLock_WrBegin(&gameStateLock);
+    return &gameState;
 }
 
-static void RenderScreen(uint8_t cursorDoor, uint8_t cursorSwitch) {
-    char line[128];
+static void GameState_WrEnd(void) {
+    OS_ERR err;
 
-    Term_ClearScreen();
-    Term_CursorHome();
-
-    /* ─ 전체 지우기 & 타이틀 배너 ─ */
-    send_string("\033[46m\033[30m================================================\r\n");
-    send_string("              Monty Hall Simulator              \r\n");
-    send_string("================================================\033[0m\r\n\r\n");
-
-    CPU_SR_ALLOC();
-    GamePhase_t phaseSnap;
-    DoorState_t doorSnap[4];
-    uint8_t userSnap, hostSnap, finalSnap;
-    bool winSnap;
-    char footerSnap[64];
-
-    OS_CRITICAL_ENTER();
-    phaseSnap = gamePhase;
-    memcpy(doorSnap, doors, sizeof doors);
-    userSnap = userChoice;
-    hostSnap = hostChoice;
-    finalSnap = finalDoorChoice;
-    winSnap = gameWin;
-    strcpy(footerSnap, footer);
-    OS_CRITICAL_EXIT();
-
-    /* ─ 3개 문, 5줄에 걸쳐 출력 ─ */
-    for (int row = 0; row < 5; ++row) {
-        for (int d = 1; d <= 3; ++d) {
-            if (d == 1) send_string("   ");
-            send_string(doorArt[doorSnap[d]][row]);
-            send_string("       "); /* 문 간 간격 */
-        }
-        send_string("\r\n");
-    }
+    SeqLock_WrEnd(&gameStateLock);
+    OSSchedUnlock(&err);
+}
+
+/* 일관된 스냅샷 복사: 갱신과 겹치면 다시 복사 */
+static void GameState_Read(GameState_t *p_snap) {
+    (void)SeqLock_Rd(&gameStateLock, p_snap, &gameState, sizeof gameState);
+}
+
+/* 통계 스냅샷: 스냅샷이 커서 (수백 B) 게임 상태와 따로 복사한다 */
+static void GameStats_Read(APP_STATS *p_snap) {
+    (void)SeqLock_Rd(&gameStateLock, p_snap, &gameStats, sizeof gameStats);
+}
 
-    for (uint8_t i = 1; i <= 3; i++) {
-        char lbl[32];
-        if (i == 1)
-            sprintf(lbl, "       %u", i);
-        else
-            sprintf(lbl, "               %u", i);
-        send_string(lbl);
+/*-------------------------------------------------------------*/
+/*  화면 갱신 요청 / 프레임 통계                                  */
+/*-------------------------------------------------------------*/
+typedef struct {
+    CPU_INT32U requested; /* 큐에 들어간 Render_Request() 횟수  */
+    CPU_INT32U rendered;  /* 실제로 그린 프레임 수               */
+    CPU_TS latMin;        /* 입력 → 프레임 완료 지연 (CPU_TS)    */
+    CPU_TS latMax;
+    CPU_INT64U latSum;
+} RenderStats_t;
+
+static RenderStats_t renderStats = {.latMin = DEF_INT_32U_MAX_VAL}; /* AppTask_GAME 만 씀 */
+
+/* 화면 갱신 요청: Task_GAME 의 태스크 메시지 큐에 빈 메시지를 넣음.
+ * 커널이 메시지마다 포스트 시각을 기록하므로 큐 맨 앞이 가장 오래된 요청 (Note #2, app_cfg.h).
+ * 큐가 차 있으면 (OS_ERR_Q_MAX) 이미 그려질 요청이 있으므로 이 요청은 그 프레임에 합쳐짐 */
+static void Render_Request(void) {
+    OS_ERR err;
+
+    OSTaskQPost(&Task_GAME_TCB, (void *)0, 0u, OS_OPT_POST_FIFO, &err);
+}
+
+static void Render_Done(CPU_TS reqTs) {
+    renderStats.rendered++;
+    AppBg_UiActive(); /* 배경 처리율: UI 가 돈 창 */
+    if (reqTs != 0u) {
+        CPU_TS lat = OS_TS_GET() - reqTs;
+        if (lat < renderStats.latMin) renderStats.latMin = lat;
+        if (lat > renderStats.latMax) renderStats.latMax = lat;
+        renderStats.latSum += lat;
     }
-    send_string("\r\n");
+}
+
+/*-------------------------------------------------------------*/
+/*  다른 모듈에 여는 서비스 (app.h)                              */
+/*-------------------------------------------------------------*/
+/* LED GPIO: 첫 결과나 콘솔 'led' 에서 ("led" 단계) */
+void App_LedNeed(void) {
+    AppInit_Need(INIT_LED);
+}
 
-    if (phaseSnap == PHASE_REVEAL || phaseSnap == PHASE_RESULT) {
-        for (uint8_t i = 1; i <= 3; i++) {
-            uint8_t markDoor = (phaseSnap == PHASE_REVEAL) ? userSnap
-                                                           : finalSnap;
+void App_StatsRead(APP_STATS *p_snap) {
+    GameStats_Read(p_snap);
+}
 
-            if (i == 1)
-                send_string(i == markDoor ? "       ▲" : "        ");
-            else
-                send_string(i == markDoor ? "               ▲" : "                ");
-        }
-        send_string("\r\n");
-    } else {
-        send_string(" \r\n");
+/* 배치 결과 합치기: 라운드 수(roundCount)는 게임 라운드만 센다 */
+void App_StatsMerge(const APP_STATS *p_shard) {
+    (void)GameState_WrBegin();
+    AppStats_Merge(&gameStats, p_shard);
+    GameState_WrEnd();
+    Render_Request();
+}
+
+void App_StatsClr(void) {
+    (void)GameState_WrBegin();
+    AppStats_Clr(&gameStats);
+    GameState_WrEnd();
+    Render_Request();
+}
+
+void App_TermLock(void) {
+    OS_ERR err;
+
+    OSMutexPend(&termMutex, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+}
+
+void App_TermUnlock(void) {
+    OS_ERR err;
+
+    OSMutexPost(&termMutex, OS_OPT_POST_NONE, &err);
+}
+
+void App_RenderModeSet(APP_RENDER_MODE mode) {
+    renderMode = mode;
+    Render_Request(); /* 새 모드로 한 번 그림 */
+}
+
+APP_RENDER_MODE App_RenderModeGet(void) {
+    return renderMode;
+}
+
+static void MakeStatsLine(char *buf, size_t n, const APP_STATS *st) {
+    APP_STATS_CELL all;
+    APP_STATS_SUMMARY sum;
+    char r[APP_STATS_U64_STR_LEN], w[APP_STATS_U64_STR_LEN], l[APP_STATS_U64_STR_LEN];
+    CPU_INT32U pm;
+
+    AppStats_CellGet(st, APP_STATS_ALL, APP_STATS_ALL, &all);
+    AppStats_Summarize(&all, &sum);
+    pm = AppStats_Permille(sum.mean);
+    snprintf(buf, n,
+             "[Round:%3s | \033[32mWin:%3s\033[0m | \033[31mLose:%3s\033[0m | \033[34mWin Rate:%3u.%u%%\033[0m]",
+             AppStats_U64ToStr(all.rounds, r),
+             AppStats_U64ToStr(all.wins, w),
+             AppStats_U64ToStr(all.rounds - all.wins, l),
+             (unsigned)(pm / 10u), (unsigned)(pm % 10u));
+}
+
+/* 전략별 승률과 95% Wilson 신뢰구간 (‰ → %.1) */
+static void MakeStratLine(char *buf, size_t n, const APP_STATS *st) {
+    static const char *const name[APP_STATS_STRAT_NBR] = {"Stay", "Switch"};
+    APP_STATS_CELL cell;
+    APP_STATS_SUMMARY sum;
+    char r[APP_STATS_U64_STR_LEN];
+    size_t len = 0u;
+
+    buf[0] = '\0';
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR && len < n; s++) {
+        AppStats_CellGet(st, s, APP_STATS_ALL, &cell);
+        AppStats_Summarize(&cell, &sum);
+        CPU_INT32U pm = AppStats_Permille(sum.mean);
+        CPU_INT32U lo = AppStats_Permille(sum.ciLo);
+        CPU_INT32U hi = AppStats_Permille(sum.ciHi);
+        int k = snprintf(buf + len, n - len, "%s%s n=%s %u.%u%% [%u.%u-%u.%u]",
+                         (s == 0u) ? "[" : " | ", name[s],
+                         AppStats_U64ToStr(cell.rounds, r),
+                         (unsigned)(pm / 10u), (unsigned)(pm % 10u),
+                         (unsigned)(lo / 10u), (unsigned)(lo % 10u),
+                         (unsigned)(hi / 10u), (unsigned)(hi % 10u));
+        if (k < 0) return;
+        len += (size_t)k;
     }
+    if (len + 1u < n) {
+        buf[len] = ']';
+        buf[len + 1u] = '\0';
+    }
+}
 
-    /* ─ 커서(★) 줄 ───────────────────────────────────── */
-    for (uint8_t i = 1; i <= 3; i++) {
-        bool showStar = false;
+/* 배경 시뮬레이션: 라운드, 전략별 승률, 처리율 (app_bg.c) */
+static void MakeBgLine(char *buf, size_t n, const APP_STATS *st) {
+    APP_BG_STATUS bg;
+    APP_STATS_CELL cell;
+    APP_STATS_SUMMARY sum;
+    CPU_INT32U pm[APP_STATS_STRAT_NBR];
+    CPU_INT64U rounds = 0u;
+    char r[APP_STATS_U64_STR_LEN];
+
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        AppStats_CellGet(st, s, APP_STATS_ALL, &cell);
+        AppStats_Summarize(&cell, &sum);
+        pm[s] = AppStats_Permille(sum.mean);
+        rounds += cell.rounds;
+    }
+    AppBg_StatusGet(&bg);
+    snprintf(buf, n, "[Bg%s n=%s Stay %u.%u%% | Switch %u.%u%% | idle %u r/s, ui %u r/s]",
+             (bg.on == DEF_ON) ? "" : " off",
+             AppStats_U64ToStr(rounds, r),
+             (unsigned)(pm[APP_STATS_STRAT_STAY] / 10u), (unsigned)(pm[APP_STATS_STRAT_STAY] % 10u),
+             (unsigned)(pm[APP_STATS_STRAT_SWITCH] / 10u), (unsigned)(pm[APP_STATS_STRAT_SWITCH] % 10u),
+             (unsigned)AppBg_Rate(&bg, APP_BG_RATE_IDLE),
+             (unsigned)AppBg_Rate(&bg, APP_BG_RATE_UI));
+}
 
-        if (phaseSnap == PHASE_SELECT) {
-            showStar = (i == cursorDoor); /* 선택 단계 */
-        } else if (phaseSnap == PHASE_REVEAL) {
-            /* 열리지 않은 두 문 중 하나에만 커서 */
-            uint8_t altDoor = 6 - userSnap - hostSnap; /* 남은 다른 문 */
-            uint8_t curDoor = (cursorSwitch ? altDoor : userSnap);
-            showStar = (i == curDoor);
-        }
+static void RenderScreen(const GameState_t *gs, APP_RENDER_MODE mode) {
+    char line[128];
+
+    if (mode == APP_RENDER_FULL) {
+        Term_ClearScreen();
+        Term_CursorHome();
+
+        /* ─ 전체 지우기 & 타이틀 배너 ─ */
+        send_string("\033[46m\033[30m================================================\r\n");
+        send_string("              Monty Hall Simulator              \r\n");
+        send_string("================================================\033[0m\r\n\r\n");
 
-        if (i == 1)
-            send_string(showStar ? "       ★" : "        ");
-        else
-            send_string(showStar ? "               ★  " : "                ");
+        /* ─ 문, 번호, ▲ 표시, 커서(★) 줄: 프레임 캐시에서 ─ */
+        send_string(AppFrame_Body(gs));
     }
-    send_string("\r\n\r\n"); /* 끝난 뒤 공백 줄 */
 
     /* ─ 통계 ─ */
-    MakeStatsLine(line, sizeof line);
+    APP_STATS stats;
+    GameStats_Read(&stats);
+    MakeStatsLine(line, sizeof line, &stats);
+    send_string(line);
+    send_string("\r\n");
+    MakeStratLine(line, sizeof line, &stats);
+    send_string(line);
+    send_string("\r\n");
+    AppBg_StatsRead(&stats);
+    MakeBgLine(line, sizeof line, &stats);
+    send_string(line);
+    send_string("\r\n");
+#if (APP_CFG_RENDER_STATS_SHOW == DEF_ENABLED)
+    /* ─ 프레임 통계: 요청 대비 실제 렌더, 입력 → 화면 지연 (직전 프레임까지) ─ */
+    CPU_INT32U tsPerUs = BSP_CPU_ClkFreq() / 1000000u;
+    CPU_INT32U latAvg = (renderStats.rendered != 0u)
+                            ? (CPU_INT32U)(renderStats.latSum / renderStats.rendered)
+                            : 0u;
+    snprintf(line, sizeof line, "[Frames req:%u drawn:%u | in->px min:%u avg:%u max:%u us]",
+             (unsigned)renderStats.requested,
+             (unsigned)renderStats.rendered,
+             (unsigned)((renderStats.rendered != 0u) ? renderStats.latMin / tsPerUs : 0u),
+             (unsigned)(latAvg / tsPerUs),
+             (unsigned)(renderStats.latMax / tsPerUs));
+    send_string(line);
+    send_string("\r\n");
+    APP_FRAME_STATS frameStats;
+    AppFrame_StatsGet(&frameStats);
+    snprintf(line, sizeof line, "[Frame cache hit:%u miss:%u evict:%u | build max:%u hit max:%u cyc | %u B]",
+             (unsigned)frameStats.hits,
+             (unsigned)frameStats.misses,
+             (unsigned)frameStats.evictions,
+             (unsigned)frameStats.buildMax,
+             (unsigned)frameStats.hitMax,
+             (unsigned)frameStats.ramSize);
+    send_string(line);
+    send_string("\r\n");
+#endif
+#if (APP_CFG_INT_DIS_MEAS_SHOW == DEF_ENABLED) && defined(CPU_CFG_INT_DIS_MEAS_EN)
+    /* ─ 최악 인터럽트 금지 시간 (CPU_TS 단위 = CPU 클록) ─ */
+    CPU_TS_TMR intDisMax = CPU_IntDisMeasMaxGet();
+    snprintf(line, sizeof line, "[IntDis max: %u cyc = %u ns]",
+             (unsigned)intDisMax,
+             (unsigned)(((CPU_INT64U)intDisMax * 1000000000u) / BSP_CPU_ClkFreq()));
     send_string(line);
-    send_string("\r\n\r\n");
+    send_string("\r\n");
+#endif
+    if (mode != APP_RENDER_FULL) {
+        return; /* 통계 모드: 통계 줄만 이어서 출력 */
+    }
+    send_string("\r\n");
 
     /* ─ 하단 안내 ─ */
-    send_string(footerSnap);
+    send_string(gs->footer);
     send_string("\r\n");
 }
 
@@ -273,18 +385,28 @@ static void RNG_HwInit(void) {
     RCC_AHB2PeriphClockCmd(RCC_AHB2Periph_RNG, ENABLE);
 
     RNG_Cmd(DISABLE);
-    RNG_Cmd(ENABLE); /* Enable RNG */
-
-    /* 첫 DRDY 플래그 대기 */
-    while (RNG_GetFlagStatus(RNG_FLAG_DRDY) == RESET);
+    RNG_Cmd(ENABLE); /* Enable RNG, 첫 DRDY 는 첫 난수에서 기다림 */
 }
 
 /* 32-bit 난수 얻기 */
 static inline uint32_t RNG_GetRandom32(void) {
+    AppInit_Need(INIT_RNG); /* 처음 한 번만 RNG_HwInit() (app_init.c Note #2) */
     while (RNG_GetFlagStatus(RNG_FLAG_DRDY) == RESET);
     return RNG_GetRandomNumber();
 }
 
+/* 게임 로직의 난수: 재생 중이면 저널에서, 아니면 하드웨어 RNG (녹화 중이면 저널에 남김) */
+static uint32_t Game_Rand(void) {
+    CPU_INT32U r;
+
+    if (AppReplay_RandGet(&r) == DEF_YES) {
+        return r;
+    }
+    r = RNG_GetRandom32();
+    AppReplay_RandPut(r);
+    return r;
+}
+
 void STM_Nucleo_COMInit(COM_TypeDef COM, USART_InitTypeDef *USART_InitStruct) {
     GPIO_InitTypeDef GPIO_InitStructure;
 
@@ -339,14 +461,134 @@ static void USART_Config(void) {
     STM_Nucleo_COMInit(COM1, &USART_InitStructure);
 }
 
+/*-------------------------------------------------------------*/
+/*  COM1 수신: 원형 DMA + idle-line (app_console.c Note #1)       */
+/*-------------------------------------------------------------*/
+#define COM1_RX_DMA_STREAM DMA1_Stream1 /* USART3_RX = DMA1 Stream1 Channel 4 */
+#define COM1_RX_DMA_CHANNEL DMA_Channel_4
+#define COM1_RX_DMA_INT_ID BSP_INT_ID_DMA1_CH1
+
+#if (OS_STAT_CYCLES_EN > 0u)
+static OS_LOAD Com1RxDmaLoad;  /* 'load' 명령의 ISR 별 부하 */
+static OS_LOAD Com1RxIdleLoad;
+#endif
+
+/* DMA 가 다음에 쓸 위치 */
+static CPU_SIZE_T USART_RxDmaIx(void) {
+    CPU_SIZE_T size;
+
+    (void)AppConsole_RxBufGet(&size);
+    return size - DMA_GetCurrDataCounter(COM1_RX_DMA_STREAM);
+}
+
+/* 반/끝 전송 인터럽트: 한 바퀴에 두 번은 위치를 알림 */
+static void USART_RxDmaISR(void) {
+    if (DMA_GetITStatus(COM1_RX_DMA_STREAM, DMA_IT_HTIF1) != RESET) {
+        DMA_ClearITPendingBit(COM1_RX_DMA_STREAM, DMA_IT_HTIF1);
+    }
+    if (DMA_GetITStatus(COM1_RX_DMA_STREAM, DMA_IT_TCIF1) != RESET) {
+        DMA_ClearITPendingBit(COM1_RX_DMA_STREAM, DMA_IT_TCIF1);
+    }
+    AppConsole_RxNotify(USART_RxDmaIx());
+}
+
+/* 수신 선이 한 문자 시간 이상 쉬면: 받은 데까지 알림 */
+static void USART_RxIdleISR(void) {
+    if (USART_GetITStatus(Nucleo_COM1, USART_IT_IDLE) != RESET) {
+        (void)USART_ReceiveData(Nucleo_COM1); /* SR 다음 DR 읽기로 IDLE 해제 */
+        AppConsole_RxNotify(USART_RxDmaIx());
+    }
+}
+
+static void USART_RxDmaConfig(void) {
+    DMA_InitTypeDef dma;
+    CPU_SIZE_T size;
+    CPU_INT08U *p_buf = AppConsole_RxBufGet(&size);
+
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1, ENABLE);
+    DMA_DeInit(COM1_RX_DMA_STREAM);
+    DMA_StructInit(&dma);
+    dma.DMA_Channel = COM1_RX_DMA_CHANNEL;
+    dma.DMA_PeripheralBaseAddr = (uint32_t)&Nucleo_COM1->DR;
+    dma.DMA_Memory0BaseAddr = (uint32_t)p_buf;
+    dma.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    dma.DMA_BufferSize = size;
+    dma.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    dma.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    dma.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    dma.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    dma.DMA_Mode = DMA_Mode_Circular;
+    dma.DMA_Priority = DMA_Priority_Medium;
+    dma.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_Init(COM1_RX_DMA_STREAM, &dma);
+    DMA_ITConfig(COM1_RX_DMA_STREAM, DMA_IT_HT | DMA_IT_TC, ENABLE);
+
+    BSP_IntVectSet(COM1_RX_DMA_INT_ID, USART_RxDmaISR);
+    BSP_IntVectSet(BSP_INT_ID_USART3, USART_RxIdleISR);
+#if (OS_STAT_CYCLES_EN > 0u)
+    BSP_IntLoadSet(COM1_RX_DMA_INT_ID, &Com1RxDmaLoad, "COM1 RX DMA");
+    BSP_IntLoadSet(BSP_INT_ID_USART3, &Com1RxIdleLoad, "COM1 RX idle");
+#endif
+    BSP_IntEn(COM1_RX_DMA_INT_ID);
+    BSP_IntEn(BSP_INT_ID_USART3);
+
+    USART_ITConfig(Nucleo_COM1, USART_IT_IDLE, ENABLE);
+    USART_DMACmd(Nucleo_COM1, USART_DMAReq_Rx, ENABLE);
+    DMA_Cmd(COM1_RX_DMA_STREAM, ENABLE);
+}
+
+CPU_INT32U App_Rand32(void) {
+    return RNG_GetRandom32();
+}
+
+/*-------------------------------------------------------------*/
+/*  초기화 단계 (app_init.c Note #1)                              */
+/*-------------------------------------------------------------*/
+static void Init_Bsp(void) {
+    BSP_Init();      /* Initialize BSP functions                             */
+    BSP_Tick_Init(); /* Initialize Tick Services.                            */
+}
+
+static void Init_Stat(void) {
+#if (OS_CFG_STAT_TASK_EN > 0u) && (OS_STAT_CYCLES_EN == 0u)
+    OS_ERR err;
+
+    OSStatTaskCPUUsageInit(&err); /* Compute CPU capacity with no task running            */
+#endif                            /* 사이클 계수로 재면 보정이 필요 없음 (os_stat.c)      */
+}
+
+static void Init_Bench(void) {
+#if (APP_CFG_BENCH_EN == DEF_ENABLED)
+    AppBench_Run(); /* Kernel microbenchmarks, CSV report on COM1           */
+#endif
+}
+
+static void Init_Com1Rx(void) {
+#if (APP_CFG_CONSOLE_FAKE_UART_EN == DEF_DISABLED)
+    USART_RxDmaConfig();
+#endif
+}
+
+/* NOW: 태스크보다 먼저, BG: 초기화 태스크가 (먼저 찾는 태스크가 있으면 그 태스크가), LAZY: 찾을 때만 */
+static const APP_INIT_STAGE AppInitTbl[INIT_NBR] = {
+    {"bsp", Init_Bsp, APP_INIT_MODE_NOW, 0u},
+    {"com1", USART_Config, APP_INIT_MODE_NOW, APP_INIT_DEP(INIT_BSP)},                    /* 첫 화면 */
+    {"stat", Init_Stat, APP_INIT_MODE_NOW, APP_INIT_DEP(INIT_BSP)},                       /* 다른 태스크 없이 */
+    {"bench", Init_Bench, APP_INIT_MODE_NOW, APP_INIT_DEP(INIT_BSP) | APP_INIT_DEP(INIT_COM1)},
+    {"objects", AppObjCreate, APP_INIT_MODE_NOW, 0u},
+    {"tasks", AppTaskCreate, APP_INIT_MODE_NOW, APP_INIT_DEP(INIT_OBJ) | APP_INIT_DEP(INIT_COM1)},
+    {"rng", RNG_HwInit, APP_INIT_MODE_BG, APP_INIT_DEP(INIT_BSP)},                        /* PLL48 클록 */
+    {"input", Setup_InputHw, APP_INIT_MODE_BG, APP_INIT_DEP(INIT_BSP)},
+    {"com1 rx", Init_Com1Rx, APP_INIT_MODE_BG, APP_INIT_DEP(INIT_COM1) | APP_INIT_DEP(INIT_TASKS)}, /* 콘솔 태스크 */
+    {"led", Setup_Gpio, APP_INIT_MODE_LAZY, 0u},                                         /* 첫 결과에서 */
+};
+
 int main(void) {
     OS_ERR err;
 
     /* Basic Init */
-    RCC_DeInit();
-    // SystemCoreClockUpdate();
-    Setup_Gpio();
-    Setup_InputHw();
+    RCC_DeInit(); /* 16MHz HSI 로 시작, 180MHz 클럭 트리는 BSP_Init() (bsp_clk.c) */
+    /* 나머지 주변장치는 AppTaskStart() 의 초기화 단계에서 (AppInitTbl) */
     /* BSP Init */
     BSP_IntDisAll(); /* Disable all interrupts.                              */
     CPU_Init();      /* Initialize the uC/CPU Services                       */
@@ -362,7 +604,7 @@ int main(void) {
                  (void *)0u,
                  (OS_PRIO)APP_CFG_TASK_START_PRIO,
                  (CPU_STK *)&AppTaskStartStk[0u],
-                 (CPU_STK_SIZE)AppTaskStartStk[APP_CFG_TASK_START_STK_SIZE / 10u],
+                 (CPU_STK_SIZE)APP_CFG_TASK_START_STK_SIZE / 10u,
                  (CPU_STK_SIZE)APP_CFG_TASK_START_STK_SIZE,
                  (OS_MSG_QTY)0u,
                  (OS_TICK)0u,
@@ -389,33 +631,19 @@ int main(void) {
 *
 * Notes       : 1) The first line of code is used to prevent a compiler warning because 'p_arg' is not
 *                  used.  The compiler should not generate any code for this statement.
+*
+*               2) Start-up runs as the stages of AppInitTbl[] (see 'app_init.c').  Only what the first
+*                  frame needs runs here; the rest is left to the init task or to the task that uses it.
 *********************************************************************************************************
 */
 static void AppTaskStart(void *p_arg) {
-    OS_ERR err;
-
     (void)p_arg;
 
-    BSP_Init();      /* Initialize BSP functions                             */
-    BSP_Tick_Init(); /* Initialize Tick Services.                            */
-    USART_Config();
-    RNG_HwInit(); /* <<< 추가 */
-
-#if OS_CFG_STAT_TASK_EN > 0u
-    OSStatTaskCPUUsageInit(&err); /* Compute CPU capacity with no task running            */
-#endif
+    AppInit_Start(AppInitTbl, INIT_NBR);
 
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
     CPU_IntDisMeasMaxCurReset();
 #endif
-
-    // BSP_LED_Off(0u);                                            /* Turn Off LEDs after initialization                   */
-
-    APP_TRACE_DBG(("Creating Application Kernel Objects\n\r"));
-    AppObjCreate(); /* Create Applicaiton kernel objects                    */
-
-    APP_TRACE_DBG(("Creating Application Tasks\n\r"));
-    AppTaskCreate(); /* Create Application tasks                            */
 }
 
 static JoyDir_t Joystick_ReadDir(void) {
@@ -439,92 +667,101 @@ void send_string(const char *str) {
     }
 }
 
-static void AppTask_LED(void *p_arg) {
+void send_bytes(const CPU_INT08U *p_data, CPU_SIZE_T len) {
+    while (len-- != 0u) {
+        while (USART_GetFlagStatus(Nucleo_COM1, USART_FLAG_TXE) == RESET);
+        USART_SendData(Nucleo_COM1, *p_data++);
+    }
+}
+
+/* 라운드 결과 LED (app_led.c): 연승이면 도는 불, 빠른 재생 중에는 켜지 않음 */
+static void Led_Result(bool win) {
+    static CPU_INT32U winStreak;
+
+    winStreak = win ? winStreak + 1u : 0u;
+    if (AppReplay_IsFast() == DEF_YES) {
+        return;
+    }
+    App_LedNeed();
+    if (winStreak >= APP_CFG_LED_STREAK_MIN) {
+        AppLed_Play(&AppLed_PatStreak);
+    } else {
+        AppLed_Play(win ? &AppLed_PatWin : &AppLed_PatLose);
+    }
+}
+
+/* 입력 이벤트 하나를 게임에 반영: AppTask_INPUT (실제 입력) 또는 재생 태스크 (app_replay.c) 가 호출 */
+void App_InputApply(APP_INPUT_EVENT ev) {
     OS_ERR err;
-    (void)p_arg;
 
-    for (;;) {
-        /* ① 게임 로직이 Sem_LedShow 를 포스트할 때까지 대기 */
-        OSSemPend(&Sem_LedShow, 0u, OS_OPT_PEND_BLOCKING, NULL, &err);
-
-        CPU_SR_ALLOC();
-        OS_CRITICAL_ENTER(); /* ▼ gameWin 스냅샷 */
-        bool win = gameWin;
-        OS_CRITICAL_EXIT(); /* ▲ */
-
-        if (win) { /* 승리 → GREEN */
-            GPIO_SetBits(GPIOB, LED_GREEN_PIN);
-        } else { /* 패배 → RED   */
-            GPIO_SetBits(GPIOB, LED_RED_PIN);
+    AppReplay_Input(ev); /* 녹화 중이면 저널에 */
+
+    /* ───── ① 조이스틱 이동 처리 ─────────────────────── */
+    if (ev != APP_INPUT_BTN) {
+        GameState_t *gs = GameState_WrBegin(); /* ▼ 갱신 시작 */
+        GamePhase_t phaseSnap = gs->phase;
+        if (phaseSnap == PHASE_SELECT) {
+            gs->cursorDoor = (ev == APP_INPUT_LEFT)
+                                 ? ((gs->cursorDoor == 1) ? 3 : gs->cursorDoor - 1)
+                                 : ((gs->cursorDoor == 3) ? 1 : gs->cursorDoor + 1);
+        } else if (phaseSnap == PHASE_REVEAL) {
+            gs->cursorSwitch ^= 1;
         }
+        GameState_WrEnd(); /* ▲ 갱신 끝   */
 
-        /* ② 2 초 점등 */
-        OSTimeDlyHMSM(0, 0, 2, 0, OS_OPT_TIME_HMSM_STRICT, &err);
+        /* 화면 갱신 요청은 갱신 밖에서 */
+        if (phaseSnap == PHASE_SELECT || phaseSnap == PHASE_REVEAL)
+            Render_Request();
+        return;
+    }
 
-        /* ③ 소등 */
-        GPIO_ResetBits(GPIOB, LED_GREEN_PIN | LED_RED_PIN);
+    /* ───── ② 확인 버튼 처리 ───────────────────────── */
+    GameState_t *gs = GameState_WrBegin(); /* ▼ */
+    GamePhase_t phaseSnap = gs->phase;
+    if (phaseSnap == PHASE_SELECT) {
+        gs->userChoice = gs->cursorDoor;
+    } else if (phaseSnap == PHASE_REVEAL) {
+        gs->switchChoice = (gs->cursorSwitch == 1);
+    }
+    GameState_WrEnd(); /* ▲ */
+
+    /* 화면 갱신은 다음 단계를 발행하는 GameLogic 이 요청 */
+    if (phaseSnap == PHASE_SELECT) {
+        OSSemPost(&Sem_UserSelectDone, OS_OPT_POST_1, &err);
+    } else if (phaseSnap == PHASE_REVEAL) {
+        OSSemPost(&Sem_SwitchSelectDone, OS_OPT_POST_1, &err);
+    } else if (phaseSnap == PHASE_RESULT) {
+        OSSemPost(&Sem_NextRoundLogic, OS_OPT_POST_1, &err);
     }
 }
 
 static void AppTask_INPUT(void *p_arg) {
-    OS_ERR err;
+    static APP_PERIOD period; /* 모니터에 등록된 채로 남음 */
     (void)p_arg;
 
     bool btnPrev = true; /* 풀-업 → HIGH(1) */
     JoyDir_t dirPrev = JOY_IDLE;
 
+    AppInit_Need(INIT_INPUT); /* 초기화 태스크보다 먼저 돌면 여기서 설정 */
+
+    AppPeriod_Start(&period, "AppTask_INPUT", APP_CFG_INPUT_PERIOD_MS);
     for (;;) {
-        /* ───── ① 조이스틱 이동 처리 ─────────────────────── */
-        JoyDir_t dir = Joystick_ReadDir();
+        /* 재생 중에는 실제 입력을 읽기만 하고 버림 (엣지 상태는 계속 따라감) */
+        CPU_BOOLEAN live = (AppReplay_IsPlaying() == DEF_NO);
 
-        if (dir != dirPrev && dir != JOY_IDLE) {
-            CPU_SR_ALLOC();
-            OS_CRITICAL_ENTER(); /* ▼ 보호 시작 */
-            if (gamePhase == PHASE_SELECT) {
-                cursorDoor = (dir == JOY_LEFT)
-                                 ? ((cursorDoor == 1) ? 3 : cursorDoor - 1)
-                                 : ((cursorDoor == 3) ? 1 : cursorDoor + 1);
-            } else if (gamePhase == PHASE_REVEAL) {
-                cursorSwitch ^= 1;
-            }
-            OS_CRITICAL_EXIT(); /* ▲ 보호 끝   */
-
-            /* 세마포어 포스트는 보호 밖에서 */
-            OS_CRITICAL_ENTER();
-            GamePhase_t phaseSnap = gamePhase;
-            OS_CRITICAL_EXIT();
-            if (phaseSnap == PHASE_SELECT)
-                OSSemPost(&Sem_DisplaySelectDone, OS_OPT_POST_1, &err);
-            else if (phaseSnap == PHASE_REVEAL)
-                OSSemPost(&Sem_DisplaySwitchDone, OS_OPT_POST_1, &err);
+        JoyDir_t dir = Joystick_ReadDir();
+        if (dir != dirPrev && dir != JOY_IDLE && live) {
+            App_InputApply((dir == JOY_LEFT) ? APP_INPUT_LEFT : APP_INPUT_RIGHT);
         }
         dirPrev = dir;
 
-        /* ───── ② 확인 버튼 처리 ───────────────────────── */
         bool btnNow = GPIO_ReadInputDataBit(GPIOF, GPIO_Pin_13);
-        if (!btnNow && btnPrev) { /* Edge ↓ */
-            CPU_SR_ALLOC();
-            OS_CRITICAL_ENTER(); /* ▼ */
-
-            if (gamePhase == PHASE_SELECT) {
-                userChoice = cursorDoor;
-                OS_CRITICAL_EXIT(); /* ▲ */
-                OSSemPost(&Sem_UserSelectDone, OS_OPT_POST_1, &err);
-                OSSemPost(&Sem_DisplaySelectDone, OS_OPT_POST_1, &err);
-            } else if (gamePhase == PHASE_REVEAL) {
-                switchChoice = (cursorSwitch == 1);
-                OS_CRITICAL_EXIT(); /* ▲ */
-                OSSemPost(&Sem_SwitchSelectDone, OS_OPT_POST_1, &err);
-                OSSemPost(&Sem_DisplaySwitchDone, OS_OPT_POST_1, &err);
-            } else if (gamePhase == PHASE_RESULT) {
-                OS_CRITICAL_EXIT(); /* ▲ */
-                OSSemPost(&Sem_NextRoundDisp, OS_OPT_POST_1, &err);
-                OSSemPost(&Sem_NextRoundLogic, OS_OPT_POST_1, &err);
-            }
+        if (!btnNow && btnPrev && live) { /* Edge ↓ */
+            App_InputApply(APP_INPUT_BTN);
         }
         btnPrev = btnNow;
 
-        OSTimeDlyHMSM(0, 0, 0, 10, OS_OPT_TIME_HMSM_STRICT, &err); /* 10 ms */
+        AppPeriod_Wait(&period); /* 절대 tick 릴리스, 지터/미스 기록 */
     }
 }
 
@@ -538,7 +775,7 @@ static void AppTask_INPUT(void *p_arg) {
 *
 * Return(s)   : none
 *
-* Caller(s)   : AppTaskStart()
+* Caller(s)   : AppInit_Start(), stage "tasks" of AppInitTbl[]
 *
 * Note(s)     : none.
 *********************************************************************************************************
@@ -554,8 +791,8 @@ static void AppTaskCreate(void) {
         (void *)0u,
         (OS_PRIO)0u,
         (CPU_STK *)&Task_INPUT_Stack[0u],
-        (CPU_STK_SIZE)Task_INPUT_Stack[(APP_CFG_TASK_START_STK_SIZE * 10) / 10u],
-        (CPU_STK_SIZE)APP_CFG_TASK_START_STK_SIZE * 10,
+        (CPU_STK_SIZE)APP_CFG_TASK_INPUT_STK_SIZE / 10u,
+        (CPU_STK_SIZE)APP_CFG_TASK_INPUT_STK_SIZE,
         (OS_MSG_QTY)0u,
         (OS_TICK)0u,
         (void *)0u,
@@ -566,10 +803,10 @@ static void AppTaskCreate(void) {
     OSTaskCreate(&Task_GAME_TCB, "AppTask_GAME",
                  AppTask_GAME, 0,
                  4u, &Task_GAME_Stack[0],
-                 APP_CFG_TASK_START_STK_SIZE / 10u,
-                 APP_CFG_TASK_START_STK_SIZE * 10,
-                 0, 0, 0,
-                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+                 APP_CFG_TASK_GAME_STK_SIZE / 10u,
+                 APP_CFG_TASK_GAME_STK_SIZE,
+                 APP_CFG_RENDER_REQ_Q_SIZE, 0, 0,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | OS_OPT_TASK_SAVE_FP, &err); /* 통계 줄: FP32 요약 */
 
     /* GameLogic Task: 입력 이벤트 받아 시뮬레이션 수행 */
     OSTaskCreate(&Task_GameLogic_TCB,
@@ -578,20 +815,17 @@ static void AppTaskCreate(void) {
                  0u,
                  3u, /* 우선순위 조정 */
                  &Task_GameLogic_Stack[0],
-                 APP_CFG_TASK_START_STK_SIZE / 10u,
-                 APP_CFG_TASK_START_STK_SIZE,
+                 APP_CFG_TASK_GAME_LOGIC_STK_SIZE / 10u,
+                 APP_CFG_TASK_GAME_LOGIC_STK_SIZE,
                  0u, 0u, 0u,
                  OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR,
                  &err);
 
-    OSTaskCreate(&Task_LED_TCB, "AppTask_LED",
-                 AppTask_LED, 0,
-                 5u, /* 우선순위 : GAME보다 낮게 */
-                 &Task_LED_Stk[0],
-                 APP_CFG_TASK_START_STK_SIZE / 10u,
-                 APP_CFG_TASK_START_STK_SIZE,
-                 0, 0, 0,
-                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+    AppConsole_Init(); /* COM1 명령 콘솔 */
+    AppBatch_Init();   /* 배치 시뮬레이션 */
+    AppBg_Init();      /* 배경 시뮬레이션 (idle 바로 위) */
+    AppTelem_Init();   /* 바이너리 텔레메트리 (render telem) */
+    AppReplay_Init();  /* 입력 저널 녹화 / 재생 */
 }
 
 /*
@@ -604,7 +838,7 @@ static void AppTaskCreate(void) {
 *
 * Return(s)   : none
 *
-* Caller(s)   : AppTaskStart()
+* Caller(s)   : AppInit_Start(), stage "objects" of AppInitTbl[]
 *
 * Note(s)     : none.
 *********************************************************************************************************
@@ -612,14 +846,13 @@ static void AppTaskCreate(void) {
 
 static void AppObjCreate(void) {
     OS_ERR err;
+    SeqLock_Init(&gameStateLock);
+    AppStats_Clr(&gameStats);
     OSSemCreate(&Sem_UserSelectDone, "UserSelDone", 0u, &err);
-    OSSemCreate(&Sem_DisplaySelectDone, "DispSelDone", 0u, &err);
     OSSemCreate(&Sem_SwitchSelectDone, "SwitchSelDone", 0u, &err);
-    OSSemCreate(&Sem_DisplaySwitchDone, "DispSwitchDone", 0u, &err);
-    OSSemCreate(&Sem_ResultReady, "ResultReady", 0u, &err);
-    OSSemCreate(&Sem_LedShow, "LedShow", 0u, &err);
-    OSSemCreate(&Sem_NextRoundDisp, "NextRoundDisp", 0u, &err);
     OSSemCreate(&Sem_NextRoundLogic, "NextRoundLogic", 0u, &err);
+    OSMutexCreate(&termMutex, "Term", &err);
+    AppLed_Init(); /* 결과 LED 타이머 */
 }
 
 /*
@@ -632,7 +865,7 @@ static void AppObjCreate(void) {
 *
 * Return(s)   : none
 *
-* Caller(s)   : AppTaskStart()
+* Caller(s)   : AppInit_Need(), stage "led" of AppInitTbl[]
 *
 * Note(s)     :
 *              LED1 PB0
@@ -660,133 +893,121 @@ static void Setup_Gpio(void) {
 /*-------------------------------------------------------------*/
 static void AppTask_GAME(void *p_arg) {
     OS_ERR err;
+    GameState_t snap;
+    const OS_TICK frameTicks = (APP_CFG_RENDER_FRAME_MS * OSCfg_TickRate_Hz + 999u) / 1000u;
+    OS_TICK frameTick = OSTimeGet(&err) - frameTicks; /* 마지막 프레임 시작 tick */
+    OS_MSG_SIZE msgSize;
+    CPU_TS reqTs;
+
+    (void)p_arg;
 
     for (;;) {
-        /* 선택 단계 ------------------------------------------------ */
-        CPU_SR_ALLOC();
-        OS_CRITICAL_ENTER();
-        uint8_t doorSnap = cursorDoor;
-        GamePhase_t phase = gamePhase;
-        OS_CRITICAL_EXIT();
-        RenderScreen(doorSnap, 0);
-        while (phase == PHASE_SELECT) {
-            OSSemPend(&Sem_DisplaySelectDone, 0, OS_OPT_PEND_BLOCKING, NULL, &err);
-            CPU_SR_ALLOC();
-            OS_CRITICAL_ENTER();
-            doorSnap = cursorDoor;
-            phase = gamePhase;
-            OS_CRITICAL_EXIT();
-            RenderScreen(doorSnap, 0);
+        /* 화면 갱신 요청 대기: reqTs = 아직 그려지지 않은 가장 오래된 요청의 포스트 시각 */
+        (void)OSTaskQPend(0, OS_OPT_PEND_BLOCKING, &msgSize, &reqTs, &err);
+
+        /* 프레임 간격 제한: 직전 프레임 이후 간격이 남았으면 기다리며 요청을 모으고,
+         * 한동안 조용했다면 (idle 후 첫 이벤트) 기다리지 않고 바로 그림 */
+        OS_TICK elapsed = OSTimeGet(&err) - frameTick;
+        if (elapsed < frameTicks) {
+            OSTimeDly(frameTicks - elapsed, OS_OPT_TIME_DLY, &err);
         }
 
-        /* 스테이/스위치 단계 --------------------------------------- */
-        OS_CRITICAL_ENTER();
-        doorSnap = cursorDoor;
-        uint8_t switchSnap = cursorSwitch;
-        phase = gamePhase;
-        OS_CRITICAL_EXIT();
-        RenderScreen(doorSnap, switchSnap);
-        while (phase == PHASE_REVEAL) {
-            OSSemPend(&Sem_DisplaySwitchDone, 0, OS_OPT_PEND_BLOCKING, NULL, &err);
-            CPU_SR_ALLOC();
-            OS_CRITICAL_ENTER();
-            doorSnap = cursorDoor;
-            switchSnap = cursorSwitch;
-            phase = gamePhase;
-            OS_CRITICAL_EXIT();
-            RenderScreen(doorSnap, switchSnap);
+        /* 쌓인 요청을 모두 흡수한 뒤 스냅샷: 이후 요청은 다음 프레임으로 */
+        renderStats.requested += 1u + OSTaskQFlush((OS_TCB *)0, &err);
+        frameTick = OSTimeGet(&err);
+
+        GameState_Read(&snap);
+        APP_RENDER_MODE mode = App_RenderModeGet();
+        if ((mode == APP_RENDER_FULL) || (mode == APP_RENDER_STATS)) { /* OFF, TELEM: 그리지 않음 */
+            App_TermLock(); /* 콘솔 응답과 섞이지 않게 */
+            RenderScreen(&snap, mode);
+            App_TermUnlock();
+            Render_Done(reqTs);
+            AppInit_FrameDone(); /* 부팅 보고: 첫 화면 */
         }
-
-        /* 결과 단계 ----------------------------------------------- */
-        OSSemPend(&Sem_ResultReady, 0, OS_OPT_PEND_BLOCKING, NULL, &err);
-        RenderScreen(0, 0);                           /* 문 + 결과 표시 */
-        OSSemPost(&Sem_LedShow, OS_OPT_POST_1, &err); /* 2 s LED */
-
-        /* BTN 누를 때까지 대기 */
-        OSSemPend(&Sem_NextRoundDisp, 0, OS_OPT_PEND_BLOCKING, NULL, &err);
     }
 }
 
 static void AppTask_GameLogic(void *p_arg) {
     OS_ERR err;
+    GameState_t *gs;
 
     for (;;) {
-        OSSemSet(&Sem_DisplaySelectDone, 0, &err);
-        OSSemSet(&Sem_DisplaySwitchDone, 0, &err);
-        /* 1) 라운드 초기화 */
-        CPU_SR_ALLOC();
-        OS_CRITICAL_ENTER();
-        cursorDoor = 1;
-        cursorSwitch = 0;
-        prizeDoor = (RNG_GetRandom32() % 3) + 1;
-        gamePhase = PHASE_SELECT;
-        userChoice = 0;
-        switchChoice = false;
-        doors[1] = doors[2] = doors[3] = DOOR_CLOSED;
-        strcpy(footer, "←/→ to move, BTN select");
-        OS_CRITICAL_EXIT();
-
-        OSSemPost(&Sem_DisplaySelectDone, OS_OPT_POST_1, &err); /* 화면 갱신 요청 */
+        /* 1) 라운드 초기화 (난수는 갱신 밖에서 미리 뽑음) */
+        AppReplay_RoundStart(); /* 녹화 / 재생은 라운드 경계에서 시작 */
+        uint8_t prize = (Game_Rand() % 3) + 1;
+        gs = GameState_WrBegin();
+        gs->cursorDoor = 1;
+        gs->cursorSwitch = 0;
+        gs->prizeDoor = prize;
+        gs->phase = PHASE_SELECT;
+        gs->userChoice = 0;
+        gs->switchChoice = false;
+        gs->doors[1] = gs->doors[2] = gs->doors[3] = DOOR_CLOSED;
+        gs->footer = "←/→ to move, BTN select";
+        GameState_WrEnd();
+
+        Render_Request(); /* 화면 갱신 요청 */
 
         /* 2) 사용자 첫 선택 대기 */
         OSSemPend(&Sem_UserSelectDone, 0u, OS_OPT_PEND_BLOCKING, NULL, &err);
         /* 3) 호스트 문 공개 (userChoice, prizeDoor 기반) */
-        OS_CRITICAL_ENTER();
-        if (userChoice == prizeDoor) {
-            // 상금 아닌 문 중 랜덤 공개
-            do {
-                hostChoice = (RNG_GetRandom32() % 3) + 1;
-            } while (hostChoice == prizeDoor);
+        uint32_t hostRnd = Game_Rand();
+        gs = GameState_WrBegin();
+        if (gs->userChoice == gs->prizeDoor) {
+            // 상금 아닌 두 문 중 랜덤 공개
+            uint8_t next = (gs->prizeDoor % 3) + 1;
+            gs->hostChoice = (hostRnd & 1u) ? next : (uint8_t)(6 - gs->prizeDoor - next);
         } else {
             // 남은 하나(상금도 아님) 공개
-            for (uint8_t d = 1; d <= 3; d++) {
-                if (d != userChoice && d != prizeDoor) {
-                    hostChoice = d;
-                    break;
-                }
-            }
+            gs->hostChoice = (uint8_t)(6 - gs->userChoice - gs->prizeDoor);
         }
 
         /* 4) 교체 여부 선택 단계로 전환 */
-        gamePhase = PHASE_REVEAL;
-        cursorSwitch = 0;
+        gs->phase = PHASE_REVEAL;
+        gs->cursorSwitch = 0;
         /* 5) 사용자 교체/유지 선택 대기 */
         /* 호스트가 염소 문을 연 직후 ---------------------------- */
-        doors[hostChoice] = DOOR_OPEN_GOAT;
-        strcpy(footer, "←/→ Toggle Stay/Switch, BTN confirm");
-        OS_CRITICAL_EXIT();
-        OSSemPost(&Sem_DisplaySwitchDone, OS_OPT_POST_1, &err); /* 화면 갱신 요청 */
+        gs->doors[gs->hostChoice] = DOOR_OPEN_GOAT;
+        gs->footer = "←/→ Toggle Stay/Switch, BTN confirm";
+        GameState_WrEnd();
+        Render_Request(); /* 화면 갱신 요청 */
         OSSemPend(&Sem_SwitchSelectDone, 0u, OS_OPT_PEND_BLOCKING, NULL, &err);
 
         /* 6) 최종 선택 결정 */
-        OS_CRITICAL_ENTER();
-        uint8_t finalDoor = switchChoice
-                                ? (uint8_t)(6 - userChoice - hostChoice)  // 1+2+3=6
-                                : userChoice;
-
-        finalDoorChoice = finalDoor;
-        gameWin = (finalDoor == prizeDoor);
-        gamePhase = PHASE_RESULT;
+        gs = GameState_WrBegin();
+        uint8_t finalDoor = gs->switchChoice
+                                ? (uint8_t)(6 - gs->userChoice - gs->hostChoice)  // 1+2+3=6
+                                : gs->userChoice;
+
+        gs->finalDoorChoice = finalDoor;
+        gs->gameWin = (finalDoor == gs->prizeDoor);
+        gs->phase = PHASE_RESULT;
         /* ─ 통계 누적 ------------------------------------------- */
-        g_roundCount++;
-        if (gameWin)
-            g_winCount++;
-        else
-            g_loseCount++;
+        gs->roundCount++;
+        AppStats_Add(&gameStats,
+                     gs->switchChoice ? APP_STATS_STRAT_SWITCH : APP_STATS_STRAT_STAY,
+                     gs->userChoice, gs->gameWin ? 1u : 0u);
+        AppTelem_Round(gs->roundCount,
+                       gs->switchChoice ? APP_STATS_STRAT_SWITCH : APP_STATS_STRAT_STAY,
+                       gs->userChoice, gs->prizeDoor, gs->gameWin ? 1u : 0u);
+        AppReplay_Result(finalDoor, gs->gameWin ? DEF_YES : DEF_NO);
         /* 결과 확정 직후 --------------------------------------- */
-        doors[prizeDoor] = DOOR_OPEN_PRIZE;
-        if (!gameWin)
-            doors[finalDoor] = DOOR_OPEN_FAIL; /* 최종 선택 문을 FAIL 상태로 */
+        gs->doors[gs->prizeDoor] = DOOR_OPEN_PRIZE;
+        if (!gs->gameWin)
+            gs->doors[finalDoor] = DOOR_OPEN_FAIL; /* 최종 선택 문을 FAIL 상태로 */
         else {
             /* 승리 → 나머지 한 문을 EMPTY 로 열어 줌 */
-            uint8_t remDoor = 6 - prizeDoor - hostChoice; /* 세 문 합 1 + 2 + 3 = 6 */
-            doors[remDoor] = DOOR_OPEN_FAIL;
+            uint8_t remDoor = 6 - gs->prizeDoor - gs->hostChoice; /* 세 문 합 1 + 2 + 3 = 6 */
+            gs->doors[remDoor] = DOOR_OPEN_FAIL;
         }
 
-        strcpy(footer, gameWin ? "\033[32mWIN!\033[0m – press BTN for next round"
-                               : "\033[31mLOSE!\033[0m – press BTN for next round");
-        OS_CRITICAL_EXIT();
-        OSSemPost(&Sem_ResultReady, OS_OPT_POST_1, &err); /* 화면 갱신 요청 */
+        gs->footer = gs->gameWin ? "\033[32mWIN!\033[0m – press BTN for next round"
+                                 : "\033[31mLOSE!\033[0m – press BTN for next round";
+        bool win = gs->gameWin;
+        GameState_WrEnd();
+        Render_Request(); /* 화면 갱신 요청 */
+        Led_Result(win);  /* 라운드 결과 2 s LED */
 
         /* 7) 잠시 대기 후 재시작 */
         // OSTimeDlyHMSM(0, 0, 5, 0, OS_OPT_TIME_HMSM_STRICT, &err);
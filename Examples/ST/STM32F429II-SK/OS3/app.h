@@ -0,0 +1,109 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app.h
+* Description   : Application-wide services shared between app.c and the app_xxx modules.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_MODULE_PRESENT
+#define  APP_MODULE_PRESENT
+
+#include  <stdint.h>
+#include  <stdbool.h>
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  <app_cfg.h>
+#include  "app_stats.h"
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef enum {
+    PHASE_SELECT,  // 1단계: 문 선택 대기
+    PHASE_REVEAL,  // 2단계: 호스트 문 공개 및 교체 선택 대기
+    PHASE_RESULT   // 3단계: 최종 결과 표시
+} GamePhase_t;
+
+typedef enum {
+    DOOR_CLOSED,     /* ? 표시  */
+    DOOR_OPEN_GOAT,  /* GOAT!  */
+    DOOR_OPEN_PRIZE, /* $$$$$  */
+    DOOR_OPEN_FAIL   /* XX!!   */
+} DoorState_t;
+
+/* ─── 공유 게임 상태 ───────────────────────────────────────
+ * 모든 태스크가 공유하는 상태를 한 구조체로 모아 seqlock 으로 발행한다.
+ * 쓰기는 app.c 의 GameState_WrBegin()/GameState_WrEnd() 사이에서만 (스케줄러 잠금),
+ * 읽기는 GameState_Read() 로 스냅샷을 복사하며 인터럽트를 막지 않는다. */
+typedef struct {
+    GamePhase_t phase;
+    uint8_t prizeDoor;
+    uint8_t userChoice;
+    uint8_t hostChoice;
+    uint8_t finalDoorChoice; /* RESULT 단계에서 ▲ 표시용 */
+    uint8_t cursorDoor;      /* 1 ~ 3 */
+    uint8_t cursorSwitch;    /* 0=Stay, 1=Switch */
+    bool switchChoice;
+    bool gameWin;
+    DoorState_t doors[4]; /* 1 ~ 3 사용 */
+    const char *footer;   /* 하단 안내 메시지 (문자열 상수) */
+    uint32_t roundCount;  /* 끝난 라운드 수 (승/패 통계는 app_stats 의 gameStats) */
+} GameState_t;
+
+typedef enum {
+    APP_INPUT_LEFT,   /* 조이스틱 왼쪽으로 (엣지)   */
+    APP_INPUT_RIGHT,  /* 조이스틱 오른쪽으로 (엣지) */
+    APP_INPUT_BTN     /* 버튼 눌림 (엣지)          */
+} APP_INPUT_EVENT;
+
+typedef enum {
+    APP_RENDER_FULL,  /* 전체 화면 (기본)        */
+    APP_RENDER_STATS, /* 통계 줄만, 지우지 않음   */
+    APP_RENDER_OFF,   /* 화면 갱신 안 함         */
+    APP_RENDER_TELEM  /* 바이너리 텔레메트리 (app_telem.c) */
+} APP_RENDER_MODE;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void             send_string      (const char       *str);      /* Blocking USART3 (COM1) string output.                */
+
+void             send_bytes       (const CPU_INT08U *p_data,    /* Blocking USART3 (COM1) binary output.                */
+                                   CPU_SIZE_T        len);
+
+void             App_TermLock     (void);                       /* Exclusive use of COM1 for multi-line output.         */
+
+void             App_TermUnlock   (void);
+
+CPU_INT32U       App_Rand32       (void);                       /* Hardware RNG.                                        */
+
+void             App_InputApply   (APP_INPUT_EVENT   ev);       /* Feed an input event to the game (live or replay).    */
+
+void             App_RenderModeSet(APP_RENDER_MODE   mode);
+
+APP_RENDER_MODE  App_RenderModeGet(void);
+
+void             App_StatsMerge   (const APP_STATS  *p_shard);  /* Add a shard to the game statistics.                  */
+
+void             App_StatsRead    (APP_STATS        *p_snap);
+
+void             App_StatsClr     (void);
+
+void             App_LedNeed      (void);                       /* Set up the LED GPIOs before 'app_led.c' drives them. */
+
+
+#endif
@@ -0,0 +1,766 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_batch.c
+* Description   : Background batch simulation of Monty Hall rounds.
+*
+* Note(s)       : (1) A batch runs in its own task at APP_CFG_TASK_BATCH_PRIO, below every game task and
+*                     the kernel's statistics and timer tasks, so the game and the console stay responsive.
+*                     Rounds are simulated APP_CFG_BATCH_CHUNK at a time into a private shard that is then
+*                     merged into the game statistics (App_StatsMerge()); a stop request, a strategy or a
+*                     door count change takes effect at the next chunk.
+*
+*                 (2) With N doors the host opens N - 2 goat doors, so switching moves to the single other
+*                     closed door.  Switching therefore wins exactly when the first pick was wrong :
+*
+*                         stay   wins  <=>  pick == prize          P = 1 / N
+*                         switch wins  <=>  pick != prize          P = (N - 1) / N
+*
+*                     and a round only needs two random draws: prize and pick.
+*
+*                 (3) Random numbers come from xoshiro128**, seeded through splitmix32 so that any 32-bit
+*                     seed gives a good state.  Doors are drawn with a multiply-shift ((r * N) >> 32) rather
+*                     than a modulo; the bias is below 2^-29 for N <= 8.
+*
+*                 (4) With a tolerance set (AppBatch_TolSet()), the batch also keeps its own running totals
+*                     per strategy and stops after the first chunk at which every strategy it plays is
+*                     within the tolerance of the exact probability (AppExact_Check(), 'app_exact.c'); the
+*                     target, if any, still bounds it.  The totals restart when the strategy or the door
+*                     count changes.  Only the batch's rounds count, not the interactive game's.
+*
+*                 (5) Variance reduction (AppBatch_SampleSet()).  In the common random number (CRN) modes a
+*                     draw of prize and pick is scored for both strategies.  Draws come in blocks of m; the
+*                     wins x of each strategy in a block, and the paired difference d = x_switch - x_stay,
+*                     are independent from block to block, so the estimators are block means over m and
+*                     their variances come from the spread of the blocks :
+*
+*                         CRN     m = 1   prize and pick at random
+*                         ANTI    m = 2   one prize, a random pick and its mirror N - 1 - pick
+*                         STRAT   m = N   for o = 0 .. N - 1: prize at random, pick = prize + o mod N
+*
+*                     The host opens N - 2 doors, so switch wins exactly when stay loses and d = m - 2 x_stay:
+*                     the difference carries all of stay's variance and common numbers cannot shrink it;
+*                     they save the draws, each one being scored twice.  The two picks of an antithetic
+*                     pair cannot both win for an even N, which lowers the variance, and are uncorrelated
+*                     for an odd N.  STRAT samples each offset of the pick to the prize (the strata, each of
+*                     probability 1 / N) once per block.  Since the outcome only depends on that offset, no
+*                     variance is left and the estimate is exact after one block; such a run checks the
+*                     scoring, not the generator.
+*
+*                     The variance reduction factor is the variance of independent sampling with as many
+*                     draws, split evenly between the strategies estimated, over the estimator's variance :
+*                     p (1 - p) / D over var, with p1 q1 + p2 q2 for the difference.  INDEP gives about 1.
+*
+*                     Block sums are exact integers within a chunk (APP_BATCH_EST_ACC); each chunk is merged
+*                     into the batch's moments with Chan's parallel update (see 'app_stats.c' Note #1), the
+*                     means from the 64-bit sums and M2 in CPU_FP32 with a relative error of about one
+*                     2^-24 per chunk.
+*
+*                 (6) With a precision set (AppBatch_PrecSet()), the batch stops after the first chunk at
+*                     which the half-width z * sqrt(var) of every estimate, i.e. of each strategy played and
+*                     of the difference when both are, is at most the precision.  Unlike the tolerance
+*                     (Note #4) it needs no exact answer, and the CRN modes get there in fewer draws.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_batch.h"
+#include "app_exact.h"
+
+BSP_CCM_DATA static OS_TCB BatchTCB;
+BSP_CCM_DATA static CPU_STK BatchStk[APP_CFG_TASK_BATCH_STK_SIZE];
+
+static APP_STATS BatchShard;     /* 배치 태스크 전용, 청크마다 합친 뒤 비움 */
+static APP_BATCH_STATUS BatchStatus = {.strat = APP_BATCH_STRAT_SWITCH,
+                                       .doors = APP_BATCH_DOORS_MIN};
+static volatile CPU_BOOLEAN BatchStopReq;
+static APP_STATS_CELL BatchSum[APP_STATS_STRAT_NBR]; /* 배치 태스크 전용, 허용오차 판정용 (Note #4) */
+static APP_BATCH_EST BatchEst;         /* 배치 태스크 전용 (Note #5)     */
+static APP_BATCH_EST BatchEstPub;      /* 청크마다 복사, AppBatch_EstGet() */
+
+/*-------------------------------------------------------------*/
+/*  난수 (Note #3)                                              */
+/*-------------------------------------------------------------*/
+static inline CPU_INT32U Batch_Rotl(CPU_INT32U x, CPU_INT08U k) {
+    return (x << k) | (x >> (32u - k));
+}
+
+static inline CPU_INT32U Batch_Rand(APP_BATCH_RNG *p_rng) {
+    CPU_INT32U *s = p_rng->s;
+    CPU_INT32U r = Batch_Rotl(s[1] * 5u, 7u) * 9u;
+    CPU_INT32U t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Batch_Rotl(s[3], 11u);
+    return r;
+}
+
+/* 0 .. doors-1 */
+static inline CPU_INT08U Batch_Door(CPU_INT32U r, CPU_INT08U doors) {
+    return (CPU_INT08U)(((CPU_INT64U)r * doors) >> 32);
+}
+
+/* 한 추첨을 두 전략으로, stay 승 = 1 */
+static inline CPU_INT08U Batch_Score(APP_STATS *p_stats, CPU_INT08U prize, CPU_INT08U pick) {
+    CPU_INT08U win = (prize == pick);
+
+    AppStats_Add(p_stats, APP_STATS_STRAT_STAY, (CPU_INT08U)(pick + 1u), win);
+    AppStats_Add(p_stats, APP_STATS_STRAT_SWITCH, (CPU_INT08U)(pick + 1u), (CPU_INT08U)(win ^ 1u));
+    return win;
+}
+
+static CPU_INT08U Batch_BlockLen(CPU_INT08U sample, CPU_INT08U doors) {
+    return (sample == APP_BATCH_SAMPLE_STRAT) ? doors : (sample == APP_BATCH_SAMPLE_ANTI) ? 2u : 1u;
+}
+
+/*-------------------------------------------------------------*/
+/*  추정치 (Note #5)                                            */
+/*-------------------------------------------------------------*/
+/* Chan: 블록 n_a 개의 (합 s1_a, M2_a) 에 청크의 n_b 개 (합 s1_b, 제곱합 s2_b) 를 더한 M2 */
+static CPU_FP32 Batch_ChanM2(CPU_INT64U na, CPU_INT64S s1a, CPU_FP32 m2a,
+                             CPU_INT32U nb, CPU_INT32S s1b, CPU_INT32U s2b) {
+    CPU_FP32 m2b, delta;
+
+    if (nb == 0u) {
+        return m2a;
+    }
+    m2b = (CPU_FP32)((CPU_INT64S)nb * (CPU_INT64S)s2b - (CPU_INT64S)s1b * s1b) / (CPU_FP32)nb; /* 정확한 분자 */
+    if (na == 0u) {
+        return m2b;
+    }
+    delta = (CPU_FP32)s1b / (CPU_FP32)nb - (CPU_FP32)s1a / (CPU_FP32)na;
+    return m2a + m2b + delta * delta * ((CPU_FP32)na * (CPU_FP32)nb / (CPU_FP32)(na + nb));
+}
+
+static void Batch_EstMerge(APP_BATCH_EST *p_est, const APP_BATCH_EST_ACC *p_acc) {
+    if (p_est->sample != APP_BATCH_SAMPLE_INDEP) {
+        p_est->dm2 = Batch_ChanM2(p_est->n[0], p_est->d1, p_est->dm2, p_acc->n[0], p_acc->d1, p_acc->d2);
+        p_est->d1 += p_acc->d1;
+    }
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        p_est->m2[s] = Batch_ChanM2(p_est->n[s], (CPU_INT64S)p_est->s1[s], p_est->m2[s],
+                                    p_acc->n[s], (CPU_INT32S)p_acc->s1[s], p_acc->s2[s]);
+        p_est->s1[s] += p_acc->s1[s];
+        p_est->n[s] += p_acc->n[s];
+    }
+}
+
+static CPU_BOOLEAN Batch_Precise(CPU_INT32U prec) {
+    APP_BATCH_EST_SUMMARY sum;
+    const CPU_FP32 half_max = (CPU_FP32)prec / 1000000.0f;
+    CPU_BOOLEAN any = DEF_NO;
+
+    for (CPU_INT08U what = 0u; what <= APP_BATCH_EST_DIFF; what++) {
+        if (AppBatch_EstSummarize(&BatchEst, what, &sum) != DEF_OK) {
+            continue; /* 두 번 이상 뽑지 않은 전략 */
+        }
+        if (sum.half > half_max) {
+            return DEF_NO;
+        }
+        any = DEF_YES;
+    }
+    return any;
+}
+
+/*-------------------------------------------------------------*/
+/*  허용오차 (Note #4)                                          */
+/*-------------------------------------------------------------*/
+static CPU_BOOLEAN Batch_Converged(CPU_INT08U doors, CPU_INT32U tol) {
+    APP_EXACT_MODEL model;
+    APP_EXACT_RESULT exact;
+    APP_EXACT_CHECK chk;
+    APP_STATS_CELL cell;
+    CPU_BOOLEAN played = DEF_NO;
+
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        AppStats_CellGet(&BatchShard, s, APP_STATS_ALL, &cell);
+        BatchSum[s].rounds += cell.rounds;
+        BatchSum[s].wins += cell.wins;
+    }
+
+    AppExact_ModelInit(&model, doors);
+    (void)AppExact_Eval(&model, APP_EXACT_PICK_ANY, &exact);
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        if (BatchSum[s].rounds == 0u) {
+            continue;
+        }
+        AppExact_Check(&exact.win[s], &BatchSum[s], tol, &chk);
+        if (chk.within == DEF_NO) {
+            return DEF_NO;
+        }
+        played = DEF_YES;
+    }
+    return played;
+}
+
+/*-------------------------------------------------------------*/
+/*  배치 태스크                                                  */
+/*-------------------------------------------------------------*/
+static void AppTask_Batch(void *p_arg) {
+    OS_ERR err;
+    APP_BATCH_RNG rng;
+    APP_BATCH_EST_ACC acc;
+    APP_STATS_CELL cell;
+    CPU_INT08U strat, doors, sample, m, sumStrat = 0u, sumDoors = 0u, sumSample = 0u;
+    CPU_INT64U target, done;
+    CPU_INT32U n, tol, prec;
+    CPU_BOOLEAN converged;
+    CPU_TS ts;
+    CPU_SR_ALLOC();
+
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+
+        CPU_CRITICAL_ENTER();
+        target = BatchStatus.target;
+        AppBatch_RngSeed(&rng, BatchStatus.seed);
+        CPU_CRITICAL_EXIT();
+
+        done = 0u;
+        converged = DEF_NO;
+        sumDoors = 0u; /* 합계를 새로 */
+        while ((BatchStopReq == DEF_NO) && (converged == DEF_NO)) {
+            n = APP_CFG_BATCH_CHUNK;
+            if ((target != 0u) && (target - done < n)) {
+                n = (CPU_INT32U)(target - done);
+            }
+            if (n == 0u) {
+                break;
+            }
+
+            CPU_CRITICAL_ENTER(); /* 설정 변경은 청크 단위로 반영 (Note #1) */
+            strat = BatchStatus.strat;
+            doors = BatchStatus.doors;
+            tol = BatchStatus.tol;
+            sample = BatchStatus.sample;
+            prec = BatchStatus.prec;
+            CPU_CRITICAL_EXIT();
+            if ((strat != sumStrat) || (doors != sumDoors) || (sample != sumSample)) { /* 다른 실험 (Note #4, #5) */
+                Mem_Clr(BatchSum, sizeof BatchSum);
+                Mem_Clr(&BatchEst, sizeof BatchEst);
+                BatchEst.sample = sample;
+                BatchEst.m = Batch_BlockLen(sample, doors);
+                sumStrat = strat;
+                sumDoors = doors;
+                sumSample = sample;
+            }
+
+            Mem_Clr(&acc, sizeof acc);
+            ts = OS_TS_GET();
+            if (sample == APP_BATCH_SAMPLE_INDEP) {
+                AppBatch_Run(&BatchShard, &rng, strat, doors, n);
+            } else {
+                m = BatchEst.m;
+                n = (n + m - 1u) / m; /* 블록 수, 마지막 청크는 조금 넘칠 수 있음 */
+                AppBatch_RunVr(&BatchShard, &acc, &rng, sample, doors, n);
+                n *= m;
+            }
+            ts = OS_TS_GET() - ts;
+            if (sample == APP_BATCH_SAMPLE_INDEP) { /* 라운드 = 블록, 승 = 승의 제곱 */
+                for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+                    AppStats_CellGet(&BatchShard, s, APP_STATS_ALL, &cell);
+                    acc.n[s] = (CPU_INT32U)cell.rounds;
+                    acc.s1[s] = (CPU_INT32U)cell.wins;
+                    acc.s2[s] = (CPU_INT32U)cell.wins;
+                }
+            }
+
+            App_StatsMerge(&BatchShard);
+            Batch_EstMerge(&BatchEst, &acc);
+            if (tol != 0u) {
+                converged = Batch_Converged(doors, tol);
+            }
+            if ((prec != 0u) && (converged == DEF_NO)) {
+                converged = Batch_Precise(prec);
+            }
+            AppStats_Clr(&BatchShard);
+            done += n;
+
+            CPU_CRITICAL_ENTER();
+            BatchStatus.done = done;
+            BatchStatus.cycles += ts;
+            BatchStatus.converged = converged;
+            BatchEstPub = BatchEst;
+            CPU_CRITICAL_EXIT();
+        }
+
+        CPU_CRITICAL_ENTER();
+        BatchStatus.running = DEF_NO;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                           AppBatch_Init()
+*
+* Description : Create the batch task.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskCreate().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppBatch_Init(void) {
+    OS_ERR err;
+
+    AppStats_Clr(&BatchShard);
+    OSTaskCreate(&BatchTCB, "AppTask_Batch",
+                 AppTask_Batch, 0u,
+                 APP_CFG_TASK_BATCH_PRIO,
+                 &BatchStk[0],
+                 APP_CFG_TASK_BATCH_STK_SIZE / 10u,
+                 APP_CFG_TASK_BATCH_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+}
+
+/*
+*********************************************************************************************************
+*                                          AppBatch_Start()
+*
+* Description : Start a batch with the current strategy and door count.
+*
+* Argument(s) : target      Number of rounds to simulate, or 0 to run until AppBatch_Stop().
+*
+*               seed        Seed of the random number generator; the same seed, strategy and door count
+*                           give the same results.
+*
+* Return(s)   : DEF_OK,   if the batch was started.
+*
+*               DEF_FAIL, if a batch is already running.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppBatch_Start(CPU_INT64U target, CPU_INT32U seed) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if (BatchStatus.running == DEF_YES) {
+        CPU_CRITICAL_EXIT();
+        return DEF_FAIL;
+    }
+    BatchStatus.running = DEF_YES;
+    BatchStatus.seed = seed;
+    BatchStatus.target = target;
+    BatchStatus.done = 0u;
+    BatchStatus.cycles = 0u;
+    BatchStatus.converged = DEF_NO;
+    BatchStopReq = DEF_NO;
+    CPU_CRITICAL_EXIT();
+
+    OSTaskSemPost(&BatchTCB, OS_OPT_POST_NONE, &err);
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                           AppBatch_Stop()
+*
+* Description : Stop the running batch after its current chunk.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The rounds of the current chunk are still merged into the game statistics.
+*********************************************************************************************************
+*/
+
+void AppBatch_Stop(void) {
+    BatchStopReq = DEF_YES;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppBatch_StratSet()
+*
+* Description : Set the strategy of batch rounds.
+*
+* Argument(s) : strat       APP_BATCH_STRAT_STAY, APP_BATCH_STRAT_SWITCH or APP_BATCH_STRAT_MIX.
+*
+* Return(s)   : DEF_OK,   if the strategy was set.
+*
+*               DEF_FAIL, if 'strat' is invalid.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) A running batch uses the new strategy from its next chunk on.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppBatch_StratSet(CPU_INT08U strat) {
+    if (strat > APP_BATCH_STRAT_MIX) {
+        return DEF_FAIL;
+    }
+    BatchStatus.strat = strat;
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppBatch_DoorsSet()
+*
+* Description : Set the number of doors of batch rounds.
+*
+* Argument(s) : doors       APP_BATCH_DOORS_MIN .. APP_BATCH_DOORS_MAX.
+*
+* Return(s)   : DEF_OK,   if the door count was set.
+*
+*               DEF_FAIL, if 'doors' is out of range.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) A running batch uses the new door count from its next chunk on.  The interactive game
+*                   always has three doors.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppBatch_DoorsSet(CPU_INT08U doors) {
+    if ((doors < APP_BATCH_DOORS_MIN) || (doors > APP_BATCH_DOORS_MAX)) {
+        return DEF_FAIL;
+    }
+    BatchStatus.doors = doors;
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                          AppBatch_TolSet()
+*
+* Description : Set the tolerance at which a batch stops by itself.
+*
+* Argument(s) : tol         Tolerance on the win probability (ppm), or 0 to run to the target.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #4 at the top of this file.  A running batch uses the new tolerance from its
+*                   next chunk on.
+*********************************************************************************************************
+*/
+
+void AppBatch_TolSet(CPU_INT32U tol) {
+    BatchStatus.tol = tol;
+}
+
+/*
+*********************************************************************************************************
+*                                        AppBatch_SampleSet()
+*
+* Description : Set how batch rounds are sampled.
+*
+* Argument(s) : sample      APP_BATCH_SAMPLE_INDEP, _CRN, _ANTI or _STRAT.
+*
+* Return(s)   : DEF_OK,   if the sampling was set.
+*
+*               DEF_FAIL, if 'sample' is invalid.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #5 at the top of this file.  The CRN modes score both strategies and ignore the
+*                   strategy setting.  A running batch uses the new sampling from its next chunk on, and its
+*                   estimates restart.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppBatch_SampleSet(CPU_INT08U sample) {
+    if (sample > APP_BATCH_SAMPLE_STRAT) {
+        return DEF_FAIL;
+    }
+    BatchStatus.sample = sample;
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppBatch_PrecSet()
+*
+* Description : Set the precision at which a batch stops by itself.
+*
+* Argument(s) : prec        Confidence half-width of the estimates (ppm), or 0 to run to the target.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #6 at the top of this file.
+*********************************************************************************************************
+*/
+
+void AppBatch_PrecSet(CPU_INT32U prec) {
+    BatchStatus.prec = prec;
+}
+
+/*
+*********************************************************************************************************
+*                                        AppBatch_StatusGet()
+*
+* Description : Get the batch settings and the progress of the running or last batch.
+*
+* Argument(s) : p_status    Pointer to the status copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppBatch_StatusGet(APP_BATCH_STATUS *p_status) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_status = BatchStatus;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                         AppBatch_RngSeed()
+*
+* Description : Seed a batch random number generator.
+*
+* Argument(s) : p_rng       Pointer to the generator.
+*
+*               seed        Seed.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_Batch(), Application.
+*
+* Note(s)     : (1) See Note #3 at the top of this file.
+*********************************************************************************************************
+*/
+
+void AppBatch_RngSeed(APP_BATCH_RNG *p_rng, CPU_INT32U seed) {
+    for (CPU_INT08U i = 0u; i < 4u; i++) {
+        CPU_INT32U z = (seed += 0x9E3779B9u); /* splitmix32 */
+        z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+        p_rng->s[i] = z ^ (z >> 16);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                           AppBatch_Run()
+*
+* Description : Simulate rounds and add them to a statistics shard.
+*
+* Argument(s) : p_stats     Pointer to the shard.
+*
+*               p_rng       Pointer to the random number generator.
+*
+*               strat       APP_BATCH_STRAT_STAY, APP_BATCH_STRAT_SWITCH or APP_BATCH_STRAT_MIX.
+*
+*               doors       APP_BATCH_DOORS_MIN .. APP_BATCH_DOORS_MAX.
+*
+*               rounds      Number of rounds.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_Batch(), Application.
+*
+* Note(s)     : (1) See Note #2 at the top of this file.  The kernel touches no shared state, so it can be
+*                   run on any shard, from any task.
+*
+*               (2) In APP_BATCH_STRAT_MIX the low bit of the pick draw chooses the strategy; the pick
+*                   itself comes from the high bits.
+*********************************************************************************************************
+*/
+
+void AppBatch_Run(APP_STATS *p_stats, APP_BATCH_RNG *p_rng, CPU_INT08U strat, CPU_INT08U doors, CPU_INT32U rounds) {
+    while (rounds-- != 0u) {
+        CPU_INT32U rPrize = Batch_Rand(p_rng);
+        CPU_INT32U rPick = Batch_Rand(p_rng);
+        CPU_INT08U prize = Batch_Door(rPrize, doors);
+        CPU_INT08U pick = Batch_Door(rPick, doors);
+        CPU_INT08U sw = (strat == APP_BATCH_STRAT_MIX) ? (CPU_INT08U)(rPick & 1u) : strat; /* Note #2 */
+
+        AppStats_Add(p_stats, sw, (CPU_INT08U)(pick + 1u), (CPU_INT08U)((prize == pick) ^ sw));
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          AppBatch_RunVr()
+*
+* Description : Simulate blocks of rounds with common random numbers and add them to a statistics shard
+*               and to the block sums of a chunk.
+*
+* Argument(s) : p_stats     Pointer to the shard; every draw adds a round to both strategies.
+*
+*               p_acc       Pointer to the block sums.
+*
+*               p_rng       Pointer to the random number generator.
+*
+*               sample      APP_BATCH_SAMPLE_CRN, _ANTI or _STRAT.
+*
+*               doors       APP_BATCH_DOORS_MIN .. APP_BATCH_DOORS_MAX.
+*
+*               blocks      Number of blocks, each of 1, 2 or 'doors' draws.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_Batch(), Application.
+*
+* Note(s)     : (1) See Note #5 at the top of this file.  The 32-bit block sums hold a chunk; a block wins
+*                   at most APP_BATCH_DOORS_MAX times, so up to 2^25 blocks fit.
+*********************************************************************************************************
+*/
+
+void AppBatch_RunVr(APP_STATS *p_stats, APP_BATCH_EST_ACC *p_acc, APP_BATCH_RNG *p_rng, CPU_INT08U sample,
+                    CPU_INT08U doors, CPU_INT32U blocks) {
+    CPU_INT08U m = Batch_BlockLen(sample, doors);
+    CPU_INT08U prize, pick;
+
+    while (blocks-- != 0u) {
+        CPU_INT32U stay = 0u, sw;
+        CPU_INT32S d;
+
+        if (sample == APP_BATCH_SAMPLE_STRAT) {
+            for (CPU_INT08U o = 0u; o < doors; o++) {
+                prize = Batch_Door(Batch_Rand(p_rng), doors);
+                pick = (CPU_INT08U)((prize + o) % doors);
+                stay += Batch_Score(p_stats, prize, pick);
+            }
+        } else {
+            prize = Batch_Door(Batch_Rand(p_rng), doors);
+            pick = Batch_Door(Batch_Rand(p_rng), doors);
+            stay += Batch_Score(p_stats, prize, pick);
+            if (sample == APP_BATCH_SAMPLE_ANTI) {
+                stay += Batch_Score(p_stats, prize, (CPU_INT08U)(doors - 1u - pick));
+            }
+        }
+
+        sw = m - stay;
+        d = (CPU_INT32S)sw - (CPU_INT32S)stay;
+        p_acc->n[APP_STATS_STRAT_STAY]++;
+        p_acc->n[APP_STATS_STRAT_SWITCH]++;
+        p_acc->s1[APP_STATS_STRAT_STAY] += stay;
+        p_acc->s2[APP_STATS_STRAT_STAY] += stay * stay;
+        p_acc->s1[APP_STATS_STRAT_SWITCH] += sw;
+        p_acc->s2[APP_STATS_STRAT_SWITCH] += sw * sw;
+        p_acc->d1 += d;
+        p_acc->d2 += (CPU_INT32U)(d * d);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          AppBatch_EstGet()
+*
+* Description : Get the estimator state of the running or last batch, as of its last chunk.
+*
+* Argument(s) : p_est       Pointer to the copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppBatch_EstGet(APP_BATCH_EST *p_est) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_est = BatchEstPub;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                       AppBatch_EstSummarize()
+*
+* Description : Compute an estimate, its variance, confidence half-width and variance reduction factor.
+*
+* Argument(s) : p_est       Pointer to the estimator state.
+*
+*               what        APP_STATS_STRAT_STAY, APP_STATS_STRAT_SWITCH or APP_BATCH_EST_DIFF.
+*
+*               p_sum       Pointer to the summary.
+*
+* Return(s)   : DEF_OK,   if the estimate exists.
+*
+*               DEF_FAIL, if it needs more blocks (at least 2 of each strategy involved).
+*
+* Caller(s)   : AppTask_Batch(), Application.
+*
+* Note(s)     : (1) See Note #5 at the top of this file.  Without common numbers the difference is that of
+*                   two independent estimates, and its variance their sum.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppBatch_EstSummarize(const APP_BATCH_EST *p_est, CPU_INT08U what, APP_BATCH_EST_SUMMARY *p_sum) {
+    const CPU_FP32 z = (CPU_FP32)APP_CFG_STATS_Z_X100 / 100.0f;
+    CPU_BOOLEAN paired = (p_est->sample != APP_BATCH_SAMPLE_INDEP) ? DEF_YES : DEF_NO;
+    APP_BATCH_EST_SUMMARY st, sw;
+    CPU_FP32 n, m = (CPU_FP32)p_est->m, ref, d_per;
+    CPU_INT08U k;
+
+    if (paired == DEF_YES) {
+        p_sum->draws = p_est->n[0] * p_est->m;
+        k = APP_STATS_STRAT_NBR;
+    } else {
+        p_sum->draws = p_est->n[APP_STATS_STRAT_STAY] + p_est->n[APP_STATS_STRAT_SWITCH];
+        k = (CPU_INT08U)((p_est->n[APP_STATS_STRAT_STAY] != 0u) + (p_est->n[APP_STATS_STRAT_SWITCH] != 0u));
+    }
+    d_per = (k != 0u) ? (CPU_FP32)p_sum->draws / (CPU_FP32)k : 0.0f; /* 전략마다의 추첨 수 */
+
+    if (what < APP_STATS_STRAT_NBR) {
+        if (p_est->n[what] < 2u) {
+            return DEF_FAIL;
+        }
+        n = (CPU_FP32)p_est->n[what];
+        p_sum->mean = (CPU_FP32)p_est->s1[what] / (n * m);
+        p_sum->var = p_est->m2[what] / (n - 1.0f) / (n * m * m);
+        ref = p_sum->mean * (1.0f - p_sum->mean) / d_per;
+    } else {
+        if ((AppBatch_EstSummarize(p_est, APP_STATS_STRAT_STAY, &st) != DEF_OK) ||
+            (AppBatch_EstSummarize(p_est, APP_STATS_STRAT_SWITCH, &sw) != DEF_OK)) {
+            return DEF_FAIL;
+        }
+        if (paired == DEF_YES) {
+            n = (CPU_FP32)p_est->n[0];
+            p_sum->mean = (CPU_FP32)p_est->d1 / (n * m);
+            p_sum->var = p_est->dm2 / (n - 1.0f) / (n * m * m);
+        } else {
+            p_sum->mean = sw.mean - st.mean;
+            p_sum->var = sw.var + st.var;
+        }
+        ref = (st.mean * (1.0f - st.mean) + sw.mean * (1.0f - sw.mean)) / d_per;
+    }
+
+    p_sum->half = z * sqrtf(p_sum->var);
+    p_sum->vrf = (p_sum->var > 0.0f) ? ref / p_sum->var : 0.0f;
+    return DEF_OK;
+}
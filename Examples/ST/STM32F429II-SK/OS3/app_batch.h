@@ -0,0 +1,137 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_batch.h
+* Description   : Background batch simulation of Monty Hall rounds.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_BATCH_MODULE_PRESENT
+#define  APP_BATCH_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_BATCH_STRAT_STAY            APP_STATS_STRAT_STAY
+#define  APP_BATCH_STRAT_SWITCH          APP_STATS_STRAT_SWITCH
+#define  APP_BATCH_STRAT_MIX                               2u   /* Stay or switch at random, 50/50 per round.           */
+
+#define  APP_BATCH_DOORS_MIN                               3u
+#define  APP_BATCH_DOORS_MAX             APP_CFG_STATS_PICK_MAX
+
+#define  APP_BATCH_SAMPLE_INDEP                            0u   /* One strategy per draw, APP_BATCH_STRAT_xxx.          */
+#define  APP_BATCH_SAMPLE_CRN                              1u   /* Both strategies on common draws.                     */
+#define  APP_BATCH_SAMPLE_ANTI                             2u   /* CRN, picks in antithetic pairs.                      */
+#define  APP_BATCH_SAMPLE_STRAT                            3u   /* CRN, picks stratified on their offset to the prize.  */
+
+#define  APP_BATCH_EST_DIFF              APP_STATS_STRAT_NBR    /* Estimate of P(switch wins) - P(stay wins).           */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {                                                /* xoshiro128** generator state.                        */
+    CPU_INT32U s[4];
+} APP_BATCH_RNG;
+
+typedef struct {
+    CPU_BOOLEAN running;
+    CPU_INT08U  strat;   /* APP_BATCH_STRAT_xxx                   */
+    CPU_INT08U  doors;   /* APP_BATCH_DOORS_MIN .. _MAX           */
+    CPU_INT32U  seed;    /* 마지막 배치의 시드                     */
+    CPU_INT64U  target;  /* 목표 라운드 수, 0 = 멈출 때까지        */
+    CPU_INT64U  done;    /* 마지막 배치에서 끝난 라운드 수          */
+    CPU_INT64U  cycles;  /* 마지막 배치의 커널 실행 시간 (CPU_TS)   */
+    CPU_INT32U  tol;     /* 허용오차 (ppm), 0 = 목표 라운드까지     */
+    CPU_BOOLEAN converged; /* 마지막 배치가 허용오차나 정밀도로 멈춤 */
+    CPU_INT08U  sample;  /* APP_BATCH_SAMPLE_xxx                  */
+    CPU_INT32U  prec;    /* 목표 정밀도 (ppm), 0 = 없음           */
+} APP_BATCH_STATUS;
+
+typedef struct {                                                /* Block sums of one chunk ('app_batch.c' Note #5).     */
+    CPU_INT32U  n[APP_STATS_STRAT_NBR];     /* 전략별 블록 수                    */
+    CPU_INT32U  s1[APP_STATS_STRAT_NBR];    /* 블록당 승 수의 합                 */
+    CPU_INT32U  s2[APP_STATS_STRAT_NBR];    /* 그 제곱의 합                      */
+    CPU_INT32S  d1;                         /* 블록당 (switch 승 - stay 승) 의 합 */
+    CPU_INT32U  d2;
+} APP_BATCH_EST_ACC;
+
+typedef struct {
+    CPU_INT08U  sample;                     /* APP_BATCH_SAMPLE_xxx               */
+    CPU_INT08U  m;                          /* 블록당 추첨 수                     */
+    CPU_INT64U  n[APP_STATS_STRAT_NBR];     /* 전략별 블록 수                     */
+    CPU_INT64U  s1[APP_STATS_STRAT_NBR];    /* 블록당 승 수의 합                  */
+    CPU_FP32    m2[APP_STATS_STRAT_NBR];    /* 블록당 승 수의 편차 제곱합 (Chan)   */
+    CPU_INT64S  d1;                         /* 짝지은 차의 합, CRN 계열만          */
+    CPU_FP32    dm2;
+} APP_BATCH_EST;
+
+typedef struct {
+    CPU_FP32    mean;   /* 라운드당 추정치                                   */
+    CPU_FP32    var;    /* 추정치의 분산                                     */
+    CPU_FP32    half;   /* 신뢰구간 반폭, z * sqrt(var)                      */
+    CPU_FP32    vrf;    /* 분산 감소비 (Note #5), var = 0 이면 의미 없음      */
+    CPU_INT64U  draws;  /* 상품/선택 추첨 수                                 */
+} APP_BATCH_EST_SUMMARY;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppBatch_Init     (void);
+
+CPU_BOOLEAN  AppBatch_Start    (CPU_INT64U         target,
+                                CPU_INT32U         seed);
+
+void         AppBatch_Stop     (void);
+
+CPU_BOOLEAN  AppBatch_StratSet (CPU_INT08U         strat);
+
+CPU_BOOLEAN  AppBatch_DoorsSet (CPU_INT08U         doors);
+
+void         AppBatch_TolSet   (CPU_INT32U         tol);
+
+CPU_BOOLEAN  AppBatch_SampleSet(CPU_INT08U         sample);
+
+void         AppBatch_PrecSet  (CPU_INT32U         prec);
+
+void         AppBatch_StatusGet(APP_BATCH_STATUS  *p_status);
+
+void         AppBatch_RngSeed  (APP_BATCH_RNG     *p_rng,
+                                CPU_INT32U         seed);
+
+void         AppBatch_Run      (APP_STATS         *p_stats,
+                                APP_BATCH_RNG     *p_rng,
+                                CPU_INT08U         strat,
+                                CPU_INT08U         doors,
+                                CPU_INT32U         rounds);
+
+void         AppBatch_RunVr    (APP_STATS         *p_stats,
+                                APP_BATCH_EST_ACC *p_acc,
+                                APP_BATCH_RNG     *p_rng,
+                                CPU_INT08U         sample,
+                                CPU_INT08U         doors,
+                                CPU_INT32U         blocks);
+
+void         AppBatch_EstGet   (APP_BATCH_EST     *p_est);
+
+CPU_BOOLEAN  AppBatch_EstSummarize(const APP_BATCH_EST    *p_est,
+                                   CPU_INT08U              what,
+                                   APP_BATCH_EST_SUMMARY  *p_sum);
+
+
+#endif
@@ -0,0 +1,873 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_bench.c
+* Description   : Thread-Metric style uC/OS-III kernel microbenchmarks.
+*
+* Note(s)       : (1) Every benchmark is timed with OS_TS_GET() (the DWT cycle counter on this target) and
+*                     reported as one CSV record on COM1 :
+*
+*                         BENCH,<name>,<samples>,<min>,<avg>,<max>
+*
+*                     Times are CPU_TS counts with the timestamp read overhead already removed.  The
+*                     'BENCH_BEGIN' record carries the timestamp frequency and the kernel configuration,
+*                     so the output of two builds can be compared with a plain diff or scaled on the host.
+*
+*                 (2) Only kernel services and CPU_TS are used, except for Bench_IntTrig() which pends a
+*                     spare NVIC interrupt and is the single target specific piece.
+*
+*                 (3) ctx_sw_preempt is repeated with the FPU in use by the waking task, by the woken task
+*                     and by both (ctx_sw_fp_lo, ctx_sw_fp_hi, ctx_sw_fp_both).  The FP tasks are created with
+*                     OS_OPT_TASK_SAVE_FP.  The default port then moves S0-S31 and FPSCR in OSTaskSwHook();
+*                     built with OS_CPU_CFG_FP_LAZY_EN (see 'os_cpu.h') it moves S16-S31 in PendSV and lets
+*                     the hardware stack S0-S15 lazily.  'BENCH_BEGIN' reports which one as fp=eager|lazy.
+*
+*                 (4) The zero latency probe ('app_zlat.c') runs during the whole suite; zl_int_latency is
+*                     its entry latency in CPU clocks, printed next to int_dis_max.  Built without
+*                     CPU_CFG_KA_IPL_BOUNDARY (PRIMASK critical sections) the two track each other; with it,
+*                     zl_int_latency no longer depends on the kernel's critical sections.  The probe adds
+*                     one short interrupt every APP_CFG_BENCH_ZLAT_PERIOD_US to the other benchmarks.
+*
+*                 (5) os_sched is OSSched() with no better task ready, os_time_tick is OSTimeTick() called
+*                     from the control task, through the tick task's list update and back.  'BENCH_BEGIN'
+*                     reports where the kernel data (kdata) and the scheduler code (kcode) were linked :
+*                     ccm, sram or flash (see 'bsp.h  MACRO'S  Note #1).  Together with sem_pingpong and
+*                     ctx_sw_preempt these compare a CCM/SRAM build with a flash/SRAM one.  os_time_tick
+*                     runs with the tick counter, both tick lists and the timer update counter set aside
+*                     and puts them back afterwards, so the fake ticks move neither OSTimeGet() nor any
+*                     delay, timeout or timer.  The kernel time stands still for the loop (real ticks in
+*                     it are dropped) and the tick task walks empty lists.  Nothing else can pend with a
+*                     timeout meanwhile: the control task only lets the tick task run.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_bench.h"
+#include "app_zlat.h"
+
+#if (APP_CFG_BENCH_EN == DEF_ENABLED)
+
+#define BENCH_PRIO_HI   (APP_CFG_TASK_BENCH_PRIO)
+#define BENCH_PRIO_LO   (APP_CFG_TASK_BENCH_PRIO + 1u)
+#define BENCH_FLAG_BIT  ((OS_FLAGS)DEF_BIT_00)
+#define BENCH_FLAG_BIT_MISS ((OS_FLAGS)DEF_BIT_01) /* 대기 태스크가 없는 비트 */
+#define BENCH_FLAG_GRP_QTY  4u
+#define BENCH_WAITERS   ((APP_CFG_BENCH_MUTEX_NEST > BENCH_FLAG_GRP_QTY) ? APP_CFG_BENCH_MUTEX_NEST : BENCH_FLAG_GRP_QTY)
+#define BENCH_TASK_MAX  (BENCH_WAITERS + 1u) /* 플래그 방송 대기 태스크는 별도 풀 */
+#define BENCH_FP_LO     DEF_BIT_00 /* 깨우는 (하위) 태스크가 FPU 사용 */
+#define BENCH_FP_HI     DEF_BIT_01 /* 깨어나는 (상위) 태스크가 FPU 사용 */
+#ifdef OS_CPU_CFG_FP_LAZY_EN
+#define BENCH_FP        "lazy"     /* 포트의 FP 문맥 저장 방식 (Note #3) */
+#else
+#define BENCH_FP        "eager"
+#endif
+#ifdef CPU_CFG_KA_IPL_BOUNDARY
+#define BENCH_CRIT      "basepri"  /* 커널 임계 구역이 가리는 인터럽트 (Note #4) */
+#else
+#define BENCH_CRIT      "primask"
+#endif
+
+typedef struct {
+    CPU_TS     min;
+    CPU_TS     max;
+    CPU_INT64U sum;
+    CPU_INT32U n;
+} BENCH_RESULT;
+
+BSP_CCM_DATA static OS_TCB BenchTCB[BENCH_TASK_MAX];
+BSP_CCM_DATA static CPU_STK BenchStk[BENCH_TASK_MAX][APP_CFG_TASK_BENCH_STK_SIZE];
+static CPU_INT08U BenchTaskQty;
+
+BSP_CCM_DATA static OS_TCB BenchFlagTCB[APP_CFG_BENCH_FLAG_WAITERS]; /* 방송 대기 태스크 (app_cfg.h Note #3) */
+static CPU_STK BenchFlagStk[APP_CFG_BENCH_FLAG_WAITERS][APP_CFG_TASK_BENCH_FLAG_STK_SIZE]; /* SRAM */
+
+BSP_CCM_DATA static OS_TCB BenchCtrlTCB; /* 벤치마크를 돌리는 태스크              */
+BSP_CCM_DATA static CPU_STK BenchCtrlStk[APP_CFG_TASK_BENCH_CTRL_STK_SIZE];
+static OS_TCB *BenchCtrlTCBPtr;   /* 보조 태스크가 결과를 알리는 태스크     */
+static OS_TCB *BenchCallerTCBPtr; /* AppBench_Run() 을 부른 태스크         */
+
+static OS_SEM BenchSem1;
+static OS_SEM BenchSem2;
+static OS_MUTEX BenchMutex;
+static OS_MUTEX BenchMutexTbl[APP_CFG_BENCH_MUTEX_NEST];
+static OS_FLAG_GRP BenchFlagGrp;
+static OS_FLAG_GRP BenchFlagGrpTbl[BENCH_FLAG_GRP_QTY];
+static OS_Q BenchQ;
+static OS_MEM BenchMem;
+static CPU_INT32U BenchMemStorage[8][4];
+static OS_TMR BenchTmr;
+
+static volatile CPU_TS BenchT0;   /* 측정 시작 시각 (태스크 간 공유) */
+static volatile CPU_TS BenchTIsr; /* ISR / 타이머 콜백 진입 시각      */
+static volatile CPU_INT32U BenchCtr;
+static CPU_TS BenchOvhd; /* OS_TS_GET() 두 번 읽는 비용 */
+static CPU_INT08U BenchFpUse;     /* BENCH_FP_xx: FPU 를 쓰는 쪽 (Note #3) */
+static volatile CPU_FP32 BenchFpAcc; /* FP 연산 대상: 태스크의 FP 문맥을 켬  */
+
+static BENCH_RESULT BenchRes;
+static BENCH_RESULT BenchRes2;
+
+/*-------------------------------------------------------------*/
+/*  결과 누적 / 출력                                            */
+/*-------------------------------------------------------------*/
+static void Bench_ResultClr(BENCH_RESULT *p_res) {
+    p_res->min = DEF_INT_32U_MAX_VAL;
+    p_res->max = 0u;
+    p_res->sum = 0u;
+    p_res->n = 0u;
+}
+
+static void Bench_ResultAdd(BENCH_RESULT *p_res, CPU_TS t0, CPU_TS t1) {
+    CPU_TS dt = t1 - t0;
+
+    dt = (dt > BenchOvhd) ? (dt - BenchOvhd) : 0u;
+    if (dt < p_res->min) p_res->min = dt;
+    if (dt > p_res->max) p_res->max = dt;
+    p_res->sum += dt;
+    p_res->n++;
+}
+
+static void Bench_Report(const char *name, const BENCH_RESULT *p_res) {
+    char line[96];
+    CPU_TS avg = (p_res->n != 0u) ? (CPU_TS)(p_res->sum / p_res->n) : 0u;
+    CPU_TS min = (p_res->n != 0u) ? p_res->min : 0u;
+
+    snprintf(line, sizeof line, "BENCH,%s,%u,%u,%u,%u\r\n",
+             name, (unsigned)p_res->n, (unsigned)min, (unsigned)avg, (unsigned)p_res->max);
+    send_string(line);
+}
+
+static void Bench_OvhdCalc(void) {
+    CPU_TS t0, t1;
+
+    BenchOvhd = DEF_INT_32U_MAX_VAL;
+    for (CPU_INT08U i = 0u; i < 32u; i++) {
+        t0 = OS_TS_GET();
+        t1 = OS_TS_GET();
+        if ((t1 - t0) < BenchOvhd) BenchOvhd = t1 - t0;
+    }
+}
+
+/*-------------------------------------------------------------*/
+/*  보조 태스크 관리                                             */
+/*-------------------------------------------------------------*/
+static OS_TCB *Bench_TaskCreateOpt(OS_TASK_PTR p_task, void *p_arg, OS_PRIO prio, OS_OPT opt) {
+    OS_ERR err;
+    OS_TCB *p_tcb = &BenchTCB[BenchTaskQty];
+
+    OSTaskCreate(p_tcb, "Bench", p_task, p_arg, prio,
+                 &BenchStk[BenchTaskQty][0],
+                 APP_CFG_TASK_BENCH_STK_SIZE / 10u,
+                 APP_CFG_TASK_BENCH_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | opt, &err);
+    BenchTaskQty++;
+    return p_tcb;
+}
+
+static OS_TCB *Bench_TaskCreate(OS_TASK_PTR p_task, void *p_arg, OS_PRIO prio) {
+    return Bench_TaskCreateOpt(p_task, p_arg, prio, (OS_OPT)0);
+}
+
+static void Bench_TaskDelAll(void) {
+    OS_ERR err;
+
+    while (BenchTaskQty > 0u) {
+        BenchTaskQty--;
+        OSTaskDel(&BenchTCB[BenchTaskQty], &err);
+    }
+}
+
+static void Bench_WaitDone(void) {
+    OS_ERR err;
+    OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+}
+
+static void Bench_Done(void) {
+    OS_ERR err;
+    OSTaskSemPost(BenchCtrlTCBPtr, OS_OPT_POST_NONE, &err);
+}
+
+static void Bench_Park(void) { /* 삭제될 때까지 대기 */
+    OS_ERR err;
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+    }
+}
+
+/*-------------------------------------------------------------*/
+/*  ① 선점형 문맥 전환: 하위 태스크가 상위 태스크를 깨움         */
+/*-------------------------------------------------------------*/
+static void Bench_TaskWakeHi(void *p_arg) {
+    OS_ERR err;
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+        if (DEF_BIT_IS_SET(BenchFpUse, BENCH_FP_HI)) {
+            BenchFpAcc += 1.0f; /* 측정 구간 밖에서 FP 문맥을 만듦 */
+        }
+    }
+}
+
+static void Bench_TaskPreemptLo(void *p_arg) {
+    OS_ERR err;
+    OS_TCB *p_hi = (OS_TCB *)p_arg;
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        if (DEF_BIT_IS_SET(BenchFpUse, BENCH_FP_LO)) {
+            BenchFpAcc += 1.0f;
+        }
+        BenchT0 = OS_TS_GET();
+        OSTaskSemPost(p_hi, OS_OPT_POST_NONE, &err);
+    }
+    Bench_Done();
+    Bench_Park();
+}
+
+static void Bench_CtxSwPreempt(const char *name, CPU_INT08U fp_use) {
+    OS_TCB *p_hi;
+
+    Bench_ResultClr(&BenchRes);
+    BenchFpUse = fp_use;
+    p_hi = Bench_TaskCreateOpt(Bench_TaskWakeHi, 0, BENCH_PRIO_HI,
+                               DEF_BIT_IS_SET(fp_use, BENCH_FP_HI) ? OS_OPT_TASK_SAVE_FP : (OS_OPT)0);
+    Bench_TaskCreateOpt(Bench_TaskPreemptLo, p_hi, BENCH_PRIO_LO,
+                        DEF_BIT_IS_SET(fp_use, BENCH_FP_LO) ? OS_OPT_TASK_SAVE_FP : (OS_OPT)0);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+    BenchFpUse = 0u;
+    Bench_Report(name, &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ② 협력형 문맥 전환: 같은 우선순위 두 태스크가 번갈아 양보    */
+/*-------------------------------------------------------------*/
+static void Bench_TaskCoop(void *p_arg) {
+    OS_ERR err;
+    OS_TCB *p_peer = (OS_TCB *)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+        if (++BenchCtr == APP_CFG_BENCH_ITER) {
+            Bench_Done();
+        }
+        BenchT0 = OS_TS_GET();
+        OSTaskSemPost(p_peer, OS_OPT_POST_NONE, &err); /* 같은 우선순위 → 준비 상태만 */
+    }
+}
+
+static void Bench_CtxSwCoop(void) {
+    OS_ERR err;
+
+    Bench_ResultClr(&BenchRes);
+    BenchCtr = 0u;
+    Bench_TaskCreate(Bench_TaskCoop, &BenchTCB[1], BENCH_PRIO_LO);
+    Bench_TaskCreate(Bench_TaskCoop, &BenchTCB[0], BENCH_PRIO_LO);
+    OSTimeDly(1u, OS_OPT_TIME_DLY, &err); /* 두 태스크 모두 Pend 상태로 */
+
+    BenchT0 = OS_TS_GET();
+    OSTaskSemPost(&BenchTCB[0], OS_OPT_POST_NONE, &err);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+    Bench_Report("ctx_sw_coop", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ③ 세마포어 핑퐁 (왕복 시간)                                 */
+/*-------------------------------------------------------------*/
+static void Bench_TaskPong(void *p_arg) {
+    OS_ERR err;
+    (void)p_arg;
+
+    for (;;) {
+        OSSemPend(&BenchSem1, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        OSSemPost(&BenchSem2, OS_OPT_POST_1, &err);
+    }
+}
+
+static void Bench_TaskPing(void *p_arg) {
+    OS_ERR err;
+    CPU_TS t0;
+    (void)p_arg;
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        t0 = OS_TS_GET();
+        OSSemPost(&BenchSem1, OS_OPT_POST_1, &err);
+        OSSemPend(&BenchSem2, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+    }
+    Bench_Done();
+    Bench_Park();
+}
+
+static void Bench_SemPingPong(void) {
+    Bench_ResultClr(&BenchRes);
+    Bench_TaskCreate(Bench_TaskPong, 0, BENCH_PRIO_HI);
+    Bench_TaskCreate(Bench_TaskPing, 0, BENCH_PRIO_LO);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+    Bench_Report("sem_pingpong", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ④ 메시지 큐 Post + Pend (문맥 전환 없음)                   */
+/*-------------------------------------------------------------*/
+static void Bench_QMsg(void) {
+    OS_ERR err;
+    OS_MSG_SIZE size;
+    CPU_TS t0;
+
+    Bench_ResultClr(&BenchRes);
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        t0 = OS_TS_GET();
+        OSQPost(&BenchQ, (void *)&BenchQ, sizeof(BenchQ), OS_OPT_POST_FIFO, &err);
+        (void)OSQPend(&BenchQ, 0u, OS_OPT_PEND_NON_BLOCKING, &size, (CPU_TS *)0, &err);
+        Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+    }
+    Bench_Report("q_post_pend", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑤ 우선순위 상속이 일어나는 뮤텍스 인계                      */
+/*-------------------------------------------------------------*/
+static void Bench_TaskMutexHi(void *p_arg) {
+    OS_ERR err;
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        OSMutexPend(&BenchMutex, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err); /* 소유자 우선순위 상승 */
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+    }
+}
+
+static void Bench_TaskMutexLo(void *p_arg) {
+    OS_ERR err;
+    OS_TCB *p_hi = (OS_TCB *)p_arg;
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        OSMutexPend(&BenchMutex, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        OSTaskSemPost(p_hi, OS_OPT_POST_NONE, &err); /* 상위 태스크가 뮤텍스에서 블록됨 */
+        BenchT0 = OS_TS_GET();
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+    }
+    Bench_Done();
+    Bench_Park();
+}
+
+static void Bench_MutexPI(void) {
+    OS_TCB *p_hi;
+
+    Bench_ResultClr(&BenchRes);
+    p_hi = Bench_TaskCreate(Bench_TaskMutexHi, 0, BENCH_PRIO_HI);
+    Bench_TaskCreate(Bench_TaskMutexLo, p_hi, BENCH_PRIO_LO);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+    Bench_Report("mutex_pi_handoff", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑤-1 중첩 뮤텍스 해제: 대기자가 있는 뮤텍스 N개를 쥔 상태   */
+/*-------------------------------------------------------------*/
+static void Bench_TaskNestWaiter(void *p_arg) {
+    OS_ERR err;
+    OS_MUTEX *p_mutex = (OS_MUTEX *)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        OSMutexPend(p_mutex, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        OSMutexPost(p_mutex, OS_OPT_POST_NONE, &err);
+    }
+}
+
+static void Bench_TaskNestOwner(void *p_arg) {
+    OS_ERR err;
+    CPU_TS t0;
+    CPU_INT08U k;
+    (void)p_arg;
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER / APP_CFG_BENCH_MUTEX_NEST; i++) {
+        for (k = 0u; k < APP_CFG_BENCH_MUTEX_NEST; k++) {
+            OSMutexPend(&BenchMutexTbl[k], 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+            OSTaskSemPost(&BenchTCB[k], OS_OPT_POST_NO_SCHED, &err);
+        }
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err); /* 대기자 전원이 각자의 뮤텍스에서 블록 */
+
+        while (k > 0u) { /* 나중에 잡은 것부터 해제 */
+            k--;
+            t0 = OS_TS_GET();
+            OSMutexPost(&BenchMutexTbl[k], OS_OPT_POST_NO_SCHED, &err); /* 상속 우선순위 재계산 포함 */
+            Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+        }
+        OSSched();
+    }
+    Bench_Done();
+    Bench_Park();
+}
+
+static void Bench_MutexNested(void) {
+    Bench_ResultClr(&BenchRes);
+    for (CPU_INT08U k = 0u; k < APP_CFG_BENCH_MUTEX_NEST; k++) {
+        Bench_TaskCreate(Bench_TaskNestWaiter, &BenchMutexTbl[k], BENCH_PRIO_HI);
+    }
+    Bench_TaskCreate(Bench_TaskNestOwner, 0, BENCH_PRIO_LO);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+    Bench_Report("mutex_nest_post", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑥ 이벤트 플래그 브로드캐스트                                */
+/*-------------------------------------------------------------*/
+static void Bench_TaskFlagWaiter(void *p_arg) {
+    OS_ERR err;
+    CPU_INT32U waiters = (CPU_INT32U)(CPU_ADDR)p_arg;
+
+    for (;;) {
+        OSFlagPend(&BenchFlagGrp, BENCH_FLAG_BIT, 0u,
+                   OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        if (++BenchCtr == waiters) { /* 마지막으로 깨어난 태스크 */
+            Bench_ResultAdd(&BenchRes2, BenchT0, OS_TS_GET());
+            Bench_Done();
+        }
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err); /* 다음 라운드까지 대기 */
+    }
+}
+
+static void Bench_FlagWaitPending(CPU_INT32U waiters) {
+    OS_ERR err;
+
+    while (BenchFlagGrp.PendList.NbrEntries < waiters) {
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+}
+
+static void Bench_FlagBcastN(CPU_INT32U waiters) {
+    OS_ERR err;
+    BENCH_RESULT miss;
+    char name[24];
+
+    Bench_ResultClr(&BenchRes);
+    Bench_ResultClr(&BenchRes2);
+    Bench_ResultClr(&miss);
+    for (CPU_INT32U k = 0u; k < waiters; k++) {
+        OSTaskCreate(&BenchFlagTCB[k], "Bench Flag", Bench_TaskFlagWaiter, (void *)(CPU_ADDR)waiters, BENCH_PRIO_LO,
+                     &BenchFlagStk[k][0],
+                     APP_CFG_TASK_BENCH_FLAG_STK_SIZE / 10u,
+                     APP_CFG_TASK_BENCH_FLAG_STK_SIZE,
+                     0u, 0u, 0u,
+                     OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+    }
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        Bench_FlagWaitPending(waiters);
+
+        /* 아무도 기다리지 않는 비트: 대기 태스크 수와 무관해야 함 */
+        BenchT0 = OS_TS_GET();
+        OSFlagPost(&BenchFlagGrp, BENCH_FLAG_BIT_MISS, OS_OPT_POST_FLAG_SET, &err);
+        Bench_ResultAdd(&miss, BenchT0, OS_TS_GET());
+        OSFlagPost(&BenchFlagGrp, BENCH_FLAG_BIT_MISS, OS_OPT_POST_FLAG_CLR, &err);
+
+        BenchCtr = 0u;
+        BenchT0 = OS_TS_GET();
+        OSFlagPost(&BenchFlagGrp, BENCH_FLAG_BIT, OS_OPT_POST_FLAG_SET, &err);
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET()); /* Post 자체 비용 */
+        Bench_WaitDone();
+
+        OSFlagPost(&BenchFlagGrp, BENCH_FLAG_BIT, OS_OPT_POST_FLAG_CLR, &err);
+        for (CPU_INT32U k = 0u; k < waiters; k++) {
+            OSTaskSemPost(&BenchFlagTCB[k], OS_OPT_POST_NO_SCHED, &err);
+        }
+    }
+    for (CPU_INT32U k = 0u; k < waiters; k++) {
+        OSTaskDel(&BenchFlagTCB[k], &err);
+    }
+    snprintf(name, sizeof name, "flag_post_miss_%u", (unsigned)waiters);
+    Bench_Report(name, &miss);
+    snprintf(name, sizeof name, "flag_post_%u", (unsigned)waiters);
+    Bench_Report(name, &BenchRes);
+    snprintf(name, sizeof name, "flag_bcast_last_%u", (unsigned)waiters);
+    Bench_Report(name, &BenchRes2);
+}
+
+/* 여러 그룹에 대한 Post: OSFlagPost() 반복과 OSFlagPostMulti() 비교 */
+static void Bench_TaskFlagGrpWaiter(void *p_arg) {
+    OS_ERR err;
+    OS_FLAG_GRP *p_grp = (OS_FLAG_GRP *)p_arg;
+
+    for (;;) {
+        OSFlagPend(p_grp, BENCH_FLAG_BIT, 0u,
+                   OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_FLAG_CONSUME | OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        if (++BenchCtr == BENCH_FLAG_GRP_QTY) {
+            Bench_Done();
+        }
+    }
+}
+
+static void Bench_FlagPostMulti(void) {
+    OS_ERR err;
+    OS_FLAG_POST_DATA post_tbl[BENCH_FLAG_GRP_QTY];
+    BENCH_RESULT loop;
+    CPU_INT08U g;
+
+    Bench_ResultClr(&loop);
+    Bench_ResultClr(&BenchRes);
+    for (g = 0u; g < BENCH_FLAG_GRP_QTY; g++) {
+        OSFlagCreate(&BenchFlagGrpTbl[g], "Bench Flags Multi", (OS_FLAGS)0, &err);
+        Bench_TaskCreate(Bench_TaskFlagGrpWaiter, &BenchFlagGrpTbl[g], BENCH_PRIO_LO);
+        post_tbl[g].GrpPtr = &BenchFlagGrpTbl[g];
+        post_tbl[g].Flags  = BENCH_FLAG_BIT;
+        post_tbl[g].Opt    = OS_OPT_POST_FLAG_SET;
+    }
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        for (g = 0u; g < BENCH_FLAG_GRP_QTY; g++) {
+            while (BenchFlagGrpTbl[g].PendList.NbrEntries == 0u) {
+                OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+            }
+        }
+        BenchCtr = 0u;
+        BenchT0 = OS_TS_GET();
+        if ((i & 1u) == 0u) {
+            OSFlagPostMulti(&post_tbl[0], BENCH_FLAG_GRP_QTY, OS_OPT_POST_NONE, &err);
+            Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+        } else {
+            for (g = 0u; g < BENCH_FLAG_GRP_QTY; g++) {
+                OSFlagPost(post_tbl[g].GrpPtr, post_tbl[g].Flags, post_tbl[g].Opt, &err);
+            }
+            Bench_ResultAdd(&loop, BenchT0, OS_TS_GET());
+        }
+        Bench_WaitDone();
+    }
+    Bench_TaskDelAll();
+    for (g = 0u; g < BENCH_FLAG_GRP_QTY; g++) {
+        OSFlagDel(&BenchFlagGrpTbl[g], OS_OPT_DEL_ALWAYS, &err);
+    }
+    Bench_Report("flag_post_loop", &loop);
+    Bench_Report("flag_post_multi", &BenchRes);
+}
+
+static void Bench_FlagBcast(void) {
+    static const CPU_INT32U waiters_tbl[] = {8u, 32u, 64u};
+
+    for (CPU_INT08U i = 0u; i < sizeof(waiters_tbl) / sizeof(waiters_tbl[0]); i++) {
+        if (waiters_tbl[i] <= APP_CFG_BENCH_FLAG_WAITERS) {
+            Bench_FlagBcastN(waiters_tbl[i]);
+        }
+    }
+    Bench_FlagPostMulti();
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑦ 메모리 파티션 Get + Put                                   */
+/*-------------------------------------------------------------*/
+static void Bench_MemGetPut(void) {
+    OS_ERR err;
+    void *p_blk;
+    CPU_TS t0;
+
+    Bench_ResultClr(&BenchRes);
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        t0 = OS_TS_GET();
+        p_blk = OSMemGet(&BenchMem, &err);
+        OSMemPut(&BenchMem, p_blk, &err);
+        Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+    }
+    Bench_Report("mem_get_put", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑧ 타이머 만료: 주기 간격과 콜백 → 태스크 지연                */
+/*-------------------------------------------------------------*/
+static void Bench_TmrCallback(void *p_tmr, void *p_arg) {
+    OS_ERR err;
+    CPU_TS ts = OS_TS_GET();
+    (void)p_tmr;
+    (void)p_arg;
+
+    if (BenchCtr > 0u) {
+        Bench_ResultAdd(&BenchRes2, BenchTIsr, ts); /* 만료 간격 */
+    }
+    BenchTIsr = ts;
+    BenchCtr++;
+    BenchT0 = OS_TS_GET();
+    OSTaskSemPost(BenchCtrlTCBPtr, OS_OPT_POST_NONE, &err);
+}
+
+static void Bench_TmrExpiry(void) {
+    OS_ERR err;
+
+    Bench_ResultClr(&BenchRes);
+    Bench_ResultClr(&BenchRes2);
+    BenchCtr = 0u;
+    OSTmrCreate(&BenchTmr, "Bench Tmr", 1u, 1u, OS_OPT_TMR_PERIODIC,
+                Bench_TmrCallback, 0, &err);
+    OSTmrStart(&BenchTmr, &err);
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_TMR_ITER; i++) {
+        Bench_WaitDone();
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+    }
+    OSTmrDel(&BenchTmr, &err);
+    Bench_Report("tmr_period", &BenchRes2);
+    Bench_Report("tmr_cb_to_task", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑨ 인터럽트 → 태스크 지연 (소프트웨어로 IRQ 펜딩)            */
+/*-------------------------------------------------------------*/
+static void Bench_IntTrig(void) {
+    CPU_REG_NVIC_SETPEND(APP_CFG_BENCH_INT_ID / 32u) = DEF_BIT(APP_CFG_BENCH_INT_ID % 32u);
+    CPU_MB();
+}
+
+static void Bench_ISR(void) {
+    OS_ERR err;
+
+    BenchTIsr = OS_TS_GET();
+    OSTaskSemPost(&BenchTCB[0], OS_OPT_POST_NONE, &err);
+}
+
+static void Bench_TaskIntHi(void *p_arg) {
+    OS_ERR err;
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        Bench_ResultAdd(&BenchRes, BenchT0, OS_TS_GET());
+        Bench_ResultAdd(&BenchRes2, BenchT0, BenchTIsr);
+    }
+}
+
+static void Bench_TaskIntLo(void *p_arg) {
+    (void)p_arg;
+
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        BenchT0 = OS_TS_GET();
+        Bench_IntTrig();
+    }
+    Bench_Done();
+    Bench_Park();
+}
+
+static void Bench_IntToTask(void) {
+    Bench_ResultClr(&BenchRes);
+    Bench_ResultClr(&BenchRes2);
+    BSP_IntVectSet(APP_CFG_BENCH_INT_ID, Bench_ISR);
+    BSP_IntEn(APP_CFG_BENCH_INT_ID);
+
+    Bench_TaskCreate(Bench_TaskIntHi, 0, BENCH_PRIO_HI);
+    Bench_TaskCreate(Bench_TaskIntLo, 0, BENCH_PRIO_LO);
+    Bench_WaitDone();
+    Bench_TaskDelAll();
+
+    BSP_IntDis(APP_CFG_BENCH_INT_ID);
+    Bench_Report("int_entry", &BenchRes2);
+    Bench_Report("int_to_task", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑩ 스케줄러와 틱 경로 (Note #5)                               */
+/*-------------------------------------------------------------*/
+static const char *Bench_Region(CPU_ADDR addr) {
+    switch (addr >> 28) { /* 메모리 맵의 512 MB 블록 */
+        case 0x0u:
+            return "flash";
+        case 0x1u:
+            return "ccm";
+        case 0x2u:
+            return "sram";
+        default:
+            return "other";
+    }
+}
+
+static void Bench_SchedTick(void) {
+    CPU_TS t0;
+    OS_TICK tick_ctr;
+    OS_TCB *p_dly;
+    OS_TCB *p_timeout;
+#if OS_CFG_TMR_EN > 0u
+    OS_CTR tmr_ctr;
+#endif
+    CPU_SR_ALLOC();
+
+    Bench_ResultClr(&BenchRes);
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        t0 = OS_TS_GET();
+        OSSched(); /* 더 높은 준비 태스크 없음: 판단만 */
+        Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+    }
+    Bench_Report("os_sched", &BenchRes);
+
+    /* 가짜 틱이 커널 시간을 옮기지 않도록 상태를 떼어 두었다가 되돌림 (Note #5) */
+    CPU_CRITICAL_ENTER();
+    tick_ctr = OSTickCtr;
+    p_dly = OSTickListDly.TCB_Ptr;
+    p_timeout = OSTickListTimeout.TCB_Ptr;
+    OSTickListDly.TCB_Ptr = (OS_TCB *)0;
+    OSTickListTimeout.TCB_Ptr = (OS_TCB *)0;
+#if OS_CFG_TMR_EN > 0u
+    tmr_ctr = OSTmrUpdateCtr;
+    OSTmrUpdateCtr = (OS_CTR)DEF_INT_32U_MAX_VAL; /* 타이머 태스크를 깨우지 않음 */
+#endif
+    CPU_CRITICAL_EXIT();
+
+    Bench_ResultClr(&BenchRes);
+    for (CPU_INT32U i = 0u; i < APP_CFG_BENCH_ITER; i++) {
+        t0 = OS_TS_GET();
+        OSTimeTick(); /* 틱 태스크가 목록을 갱신하고 돌아옴 */
+        Bench_ResultAdd(&BenchRes, t0, OS_TS_GET());
+    }
+
+    CPU_CRITICAL_ENTER();
+    OSTickCtr = tick_ctr;
+    OSTickListDly.TCB_Ptr = p_dly;
+    OSTickListTimeout.TCB_Ptr = p_timeout;
+#if OS_CFG_TMR_EN > 0u
+    OSTmrUpdateCtr = tmr_ctr;
+#endif
+    CPU_CRITICAL_EXIT();
+    Bench_Report("os_time_tick", &BenchRes);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑪ 제로 레이턴시 인터럽트 진입 지연 (Note #4)                 */
+/*-------------------------------------------------------------*/
+static void Bench_ZeroLat(void) {
+    APP_ZLAT_STATS st;
+    BENCH_RESULT res;
+
+    AppZLat_Stop(&st);
+    res.n = st.n;
+    res.min = st.min;
+    res.max = st.max;
+    res.sum = st.sum;
+    Bench_Report("zl_int_latency", &res);
+}
+
+/*-------------------------------------------------------------*/
+/*  ⑫ 커널 전역 최대값 (측정 기능이 켜져 있을 때만)              */
+/*-------------------------------------------------------------*/
+static void Bench_KernelMax(void) {
+    BENCH_RESULT res;
+
+#ifdef CPU_CFG_INT_DIS_MEAS_EN
+    Bench_ResultClr(&res);
+    res.min = res.max = CPU_IntDisMeasMaxGet();
+    res.sum = res.max;
+    res.n = 1u;
+    Bench_Report("int_dis_max", &res);
+#endif
+#if OS_CFG_SCHED_LOCK_TIME_MEAS_EN > 0u
+    Bench_ResultClr(&res);
+    res.min = res.max = OSSchedLockTimeMax;
+    res.sum = res.max;
+    res.n = 1u;
+    Bench_Report("sched_lock_max", &res);
+#endif
+    (void)&res;
+}
+
+/*-------------------------------------------------------------*/
+/*  제어 태스크: 스위트 전체를 돌리고 부른 태스크에 알림            */
+/*-------------------------------------------------------------*/
+static void Bench_TaskCtrl(void *p_arg) {
+    OS_ERR err;
+    CPU_ERR cpu_err;
+    char line[160];
+    (void)p_arg;
+
+    BenchCtrlTCBPtr = OSTCBCurPtr;
+    OSSemCreate(&BenchSem1, "Bench Sem1", 0u, &err);
+    OSSemCreate(&BenchSem2, "Bench Sem2", 0u, &err);
+    OSMutexCreate(&BenchMutex, "Bench Mutex", &err);
+    for (CPU_INT08U k = 0u; k < APP_CFG_BENCH_MUTEX_NEST; k++) {
+        OSMutexCreate(&BenchMutexTbl[k], "Bench Mutex Nest", &err);
+    }
+    OSFlagCreate(&BenchFlagGrp, "Bench Flags", (OS_FLAGS)0, &err);
+    OSQCreate(&BenchQ, "Bench Q", 1u, &err);
+    OSMemCreate(&BenchMem, "Bench Mem", &BenchMemStorage[0][0], 8u, sizeof(BenchMemStorage[0]), &err);
+    Bench_OvhdCalc();
+
+    snprintf(line, sizeof line,
+             "BENCH_BEGIN,fmt=1,os=%u,ts_hz=%u,cpu_hz=%u,tick_hz=%u,tmr_hz=%u,ovhd=%u,crit=%s,fp=%s,kdata=%s,kcode=%s\r\n",
+             (unsigned)OS_VERSION,
+             (unsigned)CPU_TS_TmrFreqGet(&cpu_err),
+             (unsigned)BSP_CPU_ClkFreq(),
+             (unsigned)OSCfg_TickRate_Hz,
+             (unsigned)OSCfg_TmrTaskRate_Hz,
+             (unsigned)BenchOvhd,
+             BENCH_CRIT,
+             BENCH_FP,
+             Bench_Region((CPU_ADDR)&OSRdyList[0]),
+             Bench_Region((CPU_ADDR)&OSSched));
+    send_string(line);
+    AppZLat_Start();
+
+    Bench_CtxSwCoop();
+    Bench_CtxSwPreempt("ctx_sw_preempt", 0u);
+    Bench_CtxSwPreempt("ctx_sw_fp_lo", BENCH_FP_LO);
+    Bench_CtxSwPreempt("ctx_sw_fp_hi", BENCH_FP_HI);
+    Bench_CtxSwPreempt("ctx_sw_fp_both", BENCH_FP_LO | BENCH_FP_HI);
+    Bench_SemPingPong();
+    Bench_QMsg();
+    Bench_MutexPI();
+    Bench_MutexNested();
+    Bench_FlagBcast();
+    Bench_MemGetPut();
+    Bench_TmrExpiry();
+    Bench_IntToTask();
+    Bench_SchedTick();
+    Bench_ZeroLat();
+    Bench_KernelMax();
+
+    send_string("BENCH_END\r\n");
+    OSTaskSemPost(BenchCallerTCBPtr, OS_OPT_POST_NONE, &err);
+    Bench_Park();
+}
+
+/*
+*********************************************************************************************************
+*                                           AppBench_Run()
+*
+* Description : Run every kernel benchmark once and print the results on COM1 (see Note #1 at the top).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskStart(), before the game objects and tasks are created.
+*
+* Note(s)     : (1) The suite runs in its own task at APP_CFG_TASK_BENCH_CTRL_PRIO, above the helper tasks
+*                   (which report back through its task semaphore), with a stack sized for snprintf().
+*                   The caller blocks until the suite is done; the control task is then deleted.
+*********************************************************************************************************
+*/
+
+void AppBench_Run(void) {
+    OS_ERR err;
+
+    BenchCallerTCBPtr = OSTCBCurPtr;
+    OSTaskCreate(&BenchCtrlTCB, "Bench Ctrl",
+                 Bench_TaskCtrl, 0u,
+                 APP_CFG_TASK_BENCH_CTRL_PRIO,
+                 &BenchCtrlStk[0],
+                 APP_CFG_TASK_BENCH_CTRL_STK_SIZE / 10u,
+                 APP_CFG_TASK_BENCH_CTRL_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+    OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+    OSTaskDel(&BenchCtrlTCB, &err);
+}
+
+#endif
@@ -0,0 +1,28 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_bench.h
+* Description   : Thread-Metric style uC/OS-III kernel microbenchmarks.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_BENCH_MODULE_PRESENT
+#define  APP_BENCH_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if (APP_CFG_BENCH_EN == DEF_ENABLED)
+void  AppBench_Run (void);
+#endif
+
+
+#endif
@@ -0,0 +1,283 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_bg.c
+* Description   : Idle priority background simulation with its own statistics block.
+*
+* Note(s)       : (1) AppTask_Bg runs at APP_CFG_TASK_BG_PRIO, just above the kernel's idle task, and
+*                     only gets the CPU that every other task leaves.  It simulates 3 door rounds,
+*                     stay or switch at random (AppBatch_Run(), 'app_batch.c'), APP_CFG_BG_CHUNK at a
+*                     time into a private shard, and merges the shard into a statistics block of its own,
+*                     separate from the game statistics.  A console batch (APP_CFG_TASK_BATCH_PRIO) runs
+*                     ahead of it.
+*
+*                 (2) Simulating a chunk locks nothing, so AppTask_INPUT and every other task preempt it
+*                     at once, like they preempt the idle task.  The only stretch that delays them is the
+*                     merge into the statistics block : the writer locks the scheduler so that the game
+*                     task, which reads the block, cannot preempt it half way (see 'lib_seqlock.h'
+*                     Note #3).  Its length does not depend on the chunk; it is measured every chunk and
+*                     merges longer than APP_CFG_BG_LOCK_MAX_US are counted.  The chunk only sets how
+*                     often the block is updated and how soon 'bg off' takes effect.
+*
+*                 (3) The worker counts its rounds in windows of APP_CFG_BG_RATE_WIN_MS.  A window in which
+*                     the game task drew a frame (AppBg_UiActive()) counts as 'ui', any other as 'idle';
+*                     AppBg_Rate() gives the rounds per second of either kind.  Windows are measured
+*                     in OS ticks; time spent off is not counted.
+*
+*                 (4) The worker never requests a frame : its line on the screen is refreshed with the
+*                     next frame drawn for another reason.  While it runs the kernel's CPU usage reads
+*                     close to 100 %; the console command 'load' shows the share of each task.
+*
+*                 (5) With OS_CFG_TICK_VIRT_EN time only moves when every task is blocked, which never
+*                     happens while the worker runs.  It is then not started by AppBg_Init() and, once
+*                     turned on, sleeps a tick after each chunk : virtual time advances one tick per chunk.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_batch.h"
+#include "app_bg.h"
+
+#define BG_SEED 0x4D484247u /* "MHBG" */
+
+BSP_CCM_DATA static OS_TCB BgTCB;
+BSP_CCM_DATA static CPU_STK BgStk[APP_CFG_TASK_BG_STK_SIZE];
+
+static APP_STATS BgShard;   /* 배경 태스크 전용, 청크마다 합친 뒤 비움 */
+static APP_STATS BgStats;   /* 배경 통계, BgLock 으로 발행           */
+static SEQLOCK BgLock;
+static APP_BG_STATUS BgStatus;
+static volatile CPU_BOOLEAN BgUiSeen; /* 이번 측정 창에 프레임이 그려짐 (Note #3) */
+
+/*-------------------------------------------------------------*/
+/*  발행 (Note #2)                                              */
+/*-------------------------------------------------------------*/
+/* 배경 통계에 합치고 스케줄러를 잠근 시간을 돌려줌 */
+static CPU_TS Bg_Publish(void) {
+    OS_ERR err;
+    CPU_TS ts;
+
+    OSSchedLock(&err);
+    ts = OS_TS_GET();
+    SeqLock_WrBegin(&BgLock);
+    AppStats_Merge(&BgStats, &BgShard);
+    SeqLock_WrEnd(&BgLock);
+    ts = OS_TS_GET() - ts;
+    OSSchedUnlock(&err); /* 여기서 밀린 태스크로 넘어감 */
+
+    AppStats_Clr(&BgShard);
+    return ts;
+}
+
+/*-------------------------------------------------------------*/
+/*  배경 태스크                                                  */
+/*-------------------------------------------------------------*/
+static void AppTask_Bg(void *p_arg) {
+    OS_ERR err;
+    CPU_ERR cpu_err;
+    APP_BATCH_RNG rng;
+    OS_TICK winStart, now;
+    CPU_INT32U winRounds;
+    CPU_INT08U cls;
+    CPU_TS ts, lock;
+    const OS_TICK winTicks = (APP_CFG_BG_RATE_WIN_MS * OSCfg_TickRate_Hz + 999u) / 1000u;
+    const CPU_TS lockMax = (CPU_TS)((CPU_INT64U)APP_CFG_BG_LOCK_MAX_US * CPU_TS_TmrFreqGet(&cpu_err) / 1000000u);
+    CPU_SR_ALLOC();
+
+    (void)p_arg;
+
+    AppBatch_RngSeed(&rng, BG_SEED);
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+
+        winStart = OSTimeGet(&err); /* 꺼져 있던 시간은 세지 않음 (Note #3) */
+        winRounds = 0u;
+        BgUiSeen = DEF_NO;
+        while (BgStatus.on == DEF_YES) {
+            ts = OS_TS_GET();
+            AppBatch_Run(&BgShard, &rng, APP_BATCH_STRAT_MIX, APP_BATCH_DOORS_MIN, APP_CFG_BG_CHUNK);
+            ts = OS_TS_GET() - ts; /* 선점되면 길어짐: 최소값만 청크 시간 */
+            lock = Bg_Publish();
+            winRounds += APP_CFG_BG_CHUNK;
+
+            now = OSTimeGet(&err);
+            CPU_CRITICAL_ENTER();
+            BgStatus.rounds += APP_CFG_BG_CHUNK;
+            if ((BgStatus.chunk_min == 0u) || (ts < BgStatus.chunk_min)) {
+                BgStatus.chunk_min = ts;
+            }
+            if (lock > BgStatus.lock_max) {
+                BgStatus.lock_max = lock;
+            }
+            if (lock > lockMax) {
+                BgStatus.lock_over++;
+            }
+            if (now - winStart >= winTicks) {
+                cls = (BgUiSeen == DEF_YES) ? APP_BG_RATE_UI : APP_BG_RATE_IDLE;
+                BgUiSeen = DEF_NO;
+                BgStatus.rate[cls].windows++;
+                BgStatus.rate[cls].rounds += winRounds;
+                BgStatus.rate[cls].ticks += now - winStart;
+                winStart = now;
+                winRounds = 0u;
+            }
+            CPU_CRITICAL_EXIT();
+#if (OS_CFG_TICK_VIRT_EN > 0u)
+            OSTimeDly(1u, OS_OPT_TIME_DLY, &err); /* 가상 시간이 흐르도록 (Note #5) */
+#endif
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                            AppBg_Init()
+*
+* Description : Create the background simulation task.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskCreate().
+*
+* Note(s)     : (1) With APP_CFG_BG_START_ON the worker starts at once; otherwise at the first
+*                   AppBg_Set(DEF_ON).  Never at once with OS_CFG_TICK_VIRT_EN (see Note #5 at the top
+*                   of this file).
+*********************************************************************************************************
+*/
+
+void AppBg_Init(void) {
+    OS_ERR err;
+
+    SeqLock_Init(&BgLock);
+    AppStats_Clr(&BgShard);
+    AppStats_Clr(&BgStats);
+    BgStatus.chunk = APP_CFG_BG_CHUNK;
+    OSTaskCreate(&BgTCB, "AppTask_Bg",
+                 AppTask_Bg, 0u,
+                 APP_CFG_TASK_BG_PRIO,
+                 &BgStk[0],
+                 APP_CFG_TASK_BG_STK_SIZE / 10u,
+                 APP_CFG_TASK_BG_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+#if (APP_CFG_BG_START_ON == DEF_ENABLED) && (OS_CFG_TICK_VIRT_EN == 0u)
+    AppBg_Set(DEF_ON);
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                             AppBg_Set()
+*
+* Description : Start or stop the background simulation.
+*
+* Argument(s) : on          DEF_ON to start, DEF_OFF to stop.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppBg_Init(), Application.
+*
+* Note(s)     : (1) The worker stops after its current chunk, which is still merged.  The statistics and
+*                   the rates are kept; see AppBg_Clr().
+*********************************************************************************************************
+*/
+
+void AppBg_Set(CPU_BOOLEAN on) {
+    OS_ERR err;
+    CPU_BOOLEAN was;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    was = BgStatus.on;
+    BgStatus.on = on;
+    CPU_CRITICAL_EXIT();
+
+    if ((on == DEF_ON) && (was == DEF_OFF)) {
+        OSTaskSemPost(&BgTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                             AppBg_Clr()
+*
+* Description : Clear the background statistics, the rates and the merge times.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Task level only.  The block is cleared under the same scheduler lock as the worker's
+*                   merge (see Note #2 at the top of this file).
+*********************************************************************************************************
+*/
+
+void AppBg_Clr(void) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    OSSchedLock(&err);
+    SeqLock_WrBegin(&BgLock);
+    AppStats_Clr(&BgStats);
+    SeqLock_WrEnd(&BgLock);
+    CPU_CRITICAL_ENTER();
+    BgStatus.rounds = 0u;
+    BgStatus.chunk_min = 0u;
+    BgStatus.lock_max = 0u;
+    BgStatus.lock_over = 0u;
+    Mem_Clr(BgStatus.rate, sizeof BgStatus.rate);
+    CPU_CRITICAL_EXIT();
+    OSSchedUnlock(&err);
+}
+
+/*
+*********************************************************************************************************
+*                                          AppBg_UiActive()
+*
+* Description : Mark the current rate window as one with the user interface active.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_GAME, after each frame.
+*
+* Note(s)     : (1) See Note #3 at the top of this file.
+*********************************************************************************************************
+*/
+
+void AppBg_UiActive(void) {
+    BgUiSeen = DEF_YES;
+}
+
+void AppBg_StatsRead(APP_STATS *p_snap) {
+    (void)SeqLock_Rd(&BgLock, p_snap, &BgStats, sizeof BgStats);
+}
+
+void AppBg_StatusGet(APP_BG_STATUS *p_status) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_status = BgStatus;
+    CPU_CRITICAL_EXIT();
+}
+
+/* 라운드/초, 끝난 창이 없으면 0 (Note #3) */
+CPU_INT32U AppBg_Rate(const APP_BG_STATUS *p_status, CPU_INT08U cls) {
+    const APP_BG_RATE *p_rate = &p_status->rate[cls];
+
+    if (p_rate->ticks == 0u) {
+        return 0u;
+    }
+    return (CPU_INT32U)(p_rate->rounds * OSCfg_TickRate_Hz / p_rate->ticks);
+}
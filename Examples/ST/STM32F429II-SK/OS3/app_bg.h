@@ -0,0 +1,73 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_bg.h
+* Description   : Idle priority background simulation with its own statistics block.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_BG_MODULE_PRESENT
+#define  APP_BG_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_BG_RATE_IDLE                                  0u   /* Rate windows without a frame drawn.                  */
+#define  APP_BG_RATE_UI                                    1u   /* Rate windows with at least one frame drawn.          */
+#define  APP_BG_RATE_NBR                                   2u
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U  windows;     /* 끝난 측정 창                                      */
+    CPU_INT64U  rounds;      /* 그 창들의 라운드                                   */
+    CPU_INT64U  ticks;       /* 그 창들의 길이 (OS tick)                           */
+} APP_BG_RATE;
+
+typedef struct {
+    CPU_BOOLEAN on;
+    CPU_INT32U  chunk;       /* 청크당 라운드                                      */
+    CPU_INT64U  rounds;      /* 배경 통계의 라운드                                 */
+    CPU_TS      chunk_min;   /* 청크 최소 시간 (CPU_TS), 선점되지 않은 청크         */
+    CPU_TS      lock_max;    /* 발행 구간 (스케줄러 잠금) 최대 시간 (CPU_TS)        */
+    CPU_INT32U  lock_over;   /* APP_CFG_BG_LOCK_MAX_US 를 넘은 발행                */
+    APP_BG_RATE rate[APP_BG_RATE_NBR];
+} APP_BG_STATUS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppBg_Init       (void);
+
+void         AppBg_Set        (CPU_BOOLEAN           on);
+
+void         AppBg_Clr        (void);
+
+void         AppBg_UiActive   (void);
+
+void         AppBg_StatsRead  (APP_STATS            *p_snap);
+
+void         AppBg_StatusGet  (APP_BG_STATUS        *p_status);
+
+CPU_INT32U   AppBg_Rate       (const APP_BG_STATUS  *p_status,
+                               CPU_INT08U            cls);
+
+
+#endif
@@ -56,16 +56,40 @@
 
 #define  APP_CFG_TASK_START_PRIO                           2u
 #define  APP_CFG_TASK_EQ_PRIO                              4u
+#define  APP_CFG_TASK_BENCH_CTRL_PRIO                      5u   /* Must be above APP_CFG_TASK_BENCH_PRIO.               */
+#define  APP_CFG_TASK_BENCH_PRIO                           6u   /* Benchmark helpers use this prio and the next one.    */
+#define  APP_CFG_TASK_INIT_PRIO                            7u   /* Below every game task (see 'app_init.c' Note #1).    */
+#define  APP_CFG_TASK_CONSOLE_PRIO                         8u
+#define  APP_CFG_TASK_TELEM_PRIO                           9u
+#define  APP_CFG_TASK_REPLAY_PRIO                         10u   /* Below every game task (see REPLAY Note #2).          */
+#define  APP_CFG_TASK_BATCH_PRIO                          12u   /* Below the kernel's statistics and timer tasks.       */
+#define  APP_CFG_TASK_BG_PRIO            (OS_CFG_PRIO_MAX - 2u) /* Just above the idle task (see 'app_bg.c' Note #1).   */
 
 /*
 *********************************************************************************************************
 *                                            TASK STACK SIZES
+*
+* Note(s) : (1) Sizes are in CPU_STK words.  The game task sizes come from the high-water marks that the
+*               console command 'mem size' reports after a recorded session was replayed (see 'app_mem.c');
+*               AppTask_GAME formats the statistics lines with snprintf() and saves the FP context.
 *********************************************************************************************************
 */
 
 #define  APP_CFG_TASK_START_STK_SIZE                     128u
+#define  APP_CFG_TASK_GAME_STK_SIZE                      640u   /* See Note #1.                                         */
+#define  APP_CFG_TASK_GAME_LOGIC_STK_SIZE                128u
+#define  APP_CFG_TASK_INPUT_STK_SIZE                     256u
 #define  APP_CFG_TASK_BLINKY_STK_SIZE                    128u
 #define  APP_CFG_TASK_EQ_STK_SIZE                        512u
+#define  APP_CFG_TASK_BENCH_STK_SIZE                     128u
+#define  APP_CFG_TASK_BENCH_FLAG_STK_SIZE                 64u   /* Flag waiters, see KERNEL BENCHMARK Note #3.          */
+#define  APP_CFG_TASK_BENCH_CTRL_STK_SIZE                512u   /* snprintf() + report line buffers.                    */
+#define  APP_CFG_TASK_INIT_STK_SIZE                      128u
+#define  APP_CFG_TASK_CONSOLE_STK_SIZE                   384u
+#define  APP_CFG_TASK_TELEM_STK_SIZE                     256u
+#define  APP_CFG_TASK_REPLAY_STK_SIZE                    128u
+#define  APP_CFG_TASK_BATCH_STK_SIZE                     192u   /* Exact check after each chunk (app_exact.c).          */
+#define  APP_CFG_TASK_BG_STK_SIZE                        128u
 
 
 /*
@@ -79,6 +103,233 @@
 #define  APP_CFG_TASK_BLINKY_STK_SIZE_LIMIT      (APP_CFG_TASK_BLINKY_STK_SIZE    * (100u - APP_CFG_TASK_START_STK_SIZE_PCT_FULL))    / 100u
 
 
+/*
+*********************************************************************************************************
+*                                         GAME DISPLAY CONFIGURATION
+*
+* Note(s) : (1) When enabled, the game screen shows the worst-case interrupt-disable time measured by
+*               uC/CPU (CPU_IntDisMeasMaxGet()) below the statistics line.  Requires CPU_CFG_INT_DIS_MEAS_EN
+*               in 'cpu_cfg.h'.  The maximum covers every CPU_CRITICAL_ENTER() section since start-up,
+*               kernel and BSP included; with the game state behind a seqlock the application adds no
+*               section of its own to it, so the figure is that of the kernel.  To compare with the
+*               older build, let a few rounds run on each build and read the line; the older build
+*               kept interrupts off across RNG_GetRandom32() (and, for the host's goat door, across a
+*               rejection loop of them), so its maximum had no fixed bound.
+*
+*           (2) AppTask_GAME coalesces screen update requests and starts at most one frame every
+*               APP_CFG_RENDER_FRAME_MS.  The first request after an idle period of at least one frame
+*               interval is rendered without delay.  Requests are empty messages on AppTask_GAME's
+*               task queue of APP_CFG_RENDER_REQ_Q_SIZE entries, so the kernel time stamps each one
+*               and the oldest pending one gives the frame latency; they take OS_CFG_MSG_POOL_SIZE
+*               messages while pending.  A request that finds the queue full is merged into the frame
+*               already pending and is not counted.
+*
+*           (3) When enabled, the game screen shows frames requested vs. rendered and the latency from
+*               an update request (e.g. joystick input) to the end of the frame that shows it, as well as
+*               the frame cache statistics.
+*
+*           (4) The door/marker/cursor part of the screen is built once per distinct look and kept in a
+*               cache of APP_CFG_FRAME_CACHE_SIZE slots (see 'app_frame.c').  A round shows about six
+*               distinct bodies of up to 600 octets each.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_INT_DIS_MEAS_SHOW            DEF_DISABLED      /* See Note #1.                                         */
+#define  APP_CFG_RENDER_FRAME_MS                      100u      /* Min. frame start-to-start interval (see Note #2).    */
+#define  APP_CFG_RENDER_REQ_Q_SIZE                       8u      /* Pending screen update requests (see Note #2).        */
+#define  APP_CFG_RENDER_STATS_SHOW            DEF_DISABLED      /* See Note #3.                                         */
+#define  APP_CFG_FRAME_CACHE_SIZE                        8u      /* Cached screen bodies (see Note #4).                  */
+#define  APP_CFG_FRAME_BODY_SIZE                       640u      /* Octets per cached body, incl. NUL.                   */
+
+
+/*
+*********************************************************************************************************
+*                                        RESULT LED CONFIGURATION
+*
+* Note(s) : (1) A round result lights the green (win) or red (lose) LED for 2 s; from
+*               APP_CFG_LED_STREAK_MIN wins in a row on, the three LEDs run round instead (see 'app_led.c').
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_LED_STREAK_MIN                          3u      /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                       GAME STATISTICS CONFIGURATION
+*
+* Note(s) : (1) Rounds and wins are counted per strategy (stay/switch) and per initial pick, for doors
+*               1 .. APP_CFG_STATS_PICK_MAX (see 'app_stats.c').  Each (strategy, pick) cell takes 16 octets.
+*
+*           (2) Confidence intervals are Wilson score intervals with z = APP_CFG_STATS_Z_X100 / 100.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_STATS_PICK_MAX                          8u      /* See Note #1.                                         */
+#define  APP_CFG_STATS_Z_X100                          196u      /* 95 % confidence (see Note #2).                       */
+
+
+/*
+*********************************************************************************************************
+*                                   COMMAND CONSOLE / BATCH CONFIGURATION
+*
+* Note(s) : (1) COM1 input is received by a circular DMA (DMA1 Stream1 Channel 4) into a buffer of
+*               APP_CFG_CONSOLE_RX_BUF_SIZE octets and parsed by the console task (see 'app_console.c').
+*               At 115200 bd the buffer holds about 22 ms of input per half.
+*
+*           (2) When enabled, the DMA receiver is not started and AppConsole_FakeRx() feeds the console
+*               from software (host tests, scripted sessions).
+*
+*           (3) A batch merges its results into the game statistics every APP_CFG_BATCH_CHUNK rounds
+*               (see 'app_batch.c').
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_CONSOLE_RX_BUF_SIZE                   512u      /* See Note #1.                                         */
+#define  APP_CFG_CONSOLE_LINE_SIZE                      64u      /* Max. command line length, incl. NUL.                 */
+#define  APP_CFG_CONSOLE_FAKE_UART_EN         DEF_DISABLED      /* See Note #2.                                         */
+#define  APP_CFG_BATCH_CHUNK                          4096u      /* See Note #3.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                    BACKGROUND SIMULATION CONFIGURATION
+*
+* Note(s) : (1) The background worker (see 'app_bg.c') simulates rounds with the CPU time no other task
+*               wants and keeps them in statistics of its own.  When disabled it waits for 'bg on'.
+*
+*           (2) The worker merges APP_CFG_BG_CHUNK rounds at a time with the scheduler locked, the only
+*               time it holds off AppTask_INPUT.  Merges longer than APP_CFG_BG_LOCK_MAX_US are counted
+*               ('bg' command); the merge takes as long whatever the chunk size.
+*
+*           (3) Rounds per second are measured over windows of APP_CFG_BG_RATE_WIN_MS, kept apart by
+*               whether a frame was drawn in the window or not.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_BG_START_ON                  DEF_ENABLED       /* See Note #1.                                         */
+#define  APP_CFG_BG_CHUNK                             1024u      /* See Note #2.                                         */
+#define  APP_CFG_BG_LOCK_MAX_US                         10u      /* See Note #2.                                         */
+#define  APP_CFG_BG_RATE_WIN_MS                       1000u      /* See Note #3.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                      PERIODIC TASK MONITOR CONFIGURATION
+*
+* Note(s) : (1) AppTask_INPUT is released every APP_CFG_INPUT_PERIOD_MS on absolute ticks (see
+*               'app_period.c').
+*
+*           (2) Release jitter and execution time are counted in log2 histograms of
+*               APP_CFG_PERIOD_HIST_BINS bins, from 0 .. 1 us up; 16 bins reach 32 ms and more.
+*
+*           (3) Deadline misses are charged to the last configuration change made on the console if it
+*               came at most APP_CFG_PERIOD_CFG_WIN_MS before; the last APP_CFG_PERIOD_CFG_NBR different
+*               changes are kept.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_INPUT_PERIOD_MS                        10u      /* See Note #1.                                         */
+#define  APP_CFG_PERIOD_HIST_BINS                       16u      /* See Note #2.                                         */
+#define  APP_CFG_PERIOD_CFG_NBR                          8u      /* See Note #3.                                         */
+#define  APP_CFG_PERIOD_CFG_WIN_MS                    2000u      /* See Note #3.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                        TELEMETRY CONFIGURATION
+*
+* Note(s) : (1) 'render telem' switches COM1 from the ANSI screen to a binary stream of COBS framed,
+*               CRC checked records (see 'app_telem.c').  'Tools/telem_decode.py' decodes it on a host.
+*
+*           (2) Values are sent as deltas against the previous record; a SYNC record resets them, so a
+*               decoder attached mid-stream starts at the next SYNC.
+*
+*           (3) Task slots follow the kernel's debug task list; tasks past APP_CFG_TELEM_TASK_MAX are
+*               not reported, nor periodic tasks past APP_CFG_TELEM_PERIOD_MAX.
+*
+*           (4) Console replies travel in TRACE records while the stream is on.  The ring must hold the
+*               longest reply ('stats' is about 1.3 KB): the console writes it while holding COM1, so the
+*               ring cannot drain meanwhile.  What does not fit is dropped and counted.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_TELEM_PERIOD_MS                       100u      /* STATS records at most this often.                    */
+#define  APP_CFG_TELEM_KERNEL_DIV                       10u      /* KERNEL/TASK_STAT records every n periods (1 s).      */
+#define  APP_CFG_TELEM_SYNC_DIV                         50u      /* SYNC record every n periods (5 s), see Note #2.      */
+#define  APP_CFG_TELEM_Q_SIZE                           16u      /* Rounds queued for the telemetry task.                */
+#define  APP_CFG_TELEM_FRAME_SIZE                      128u      /* Octets per frame before COBS, 83 .. 254.             */
+#define  APP_CFG_TELEM_TASK_MAX                         16u      /* Task slots reported, see Note #3.                    */
+#define  APP_CFG_TELEM_PERIOD_MAX                        4u      /* Periodic task slots reported, see Note #3.           */
+#define  APP_CFG_TELEM_TRACE_BUF_SIZE                 2048u      /* Power of 2, see Note #4.                             */
+
+
+/*
+*********************************************************************************************************
+*                                     INPUT JOURNAL / REPLAY CONFIGURATION
+*
+* Note(s) : (1) 'journal rec' records the input events and RNG draws of the next rounds into a RAM
+*               journal of APP_CFG_REPLAY_BUF_SIZE octets, some 20 octets per round; 'journal play'
+*               feeds them back through the game tasks (see 'app_replay.c').
+*
+*           (2) The replay task MUST be below every game task : in a fast replay it applies the next
+*               input only when the logic and render tasks are both blocked.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_REPLAY_BUF_SIZE                      8192u      /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                      MEMORY FOOTPRINT CONFIGURATION
+*
+* Note(s) : (1) 'mem size' recommends each stack as its high-water mark plus APP_CFG_MEM_STK_MARGIN_PCT
+*               percent, rounded up to APP_CFG_MEM_STK_ROUND words (see 'app_mem.c').
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_MEM_STK_MARGIN_PCT                     25u      /* See Note #1.                                         */
+#define  APP_CFG_MEM_STK_ROUND                          16u
+
+
+/*
+*********************************************************************************************************
+*                                     KERNEL BENCHMARK CONFIGURATION
+*
+* Note(s) : (1) When enabled, AppTaskStart() runs the benchmark suite in 'app_bench.c' once before the
+*               game objects and tasks are created and prints the results on COM1.
+*
+*           (2) APP_CFG_BENCH_INT_ID is an otherwise unused peripheral interrupt that is pended from
+*               software to measure interrupt-to-task latency.
+*
+*           (3) The flag broadcast waiters have a pool of their own, separate from the other helper
+*               tasks.  They only pend, so their stacks are OS_CFG_STK_SIZE_MIN words :
+*
+*                   APP_CFG_BENCH_FLAG_WAITERS * sizeof(OS_TCB)                        in CCM
+*                   APP_CFG_BENCH_FLAG_WAITERS * APP_CFG_TASK_BENCH_FLAG_STK_SIZE * 4  in SRAM
+*
+*               With a 364-byte OS_TCB that is ~23 KB of CCM and 16 KB of SRAM at 64 waiters.  The
+*               stacks stay out of CCM, which also holds the kernel and every other task, so the TCBs
+*               the post walks keep their CCM timing.
+*
+*           (4) APP_CFG_BENCH_ZLAT_INT_ID is a free basic timer that fires every APP_CFG_BENCH_ZLAT_PERIOD_US
+*               during the whole suite as a zero latency interrupt on level APP_CFG_BENCH_ZLAT_PRIO (see
+*               'app_zlat.c').  The level MUST be above CPU_CFG_KA_IPL_BOUNDARY when that is #define'd.
+*********************************************************************************************************
+*/
+
+#define  APP_CFG_BENCH_EN                     DEF_DISABLED
+#define  APP_CFG_BENCH_ITER                           1000u     /* Iterations per benchmark.                            */
+#define  APP_CFG_BENCH_TMR_ITER                         20u     /* Timer expiries measured (one per OS timer tick).     */
+#define  APP_CFG_BENCH_FLAG_WAITERS                     64u     /* Max tasks on the flag group, see Note #3.            */
+#define  APP_CFG_BENCH_MUTEX_NEST                        8u     /* Mutexes held at once in the nested-lock benchmark.   */
+#define  APP_CFG_BENCH_INT_ID                 BSP_INT_ID_TIM7
+#define  APP_CFG_BENCH_ZLAT_INT_ID            BSP_INT_ID_TIM6_DAC /* See Note #4.                                       */
+#define  APP_CFG_BENCH_ZLAT_PRIO                         0u     /* NVIC level of the zero latency probe.                */
+#define  APP_CFG_BENCH_ZLAT_PERIOD_US                   50u     /* Probe period.                                        */
+
+
 /*
 *********************************************************************************************************
 *                                       TRACE / DEBUG CONFIGURATION
@@ -0,0 +1,1309 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_console.c
+* Description   : Line based command console on COM1, fed by a circular DMA receive buffer.
+*
+* Note(s)       : (1) This module does not touch the UART.  The driver (USART_RxDmaConfig() in 'app.c')
+*                     runs a circular DMA into the buffer returned by AppConsole_RxBufGet() and, on the
+*                     USART idle-line, DMA half-transfer and DMA transfer-complete interrupts, calls
+*                     AppConsole_RxNotify() with the DMA write index.  There is no interrupt per received
+*                     byte and no polling.
+*
+*                 (2) AppConsole_RxNotify() turns the write index into a running count of received bytes.
+*                     A wrap is detected by the index going backwards, which is unambiguous because the
+*                     half/complete interrupts notify at least twice per lap.  If the console task falls
+*                     more than a whole buffer behind, the unread data is dropped and counted as an overrun.
+*
+*                 (3) On a host, or with APP_CFG_CONSOLE_FAKE_UART_EN, AppConsole_FakeRx() plays the part of
+*                     the DMA : it copies bytes into the buffer at the write index and notifies.  Without a
+*                     kernel, a test can call AppConsole_RxDrain() directly instead of running the task.
+*
+*                 (4) Commands (one per line, case insensitive, replies start with "OK", "ERR" or a CSV
+*                     record tag) :
+*
+*                         help
+*                         batch start [<rounds> [<seed>]]        0 or no rounds = until stopped
+*                         batch stop
+*                         batch                                  batch status
+*                         batch tol <ppm>                        stop a batch at this accuracy, 0 = off
+*                         batch prec <ppm>                       stop a batch at this precision, 0 = off
+*                         batch sample indep|crn|anti|strat      sampling of batch rounds
+*                         batch est                              estimates and variance reduction
+*                         strategy stay|switch|mix               strategy of batch rounds
+*                         doors <n>                              door count of batch rounds (3 .. 8)
+*                         stats [clear]                          dump (or clear) the game statistics
+*                         exact [<reveals> [knows|blind [<w1,w2,..>]]]   exact win probabilities (batch doors)
+*                         exact check                            game statistics vs. exact, batch tolerance
+*                         led [win|lose|streak|off|err <n>]      LED service status (or play a pattern)
+*                         bg [on|off|clear]                      background simulation status (or control)
+*                         period [hist|clear]                    periodic task jitter and deadline misses
+*                         csprof [total|clear]                   critical section & scheduler lock sites
+*                         obj [clear]                            semaphore, mutex, queue & flag contention
+*                         trace                                  dump console, telemetry and task statistics
+*                         load                                   1 s / 10 s / 60 s CPU, ISR and task loads
+*                         boot                                   start-up stages and their times
+*                         mem [size]                             memory footprint (or recommended sizes)
+*                         render full|stats|off|telem            game screen mode
+*                         journal                                journal status
+*                         journal rec|stop                       record the next rounds / stop
+*                         journal play [fast] [<repeat>]         replay the journal, 0 repeats = until stopped
+*                         journal dump                           journal as JDATA,<offset>,<hex> lines
+*                         journal load <offset> <hex>            write saved octets back, offset 0 = new
+*
+*                     In 'full' render mode the next frame clears the screen; use 'render stats' or
+*                     'render off' to read long dumps.  In 'telem' mode COM1 carries the binary stream
+*                     of 'app_telem.c' and replies are sent inside it as TRACE records.  For a fast replay
+*                     benchmark use 'render off': drawing a frame takes some 50 ms of COM1.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_batch.h"
+#include "app_bg.h"
+#include "app_console.h"
+#include "app_exact.h"
+#include "app_init.h"
+#include "app_led.h"
+#include "app_mem.h"
+#include "app_period.h"
+#include "app_replay.h"
+#include "app_telem.h"
+
+#define CONSOLE_ARG_MAX  4u
+#define CONSOLE_CSPROF_ROWS 16u /* csprof 가 보여주는 사이트, 종류마다 */
+#define CONSOLE_OBJ_ROWS    24u /* obj 가 보여주는 커널 오브젝트 */
+
+#define CONSOLE_LINE_OK      0u /* 줄 조립 중                   */
+#define CONSOLE_LINE_LONG    1u /* 너무 긴 줄: 줄 끝까지 버림    */
+#define CONSOLE_LINE_RESYNC  2u /* overrun 후: 줄 끝까지 버림     */
+
+typedef struct {
+    const CPU_CHAR *name;
+    void (*fnct)(CPU_INT08U argc, CPU_CHAR **argv);
+    CPU_BOOLEAN cfg; /* 인자가 있으면 설정 변경 (app_period.c Note #4) */
+} CONSOLE_CMD;
+
+BSP_CCM_DATA static OS_TCB ConsoleTCB;
+BSP_CCM_DATA static CPU_STK ConsoleStk[APP_CFG_TASK_CONSOLE_STK_SIZE];
+
+static CPU_INT08U ConsoleRxBuf[APP_CFG_CONSOLE_RX_BUF_SIZE]; /* DMA 가 쓰는 원형 버퍼 */
+static CPU_INT32U ConsoleRxWrPos;  /* 받은 바이트 누적 (ISR 에서 갱신)       */
+static CPU_SIZE_T ConsoleRxWrIx;   /* 마지막으로 알려진 DMA 쓰기 위치          */
+static CPU_INT32U ConsoleRxRdPos;  /* 태스크가 읽은 바이트 누적               */
+static CPU_SIZE_T ConsoleRxRdIx;
+
+static CPU_CHAR ConsoleLine[APP_CFG_CONSOLE_LINE_SIZE];
+static CPU_SIZE_T ConsoleLineLen;
+static CPU_INT08U ConsoleLineState;
+
+static CPU_CHAR ConsoleTxBuf[128];
+static APP_STATS ConsoleStatsSnap; /* 통계 스냅샷, 콘솔 태스크 전용 (스택 절약) */
+static APP_CONSOLE_STATS ConsoleStats;
+#if (OS_CFG_OBJ_STAT_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+static OS_OBJ_STAT_SNAP ConsoleObjSnap[CONSOLE_OBJ_ROWS]; /* obj 스냅샷, 콘솔 태스크 전용 */
+#endif
+
+static void Console_CmdHelp(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdBatch(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdStrategy(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdDoors(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdStats(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdTrace(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdRender(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdJournal(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdLoad(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdBoot(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdMem(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdExact(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdLed(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdBg(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdPeriod(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdCsProf(CPU_INT08U argc, CPU_CHAR **argv);
+static void Console_CmdObj(CPU_INT08U argc, CPU_CHAR **argv);
+
+static const CONSOLE_CMD ConsoleCmdTbl[] = {
+    {"help", Console_CmdHelp, DEF_NO},
+    {"batch", Console_CmdBatch, DEF_YES},
+    {"strategy", Console_CmdStrategy, DEF_YES},
+    {"doors", Console_CmdDoors, DEF_YES},
+    {"stats", Console_CmdStats, DEF_NO},
+    {"trace", Console_CmdTrace, DEF_NO},
+    {"render", Console_CmdRender, DEF_YES},
+    {"journal", Console_CmdJournal, DEF_YES},
+    {"load", Console_CmdLoad, DEF_NO},
+    {"boot", Console_CmdBoot, DEF_NO},
+    {"mem", Console_CmdMem, DEF_NO},
+    {"exact", Console_CmdExact, DEF_NO},
+    {"led", Console_CmdLed, DEF_YES},
+    {"bg", Console_CmdBg, DEF_YES},
+    {"period", Console_CmdPeriod, DEF_NO},
+    {"csprof", Console_CmdCsProf, DEF_NO},
+    {"obj", Console_CmdObj, DEF_NO},
+};
+
+static const CPU_CHAR *const ConsoleStratName[] = {"stay", "switch", "mix"};
+static const CPU_CHAR *const ConsoleRenderName[] = {"full", "stats", "off", "telem"};
+static const CPU_CHAR *const ConsoleReplayName[] = {"idle", "rec-armed", "rec", "play-armed", "play"};
+static const CPU_CHAR *const ConsoleInitModeName[] = {"now", "bg", "lazy"};
+static const CPU_CHAR *const ConsoleInitStateName[] = {"pending", "running", "done"};
+static const CPU_CHAR *const ConsoleHostName[] = {"knows", "blind"};
+static const CPU_CHAR *const ConsoleSampleName[] = {"indep", "crn", "anti", "strat"};
+static const CPU_CHAR *const ConsoleEstName[] = {"stay", "switch", "diff"};
+
+/*-------------------------------------------------------------*/
+/*  출력 (호출하는 쪽에서 App_TermLock())                          */
+/*-------------------------------------------------------------*/
+static void Console_Printf(const CPU_CHAR *fmt, ...) {
+    va_list ap;
+
+    va_start(ap, fmt);
+    vsnprintf(ConsoleTxBuf, sizeof ConsoleTxBuf - 2u, fmt, ap);
+    va_end(ap);
+    Str_Cat(ConsoleTxBuf, "\r\n");
+    if (App_RenderModeGet() == APP_RENDER_TELEM) { /* COM1 은 바이너리 스트림 (Note #4) */
+        (void)AppTelem_TraceWrite(ConsoleTxBuf, Str_Len(ConsoleTxBuf));
+    } else {
+        send_string(ConsoleTxBuf);
+    }
+}
+
+/* 문자열 → 번호, 전부 숫자일 때만 */
+static CPU_BOOLEAN Console_ParseU32(const CPU_CHAR *p_str, CPU_INT32U *p_val) {
+    CPU_CHAR *p_end;
+
+    *p_val = Str_ParseNbr_Int32U(p_str, &p_end, 10u);
+    return ((p_end != p_str) && (*p_end == '\0')) ? DEF_OK : DEF_FAIL;
+}
+
+/* 이름 표에서 찾기, 없으면 n */
+static CPU_INT08U Console_Lookup(const CPU_CHAR *p_str, const CPU_CHAR *const *tbl, CPU_INT08U n) {
+    for (CPU_INT08U i = 0u; i < n; i++) {
+        if (Str_CmpIgnoreCase(p_str, tbl[i]) == 0) return i;
+    }
+    return n;
+}
+
+/*-------------------------------------------------------------*/
+/*  명령 (Note #4)                                              */
+/*-------------------------------------------------------------*/
+static void Console_CmdHelp(CPU_INT08U argc, CPU_CHAR **argv) {
+    (void)argc;
+    (void)argv;
+    Console_Printf("OK commands: batch start [rounds [seed]] | batch stop | batch");
+    Console_Printf("OK   batch tol|prec <ppm> | batch sample indep|crn|anti|strat | batch est");
+    Console_Printf("OK   strategy stay|switch|mix | doors 3..%u | stats [clear] | trace",
+                   (unsigned)APP_BATCH_DOORS_MAX);
+    Console_Printf("OK   render full|stats|off|telem");
+    Console_Printf("OK   journal [rec | stop | play [fast] [repeat] | dump | load <offset> <hex>]");
+    Console_Printf("OK   load | boot | mem [size]");
+    Console_Printf("OK   exact [reveals [knows|blind [w1,w2,..]]] | exact check");
+    Console_Printf("OK   led [win | lose | streak | off | err <1..%u>]", (unsigned)APP_LED_ERR_CODE_MAX);
+    Console_Printf("OK   bg [on | off | clear] | period [hist | clear] | csprof [total | clear]");
+    Console_Printf("OK   obj [clear]");
+}
+
+/* EST,<stay|switch|diff>,<estimate ppm>,<half-width ppm>,<variance reduction x100 | inf>,<draws>
+ * (app_batch.c Note #5), 추정치가 없으면 줄도 없음 */
+static void Console_BatchEst(void) {
+    APP_BATCH_EST est;
+    APP_BATCH_EST_SUMMARY sum;
+    CPU_CHAR vrf[12];
+    char d[APP_STATS_U64_STR_LEN];
+
+    AppBatch_EstGet(&est);
+    for (CPU_INT08U what = 0u; what <= APP_BATCH_EST_DIFF; what++) {
+        if (AppBatch_EstSummarize(&est, what, &sum) != DEF_OK) {
+            continue;
+        }
+        if (sum.var > 0.0f) {
+            snprintf(vrf, sizeof vrf, "%u", (unsigned)(sum.vrf * 100.0f + 0.5f));
+        } else {
+            Str_Copy(vrf, "inf");
+        }
+        Console_Printf("EST,%s,%d,%u,%s,%s", ConsoleEstName[what],
+                       (int)(sum.mean * (CPU_FP32)APP_EXACT_PPM_ONE + ((sum.mean < 0.0f) ? -0.5f : 0.5f)),
+                       (unsigned)(sum.half * (CPU_FP32)APP_EXACT_PPM_ONE + 0.5f), vrf,
+                       AppStats_U64ToStr(sum.draws, d));
+    }
+}
+
+static void Console_CmdBatch(CPU_INT08U argc, CPU_CHAR **argv) {
+    APP_BATCH_STATUS st;
+    CPU_INT32U target = 0u;
+    CPU_INT32U seed, tol;
+    char n[APP_STATS_U64_STR_LEN], t[APP_STATS_U64_STR_LEN];
+
+    if (argc == 1u) {
+        AppBatch_StatusGet(&st);
+        CPU_INT32U us = (CPU_INT32U)(st.cycles / (BSP_CPU_ClkFreq() / 1000000u));
+        Console_Printf("BATCH,%s,%s,%u,%s,%s,%u,%u,%u,%u,%s,%u",
+                       (st.running == DEF_YES) ? "running" : "idle",
+                       ConsoleStratName[st.strat], (unsigned)st.doors,
+                       AppStats_U64ToStr(st.done, n), AppStats_U64ToStr(st.target, t),
+                       (unsigned)st.seed, (unsigned)us, (unsigned)st.tol, (unsigned)st.converged,
+                       ConsoleSampleName[st.sample], (unsigned)st.prec);
+        return;
+    }
+
+    if (Str_CmpIgnoreCase(argv[1], "stop") == 0) {
+        AppBatch_Stop();
+        Console_Printf("OK");
+        return;
+    }
+
+    if ((argc == 3u) && ((Str_CmpIgnoreCase(argv[1], "tol") == 0) || (Str_CmpIgnoreCase(argv[1], "prec") == 0))) {
+        if ((Console_ParseU32(argv[2], &tol) != DEF_OK) || (tol >= APP_EXACT_PPM_ONE)) {
+            Console_Printf("ERR ppm");
+            return;
+        }
+        if (Str_CmpIgnoreCase(argv[1], "tol") == 0) {
+            AppBatch_TolSet(tol);
+        } else {
+            AppBatch_PrecSet(tol);
+        }
+        Console_Printf("OK");
+        return;
+    }
+
+    if ((argc == 3u) && (Str_CmpIgnoreCase(argv[1], "sample") == 0)) {
+        if (AppBatch_SampleSet(Console_Lookup(argv[2], ConsoleSampleName, APP_BATCH_SAMPLE_STRAT + 1u)) != DEF_OK) {
+            Console_Printf("ERR usage: batch sample indep|crn|anti|strat");
+            return;
+        }
+        Console_Printf("OK");
+        return;
+    }
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "est") == 0)) {
+        Console_BatchEst();
+        return;
+    }
+
+    if (Str_CmpIgnoreCase(argv[1], "start") == 0) {
+        if ((argc > 2u) && (Console_ParseU32(argv[2], &target) != DEF_OK)) {
+            Console_Printf("ERR rounds");
+            return;
+        }
+        if (argc > 3u) {
+            if (Console_ParseU32(argv[3], &seed) != DEF_OK) {
+                Console_Printf("ERR seed");
+                return;
+            }
+        } else {
+            seed = App_Rand32();
+        }
+        if (AppBatch_Start(target, seed) != DEF_OK) {
+            Console_Printf("ERR batch running");
+            return;
+        }
+        Console_Printf("OK seed %u", (unsigned)seed);
+        return;
+    }
+
+    Console_Printf("ERR usage: batch [start [rounds [seed]] | stop | tol|prec <ppm> | sample <mode> | est]");
+}
+
+static void Console_CmdStrategy(CPU_INT08U argc, CPU_CHAR **argv) {
+    CPU_INT08U strat = APP_BATCH_STRAT_MIX + 1u;
+
+    if (argc == 2u) {
+        strat = Console_Lookup(argv[1], ConsoleStratName, APP_BATCH_STRAT_MIX + 1u);
+    }
+    if (AppBatch_StratSet(strat) != DEF_OK) {
+        Console_Printf("ERR usage: strategy stay|switch|mix");
+        return;
+    }
+    Console_Printf("OK");
+}
+
+static void Console_CmdDoors(CPU_INT08U argc, CPU_CHAR **argv) {
+    CPU_INT32U doors = 0u;
+
+    if ((argc != 2u) ||
+        (Console_ParseU32(argv[1], &doors) != DEF_OK) ||
+        (doors > DEF_INT_08U_MAX_VAL) ||
+        (AppBatch_DoorsSet((CPU_INT08U)doors) != DEF_OK)) {
+        Console_Printf("ERR usage: doors %u..%u", (unsigned)APP_BATCH_DOORS_MIN, (unsigned)APP_BATCH_DOORS_MAX);
+        return;
+    }
+    Console_Printf("OK");
+}
+
+/* STATS,<strategy>,<pick>,<rounds>,<wins>,<rate ‰>,<CI low ‰>,<CI high ‰> */
+static void Console_StatsRow(const APP_STATS *p_stats, CPU_INT08U strat, CPU_INT08U pick) {
+    APP_STATS_CELL cell;
+    APP_STATS_SUMMARY sum;
+    char r[APP_STATS_U64_STR_LEN], w[APP_STATS_U64_STR_LEN];
+    char pickStr[4];
+
+    AppStats_CellGet(p_stats, strat, pick, &cell);
+    if ((cell.rounds == 0u) && (pick != APP_STATS_ALL)) {
+        return;
+    }
+    AppStats_Summarize(&cell, &sum);
+    if (pick == APP_STATS_ALL) {
+        Str_Copy(pickStr, "all");
+    } else {
+        snprintf(pickStr, sizeof pickStr, "%u", (unsigned)pick);
+    }
+    Console_Printf("STATS,%s,%s,%s,%s,%u,%u,%u",
+                   ConsoleStratName[strat], pickStr,
+                   AppStats_U64ToStr(cell.rounds, r), AppStats_U64ToStr(cell.wins, w),
+                   (unsigned)AppStats_Permille(sum.mean),
+                   (unsigned)AppStats_Permille(sum.ciLo),
+                   (unsigned)AppStats_Permille(sum.ciHi));
+}
+
+static void Console_CmdStats(CPU_INT08U argc, CPU_CHAR **argv) {
+    if (argc == 2u && Str_CmpIgnoreCase(argv[1], "clear") == 0) {
+        App_StatsClr();
+        Console_Printf("OK");
+        return;
+    }
+    if (argc != 1u) {
+        Console_Printf("ERR usage: stats [clear]");
+        return;
+    }
+
+    App_StatsRead(&ConsoleStatsSnap);
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        for (CPU_INT08U pick = 1u; pick <= APP_CFG_STATS_PICK_MAX; pick++) {
+            Console_StatsRow(&ConsoleStatsSnap, s, pick);
+        }
+        Console_StatsRow(&ConsoleStatsSnap, s, APP_STATS_ALL);
+    }
+}
+
+/* TRACE,console,<rx bytes>,<lines>,<overruns>,<long lines>
+ * TRACE,telem,<frames>,<records>,<octets>,<round drops>,<trace drops>
+ * TRACE,task,<name>,<prio>,<CPU % x100>,<ctx switches>,<stack used>,<stack size> */
+static void Console_CmdTrace(CPU_INT08U argc, CPU_CHAR **argv) {
+    APP_CONSOLE_STATS cs;
+    APP_TELEM_STATS ts;
+    (void)argc;
+    (void)argv;
+
+    AppConsole_StatsGet(&cs);
+    Console_Printf("TRACE,console,%u,%u,%u,%u",
+                   (unsigned)cs.rxBytes, (unsigned)cs.lines, (unsigned)cs.overruns, (unsigned)cs.longLines);
+    AppTelem_StatsGet(&ts);
+    Console_Printf("TRACE,telem,%u,%u,%u,%u,%u",
+                   (unsigned)ts.frames, (unsigned)ts.records, (unsigned)ts.octets,
+                   (unsigned)ts.roundDrops, (unsigned)ts.traceDrops);
+
+#if (OS_CFG_DBG_EN > 0u)
+    OS_TCB *p_tcb;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    p_tcb = OSTaskDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_tcb != (OS_TCB *)0) {
+        const CPU_CHAR *name;
+        OS_PRIO prio;
+        CPU_INT32U usage = 0u, ctxSw = 0u, stkUsed = 0u, stkSize;
+
+        CPU_CRITICAL_ENTER(); /* 태스크 하나씩 복사해서 출력 중에는 인터럽트 허용 */
+        name = p_tcb->NamePtr;
+        prio = p_tcb->Prio;
+        stkSize = p_tcb->StkSize;
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+        usage = p_tcb->CPUUsage;
+        ctxSw = p_tcb->CtxSwCtr;
+#endif
+#if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+        stkUsed = p_tcb->StkUsed;
+#endif
+        p_tcb = p_tcb->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+
+        Console_Printf("TRACE,task,%s,%u,%u,%u,%u,%u",
+                       name, (unsigned)prio, (unsigned)usage, (unsigned)ctxSw,
+                       (unsigned)stkUsed, (unsigned)stkSize);
+    }
+#endif
+}
+
+#if (OS_STAT_CYCLES_EN > 0u)
+static void Console_LoadRow(const CPU_CHAR *kind, const CPU_CHAR *name, const CPU_INT32U *p_avg) {
+    Console_Printf("LOAD,%s,%s,%u,%u,%u", kind, name,
+                   (unsigned)OS_STAT_LOAD_AVG_USAGE(p_avg[0]),
+                   (unsigned)OS_STAT_LOAD_AVG_USAGE(p_avg[1]),
+                   (unsigned)OS_STAT_LOAD_AVG_USAGE(p_avg[2]));
+}
+#endif
+
+/* LOAD,<cpu|isr|task|irq>,<name>,<1 s>,<10 s>,<60 s>, CPU % x100 (os_stat.c OS_StatTask() Note #5, #6)
+ * cpu = 바쁜 시간 전체, isr = 모든 ISR, irq = BSP_IntLoadSet() 으로 따로 센 인터럽트 (isr 에 포함) */
+static void Console_CmdLoad(CPU_INT08U argc, CPU_CHAR **argv) {
+    (void)argc;
+    (void)argv;
+
+#if (OS_STAT_CYCLES_EN > 0u)
+    CPU_INT32U avg[OS_STAT_LOAD_AVG_NBR];
+    const CPU_CHAR *name;
+    OS_TCB *p_tcb;
+    OS_LOAD *p_load;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    Mem_Copy(avg, OSStatTaskCPUUsageAvg, sizeof avg);
+    CPU_CRITICAL_EXIT();
+    Console_LoadRow("cpu", "", avg);
+    CPU_CRITICAL_ENTER();
+    Mem_Copy(avg, OSIntCPUUsageAvg, sizeof avg);
+    CPU_CRITICAL_EXIT();
+    Console_LoadRow("isr", "", avg);
+
+    CPU_CRITICAL_ENTER();
+    p_tcb = OSTaskDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_tcb != (OS_TCB *)0) {
+        CPU_CRITICAL_ENTER(); /* 하나씩 복사해서 출력 중에는 인터럽트 허용 */
+        name = p_tcb->NamePtr;
+        Mem_Copy(avg, p_tcb->CPUUsageAvg, sizeof avg);
+        p_tcb = p_tcb->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Console_LoadRow("task", name, avg);
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_load = OSStatLoadListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_load != (OS_LOAD *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_load->NamePtr;
+        Mem_Copy(avg, p_load->Avg, sizeof avg);
+        p_load = p_load->NextPtr;
+        CPU_CRITICAL_EXIT();
+        Console_LoadRow("irq", name, avg);
+    }
+#else
+    Console_Printf("ERR load needs OS_CFG_TASK_PROFILE_EN and OS_CFG_DBG_EN");
+#endif
+}
+
+/* BOOT,<stage>,<now|bg|lazy>,<pending|running|done>,<start us>,<us>,<task>, 시각은 CPU_Init() 부터
+ * BOOTMARK,frame|bg,<us>: 첫 화면, 초기화 태스크 끝 (0 = 아직) */
+static void Console_CmdBoot(CPU_INT08U argc, CPU_CHAR **argv) {
+    APP_INIT_STATUS st;
+    APP_INIT_REPORT rpt;
+
+    (void)argc;
+    (void)argv;
+
+    AppInit_StatusGet(&st);
+    for (CPU_INT08U id = 0u; id < st.nbr; id++) {
+        (void)AppInit_ReportGet(id, &rpt);
+        Console_Printf("BOOT,%s,%s,%s,%u,%u,%s", rpt.name, ConsoleInitModeName[rpt.mode],
+                       ConsoleInitStateName[rpt.state],
+                       (unsigned)((rpt.state == APP_INIT_STATE_DONE) ? rpt.us_start : 0u),
+                       (unsigned)((rpt.state == APP_INIT_STATE_DONE) ? rpt.us_end - rpt.us_start : 0u),
+                       rpt.task);
+    }
+    Console_Printf("BOOTMARK,frame,%u", (unsigned)st.frame_us);
+    Console_Printf("BOOTMARK,bg,%u", (unsigned)st.bg_us);
+}
+
+static CPU_INT32U ConsoleMemTotal;
+
+/* MEM,<kind>,<name>,<size>,<peak>,<octets>: 크기와 최고 사용량은 단위 수 (스택 = 워드, 큐 = 항목, …) */
+static void Console_MemRow(const APP_MEM_ENTRY *p_entry) {
+    CPU_CHAR peak[12] = "";
+
+    if (p_entry->peak != APP_MEM_PEAK_NONE) {
+        snprintf(peak, sizeof peak, "%u", (unsigned)p_entry->peak);
+    }
+    Console_Printf("MEM,%s,%s,%u,%s,%u", p_entry->kind, p_entry->name, (unsigned)p_entry->size, peak,
+                   (unsigned)(p_entry->unit * p_entry->size));
+    ConsoleMemTotal += p_entry->unit * p_entry->size;
+}
+
+/* SIZE,<#define>,<name>,<설정>,<최고>,<권장> (app_mem.c Note #2) */
+static void Console_MemSizeRow(const APP_MEM_ENTRY *p_entry) {
+    if ((p_entry->cfg[0] == '\0') || (p_entry->peak == APP_MEM_PEAK_NONE)) {
+        return;
+    }
+    Console_Printf("SIZE,%s,%s,%u,%u,%u", p_entry->cfg, p_entry->name, (unsigned)p_entry->size,
+                   (unsigned)p_entry->peak, (unsigned)p_entry->rec);
+}
+
+static void Console_CmdMem(CPU_INT08U argc, CPU_CHAR **argv) {
+    if (argc == 1u) {
+        ConsoleMemTotal = 0u;
+        AppMem_Walk(Console_MemRow);
+        Console_Printf("MEM,total,,,,%u", (unsigned)ConsoleMemTotal);
+    } else if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "size") == 0)) {
+        AppMem_Walk(Console_MemSizeRow);
+    } else {
+        Console_Printf("ERR usage: mem [size]");
+    }
+}
+
+/* 쉼표로 나눈 문마다의 가중치, 문 수만큼 */
+static CPU_BOOLEAN Console_ParseWeights(const CPU_CHAR *p_str, APP_EXACT_MODEL *p_model) {
+    CPU_CHAR *p_end;
+    CPU_INT32U w;
+
+    for (CPU_INT08U i = 0u; i < p_model->doors; i++) {
+        w = Str_ParseNbr_Int32U(p_str, &p_end, 10u);
+        if ((p_end == p_str) || (w > DEF_INT_16U_MAX_VAL)) {
+            return DEF_FAIL;
+        }
+        p_model->weight[i] = (CPU_INT16U)w;
+        if (*p_end == '\0') {
+            return (i + 1u == p_model->doors) ? DEF_OK : DEF_FAIL;
+        }
+        if (*p_end != ',') {
+            return DEF_FAIL;
+        }
+        p_str = p_end + 1;
+    }
+    return DEF_FAIL;
+}
+
+/* EXACT,<stay|switch|valid>,<pick|all>,<num>,<den>,<ppm>, 기약분수 (app_exact.c Note #2) */
+static void Console_ExactRow(const CPU_CHAR *what, const CPU_CHAR *pick, const APP_EXACT_RATIO *p_ratio) {
+    char num[APP_STATS_U64_STR_LEN], den[APP_STATS_U64_STR_LEN];
+
+    Console_Printf("EXACT,%s,%s,%s,%s,%u", what, pick,
+                   AppStats_U64ToStr(p_ratio->num, num), AppStats_U64ToStr(p_ratio->den, den),
+                   (unsigned)AppExact_Ppm(p_ratio));
+}
+
+/* 모델은 배치의 문 수, 기본은 아는 호스트가 N - 2 개, 균등 (AppExact_ModelInit())
+ * CHECK,<strategy>,<exact ppm>,<estimate ppm>,<CI low ppm>,<CI high ppm>,<rounds>,in|out
+ * : 게임 통계 (대화형 판 포함) 를 배치 허용오차로 (app_exact.c Note #4) */
+static void Console_CmdExact(CPU_INT08U argc, CPU_CHAR **argv) {
+    APP_BATCH_STATUS st;
+    APP_EXACT_MODEL model;
+    APP_EXACT_RESULT res;
+    APP_EXACT_CHECK chk;
+    APP_STATS_CELL cell;
+    CPU_INT32U reveals;
+    CPU_CHAR pick[4];
+    char r[APP_STATS_U64_STR_LEN];
+
+    AppBatch_StatusGet(&st);
+    AppExact_ModelInit(&model, st.doors);
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "check") == 0)) {
+        (void)AppExact_Eval(&model, APP_EXACT_PICK_ANY, &res);
+        App_StatsRead(&ConsoleStatsSnap);
+        for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+            AppStats_CellGet(&ConsoleStatsSnap, s, APP_STATS_ALL, &cell);
+            AppExact_Check(&res.win[s], &cell, st.tol, &chk);
+            Console_Printf("CHECK,%s,%u,%u,%u,%u,%s,%s", ConsoleStratName[s],
+                           (unsigned)chk.exact, (unsigned)chk.est, (unsigned)chk.ciLo, (unsigned)chk.ciHi,
+                           AppStats_U64ToStr(chk.rounds, r), (chk.within == DEF_YES) ? "in" : "out");
+        }
+        return;
+    }
+
+    if (argc > 1u) {
+        if ((Console_ParseU32(argv[1], &reveals) != DEF_OK) || (reveals > DEF_INT_08U_MAX_VAL)) {
+            reveals = DEF_INT_08U_MAX_VAL; /* 아래 AppExact_Eval() 에서 거절 */
+        }
+        model.reveals = (CPU_INT08U)reveals;
+    }
+    if (argc > 2u) {
+        model.host = Console_Lookup(argv[2], ConsoleHostName, APP_EXACT_HOST_BLIND + 1u);
+    }
+    if ((argc > 3u) && (Console_ParseWeights(argv[3], &model) != DEF_OK)) {
+        Console_Printf("ERR weights: %u comma separated numbers", (unsigned)model.doors);
+        return;
+    }
+    if (AppExact_Eval(&model, APP_EXACT_PICK_ANY, &res) != DEF_OK) {
+        Console_Printf("ERR usage: exact [0..%u [knows|blind [w1,w2,..]]] | exact check",
+                       (unsigned)(model.doors - 2u));
+        return;
+    }
+
+    for (CPU_INT08U p = 0u; p <= model.doors; p++) { /* p = 0: 첫 선택이 무작위 */
+        if (p == 0u) {
+            Str_Copy(pick, "all");
+        } else {
+            snprintf(pick, sizeof pick, "%u", (unsigned)p);
+            (void)AppExact_Eval(&model, p, &res);
+        }
+        Console_ExactRow(ConsoleStratName[APP_STATS_STRAT_STAY], pick, &res.win[APP_STATS_STRAT_STAY]);
+        Console_ExactRow(ConsoleStratName[APP_STATS_STRAT_SWITCH], pick, &res.win[APP_STATS_STRAT_SWITCH]);
+        Console_ExactRow("valid", pick, &res.valid);
+    }
+}
+
+/* LED,<pattern>,<plays>,<steps>,<callbacks>,<max callback us> */
+static void Console_CmdLed(CPU_INT08U argc, CPU_CHAR **argv) {
+    static const APP_LED_PATTERN *const pat[] = {&AppLed_PatWin, &AppLed_PatLose, &AppLed_PatStreak};
+    static const CPU_CHAR *const patName[] = {"win", "lose", "streak"};
+    APP_LED_STATUS st;
+    CPU_INT32U code;
+    CPU_INT08U ix;
+    CPU_ERR cpu_err;
+
+    if (argc == 1u) {
+        AppLed_StatusGet(&st);
+        Console_Printf("LED,%s,%u,%u,%u,%u", st.name, (unsigned)st.plays, (unsigned)st.steps,
+                       (unsigned)st.callbacks,
+                       (unsigned)((CPU_INT64U)st.cb_max * 1000000u / CPU_TS_TmrFreqGet(&cpu_err)));
+        return;
+    }
+
+    App_LedNeed();
+    ix = Console_Lookup(argv[1], patName, 3u);
+    if ((argc == 2u) && (ix < 3u)) {
+        AppLed_Play(pat[ix]);
+    } else if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "off") == 0)) {
+        AppLed_Stop();
+    } else if ((argc == 3u) && (Str_CmpIgnoreCase(argv[1], "err") == 0) &&
+               (Console_ParseU32(argv[2], &code) == DEF_OK) && (code >= 1u) && (code <= APP_LED_ERR_CODE_MAX)) {
+        AppLed_ErrCode((CPU_INT08U)code);
+    } else {
+        Console_Printf("ERR usage: led [win | lose | streak | off | err <1..%u>]", (unsigned)APP_LED_ERR_CODE_MAX);
+        return;
+    }
+    Console_Printf("OK");
+}
+
+/* BG,<on|off>,<rounds>,<chunk>,<chunk us>,<idle r/s>,<ui r/s>,<idle windows>,<ui windows>,<merge max us>,<merges over>
+ * (app_bg.c Note #2, #3) */
+static void Console_CmdBg(CPU_INT08U argc, CPU_CHAR **argv) {
+    APP_BG_STATUS st;
+    CPU_INT32U tsPerMHz;
+    CPU_ERR cpu_err;
+    char r[APP_STATS_U64_STR_LEN];
+
+    if (argc == 1u) {
+        AppBg_StatusGet(&st);
+        tsPerMHz = CPU_TS_TmrFreqGet(&cpu_err) / 1000000u;
+        Console_Printf("BG,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u", (st.on == DEF_ON) ? "on" : "off",
+                       AppStats_U64ToStr(st.rounds, r), (unsigned)st.chunk,
+                       (unsigned)(st.chunk_min / tsPerMHz),
+                       (unsigned)AppBg_Rate(&st, APP_BG_RATE_IDLE), (unsigned)AppBg_Rate(&st, APP_BG_RATE_UI),
+                       (unsigned)st.rate[APP_BG_RATE_IDLE].windows, (unsigned)st.rate[APP_BG_RATE_UI].windows,
+                       (unsigned)(st.lock_max / tsPerMHz), (unsigned)st.lock_over);
+        return;
+    }
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "on") == 0)) {
+        AppBg_Set(DEF_ON);
+    } else if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "off") == 0)) {
+        AppBg_Set(DEF_OFF);
+    } else if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "clear") == 0)) {
+        AppBg_Clr();
+    } else {
+        Console_Printf("ERR usage: bg [on | off | clear]");
+        return;
+    }
+    Console_Printf("OK");
+}
+
+/* PERIOD,<task>,<period us>,<releases>,<misses>,<skipped>,<jitter max us>,<exec max us>
+ * PCFG,<change>,<times>,<misses after it>,<s since>    (app_period.c Note #4)
+ * PHIST,<task>,jitter|exec,<bin low us>,<count>        빈 구간은 없음 (Note #3) */
+static void Console_CmdPeriod(CPU_INT08U argc, CPU_CHAR **argv) {
+    static const CPU_CHAR *const histName[APP_PERIOD_HIST_NBR] = {"jitter", "exec"};
+    APP_PERIOD_STATUS st;
+    APP_PERIOD_CFG cfg;
+    OS_ERR err;
+    CPU_BOOLEAN hist = DEF_NO;
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "clear") == 0)) {
+        AppPeriod_Clr();
+        Console_Printf("OK");
+        return;
+    }
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "hist") == 0)) {
+        hist = DEF_YES;
+    } else if (argc != 1u) {
+        Console_Printf("ERR usage: period [hist | clear]");
+        return;
+    }
+
+    for (CPU_INT08U ix = 0u; AppPeriod_StatusGet(ix, &st) == DEF_OK; ix++) {
+        if (hist == DEF_NO) {
+            Console_Printf("PERIOD,%s,%u,%u,%u,%u,%u,%u", st.name, (unsigned)st.period_us,
+                           (unsigned)st.stats.releases, (unsigned)st.stats.misses, (unsigned)st.stats.skipped,
+                           (unsigned)AppPeriod_TsToUs(st.stats.jitter_max),
+                           (unsigned)AppPeriod_TsToUs(st.stats.exec_max));
+            continue;
+        }
+        for (CPU_INT08U h = 0u; h < APP_PERIOD_HIST_NBR; h++) {
+            for (CPU_INT08U b = 0u; b < APP_CFG_PERIOD_HIST_BINS; b++) {
+                if (st.stats.hist[h][b] != 0u) {
+                    Console_Printf("PHIST,%s,%s,%u,%u", st.name, histName[h], (unsigned)AppPeriod_BinLo(b),
+                                   (unsigned)st.stats.hist[h][b]);
+                }
+            }
+        }
+    }
+    if (hist == DEF_NO) {
+        for (CPU_INT08U ix = 0u; AppPeriod_CfgGet(ix, &cfg) == DEF_OK; ix++) {
+            Console_Printf("PCFG,%s,%u,%u,%u", cfg.what, (unsigned)cfg.changes, (unsigned)cfg.misses,
+                           (unsigned)((OSTimeGet(&err) - cfg.tick) / OSCfg_TickRate_Hz));
+        }
+    }
+}
+
+#ifdef CPU_CFG_CS_PROF_EN
+static CPU_INT32U Console_CntsToUs(CPU_INT64U cnts) {
+    CPU_ERR err;
+    CPU_TS_TMR_FREQ freq = CPU_TS_TmrFreqGet(&err);
+
+    return (freq == 0u) ? 0u : (CPU_INT32U)(cnts * 1000000u / freq);
+}
+
+static CPU_INT64U Console_CsProfKey(const CPU_CS_SITE *p_site, CPU_BOOLEAN byTot) {
+    return (byTot == DEF_YES) ? p_site->Tot_cnts : (CPU_INT64U)p_site->Max_cnts;
+}
+
+/* (키, 주소) 내림차순으로 p_prev 다음 사이트, 없으면 0.  표를 복사할 스택이 없어 매번 목록을 훑음 */
+static CPU_CS_SITE *Console_CsProfNext(CPU_CS_SITE *p_list, CPU_BOOLEAN byTot, CPU_CS_SITE *p_prev,
+                                       CPU_INT64U prevKey, CPU_CS_SITE *p_copy) {
+    CPU_CS_SITE *p_best = (CPU_CS_SITE *)0;
+    CPU_CS_SITE site;
+    CPU_INT64U key, bestKey = 0u;
+
+    for (CPU_CS_SITE *p_site = p_list; p_site != (CPU_CS_SITE *)0; p_site = p_site->NextPtr) {
+        CPU_CS_ProfSiteRd(p_site, &site);
+        key = Console_CsProfKey(&site, byTot);
+        if ((site.Ctr == 0u) || ((p_prev != (CPU_CS_SITE *)0) &&
+                                 ((key > prevKey) || ((key == prevKey) && (p_site >= p_prev))))) {
+            continue;
+        }
+        if ((p_best == (CPU_CS_SITE *)0) || (key > bestKey) || ((key == bestKey) && (p_site > p_best))) {
+            p_best = p_site;
+            bestKey = key;
+            *p_copy = site;
+        }
+    }
+    return p_best;
+}
+
+/* 경로를 뺀 파일 이름 */
+static const CPU_CHAR *Console_BaseName(const CPU_CHAR *p_path) {
+    const CPU_CHAR *p_name = p_path;
+
+    for (; *p_path != '\0'; p_path++) {
+        if ((*p_path == '/') || (*p_path == '\\')) {
+            p_name = p_path + 1;
+        }
+    }
+    return p_name;
+}
+#endif
+
+/* CSPROF,<critical section sites>,<lock sites>,<locks not attributed>
+ * CSINT,<file>,<line>,<count>,<total us>,<max us>      CPU_CRITICAL_ENTER() 자리
+ * CSLOCK,0x<addr>,<count>,<total us>,<max us>          OSSchedLock() 의 복귀 주소 (addr2line 으로)
+ * 종류마다 max (또는 total) 이 큰 순서로 CONSOLE_CSPROF_ROWS 줄 ('cpu_core.c' CPU CRITICAL SECTION PROFILER) */
+static void Console_CmdCsProf(CPU_INT08U argc, CPU_CHAR **argv) {
+#ifdef CPU_CFG_CS_PROF_EN
+    CPU_CS_SITE *p_site, *p_list;
+    CPU_CS_SITE site;
+    CPU_INT64U key;
+    CPU_INT16U nbr[2];
+    CPU_BOOLEAN byTot = DEF_NO;
+    CPU_SR_ALLOC();
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "clear") == 0)) {
+        CPU_CS_ProfClr();
+        Console_Printf("OK");
+        return;
+    }
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "total") == 0)) {
+        byTot = DEF_YES;
+    } else if (argc != 1u) {
+        Console_Printf("ERR usage: csprof [total | clear]");
+        return;
+    }
+
+    for (CPU_INT08U kind = 0u; kind < 2u; kind++) {
+        nbr[kind] = 0u;
+        p_list = (kind == 0u) ? CPU_CS_ProfIntListPtr : CPU_CS_ProfLockListPtr;
+        for (p_site = p_list; p_site != (CPU_CS_SITE *)0; p_site = p_site->NextPtr) {
+            nbr[kind]++;
+        }
+    }
+    CPU_CRITICAL_ENTER();
+    key = CPU_CS_ProfLockOvfCtr;
+    CPU_CRITICAL_EXIT();
+    Console_Printf("CSPROF,%u,%u,%u", (unsigned)nbr[0], (unsigned)nbr[1], (unsigned)key);
+
+    for (CPU_INT08U kind = 0u; kind < 2u; kind++) {
+        p_list = (kind == 0u) ? CPU_CS_ProfIntListPtr : CPU_CS_ProfLockListPtr;
+        p_site = (CPU_CS_SITE *)0;
+        key = 0u;
+        for (CPU_INT08U row = 0u; row < CONSOLE_CSPROF_ROWS; row++) {
+            p_site = Console_CsProfNext(p_list, byTot, p_site, key, &site);
+            if (p_site == (CPU_CS_SITE *)0) {
+                break;
+            }
+            key = Console_CsProfKey(&site, byTot);
+            if (kind == 0u) {
+                Console_Printf("CSINT,%s,%u,%u,%u,%u", Console_BaseName(site.FilePtr), (unsigned)site.Line,
+                               (unsigned)site.Ctr, (unsigned)Console_CntsToUs(site.Tot_cnts),
+                               (unsigned)Console_CntsToUs(site.Max_cnts));
+            } else {
+                Console_Printf("CSLOCK,0x%08X,%u,%u,%u", (unsigned)(CPU_ADDR)site.AddrPtr, (unsigned)site.Ctr,
+                               (unsigned)Console_CntsToUs(site.Tot_cnts),
+                               (unsigned)Console_CntsToUs(site.Max_cnts));
+            }
+        }
+    }
+#else
+    (void)argc;
+    (void)argv;
+    Console_Printf("ERR csprof needs CPU_CFG_CS_PROF_EN");
+#endif
+}
+
+/* OBJSTAT,<objects>,<not listed>
+ * OBJ,<sem|mutex|q|flag>,<name>,<posts>,<pends>,<at once>,<blocked>,<waits>,<avg wait us>,<max wait us>,
+ *     <waiting now>,<max waiting>
+ * OSObjStatSnap() 한 번으로 찍은 같은 순간의 값 ('os.h' OBJECT CONTENTION STATISTICS) */
+static void Console_CmdObj(CPU_INT08U argc, CPU_CHAR **argv) {
+#if (OS_CFG_OBJ_STAT_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+    OS_OBJ_STAT_SNAP *p_snap;
+    const CPU_CHAR *p_type;
+    OS_OBJ_QTY nbr, total;
+    CPU_TS avg;
+    OS_ERR err;
+
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "clear") == 0)) {
+        OSObjStatReset(&err);
+        Console_Printf("OK");
+        return;
+    }
+    if (argc != 1u) {
+        Console_Printf("ERR usage: obj [clear]");
+        return;
+    }
+
+    nbr = OSObjStatSnap(ConsoleObjSnap, CONSOLE_OBJ_ROWS, &err);
+    total = (OS_OBJ_QTY)(OSSemQty + OSMutexQty + OSQQty + OSFlagQty);
+    Console_Printf("OBJSTAT,%u,%u", (unsigned)nbr, ((total > nbr) ? (unsigned)(total - nbr) : 0u));
+    for (OS_OBJ_QTY i = 0u; i < nbr; i++) {
+        p_snap = &ConsoleObjSnap[i];
+        switch (p_snap->Type) {
+            case OS_OBJ_TYPE_SEM:   p_type = "sem";   break;
+            case OS_OBJ_TYPE_MUTEX: p_type = "mutex"; break;
+            case OS_OBJ_TYPE_Q:     p_type = "q";     break;
+            default:                p_type = "flag";  break;
+        }
+        avg = (p_snap->Stat.WaitCtr == 0u) ? 0u : (CPU_TS)(p_snap->Stat.WaitTot / p_snap->Stat.WaitCtr);
+        Console_Printf("OBJ,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u", p_type,
+                       (p_snap->NamePtr != (CPU_CHAR *)0) ? p_snap->NamePtr : "?",
+                       (unsigned)p_snap->Stat.PostCtr, (unsigned)p_snap->Stat.PendCtr,
+                       (unsigned)p_snap->Stat.PendNowCtr, (unsigned)p_snap->Stat.PendBlkCtr,
+                       (unsigned)p_snap->Stat.WaitCtr, (unsigned)AppPeriod_TsToUs(avg),
+                       (unsigned)AppPeriod_TsToUs(p_snap->Stat.WaitMax), (unsigned)p_snap->Waiters,
+                       (unsigned)p_snap->Stat.WaitersMax);
+    }
+#else
+    (void)argc;
+    (void)argv;
+    Console_Printf("ERR obj needs OS_CFG_OBJ_STAT_EN and OS_CFG_DBG_EN");
+#endif
+}
+
+static void Console_CmdRender(CPU_INT08U argc, CPU_CHAR **argv) {
+    CPU_INT08U mode = APP_RENDER_TELEM + 1u;
+
+    if (argc == 2u) {
+        mode = Console_Lookup(argv[1], ConsoleRenderName, APP_RENDER_TELEM + 1u);
+    }
+    if (mode > APP_RENDER_TELEM) {
+        Console_Printf("ERR usage: render full|stats|off|telem");
+        return;
+    }
+    App_RenderModeSet((APP_RENDER_MODE)mode);
+    Console_Printf("OK");
+}
+
+/* JOURNAL,<state>,<octets>,<rounds>,<mismatches>,<repeats done>,<ms>,<full> */
+static void Console_JournalStatus(void) {
+    APP_REPLAY_STATUS st;
+
+    AppReplay_StatusGet(&st);
+    Console_Printf("JOURNAL,%s,%u,%u,%u,%u,%u,%u",
+                   ConsoleReplayName[st.state], (unsigned)st.len, (unsigned)st.rounds,
+                   (unsigned)st.mismatches, (unsigned)st.reps,
+                   (unsigned)((CPU_INT64U)st.ticks * 1000u / OSCfg_TickRate_Hz), (unsigned)st.full);
+}
+
+/* JDATA,<offset>,<hex>, 한 줄에 32 octet */
+static void Console_JournalDump(void) {
+    static const CPU_CHAR hex[] = "0123456789ABCDEF";
+    CPU_CHAR line[2u * 32u + 1u];
+    CPU_SIZE_T len;
+    const CPU_INT08U *p_jnl = AppReplay_Journal(&len);
+
+    for (CPU_SIZE_T off = 0u; off < len; off += 32u) {
+        CPU_SIZE_T n = (len - off < 32u) ? (len - off) : 32u;
+        for (CPU_SIZE_T k = 0u; k < n; k++) {
+            line[2u * k] = hex[p_jnl[off + k] >> 4];
+            line[2u * k + 1u] = hex[p_jnl[off + k] & 0x0Fu];
+        }
+        line[2u * n] = '\0';
+        Console_Printf("JDATA,%u,%s", (unsigned)off, line);
+    }
+    Console_Printf("OK");
+}
+
+static void Console_JournalLoad(CPU_CHAR *p_off, CPU_CHAR *p_hex) {
+    CPU_INT08U data[APP_CFG_CONSOLE_LINE_SIZE / 2u];
+    CPU_INT32U off;
+    CPU_SIZE_T n = 0u;
+
+    if (Console_ParseU32(p_off, &off) != DEF_OK) {
+        Console_Printf("ERR offset");
+        return;
+    }
+    for (; (p_hex[0] != '\0') && (p_hex[1] != '\0'); p_hex += 2) {
+        CPU_CHAR pair[3] = {p_hex[0], p_hex[1], '\0'};
+        CPU_CHAR *p_end;
+        data[n++] = (CPU_INT08U)Str_ParseNbr_Int32U(pair, &p_end, 16u);
+        if (*p_end != '\0') {
+            Console_Printf("ERR hex");
+            return;
+        }
+    }
+    if ((*p_hex != '\0') || (AppReplay_Load(off, data, n) != DEF_OK)) {
+        Console_Printf("ERR load (odd hex, gap, too long, or journal busy)");
+        return;
+    }
+    Console_Printf("OK");
+}
+
+static void Console_CmdJournal(CPU_INT08U argc, CPU_CHAR **argv) {
+    if (argc == 1u) {
+        Console_JournalStatus();
+        return;
+    }
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "rec") == 0)) {
+        AppReplay_RecStart();
+        Console_Printf("OK recording from the next round");
+        return;
+    }
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "stop") == 0)) {
+        AppReplay_Stop();
+        Console_JournalStatus();
+        return;
+    }
+    if ((argc == 2u) && (Str_CmpIgnoreCase(argv[1], "dump") == 0)) {
+        Console_JournalDump();
+        return;
+    }
+    if ((argc == 4u) && (Str_CmpIgnoreCase(argv[1], "load") == 0)) {
+        Console_JournalLoad(argv[2], argv[3]);
+        return;
+    }
+    if (Str_CmpIgnoreCase(argv[1], "play") == 0) {
+        CPU_BOOLEAN fast = DEF_NO;
+        CPU_INT32U repeat = 1u;
+        CPU_INT08U i = 2u;
+
+        if ((i < argc) && (Str_CmpIgnoreCase(argv[i], "fast") == 0)) {
+            fast = DEF_YES;
+            i++;
+        }
+        if ((i < argc) && (Console_ParseU32(argv[i++], &repeat) != DEF_OK)) {
+            Console_Printf("ERR repeat");
+            return;
+        }
+        if (i != argc) {
+            Console_Printf("ERR usage: journal play [fast] [repeat]");
+            return;
+        }
+        if (AppReplay_PlayStart(fast, repeat) != DEF_OK) {
+            Console_Printf("ERR no journal, or recording");
+            return;
+        }
+        Console_Printf("OK replaying from the next round");
+        return;
+    }
+    Console_Printf("ERR usage: journal [rec | stop | play [fast] [repeat] | dump | load <offset> <hex>]");
+}
+
+/*-------------------------------------------------------------*/
+/*  줄 해석 / 실행                                               */
+/*-------------------------------------------------------------*/
+static void Console_Exec(CPU_CHAR *p_line) {
+    CPU_CHAR *argv[CONSOLE_ARG_MAX];
+    CPU_INT08U argc = 0u;
+    CPU_CHAR *p = p_line;
+
+    while (*p != '\0') {
+        while (*p == ' ' || *p == '\t') *p++ = '\0';
+        if (*p == '\0') break;
+        if (argc == CONSOLE_ARG_MAX) {
+            Console_Printf("ERR too many arguments");
+            return;
+        }
+        argv[argc++] = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t') p++;
+    }
+    if (argc == 0u) {
+        return; /* 빈 줄 */
+    }
+
+    ConsoleStats.lines++;
+    for (CPU_INT08U i = 0u; i < sizeof ConsoleCmdTbl / sizeof ConsoleCmdTbl[0]; i++) {
+        if (Str_CmpIgnoreCase(argv[0], ConsoleCmdTbl[i].name) == 0) {
+            if ((ConsoleCmdTbl[i].cfg == DEF_YES) && (argc > 1u)) {
+                AppPeriod_CfgNote(ConsoleCmdTbl[i].name, argv[1]); /* 미스의 원인 후보 */
+            }
+            ConsoleCmdTbl[i].fnct(argc, argv);
+            return;
+        }
+    }
+    Console_Printf("ERR unknown command '%s' (try help)", argv[0]);
+}
+
+/* 한 바이트씩 줄 조립: CR 또는 LF 로 끝, BS/DEL 은 한 글자 지움 */
+static void Console_LineFeed(CPU_CHAR c) {
+    if (c == '\r' || c == '\n') {
+        if (ConsoleLineState == CONSOLE_LINE_LONG) {
+            ConsoleStats.longLines++;
+            Console_Printf("ERR line too long");
+        } else if (ConsoleLineState == CONSOLE_LINE_OK && ConsoleLineLen != 0u) {
+            ConsoleLine[ConsoleLineLen] = '\0';
+            Console_Exec(ConsoleLine);
+        }
+        ConsoleLineState = CONSOLE_LINE_OK;
+        ConsoleLineLen = 0u;
+        return;
+    }
+    if (ConsoleLineState != CONSOLE_LINE_OK) {
+        return;
+    }
+    if (c == '\b' || c == 0x7F) {
+        if (ConsoleLineLen != 0u) ConsoleLineLen--;
+        return;
+    }
+    if (ConsoleLineLen + 1u >= sizeof ConsoleLine) {
+        ConsoleLineState = CONSOLE_LINE_LONG;
+        return;
+    }
+    ConsoleLine[ConsoleLineLen++] = c;
+}
+
+/*-------------------------------------------------------------*/
+/*  콘솔 태스크                                                  */
+/*-------------------------------------------------------------*/
+static void AppTask_Console(void *p_arg) {
+    OS_ERR err;
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+        AppConsole_RxDrain();
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          AppConsole_Init()
+*
+* Description : Create the console task.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskCreate().
+*
+* Note(s)     : (1) The receiver must not be started (see Note #1 at the top of this file) before the
+*                   console task exists.
+*
+*               (2) The statistics dump uses the FPU (AppStats_Summarize()), so the task saves the FP
+*                   registers on a context switch.
+*********************************************************************************************************
+*/
+
+void AppConsole_Init(void) {
+    OS_ERR err;
+
+    OSTaskCreate(&ConsoleTCB, "AppTask_Console",
+                 AppTask_Console, 0u,
+                 APP_CFG_TASK_CONSOLE_PRIO,
+                 &ConsoleStk[0],
+                 APP_CFG_TASK_CONSOLE_STK_SIZE / 10u,
+                 APP_CFG_TASK_CONSOLE_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | OS_OPT_TASK_SAVE_FP, &err); /* Note #2 */
+}
+
+/*
+*********************************************************************************************************
+*                                        AppConsole_RxBufGet()
+*
+* Description : Get the receive buffer for the UART driver's circular DMA.
+*
+* Argument(s) : p_size      Pointer to a variable that receives the buffer size, in octets.
+*
+* Return(s)   : Pointer to the buffer.
+*
+* Caller(s)   : USART_RxDmaConfig().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT08U *AppConsole_RxBufGet(CPU_SIZE_T *p_size) {
+    *p_size = sizeof ConsoleRxBuf;
+    return &ConsoleRxBuf[0];
+}
+
+/*
+*********************************************************************************************************
+*                                        AppConsole_RxNotify()
+*
+* Description : Tell the console how far the receiver has written into the buffer.
+*
+* Argument(s) : wr_ix       Index of the next octet the receiver writes (buffer size - DMA NDTR).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : UART receive ISRs, AppConsole_FakeRx().
+*
+* Note(s)     : (1) See Note #2 at the top of this file.  Must be called at least twice per buffer lap.
+*********************************************************************************************************
+*/
+
+void AppConsole_RxNotify(CPU_SIZE_T wr_ix) {
+    OS_ERR err;
+    CPU_BOOLEAN more = DEF_NO;
+    CPU_SR_ALLOC();
+
+    if (wr_ix >= APP_CFG_CONSOLE_RX_BUF_SIZE) {
+        wr_ix = 0u;
+    }
+    CPU_CRITICAL_ENTER();
+    if (wr_ix != ConsoleRxWrIx) {
+        ConsoleRxWrPos += (wr_ix > ConsoleRxWrIx)
+                              ? (CPU_INT32U)(wr_ix - ConsoleRxWrIx)
+                              : (CPU_INT32U)(wr_ix + APP_CFG_CONSOLE_RX_BUF_SIZE - ConsoleRxWrIx); /* 한 바퀴 돎 */
+        ConsoleRxWrIx = wr_ix;
+        more = DEF_YES;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (more == DEF_YES) {
+        OSTaskSemPost(&ConsoleTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                        AppConsole_RxDrain()
+*
+* Description : Parse and execute everything received so far.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_Console(), host tests.
+*
+* Note(s)     : (1) Replies are sent with COM1 held by App_TermLock(), so they are not cut by a frame.
+*********************************************************************************************************
+*/
+
+void AppConsole_RxDrain(void) {
+    CPU_INT32U wrPos;
+    CPU_SIZE_T wrIx;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    wrPos = ConsoleRxWrPos;
+    wrIx = ConsoleRxWrIx;
+    CPU_CRITICAL_EXIT();
+
+    App_TermLock();
+    if (wrPos - ConsoleRxRdPos > APP_CFG_CONSOLE_RX_BUF_SIZE) { /* 덮어써짐: 다음 줄부터 다시 */
+        ConsoleStats.overruns++;
+        ConsoleRxRdPos = wrPos;
+        ConsoleRxRdIx = wrIx;
+        ConsoleLineLen = 0u;
+        ConsoleLineState = CONSOLE_LINE_RESYNC;
+        Console_Printf("ERR rx overrun");
+    }
+    while (ConsoleRxRdPos != wrPos) {
+        CPU_CHAR c = (CPU_CHAR)ConsoleRxBuf[ConsoleRxRdIx];
+        if (++ConsoleRxRdIx == APP_CFG_CONSOLE_RX_BUF_SIZE) {
+            ConsoleRxRdIx = 0u;
+        }
+        ConsoleRxRdPos++;
+        ConsoleStats.rxBytes++;
+        Console_LineFeed(c);
+    }
+    App_TermUnlock();
+}
+
+/*
+*********************************************************************************************************
+*                                        AppConsole_StatsGet()
+*
+* Description : Get the console receive statistics.
+*
+* Argument(s) : p_stats     Pointer to the statistics copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppConsole_StatsGet(APP_CONSOLE_STATS *p_stats) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_stats = ConsoleStats;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                         AppConsole_FakeRx()
+*
+* Description : Receive octets from software instead of the UART.
+*
+* Argument(s) : p_data      Pointer to the octets.
+*
+*               len         Number of octets.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Host tests, Application.
+*
+* Note(s)     : (1) See Note #3 at the top of this file.  The DMA receiver must not be running.
+*********************************************************************************************************
+*/
+
+#if (APP_CFG_CONSOLE_FAKE_UART_EN == DEF_ENABLED)
+void AppConsole_FakeRx(const CPU_CHAR *p_data, CPU_SIZE_T len) {
+    CPU_SIZE_T ix = ConsoleRxWrIx;
+
+    while (len-- != 0u) {
+        ConsoleRxBuf[ix] = (CPU_INT08U)*p_data++;
+        if (++ix == APP_CFG_CONSOLE_RX_BUF_SIZE) {
+            ix = 0u;
+        }
+        if ((ix % (APP_CFG_CONSOLE_RX_BUF_SIZE / 2u)) == 0u) { /* DMA 반/끝 인터럽트 흉내 */
+            AppConsole_RxNotify(ix);
+        }
+    }
+    AppConsole_RxNotify(ix); /* idle-line */
+}
+#endif
@@ -0,0 +1,53 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_console.h
+* Description   : Line based command console on COM1, fed by a circular DMA receive buffer.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_CONSOLE_MODULE_PRESENT
+#define  APP_CONSOLE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U rxBytes;    /* 받은 바이트                           */
+    CPU_INT32U lines;      /* 실행한 명령 줄                         */
+    CPU_INT32U overruns;   /* 태스크가 DMA 를 못 따라가 버린 횟수      */
+    CPU_INT32U longLines;  /* APP_CFG_CONSOLE_LINE_SIZE 넘어 버린 줄   */
+} APP_CONSOLE_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppConsole_Init     (void);
+
+CPU_INT08U  *AppConsole_RxBufGet (CPU_SIZE_T         *p_size);
+
+void         AppConsole_RxNotify (CPU_SIZE_T          wr_ix);
+
+void         AppConsole_RxDrain  (void);
+
+void         AppConsole_StatsGet (APP_CONSOLE_STATS  *p_stats);
+
+#if (APP_CFG_CONSOLE_FAKE_UART_EN == DEF_ENABLED)
+void         AppConsole_FakeRx   (const CPU_CHAR     *p_data,
+                                  CPU_SIZE_T          len);
+#endif
+
+
+#endif
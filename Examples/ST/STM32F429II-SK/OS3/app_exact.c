@@ -0,0 +1,230 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_exact.c
+* Description   : Exact win probabilities of generalized Monty Hall games, as rationals, and their
+*                 comparison with measured statistics.
+*
+* Note(s)       : (1) A game has N doors; the player picks door j, the host opens k of the other N - 1
+*                     doors, 0 <= k <= N - 2, and the player stays or switches to one of the c = N - 1 - k
+*                     other closed doors at random.  The host either knows where the prize is and only opens
+*                     goat doors (APP_EXACT_HOST_KNOWS), or opens doors at random (APP_EXACT_HOST_BLIND); a
+*                     round in which a blind host reveals the prize does not count.  The classic game is
+*                     N = 3, k = 1 with a knowing host; the batch simulation is k = N - 2 with a knowing host.
+*
+*                 (2) The prize is behind door i with probability w[i] / W, W = sum of the weights.  The
+*                     host's choices are symmetric, so there is a closed form.  With P = 1 / (W (N - 1) c) :
+*
+*                                        knowing host               blind host
+*                         stay   wins    w[j] (N - 1) c  P          w[j] (N - 1) c  P
+*                         switch wins    (W - w[j]) (N - 1)  P      (W - w[j]) c  P
+*                         round counts   1                          (w[j] (N - 1) c + (W - w[j]) c^2)  P
+*
+*                     and the win probability of a strategy is its 'wins' term over 'round counts'.  With
+*                     a blind host the prize, when not behind j, stays closed with probability c / (N - 1);
+*                     for N = 3 and k = 1 both strategies win 1/2.  With a random first pick the terms are
+*                     summed over j before dividing.  Everything is exact in 64-bit integers: the
+*                     denominators stay below 2^28 for 8 doors and 16-bit weights.
+*
+*                 (3) With biased weights and a knowing host these are the probabilities over all rounds,
+*                     which is what the statistics measure; the odds given the particular doors the host
+*                     opened can differ.
+*
+*                 (4) AppExact_Check() compares a measured cell with the exact value.  The estimate is
+*                     'within' the tolerance when its whole Wilson interval (APP_CFG_STATS_Z_X100) lies in
+*                     exact +/- tolerance, so that a batch stopped on it has both the accuracy and the
+*                     confidence asked for.  A biased simulation therefore never converges.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_exact.h"
+
+/*-------------------------------------------------------------*/
+/*  분수                                                        */
+/*-------------------------------------------------------------*/
+static CPU_INT64U Exact_Gcd(CPU_INT64U a, CPU_INT64U b) {
+    while (b != 0u) {
+        CPU_INT64U t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static void Exact_Ratio(APP_EXACT_RATIO *p_ratio, CPU_INT64U num, CPU_INT64U den) {
+    CPU_INT64U g = Exact_Gcd(num, den); /* den > 0 이므로 g > 0 */
+
+    p_ratio->num = num / g;
+    p_ratio->den = den / g;
+}
+
+static CPU_INT32U Exact_FpToPpm(CPU_FP32 ratio) {
+    if (ratio <= 0.0f) return 0u;
+    if (ratio >= 1.0f) return APP_EXACT_PPM_ONE;
+    return (CPU_INT32U)(ratio * (CPU_FP32)APP_EXACT_PPM_ONE + 0.5f);
+}
+
+/*
+*********************************************************************************************************
+*                                        AppExact_ModelInit()
+*
+* Description : Set a model to the game the batch simulates: a knowing host opening every goat door but
+*               one, with the prize equally likely behind each door.
+*
+* Argument(s) : p_model     Pointer to the model.
+*
+*               doors       APP_EXACT_DOORS_MIN .. APP_EXACT_DOORS_MAX.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Change 'reveals', 'host' or 'weight[]' afterwards for the other variants.
+*********************************************************************************************************
+*/
+
+void AppExact_ModelInit(APP_EXACT_MODEL *p_model, CPU_INT08U doors) {
+    Mem_Clr(p_model, sizeof *p_model);
+    p_model->doors = doors;
+    p_model->reveals = (CPU_INT08U)(doors - 2u);
+    p_model->host = APP_EXACT_HOST_KNOWS;
+}
+
+/*
+*********************************************************************************************************
+*                                           AppExact_Eval()
+*
+* Description : Compute the exact win probabilities of both strategies.
+*
+* Argument(s) : p_model     Pointer to the model.
+*
+*               pick        First pick, 1 .. doors, or APP_EXACT_PICK_ANY for a uniformly random one.
+*
+*               p_result    Pointer to the result, fractions in lowest terms.
+*
+* Return(s)   : DEF_OK,   if the result is valid.
+*
+*               DEF_FAIL, if the model or the pick is out of range.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #2 at the top of this file.  A few dozen integer operations, no loop over
+*                   rounds or host choices.  Some round always counts (c >= 1), so 'valid' is never 0.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppExact_Eval(const APP_EXACT_MODEL *p_model, CPU_INT08U pick, APP_EXACT_RESULT *p_result) {
+    CPU_INT08U n = p_model->doors;
+    CPU_INT64U w[APP_EXACT_DOORS_MAX];
+    CPU_INT64U sum_w = 0u, c, stay = 0u, sw = 0u, valid = 0u, total = 0u;
+    CPU_INT08U j_first, j_last;
+
+    if ((n < APP_EXACT_DOORS_MIN) || (n > APP_EXACT_DOORS_MAX) || (p_model->reveals > n - 2u) ||
+        (p_model->host > APP_EXACT_HOST_BLIND)) {
+        return DEF_FAIL;
+    }
+    if (pick == APP_EXACT_PICK_ANY) {
+        j_first = 0u;
+        j_last = (CPU_INT08U)(n - 1u);
+    } else if ((pick >= 1u) && (pick <= n)) {
+        j_first = (CPU_INT08U)(pick - 1u);
+        j_last = j_first;
+    } else {
+        return DEF_FAIL;
+    }
+
+    for (CPU_INT08U i = 0u; i < n; i++) {
+        w[i] = p_model->weight[i];
+        sum_w += w[i];
+    }
+    if (sum_w == 0u) { /* 균등 (Note #2) */
+        for (CPU_INT08U i = 0u; i < n; i++) {
+            w[i] = 1u;
+        }
+        sum_w = n;
+    }
+
+    c = (CPU_INT64U)(n - 1u - p_model->reveals); /* 바꿀 수 있는 닫힌 문 */
+    for (CPU_INT08U j = j_first; j <= j_last; j++) {
+        CPU_INT64U other = sum_w - w[j];
+
+        stay += w[j] * (n - 1u) * c;
+        total += sum_w * (n - 1u) * c;
+        if (p_model->host == APP_EXACT_HOST_KNOWS) {
+            sw += other * (n - 1u);
+            valid += sum_w * (n - 1u) * c;
+        } else {
+            sw += other * c;
+            valid += w[j] * (n - 1u) * c + other * c * c;
+        }
+    }
+
+    Exact_Ratio(&p_result->win[APP_STATS_STRAT_STAY], stay, valid);
+    Exact_Ratio(&p_result->win[APP_STATS_STRAT_SWITCH], sw, valid);
+    Exact_Ratio(&p_result->valid, valid, total);
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                           AppExact_Ppm()
+*
+* Description : Convert an exact ratio in [0, 1] to rounded parts per million.
+*
+* Argument(s) : p_ratio     Pointer to the ratio.
+*
+* Return(s)   : 0 .. APP_EXACT_PPM_ONE.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U AppExact_Ppm(const APP_EXACT_RATIO *p_ratio) {
+    return (CPU_INT32U)((p_ratio->num * APP_EXACT_PPM_ONE + p_ratio->den / 2u) / p_ratio->den);
+}
+
+/*
+*********************************************************************************************************
+*                                          AppExact_Check()
+*
+* Description : Compare a measured statistics cell with an exact probability.
+*
+* Argument(s) : p_exact     Pointer to the exact probability.
+*
+*               p_cell      Pointer to the measured rounds and wins.
+*
+*               tol         Tolerance (ppm).
+*
+*               p_chk       Pointer to the comparison.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_Batch(), Application.
+*
+* Note(s)     : (1) See Note #4 at the top of this file.  An empty cell is never within.
+*********************************************************************************************************
+*/
+
+void AppExact_Check(const APP_EXACT_RATIO *p_exact, const APP_STATS_CELL *p_cell, CPU_INT32U tol,
+                    APP_EXACT_CHECK *p_chk) {
+    APP_STATS_SUMMARY sum;
+
+    AppStats_Summarize(p_cell, &sum);
+    p_chk->exact = AppExact_Ppm(p_exact);
+    p_chk->est = Exact_FpToPpm(sum.mean);
+    p_chk->ciLo = Exact_FpToPpm(sum.ciLo);
+    p_chk->ciHi = Exact_FpToPpm(sum.ciHi);
+    p_chk->rounds = sum.rounds;
+    p_chk->within = ((sum.rounds != 0u) &&
+                     (p_chk->ciLo + tol >= p_chk->exact) &&
+                     (p_chk->ciHi <= p_chk->exact + tol)) ? DEF_YES : DEF_NO;
+}
@@ -0,0 +1,89 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_exact.h
+* Description   : Exact win probabilities of generalized Monty Hall games, as rationals, and their
+*                 comparison with measured statistics.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_EXACT_MODULE_PRESENT
+#define  APP_EXACT_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_EXACT_HOST_KNOWS                              0u   /* Host only opens goat doors.                          */
+#define  APP_EXACT_HOST_BLIND                              1u   /* Host opens doors at random, may reveal the prize.    */
+
+#define  APP_EXACT_DOORS_MIN                               3u
+#define  APP_EXACT_DOORS_MAX             APP_CFG_STATS_PICK_MAX
+
+#define  APP_EXACT_PICK_ANY              APP_STATS_ALL          /* First pick uniformly at random.                      */
+
+#define  APP_EXACT_PPM_ONE                           1000000u
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT08U  doors;                        /* APP_EXACT_DOORS_MIN .. _MAX                        */
+    CPU_INT08U  reveals;                      /* 호스트가 여는 문 수, 0 .. doors - 2                 */
+    CPU_INT08U  host;                         /* APP_EXACT_HOST_xxx                                 */
+    CPU_INT16U  weight[APP_EXACT_DOORS_MAX];  /* 상품 위치의 사전 가중치, 전부 0 = 균등 (Note #2)   */
+} APP_EXACT_MODEL;
+
+typedef struct {
+    CPU_INT64U  num;                          /* 기약분수 num / den                                 */
+    CPU_INT64U  den;
+} APP_EXACT_RATIO;
+
+typedef struct {
+    APP_EXACT_RATIO  win[APP_STATS_STRAT_NBR];  /* 전략별 승률, 무효 판을 뺀 조건부 확률            */
+    APP_EXACT_RATIO  valid;                     /* 유효한 판의 비율 (상품이 열리면 무효)             */
+} APP_EXACT_RESULT;
+
+typedef struct {
+    CPU_INT32U   exact;   /* 정확한 승률 (ppm)                          */
+    CPU_INT32U   est;     /* 측정 승률 (ppm)                            */
+    CPU_INT32U   ciLo;    /* Wilson 신뢰구간 (ppm)                      */
+    CPU_INT32U   ciHi;
+    CPU_INT64U   rounds;
+    CPU_BOOLEAN  within;  /* 신뢰구간 전체가 exact ± 허용오차 안         */
+} APP_EXACT_CHECK;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppExact_ModelInit(APP_EXACT_MODEL         *p_model,
+                                CPU_INT08U               doors);
+
+CPU_BOOLEAN  AppExact_Eval     (const APP_EXACT_MODEL   *p_model,
+                                CPU_INT08U               pick,
+                                APP_EXACT_RESULT        *p_result);
+
+CPU_INT32U   AppExact_Ppm      (const APP_EXACT_RATIO   *p_ratio);
+
+void         AppExact_Check    (const APP_EXACT_RATIO   *p_exact,
+                                const APP_STATS_CELL    *p_cell,
+                                CPU_INT32U               tol,
+                                APP_EXACT_CHECK         *p_chk);
+
+
+#endif
@@ -0,0 +1,258 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_frame.c
+* Description   : Lazily built, bounded cache of the game screen's door/marker/cursor frames.
+*
+* Note(s)       : (1) The part of the screen between the title banner and the statistics line (the
+*                     "body") only depends on a few visible values: the three door states, the door
+*                     marked with ▲ (or no marker row) and the door under the ★ cursor.  These are packed
+*                     into a key (Frame_Key()); the body text for a key never changes.
+*
+*                 (2) Only a few dozen keys are reachable in a game, and a round visits about six.  Bodies
+*                     are built on first use into APP_CFG_FRAME_CACHE_SIZE slots of
+*                     APP_CFG_FRAME_BODY_SIZE octets; the least recently used slot is reused when the
+*                     cache is full.
+*
+*                 (3) Only AppTask_GAME renders, so the cache needs no locking.
+*
+*                 (4) The longest body is FRAME_BODY_LEN_MAX octets :
+*
+*                         2 border rows    2 * (3 + 3 * (23 + 7) + 2)    190
+*                         3 middle rows    3 * (3 + 3 * (22 + 7) + 2)    276   ($$$$$ / EMPTY / GOAT!)
+*                         door numbers                                    42
+*                         ▲ marker row     8 + 18 + 16 + 2                44
+*                         ★ cursor row     8 + 20 + 16 + 4                48
+*                                                                        ---
+*                                                                        600
+*
+*                     APP_CFG_FRAME_BODY_SIZE is checked against it at build time.  Should the art grow
+*                     past it, Frame_Append() traps instead of cutting the body short.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_frame.h"
+
+#define FRAME_BODY_LEN_MAX  600u /* Note #4 */
+
+#if (APP_CFG_FRAME_BODY_SIZE < (FRAME_BODY_LEN_MAX + 1u))
+#error  "APP_CFG_FRAME_BODY_SIZE  illegally #define'd in 'app_cfg.h' [MUST be  >= FRAME_BODY_LEN_MAX + 1]"
+#endif
+
+typedef struct {
+    CPU_INT16U key;
+    CPU_INT16U len;     /* 0 = 빈 슬롯 */
+    CPU_INT32U lastUse; /* LRU 용 사용 순번 */
+    char body[APP_CFG_FRAME_BODY_SIZE];
+} FRAME_SLOT;
+
+/* ─── 화면 모델 ─────────────────────────────────────────── */
+static const char *const doorArt[4][5] = {
+    /* DOOR_CLOSED */
+    {
+        " ┌─────┐ ",
+        " │     │ ",
+        " │  ?  │ ",
+        " │     │ ",
+        " └─────┘ "},
+    /* DOOR_OPEN_GOAT */
+    {
+        " ┌─────┐ ",
+        " │     │ ",
+        " │\033[34mGOAT!\033[0m│ ",
+        " │     │ ",
+        " └─────┘ "},
+    /* DOOR_OPEN_PRIZE */
+    {
+        " ┌─────┐ ",
+        " │\033[33m$$$$$\033[0m│ ",
+        " │\033[33m$$$$$\033[0m│ ",
+        " │\033[33m$$$$$\033[0m│ ",
+        " └─────┘ "},
+    /* DOOR_OPEN_FAIL  ★ */
+    {
+        " ┌─────┐ ",
+        " │\033[31mXXXXX\033[0m│ ",
+        " │\033[31mEMPTY\033[0m│ ",
+        " │\033[31mXXXXX\033[0m│ ",
+        " └─────┘ "}};
+
+static FRAME_SLOT FrameCache[APP_CFG_FRAME_CACHE_SIZE];
+static CPU_INT32U FrameUseCtr;
+static APP_FRAME_STATS FrameStats;
+
+/*-------------------------------------------------------------*/
+/*  화면에 보이는 값만으로 키 만들기 (Note #1)                     */
+/*-------------------------------------------------------------*/
+/* bit 0-5 : doors[1..3] (2 bit 씩)
+ * bit 6-7 : ▲ 표시 문 (0 = 없음)
+ * bit 8   : ▲ 줄 자체가 있는지 (SELECT 단계에는 없음)
+ * bit 9-10: ★ 커서 문 (0 = 없음) */
+static CPU_INT16U Frame_Key(const GameState_t *gs) {
+    CPU_INT16U key = 0u;
+    uint8_t markDoor = 0u;
+    uint8_t starDoor = 0u;
+    CPU_BOOLEAN markRow = DEF_NO;
+
+    for (uint8_t d = 1; d <= 3; d++) {
+        key |= (CPU_INT16U)((gs->doors[d] & 3u) << ((d - 1u) * 2u));
+    }
+
+    if (gs->phase == PHASE_REVEAL || gs->phase == PHASE_RESULT) {
+        markRow = DEF_YES;
+        markDoor = (gs->phase == PHASE_REVEAL) ? gs->userChoice
+                                               : gs->finalDoorChoice;
+    }
+
+    if (gs->phase == PHASE_SELECT) {
+        starDoor = gs->cursorDoor; /* 선택 단계 */
+    } else if (gs->phase == PHASE_REVEAL) {
+        /* 열리지 않은 두 문 중 하나에만 커서 */
+        uint8_t altDoor = 6 - gs->userChoice - gs->hostChoice; /* 남은 다른 문 */
+        starDoor = (gs->cursorSwitch ? altDoor : gs->userChoice);
+    }
+
+    key |= (CPU_INT16U)((markDoor & 3u) << 6);
+    key |= (CPU_INT16U)((markRow == DEF_YES) ? DEF_BIT_08 : 0u);
+    key |= (CPU_INT16U)((starDoor & 3u) << 9);
+    return key;
+}
+
+/*-------------------------------------------------------------*/
+/*  프레임 본문 생성                                              */
+/*-------------------------------------------------------------*/
+static CPU_SIZE_T Frame_Append(FRAME_SLOT *p_slot, CPU_SIZE_T len, const char *str) {
+    while (*str != '\0') {
+        if (len >= sizeof(p_slot->body) - 1u) { /* 잘린 화면 대신 정지 (Note #4) */
+            CPU_SW_EXCEPTION(len);
+        }
+        p_slot->body[len++] = *str++;
+    }
+    return len;
+}
+
+static void Frame_Build(FRAME_SLOT *p_slot, CPU_INT16U key) {
+    CPU_SIZE_T len = 0u;
+    uint8_t markDoor = (uint8_t)((key >> 6) & 3u);
+    CPU_BOOLEAN markRow = DEF_BIT_IS_SET(key, DEF_BIT_08);
+    uint8_t starDoor = (uint8_t)((key >> 9) & 3u);
+
+    /* ─ 3개 문, 5줄에 걸쳐 출력 ─ */
+    for (int row = 0; row < 5; ++row) {
+        for (int d = 1; d <= 3; ++d) {
+            if (d == 1) len = Frame_Append(p_slot, len, "   ");
+            len = Frame_Append(p_slot, len, doorArt[(key >> ((d - 1) * 2)) & 3u][row]);
+            len = Frame_Append(p_slot, len, "       "); /* 문 간 간격 */
+        }
+        len = Frame_Append(p_slot, len, "\r\n");
+    }
+
+    len = Frame_Append(p_slot, len, "       1               2               3\r\n");
+
+    if (markRow == DEF_YES) {
+        for (uint8_t i = 1; i <= 3; i++) {
+            if (i == 1)
+                len = Frame_Append(p_slot, len, i == markDoor ? "       ▲" : "        ");
+            else
+                len = Frame_Append(p_slot, len, i == markDoor ? "               ▲" : "                ");
+        }
+        len = Frame_Append(p_slot, len, "\r\n");
+    } else {
+        len = Frame_Append(p_slot, len, " \r\n");
+    }
+
+    /* ─ 커서(★) 줄 ───────────────────────────────────── */
+    for (uint8_t i = 1; i <= 3; i++) {
+        bool showStar = (i == starDoor);
+
+        if (i == 1)
+            len = Frame_Append(p_slot, len, showStar ? "       ★" : "        ");
+        else
+            len = Frame_Append(p_slot, len, showStar ? "               ★  " : "                ");
+    }
+    len = Frame_Append(p_slot, len, "\r\n\r\n"); /* 끝난 뒤 공백 줄 */
+
+    p_slot->body[len] = '\0';
+    p_slot->len = (CPU_INT16U)len;
+    p_slot->key = key;
+}
+
+/*
+*********************************************************************************************************
+*                                           AppFrame_Body()
+*
+* Description : Return the body text (doors, door numbers, ▲ marker row and ★ cursor row) for a game
+*               state snapshot, building it into the cache on first use.
+*
+* Argument(s) : gs          Game state snapshot.
+*
+* Return(s)   : Pointer to the NUL-terminated body text.  Valid until the next call.
+*
+* Caller(s)   : RenderScreen().
+*
+* Note(s)     : (1) See the notes at the top of this file.
+*********************************************************************************************************
+*/
+
+const char *AppFrame_Body(const GameState_t *gs) {
+    CPU_TS t0 = OS_TS_GET();
+    CPU_INT16U key = Frame_Key(gs);
+    FRAME_SLOT *p_victim = &FrameCache[0];
+    CPU_TS dt;
+
+    FrameUseCtr++;
+    for (CPU_INT08U i = 0u; i < APP_CFG_FRAME_CACHE_SIZE; i++) {
+        FRAME_SLOT *p_slot = &FrameCache[i];
+
+        if (p_slot->len != 0u && p_slot->key == key) { /* 히트 */
+            p_slot->lastUse = FrameUseCtr;
+            FrameStats.hits++;
+            dt = OS_TS_GET() - t0;
+            if (dt > FrameStats.hitMax) FrameStats.hitMax = dt;
+            return p_slot->body;
+        }
+        if (p_slot->len == 0u) { /* 빈 슬롯 우선 */
+            if (p_victim->len != 0u) p_victim = p_slot;
+        } else if (p_victim->len != 0u && p_slot->lastUse < p_victim->lastUse) {
+            p_victim = p_slot;
+        }
+    }
+
+    if (p_victim->len != 0u) {
+        FrameStats.evictions++;
+    }
+    Frame_Build(p_victim, key);
+    p_victim->lastUse = FrameUseCtr;
+    FrameStats.misses++;
+    dt = OS_TS_GET() - t0;
+    if (dt > FrameStats.buildMax) FrameStats.buildMax = dt;
+    return p_victim->body;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppFrame_StatsGet()
+*
+* Description : Copy the frame cache statistics.
+*
+* Argument(s) : p_stats     Pointer to the structure that receives the statistics.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : RenderScreen().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppFrame_StatsGet(APP_FRAME_STATS *p_stats) {
+    *p_stats = FrameStats;
+    p_stats->ramSize = (CPU_INT32U)sizeof(FrameCache);
+}
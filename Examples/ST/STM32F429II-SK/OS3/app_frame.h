@@ -0,0 +1,44 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_frame.h
+* Description   : Lazily built, bounded cache of the game screen's door/marker/cursor frames.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_FRAME_MODULE_PRESENT
+#define  APP_FRAME_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U hits;      /* 캐시에서 찾은 프레임 수              */
+    CPU_INT32U misses;    /* 새로 만든 프레임 수                  */
+    CPU_INT32U evictions; /* 자리가 없어 밀려난 프레임 수         */
+    CPU_TS     buildMax;  /* 미스: 프레임 생성 최대 시간 (CPU_TS) */
+    CPU_TS     hitMax;    /* 히트: 조회 최대 시간 (CPU_TS)        */
+    CPU_INT32U ramSize;   /* 캐시가 차지하는 RAM (바이트)         */
+} APP_FRAME_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+const char  *AppFrame_Body     (const GameState_t  *gs);
+
+void         AppFrame_StatsGet (APP_FRAME_STATS    *p_stats);
+
+
+#endif
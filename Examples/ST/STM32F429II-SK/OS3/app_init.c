@@ -0,0 +1,294 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_init.c
+* Description   : Staged start-up: initialization steps with dependencies, run now, in the background or
+*                 on demand, each one time stamped for a boot report.
+*
+* Note(s)       : (1) The application declares its start-up as a table of stages (see AppInitTbl[] in
+*                     'app.c').  AppInit_Start() runs the APP_INIT_MODE_NOW stages in table order, then
+*                     creates the init task at APP_CFG_TASK_INIT_PRIO, below every game task, which runs the
+*                     APP_INIT_MODE_BG stages and deletes itself.  APP_INIT_MODE_LAZY stages only run when
+*                     somebody needs them.  The game tasks are created by a NOW stage and call AppInit_Need()
+*                     for what they use, so the first frame does not wait for start-up work it does not need.
+*
+*                 (2) AppInit_Need() returns once the stage is done.  A stage that has not started is run
+*                     right away in the calling task, after its dependencies; a stage that another task is
+*                     running is waited for on an event flag.  Dependencies may only name earlier stages, so
+*                     there can be no cycle; later ones are ignored.  Once a stage is done the call costs one
+*                     test of a bit mask.  AppInit_Need() must not be called from an ISR, with the scheduler
+*                     locked or before AppInit_Start().
+*
+*                 (3) Time stamps are CPU_TS, i.e. DWT cycles since CPU_Init() cleared the counter in main().
+*                     The microsecond times are summed piecewise at the clock of the time, since BSP_Init()
+*                     moves the CPU from the 16 MHz HSI to the PLL; only the stage that switches the clock
+*                     is approximate.  The 32-bit counter wraps after some 25 s at full speed, so the report
+*                     only makes sense for a start-up shorter than that.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_init.h"
+
+BSP_CCM_DATA static OS_TCB InitTCB;
+BSP_CCM_DATA static CPU_STK InitStk[APP_CFG_TASK_INIT_STK_SIZE];
+
+static OS_FLAG_GRP InitFlags;    /* 단계가 끝나면 그 번호의 비트 */
+static const APP_INIT_STAGE *InitTbl;
+static CPU_INT08U InitNbr;
+static APP_INIT_REPORT InitRpt[APP_INIT_STAGE_MAX];
+static volatile CPU_INT32U InitDone;   /* 끝난 단계, AppInit_Need() 빠른 길 */
+
+static CPU_TS InitTs;                  /* 마지막으로 잰 CPU_TS          */
+static CPU_INT32U InitUs;              /* 그 시각 (us)                   */
+static CPU_INT32U InitTsPerUs;         /* 그 뒤 CPU 클록 (MHz)           */
+static CPU_INT32U InitFrameUs;
+static CPU_INT32U InitBgUs;
+
+/*-------------------------------------------------------------*/
+/*  시각 (Note #3)                                              */
+/*-------------------------------------------------------------*/
+static CPU_INT32U Init_TimeUs(CPU_TS *p_ts) {
+    CPU_INT32U ts_per_us = BSP_CPU_ClkFreq() / 1000000u;
+    CPU_INT32U us;
+    CPU_TS ts;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    ts = OS_TS_GET();
+    us = (ts - InitTs) / InitTsPerUs;
+    InitTs += us * InitTsPerUs; /* 나머지는 다음 구간으로 */
+    InitUs += us;
+    InitTsPerUs = ts_per_us;
+    us = InitUs;
+    CPU_CRITICAL_EXIT();
+
+    if (p_ts != (CPU_TS *)0) {
+        *p_ts = ts;
+    }
+    return us;
+}
+
+/*-------------------------------------------------------------*/
+/*  단계 실행                                                    */
+/*-------------------------------------------------------------*/
+static void Init_Run(CPU_INT08U id) {
+    APP_INIT_REPORT *p_rpt = &InitRpt[id];
+    CPU_INT32U deps = InitTbl[id].deps & (DEF_BIT(id) - 1u); /* 앞 단계만 (Note #2) */
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    for (CPU_INT08U dep = 0u; deps != 0u; dep++, deps >>= 1) {
+        if ((deps & 1u) != 0u) {
+            AppInit_Need(dep);
+        }
+    }
+
+#if (OS_CFG_DBG_EN > 0u)
+    p_rpt->task = OSTCBCurPtr->NamePtr;
+#endif
+    p_rpt->us_start = Init_TimeUs(&p_rpt->ts_start);
+    InitTbl[id].fnct();
+    p_rpt->us_end = Init_TimeUs(&p_rpt->ts_end);
+
+    CPU_CRITICAL_ENTER();
+    p_rpt->state = APP_INIT_STATE_DONE;
+    InitDone |= DEF_BIT(id);
+    CPU_CRITICAL_EXIT();
+    (void)OSFlagPost(&InitFlags, DEF_BIT(id), OS_OPT_POST_FLAG_SET, &err);
+}
+
+/*-------------------------------------------------------------*/
+/*  초기화 태스크 (Note #1)                                       */
+/*-------------------------------------------------------------*/
+static void AppTask_Init(void *p_arg) {
+    (void)p_arg;
+
+    for (CPU_INT08U id = 0u; id < InitNbr; id++) {
+        if (InitTbl[id].mode == APP_INIT_MODE_BG) {
+            AppInit_Need(id);
+        }
+    }
+    InitBgUs = DEF_MAX(Init_TimeUs((CPU_TS *)0), 1u); /* 0 = 아직 */
+    /* 돌아가면 커널이 태스크를 지움 (OS_TaskReturn()) */
+}
+
+/*
+*********************************************************************************************************
+*                                          AppInit_Start()
+*
+* Description : Run the immediate stages of a start-up table and start the init task for the others.
+*
+* Argument(s) : p_tbl       Stage table; stays in use, so it must be static.
+*
+*               nbr         Number of stages, at most APP_INIT_STAGE_MAX.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskStart().
+*
+* Note(s)     : (1) Called once, from a task: the NOW stages may wait for each other (Note #2 above).
+*********************************************************************************************************
+*/
+
+void AppInit_Start(const APP_INIT_STAGE *p_tbl, CPU_INT08U nbr) {
+    OS_ERR err;
+
+    InitTbl = p_tbl;
+    InitNbr = (nbr < APP_INIT_STAGE_MAX) ? nbr : APP_INIT_STAGE_MAX;
+    InitTs = 0u; /* CPU_Init() 가 DWT 를 0 으로 (Note #3) */
+    InitUs = 0u;
+    InitTsPerUs = BSP_CPU_ClkFreq() / 1000000u;
+    OSFlagCreate(&InitFlags, "Init", 0u, &err);
+
+    for (CPU_INT08U id = 0u; id < InitNbr; id++) {
+        InitRpt[id].name = p_tbl[id].name;
+        InitRpt[id].mode = p_tbl[id].mode;
+        InitRpt[id].state = APP_INIT_STATE_PENDING;
+        InitRpt[id].task = "";
+    }
+    for (CPU_INT08U id = 0u; id < InitNbr; id++) {
+        if (p_tbl[id].mode == APP_INIT_MODE_NOW) {
+            AppInit_Need(id);
+        }
+    }
+
+    OSTaskCreate(&InitTCB, "AppTask_Init",
+                 AppTask_Init, 0u,
+                 APP_CFG_TASK_INIT_PRIO,
+                 &InitStk[0],
+                 APP_CFG_TASK_INIT_STK_SIZE / 10u,
+                 APP_CFG_TASK_INIT_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+}
+
+/*
+*********************************************************************************************************
+*                                           AppInit_Need()
+*
+* Description : Make sure a start-up stage is done, running it in the calling task if nobody has yet.
+*
+* Argument(s) : id          Stage number, i.e. its index in the table given to AppInit_Start().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #2 above.
+*********************************************************************************************************
+*/
+
+void AppInit_Need(CPU_INT08U id) {
+    CPU_INT08U state;
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    if ((InitDone & DEF_BIT(id)) != 0u) {
+        return;
+    }
+    if (id >= InitNbr) {
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    state = InitRpt[id].state;
+    if (state == APP_INIT_STATE_PENDING) {
+        InitRpt[id].state = APP_INIT_STATE_RUNNING; /* 이 태스크가 맡음 */
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (state == APP_INIT_STATE_PENDING) {
+        Init_Run(id);
+    } else { /* 다른 태스크가 실행 중 (그 사이 끝났으면 바로 돌아옴) */
+        (void)OSFlagPend(&InitFlags, DEF_BIT(id), 0u,
+                         OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                         AppInit_FrameDone()
+*
+* Description : Record the end of the first game frame in the boot report.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_GAME().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppInit_FrameDone(void) {
+    if (InitFrameUs == 0u) {
+        InitFrameUs = DEF_MAX(Init_TimeUs((CPU_TS *)0), 1u);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                         AppInit_StatusGet()
+*
+* Description : Get the start-up progress.
+*
+* Argument(s) : p_status    Pointer to the variable that receives the status.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppInit_StatusGet(APP_INIT_STATUS *p_status) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    p_status->nbr = InitNbr;
+    p_status->done = InitDone;
+    p_status->frame_us = InitFrameUs;
+    p_status->bg_us = InitBgUs;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                         AppInit_ReportGet()
+*
+* Description : Get the boot report of one start-up stage.
+*
+* Argument(s) : id          Stage number.
+*
+*               p_rpt       Pointer to the variable that receives the report.
+*
+* Return(s)   : DEF_OK,   if the stage exists.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The times of a stage that is not done are not meaningful.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppInit_ReportGet(CPU_INT08U id, APP_INIT_REPORT *p_rpt) {
+    CPU_SR_ALLOC();
+
+    if (id >= InitNbr) {
+        return DEF_FAIL;
+    }
+    CPU_CRITICAL_ENTER();
+    *p_rpt = InitRpt[id];
+    CPU_CRITICAL_EXIT();
+    return DEF_OK;
+}
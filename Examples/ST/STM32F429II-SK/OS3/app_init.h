@@ -0,0 +1,88 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_init.h
+* Description   : Staged start-up: initialization steps with dependencies, run now, in the background or
+*                 on demand, each one time stamped for a boot report.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_INIT_MODULE_PRESENT
+#define  APP_INIT_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_INIT_STAGE_MAX                               16u   /* Max. stages per table (bits of an OS_FLAGS).         */
+
+#define  APP_INIT_MODE_NOW                                 0u   /* Run by AppInit_Start(), before it returns.           */
+#define  APP_INIT_MODE_BG                                  1u   /* Run by the init task, or earlier on demand.          */
+#define  APP_INIT_MODE_LAZY                                2u   /* Run only on demand (AppInit_Need()).                 */
+
+#define  APP_INIT_STATE_PENDING                            0u
+#define  APP_INIT_STATE_RUNNING                            1u
+#define  APP_INIT_STATE_DONE                               2u
+
+#define  APP_INIT_DEP(id)                        DEF_BIT(id)    /* Dependency mask of a stage on stage 'id'.            */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    const CPU_CHAR  *name;
+    void           (*fnct)(void);
+    CPU_INT08U       mode;   /* APP_INIT_MODE_xxx                          */
+    CPU_INT32U       deps;   /* APP_INIT_DEP() 의 OR, 앞 단계만 (Note #2)   */
+} APP_INIT_STAGE;
+
+typedef struct {
+    const CPU_CHAR  *name;
+    CPU_INT08U       mode;
+    CPU_INT08U       state;     /* APP_INIT_STATE_xxx                      */
+    const CPU_CHAR  *task;      /* 실행한 태스크                            */
+    CPU_TS           ts_start;  /* CPU_TS, CPU_Init() 부터 (Note #3)       */
+    CPU_TS           ts_end;
+    CPU_INT32U       us_start;  /* 같은 시각을 us 로                         */
+    CPU_INT32U       us_end;
+} APP_INIT_REPORT;
+
+typedef struct {
+    CPU_INT08U       nbr;       /* 단계 수                                  */
+    CPU_INT32U       done;      /* 끝난 단계 (비트 = 단계 번호)              */
+    CPU_INT32U       frame_us;  /* 첫 화면을 다 그린 시각, 0 = 아직          */
+    CPU_INT32U       bg_us;     /* 초기화 태스크가 끝난 시각, 0 = 아직       */
+} APP_INIT_STATUS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppInit_Start     (const APP_INIT_STAGE  *p_tbl,
+                                CPU_INT08U             nbr);
+
+void         AppInit_Need      (CPU_INT08U             id);
+
+void         AppInit_FrameDone (void);
+
+void         AppInit_StatusGet (APP_INIT_STATUS       *p_status);
+
+CPU_BOOLEAN  AppInit_ReportGet (CPU_INT08U             id,
+                                APP_INIT_REPORT       *p_rpt);
+
+
+#endif
@@ -0,0 +1,210 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_led.c
+* Description   : LED pattern service (result, win streak, blink codes) run by a kernel timer, no task.
+*
+* Note(s)       : (1) A pattern is a table of steps (LEDs on, hold time) played 'repeat' times.  It is run by
+*                     a ONE-SHOT OS_TMR of one timer period (1 / OS_CFG_TMR_TASK_RATE_HZ, 100 ms) whose
+*                     callback counts down the step, switches the LEDs and re-arms the timer while the
+*                     pattern lasts.  Hold times are rounded up to whole timer periods; the first step of
+*                     a pattern gets one more, as it starts anywhere within a period.  With no pattern the
+*                     timer is not in the kernel's timer list and costs nothing.
+*
+*                 (2) The callback runs in the kernel's timer task, which the tick wakes once per timer
+*                     period whether a timer runs or not; the LEDs add no context switch of their own.
+*                     AppTask_LED, which this replaces, took four per round (woken by the result, out to
+*                     its 2 s delay, in again, out to its pend) and kept a TCB and a 128 word stack.
+*
+*                 (3) Re-arming from the callback : the timer task unlinks a ONE-SHOT timer that expired
+*                     before calling it back, and OSTmrStart() takes the timer lock that the timer task
+*                     already holds (mutex nesting, or a nested scheduler lock).  The timer goes back at
+*                     the head of the list, behind the timer task's walk, so it fires one period later.
+*
+*                 (4) The pattern state and the GPIO writes are shared with the callback under a short
+*                     critical section.  The AppLed_xxx() calls are OS_TMR services : task level only, not
+*                     from an ISR.  The LED GPIOs are set up by the "led" stage of 'app.c' (App_LedNeed()).
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "stm32f4xx_gpio.h"
+
+#include "app.h"
+#include "app_led.h"
+
+#define LED_PORT GPIOB
+#define LED_PIN_GREEN GPIO_Pin_0  /* PB0  */
+#define LED_PIN_BLUE GPIO_Pin_7   /* PB7  */
+#define LED_PIN_RED GPIO_Pin_14   /* PB14 */
+#define LED_PIN_ALL (LED_PIN_GREEN | LED_PIN_BLUE | LED_PIN_RED)
+
+#define LED_ERR_ON_MS 200u   /* 코드 한 번 깜빡임   */
+#define LED_ERR_OFF_MS 300u
+#define LED_ERR_GAP_MS 1500u /* 코드 사이           */
+#define LED_ERR_REPEAT 3u
+
+/*-------------------------------------------------------------*/
+/*  패턴                                                        */
+/*-------------------------------------------------------------*/
+static const APP_LED_STEP LedStepsWin[] = {{APP_LED_GREEN, 2000u}};
+static const APP_LED_STEP LedStepsLose[] = {{APP_LED_RED, 2000u}};
+static const APP_LED_STEP LedStepsStreak[] = {{APP_LED_GREEN, 100u}, {APP_LED_BLUE, 100u}, {APP_LED_RED, 100u},
+                                              {APP_LED_BLUE, 100u}};
+
+const APP_LED_PATTERN AppLed_PatWin = {"win", LedStepsWin, 1u, 1u};
+const APP_LED_PATTERN AppLed_PatLose = {"lose", LedStepsLose, 1u, 1u};
+const APP_LED_PATTERN AppLed_PatStreak = {"streak", LedStepsStreak, 4u, 5u}; /* 2 s 동안 도는 불 */
+
+static APP_LED_STEP LedStepsErr[2u * APP_LED_ERR_CODE_MAX];
+static APP_LED_PATTERN LedPatErr = {"err", LedStepsErr, 0u, LED_ERR_REPEAT};
+
+/*-------------------------------------------------------------*/
+/*  상태 (Note #4)                                              */
+/*-------------------------------------------------------------*/
+static OS_TMR LedTmr;
+static const APP_LED_PATTERN *LedPat; /* 0 = 꺼짐 */
+static CPU_INT08U LedIx;
+static CPU_INT08U LedRep;
+static OS_TICK LedLeft;               /* 이 단계에 남은 타이머 주기 */
+static APP_LED_STATUS LedStatus;
+
+/* 크리티컬 섹션 안에서 */
+static void Led_Out(CPU_INT08U leds) {
+    uint16_t on = 0u;
+
+    if (DEF_BIT_IS_SET(leds, APP_LED_GREEN)) on |= LED_PIN_GREEN;
+    if (DEF_BIT_IS_SET(leds, APP_LED_BLUE)) on |= LED_PIN_BLUE;
+    if (DEF_BIT_IS_SET(leds, APP_LED_RED)) on |= LED_PIN_RED;
+    GPIO_ResetBits(LED_PORT, LED_PIN_ALL & ~on);
+    GPIO_SetBits(LED_PORT, on);
+}
+
+/* 크리티컬 섹션 안에서 */
+static void Led_StepStart(void) {
+    const APP_LED_STEP *p_step = &LedPat->steps[LedIx];
+
+    Led_Out(p_step->leds);
+    LedLeft = ((OS_TICK)p_step->ms * OSCfg_TmrTaskRate_Hz + 999u) / 1000u;
+    if (LedLeft == 0u) {
+        LedLeft = 1u;
+    }
+    LedStatus.steps++;
+}
+
+/* 타이머 태스크에서, 타이머 주기마다 (Note #1, #3) */
+static void Led_Callback(void *p_tmr, void *p_arg) {
+    OS_ERR err;
+    CPU_BOOLEAN again;
+    CPU_TS ts = OS_TS_GET();
+    CPU_SR_ALLOC();
+
+    (void)p_arg;
+
+    CPU_CRITICAL_ENTER();
+    LedStatus.callbacks++;
+    if ((LedPat != (const APP_LED_PATTERN *)0) && (--LedLeft == 0u)) {
+        if (++LedIx == LedPat->nbr) {
+            LedIx = 0u;
+            LedRep++;
+            if ((LedPat->repeat != 0u) && (LedRep == LedPat->repeat)) {
+                LedPat = (const APP_LED_PATTERN *)0;
+                Led_Out(0u);
+            }
+        }
+        if (LedPat != (const APP_LED_PATTERN *)0) {
+            Led_StepStart();
+        }
+    }
+    again = (LedPat != (const APP_LED_PATTERN *)0) ? DEF_YES : DEF_NO;
+    CPU_CRITICAL_EXIT();
+
+    if (again == DEF_YES) {
+        (void)OSTmrStart((OS_TMR *)p_tmr, &err);
+    }
+
+    ts = OS_TS_GET() - ts;
+    if (ts > LedStatus.cb_max) {
+        LedStatus.cb_max = ts;
+    }
+}
+
+/*-------------------------------------------------------------*/
+/*  API                                                         */
+/*-------------------------------------------------------------*/
+void AppLed_Init(void) {
+    OS_ERR err;
+
+    OSTmrCreate(&LedTmr, "LED", 1u, 0u, OS_OPT_TMR_ONE_SHOT, Led_Callback, (void *)0, &err);
+}
+
+/* 재생 중인 패턴은 끊고 처음부터 */
+void AppLed_Play(const APP_LED_PATTERN *p_pat) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    if ((p_pat == (const APP_LED_PATTERN *)0) || (p_pat->nbr == 0u)) {
+        AppLed_Stop();
+        return;
+    }
+
+    CPU_CRITICAL_ENTER();
+    LedPat = p_pat;
+    LedIx = 0u;
+    LedRep = 0u;
+    LedStatus.plays++;
+    Led_StepStart();
+    LedLeft++; /* 첫 콜백은 한 주기 안 어디서든 온다 */
+    CPU_CRITICAL_EXIT();
+
+    (void)OSTmrStart(&LedTmr, &err); /* 돌고 있으면 한 주기로 다시 */
+}
+
+/* 빨간 불 'code' 번, 쉬고, LED_ERR_REPEAT 번 */
+void AppLed_ErrCode(CPU_INT08U code) {
+    CPU_SR_ALLOC();
+
+    if (code == 0u) {
+        AppLed_Stop();
+        return;
+    }
+    code = DEF_MIN(code, APP_LED_ERR_CODE_MAX);
+
+    CPU_CRITICAL_ENTER(); /* 재생 중일 수 있는 표를 고쳐 씀 */
+    for (CPU_INT08U i = 0u; i < code; i++) {
+        LedStepsErr[2u * i].leds = APP_LED_RED;
+        LedStepsErr[2u * i].ms = LED_ERR_ON_MS;
+        LedStepsErr[2u * i + 1u].leds = 0u;
+        LedStepsErr[2u * i + 1u].ms = (i + 1u == code) ? LED_ERR_GAP_MS : LED_ERR_OFF_MS;
+    }
+    LedPatErr.nbr = (CPU_INT08U)(2u * code);
+    CPU_CRITICAL_EXIT();
+
+    AppLed_Play(&LedPatErr);
+}
+
+void AppLed_Stop(void) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    LedPat = (const APP_LED_PATTERN *)0;
+    Led_Out(0u);
+    CPU_CRITICAL_EXIT();
+
+    (void)OSTmrStop(&LedTmr, OS_OPT_TMR_NONE, (void *)0, &err); /* 이미 멈췄으면 에러, 상관없음 */
+}
+
+void AppLed_StatusGet(APP_LED_STATUS *p_status) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_status = LedStatus;
+    p_status->name = (LedPat != (const APP_LED_PATTERN *)0) ? LedPat->name : "";
+    CPU_CRITICAL_EXIT();
+}
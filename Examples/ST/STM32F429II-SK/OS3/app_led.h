@@ -0,0 +1,85 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_led.h
+* Description   : LED pattern service (result, win streak, blink codes) run by a kernel timer, no task.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_LED_MODULE_PRESENT
+#define  APP_LED_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_LED_GREEN                               DEF_BIT_00 /* LD1, PB0                                             */
+#define  APP_LED_BLUE                                DEF_BIT_01 /* LD2, PB7                                             */
+#define  APP_LED_RED                                 DEF_BIT_02 /* LD3, PB14                                            */
+
+#define  APP_LED_ERR_CODE_MAX                              9u   /* Longest blink code (AppLed_ErrCode()).               */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT08U  leds;        /* APP_LED_xxx, 나머지는 끔                           */
+    CPU_INT16U  ms;          /* 유지 시간, 타이머 주기 단위로 올림                 */
+} APP_LED_STEP;
+
+typedef struct {
+    const CPU_CHAR     *name;
+    const APP_LED_STEP *steps;
+    CPU_INT08U          nbr;
+    CPU_INT08U          repeat;  /* 반복 횟수, 0 = AppLed_Stop() 까지              */
+} APP_LED_PATTERN;
+
+typedef struct {
+    const CPU_CHAR *name;    /* 재생 중인 패턴, 없으면 ""                          */
+    CPU_INT32U  plays;       /* 시작한 패턴                                       */
+    CPU_INT32U  steps;       /* 켠 단계                                          */
+    CPU_INT32U  callbacks;   /* 타이머 콜백                                       */
+    CPU_TS      cb_max;      /* 콜백 최대 시간 (CPU_TS)                           */
+} APP_LED_STATUS;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  const  APP_LED_PATTERN  AppLed_PatWin;
+extern  const  APP_LED_PATTERN  AppLed_PatLose;
+extern  const  APP_LED_PATTERN  AppLed_PatStreak;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppLed_Init          (void);
+
+void         AppLed_Play          (const APP_LED_PATTERN  *p_pat);
+
+void         AppLed_ErrCode       (CPU_INT08U              code);
+
+void         AppLed_Stop          (void);
+
+void         AppLed_StatusGet     (APP_LED_STATUS         *p_status);
+
+
+#endif
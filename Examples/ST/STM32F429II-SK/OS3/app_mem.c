@@ -0,0 +1,318 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_mem.c
+* Description   : Static memory footprint: stacks, pools, queues, heap and buffers, configured size vs.
+*                 high-water mark, and recommended sizes.
+*
+* Note(s)       : (1) AppMem_Walk() reports, one entry at a time :
+*
+*                         stack       every task stack (kernel tasks included), high-water from the
+*                                     statistic task's stack check (OS_CFG_STAT_TASK_STK_CHK_EN)
+*                         tcb         every task control block
+*                         isr-stack   the exception stack, high-water by scanning it (OSInit() clears it)
+*                         queue       task and OS_Q message queues, in entries; the messages themselves
+*                                     come from the message pool, so a queue has no RAM of its own
+*                         msg-pool    the kernel's OS_MSG pool
+*                         sem, mutex, flag, q, mem, tmr   every kernel object, by its debug list
+*                         heap        the uC/LIB heap
+*                         buffer      the application's larger static buffers
+*
+*                     The sizes are compile-time constants (sizeof() and the xxx_CFG_ values), the
+*                     high-water marks are read at run time.  Tasks that have deleted themselves (the start
+*                     and init tasks) are no longer in the kernel's list and are not reported.  Everything
+*                     but the buffers needs OS_CFG_DBG_EN.
+*
+*                 (2) Recommended sizes ('mem size') :
+*
+*                         stack       high-water + APP_CFG_MEM_STK_MARGIN_PCT %, rounded up to
+*                                     APP_CFG_MEM_STK_ROUND words, at least OS_CFG_STK_SIZE_MIN
+*                         msg-pool    the sum of all queue sizes : messages only live in queues, so the
+*                                     pool can never run out at that size whatever the load
+*                         heap        the octets allocated so far
+*
+*                     A high-water mark only covers what ran since reset.  To size from a known workload,
+*                     replay a recorded session ('journal play') and run a batch before 'mem size'.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_frame.h"
+#include "app_mem.h"
+#include "app_replay.h"
+
+typedef struct {
+    const CPU_CHAR *task;  /* 태스크 이름 */
+    const CPU_CHAR *cfg;   /* 스택 크기 #define */
+} MEM_STK_CFG;
+
+static const MEM_STK_CFG MemStkCfgTbl[] = {
+    {"App Task Start", "APP_CFG_TASK_START_STK_SIZE"},
+    {"AppTask_GAME", "APP_CFG_TASK_GAME_STK_SIZE"},
+    {"AppTask_GameLogic", "APP_CFG_TASK_GAME_LOGIC_STK_SIZE"},
+    {"AppTask_INPUT", "APP_CFG_TASK_INPUT_STK_SIZE"},
+    {"AppTask_Init", "APP_CFG_TASK_INIT_STK_SIZE"},
+    {"AppTask_Console", "APP_CFG_TASK_CONSOLE_STK_SIZE"},
+    {"AppTask_Telem", "APP_CFG_TASK_TELEM_STK_SIZE"},
+    {"AppTask_Replay", "APP_CFG_TASK_REPLAY_STK_SIZE"},
+    {"AppTask_Batch", "APP_CFG_TASK_BATCH_STK_SIZE"},
+    {"AppTask_Bg", "APP_CFG_TASK_BG_STK_SIZE"},
+    {"Bench", "APP_CFG_TASK_BENCH_STK_SIZE"},
+    {"Bench Ctrl", "APP_CFG_TASK_BENCH_CTRL_STK_SIZE"},
+    {"uC/OS-III Idle Task", "OS_CFG_IDLE_TASK_STK_SIZE"},
+    {"uC/OS-III Stat Task", "OS_CFG_STAT_TASK_STK_SIZE"},
+    {"uC/OS-III Tick Task", "OS_CFG_TICK_TASK_STK_SIZE"},
+    {"uC/OS-III Timer Task", "OS_CFG_TMR_TASK_STK_SIZE"},
+    {"uC/OS-III ISR Queue Task", "OS_CFG_INT_Q_TASK_STK_SIZE"},
+};
+
+/*-------------------------------------------------------------*/
+/*  항목 하나 (Note #2)                                          */
+/*-------------------------------------------------------------*/
+static CPU_INT32U Mem_StkRec(CPU_INT32U peak) {
+    CPU_INT32U rec = peak + (peak * APP_CFG_MEM_STK_MARGIN_PCT + 99u) / 100u;
+
+    rec = (rec + APP_CFG_MEM_STK_ROUND - 1u) / APP_CFG_MEM_STK_ROUND * APP_CFG_MEM_STK_ROUND;
+    return DEF_MAX(rec, (CPU_INT32U)OSCfg_StkSizeMin);
+}
+
+static void Mem_Entry(APP_MEM_FNCT fnct, const CPU_CHAR *kind, const CPU_CHAR *name, const CPU_CHAR *cfg,
+                      CPU_INT32U unit, CPU_INT32U size, CPU_INT32U peak, CPU_INT32U rec) {
+    APP_MEM_ENTRY entry;
+
+    entry.kind = kind;
+    entry.name = (name != (CPU_CHAR *)0) ? name : "";
+    entry.cfg = cfg;
+    entry.unit = unit;
+    entry.size = size;
+    entry.peak = peak;
+    entry.rec = rec;
+    fnct(&entry);
+}
+
+static const CPU_CHAR *Mem_StkCfg(const CPU_CHAR *task) {
+    for (CPU_INT08U i = 0u; i < sizeof MemStkCfgTbl / sizeof MemStkCfgTbl[0]; i++) {
+        if (Str_Cmp(task, MemStkCfgTbl[i].task) == 0) return MemStkCfgTbl[i].cfg;
+    }
+    return "";
+}
+
+/*-------------------------------------------------------------*/
+/*  커널 (OS_CFG_DBG_EN)                                        */
+/*-------------------------------------------------------------*/
+#if (OS_CFG_DBG_EN > 0u)
+static CPU_INT32U Mem_WalkTasks(APP_MEM_FNCT fnct) {
+    OS_TCB *p_tcb;
+    const CPU_CHAR *name;
+    CPU_INT32U size, peak, q_size, q_peak, q_sum = 0u;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    p_tcb = OSTaskDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_tcb != (OS_TCB *)0) {
+        CPU_CRITICAL_ENTER(); /* 하나씩 복사해서 보고 중에는 인터럽트 허용 */
+        name = p_tcb->NamePtr;
+        size = p_tcb->StkSize;
+#if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+        peak = p_tcb->StkUsed;
+#else
+        peak = APP_MEM_PEAK_NONE;
+#endif
+#if (OS_CFG_TASK_Q_EN > 0u)
+        q_size = p_tcb->MsgQ.NbrEntriesSize;
+        q_peak = p_tcb->MsgQ.NbrEntriesMax;
+#else
+        q_size = 0u;
+        q_peak = 0u;
+#endif
+        p_tcb = p_tcb->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+
+        Mem_Entry(fnct, "stack", name, Mem_StkCfg(name), sizeof(CPU_STK), size, peak,
+                  (peak != APP_MEM_PEAK_NONE) ? Mem_StkRec(peak) : 0u);
+        Mem_Entry(fnct, "tcb", name, "", sizeof(OS_TCB), 1u, APP_MEM_PEAK_NONE, 0u);
+        if (q_size != 0u) {
+            Mem_Entry(fnct, "queue", name, "", 0u, q_size, q_peak, 0u);
+            q_sum += q_size;
+        }
+    }
+    return q_sum;
+}
+
+static CPU_INT32U Mem_WalkObjs(APP_MEM_FNCT fnct) {
+    const CPU_CHAR *name;
+    CPU_INT32U q_size, q_peak, q_sum = 0u;
+    CPU_SR_ALLOC();
+
+#if (OS_CFG_SEM_EN > 0u)
+    OS_SEM *p_sem;
+
+    CPU_CRITICAL_ENTER();
+    p_sem = OSSemDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_sem != (OS_SEM *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_sem->NamePtr;
+        p_sem = p_sem->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "sem", name, "", sizeof(OS_SEM), 1u, APP_MEM_PEAK_NONE, 0u);
+    }
+#endif
+
+#if (OS_CFG_MUTEX_EN > 0u)
+    OS_MUTEX *p_mutex;
+
+    CPU_CRITICAL_ENTER();
+    p_mutex = OSMutexDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_mutex != (OS_MUTEX *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_mutex->NamePtr;
+        p_mutex = p_mutex->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "mutex", name, "", sizeof(OS_MUTEX), 1u, APP_MEM_PEAK_NONE, 0u);
+    }
+#endif
+
+#if (OS_CFG_FLAG_EN > 0u)
+    OS_FLAG_GRP *p_grp;
+
+    CPU_CRITICAL_ENTER();
+    p_grp = OSFlagDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_grp != (OS_FLAG_GRP *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_grp->NamePtr;
+        p_grp = p_grp->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "flag", name, "", sizeof(OS_FLAG_GRP), 1u, APP_MEM_PEAK_NONE, 0u);
+    }
+#endif
+
+#if (OS_CFG_Q_EN > 0u)
+    OS_Q *p_q;
+
+    CPU_CRITICAL_ENTER();
+    p_q = OSQDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_q != (OS_Q *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_q->NamePtr;
+        q_size = p_q->MsgQ.NbrEntriesSize;
+        q_peak = p_q->MsgQ.NbrEntriesMax;
+        p_q = p_q->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "q", name, "", sizeof(OS_Q), 1u, APP_MEM_PEAK_NONE, 0u);
+        Mem_Entry(fnct, "queue", name, "", 0u, q_size, q_peak, 0u);
+        q_sum += q_size;
+    }
+#endif
+
+#if (OS_CFG_MEM_EN > 0u)
+    OS_MEM *p_mem;
+    CPU_INT32U blk_size, blk_nbr;
+
+    CPU_CRITICAL_ENTER();
+    p_mem = OSMemDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_mem != (OS_MEM *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_mem->NamePtr;
+        blk_size = p_mem->BlkSize;
+        blk_nbr = p_mem->NbrMax;
+        p_mem = p_mem->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "mem", name, "", sizeof(OS_MEM), 1u, APP_MEM_PEAK_NONE, 0u);
+        Mem_Entry(fnct, "mem-blk", name, "", blk_size, blk_nbr, APP_MEM_PEAK_NONE, 0u);
+    }
+#endif
+
+#if (OS_CFG_TMR_EN > 0u)
+    OS_TMR *p_tmr;
+
+    CPU_CRITICAL_ENTER();
+    p_tmr = OSTmrDbgListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_tmr != (OS_TMR *)0) {
+        CPU_CRITICAL_ENTER();
+        name = p_tmr->NamePtr;
+        p_tmr = p_tmr->DbgNextPtr;
+        CPU_CRITICAL_EXIT();
+        Mem_Entry(fnct, "tmr", name, "", sizeof(OS_TMR), 1u, APP_MEM_PEAK_NONE, 0u);
+    }
+#endif
+
+    return q_sum;
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                            AppMem_Walk()
+*
+* Description : Report every static allocation with its configured size and high-water mark.
+*
+* Argument(s) : fnct        Function called once per entry, from the calling task.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #1 and #2 above.  The entries are copied one at a time with interrupts off,
+*                   so 'fnct' may block (e.g. print).
+*********************************************************************************************************
+*/
+
+void AppMem_Walk(APP_MEM_FNCT fnct) {
+    APP_FRAME_STATS frame;
+    APP_REPLAY_STATUS replay;
+    CPU_INT32U q_sum = 0u;
+
+#if (OS_CFG_DBG_EN > 0u)
+    q_sum += Mem_WalkTasks(fnct);
+    q_sum += Mem_WalkObjs(fnct);
+#endif
+
+    if (OSCfg_ISRStkSize > 0u) { /* OS_CFG_ISR_STK_SIZE 는 os_cfg_app.c 에서만 보임 */
+        CPU_INT32U isr_free = 0u;
+
+        while ((isr_free < OSCfg_ISRStkSize) && (OSCfg_ISRStkBasePtr[isr_free] == (CPU_STK)0)) {
+            isr_free++; /* 아래로 자라므로 바닥부터 0 인 동안이 남은 공간 */
+        }
+        Mem_Entry(fnct, "isr-stack", "", "OS_CFG_ISR_STK_SIZE", sizeof(CPU_STK), OSCfg_ISRStkSize,
+                  OSCfg_ISRStkSize - isr_free, Mem_StkRec(OSCfg_ISRStkSize - isr_free));
+    }
+
+#if (OS_MSG_EN > 0u)
+#if (OS_CFG_DBG_EN > 0u)
+    Mem_Entry(fnct, "msg-pool", "", "OS_CFG_MSG_POOL_SIZE", sizeof(OS_MSG), OSCfg_MsgPoolSize,
+              OSMsgPool.NbrUsedMax, q_sum);
+#else
+    Mem_Entry(fnct, "msg-pool", "", "", sizeof(OS_MSG), OSCfg_MsgPoolSize, APP_MEM_PEAK_NONE, 0u);
+#endif
+#endif
+    (void)q_sum;
+
+#if (LIB_MEM_CFG_HEAP_SIZE > 0u)
+    LIB_ERR lib_err;
+    CPU_INT32U heap_used = LIB_MEM_CFG_HEAP_SIZE - Mem_HeapGetSizeRem(1u, &lib_err);
+
+    Mem_Entry(fnct, "heap", "uC/LIB", "LIB_MEM_CFG_HEAP_SIZE", 1u, LIB_MEM_CFG_HEAP_SIZE, heap_used, heap_used);
+#else
+    Mem_Entry(fnct, "heap", "uC/LIB", "LIB_MEM_CFG_HEAP_SIZE", 1u, 0u, 0u, 0u);
+#endif
+
+    AppFrame_StatsGet(&frame);
+    AppReplay_StatusGet(&replay);
+    Mem_Entry(fnct, "buffer", "frame cache", "", 1u, frame.ramSize, APP_MEM_PEAK_NONE, 0u);
+    Mem_Entry(fnct, "buffer", "console rx", "", 1u, APP_CFG_CONSOLE_RX_BUF_SIZE, APP_MEM_PEAK_NONE, 0u);
+    Mem_Entry(fnct, "buffer", "journal", "", 1u, APP_CFG_REPLAY_BUF_SIZE, replay.len, 0u);
+    Mem_Entry(fnct, "buffer", "telem trace", "", 1u, APP_CFG_TELEM_TRACE_BUF_SIZE, APP_MEM_PEAK_NONE, 0u);
+}
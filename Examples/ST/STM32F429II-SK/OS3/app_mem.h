@@ -0,0 +1,55 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_mem.h
+* Description   : Static memory footprint: stacks, pools, queues, heap and buffers, configured size vs.
+*                 high-water mark, and recommended sizes.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_MEM_MODULE_PRESENT
+#define  APP_MEM_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_MEM_PEAK_NONE               DEF_INT_32U_MAX_VAL    /* High-water mark not measured.                        */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    const CPU_CHAR  *kind;   /* "stack", "queue", "msg-pool", "sem", … (Note #1)          */
+    const CPU_CHAR  *name;
+    const CPU_CHAR  *cfg;    /* 크기를 정하는 #define, "" = 없음                           */
+    CPU_INT32U       unit;   /* 한 단위의 octet, 0 = 자기 RAM 없음 (큐: 메시지는 풀에서)     */
+    CPU_INT32U       size;   /* 설정 크기 (단위)                                          */
+    CPU_INT32U       peak;   /* 최고 사용량 (단위), APP_MEM_PEAK_NONE = 잴 수 없음          */
+    CPU_INT32U       rec;    /* 권장 크기 (단위), cfg 가 있고 peak 를 잴 때만 (Note #2)      */
+} APP_MEM_ENTRY;
+
+typedef  void  (*APP_MEM_FNCT)(const APP_MEM_ENTRY  *p_entry);
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void  AppMem_Walk  (APP_MEM_FNCT  fnct);
+
+
+#endif
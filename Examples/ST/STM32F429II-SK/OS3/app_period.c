@@ -0,0 +1,355 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_period.c
+* Description   : Periodic task releases on absolute ticks, with a jitter and deadline miss monitor.
+*
+* Note(s)       : (1) A periodic task calls AppPeriod_Start() once, then AppPeriod_Wait() at the end of each
+*                     iteration :
+*
+*                         AppPeriod_Start(&period, "AppTask_X", 10u);
+*                         for (;;) {
+*                             ... work ...
+*                             AppPeriod_Wait(&period);
+*                         }
+*
+*                     Release k is tick start + k * period, and the task waits for it with
+*                     OSTimeDly(OS_OPT_TIME_MATCH).  A relative delay after the work, as AppTask_INPUT used
+*                     to do, adds the work time to every period and drifts.  The kernel's own
+*                     OS_OPT_TIME_PERIODIC mode re-times a late task silently; here the task decides.
+*                     When the next release has already passed the task runs at once, and releases
+*                     passed by a whole period or more are skipped and counted.
+*
+*                 (2) Release jitter is the time from the tick of the release to the task running again,
+*                     measured on the CPU_TS timer.  The tick of release k is timed as anchorTs + (k ticks)
+*                     in CPU_TS, which holds since both come from the CPU clock.  The anchor starts at
+*                     AppPeriod_Start() and moves back to any wake-up seen earlier than it predicts.  The
+*                     jitter is therefore the delay beyond the quickest wake-up observed; the interrupt
+*                     entry and the context switch that every wake-up pays are not in it.
+*
+*                 (3) Jitter and execution time (wake-up to AppPeriod_Wait(), preemption included) are
+*                     kept in histograms of APP_CFG_PERIOD_HIST_BINS log2 bins : bin 0 is 0 .. 1 us, bin
+*                     k is 2^k .. 2^(k+1) - 1 us, and the last bin takes everything above.  An iteration
+*                     that ends after its deadline, the next release, is a miss : jitter plus execution
+*                     time came to more than a period.
+*
+*                 (4) Configuration changes are noted by the console (AppPeriod_CfgNote()).  A miss that
+*                     comes within APP_CFG_PERIOD_CFG_WIN_MS of the last change is charged to that change.
+*                     A change with misses charged to it is a likely cause ('period' command).
+*
+*                 (5) The statistics are updated by the periodic task and read by other tasks under a
+*                     critical section.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app_period.h"
+
+#define PERIOD_CFG_NONE  0xFFu
+
+#if (APP_CFG_PERIOD_HIST_BINS < 2u) || (APP_CFG_PERIOD_HIST_BINS > 32u)
+#error  "APP_CFG_PERIOD_HIST_BINS        illegally #define'd in 'app_cfg.h' [MUST be 2 .. 32]"
+#endif
+
+static APP_PERIOD *PeriodHead; /* 등록 순서대로 */
+static CPU_TS PeriodTsPerUs;
+static CPU_TS PeriodTsPerTick;
+
+static APP_PERIOD_CFG PeriodCfg[APP_CFG_PERIOD_CFG_NBR];
+static CPU_INT08U PeriodCfgLast = PERIOD_CFG_NONE; /* 마지막으로 바뀐 설정 */
+
+/*-------------------------------------------------------------*/
+/*  시간 (Note #2, #3)                                          */
+/*-------------------------------------------------------------*/
+/* 릴리스 tick 의 CPU_TS, 2^32 로 돌아도 차이는 맞음 */
+static inline CPU_TS Period_ReleaseTs(const APP_PERIOD *p_period, OS_TICK release) {
+    return p_period->anchorTs + (CPU_TS)(release - p_period->anchorTick) * PeriodTsPerTick;
+}
+
+static CPU_INT08U Period_Bin(CPU_TS ts) {
+    CPU_INT32U us = AppPeriod_TsToUs(ts);
+    CPU_INT08U bin;
+
+    if (us < 2u) {
+        return 0u;
+    }
+    bin = (CPU_INT08U)(31u - CPU_CntLeadZeros((CPU_DATA)us));
+    return (bin < APP_CFG_PERIOD_HIST_BINS) ? bin : (APP_CFG_PERIOD_HIST_BINS - 1u);
+}
+
+/* 크리티컬 섹션 안에서 (Note #4) */
+static void Period_CfgMiss(OS_TICK now) {
+    const OS_TICK win = (APP_CFG_PERIOD_CFG_WIN_MS * OSCfg_TickRate_Hz + 999u) / 1000u;
+
+    if ((PeriodCfgLast != PERIOD_CFG_NONE) && (now - PeriodCfg[PeriodCfgLast].tick <= win)) {
+        PeriodCfg[PeriodCfgLast].misses++;
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          AppPeriod_Start()
+*
+* Description : Register a periodic task and make the current tick its first release.
+*
+* Argument(s) : p_period    Pointer to the period, owned by the task, static.
+*
+*               p_name      Name for the reports, usually the task's.
+*
+*               period_ms   Period in ms, rounded up to whole ticks.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Periodic tasks, once, before their loop.
+*
+* Note(s)     : (1) See Note #1 at the top of this file.  The period stays registered for good.
+*********************************************************************************************************
+*/
+
+void AppPeriod_Start(APP_PERIOD *p_period, const CPU_CHAR *p_name, CPU_INT32U period_ms) {
+    OS_ERR err;
+    CPU_ERR cpu_err;
+    APP_PERIOD **pp;
+    CPU_SR_ALLOC();
+
+    if (PeriodTsPerUs == 0u) {
+        CPU_TS_TMR_FREQ freq = CPU_TS_TmrFreqGet(&cpu_err);
+
+        PeriodTsPerUs = (freq >= 1000000u) ? (CPU_TS)(freq / 1000000u) : 1u;
+        PeriodTsPerTick = (CPU_TS)(freq / OSCfg_TickRate_Hz);
+    }
+
+    Mem_Clr(p_period, sizeof *p_period);
+    p_period->name = p_name;
+    p_period->period = (OS_TICK)((period_ms * OSCfg_TickRate_Hz + 999u) / 1000u);
+    if (p_period->period == 0u) {
+        p_period->period = 1u;
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_period->release = OSTimeGet(&err);
+    p_period->anchorTick = p_period->release;
+    p_period->anchorTs = OS_TS_GET(); /* 틱 뒤 어딘가: 첫 깨어남에서 당겨짐 (Note #2) */
+    p_period->startTs = p_period->anchorTs;
+    for (pp = &PeriodHead; *pp != (APP_PERIOD *)0; pp = &(*pp)->next) {
+    }
+    *pp = p_period;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                          AppPeriod_Wait()
+*
+* Description : End the current iteration and wait for the next release.
+*
+* Argument(s) : p_period    Pointer to the period of the calling task.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Periodic tasks, at the end of each iteration.
+*
+* Note(s)     : (1) See Notes #1 to #4 at the top of this file.
+*********************************************************************************************************
+*/
+
+void AppPeriod_Wait(APP_PERIOD *p_period) {
+    OS_ERR err;
+    CPU_TS end = OS_TS_GET();
+    CPU_TS exec = end - p_period->startTs;
+    CPU_TS resp = end - Period_ReleaseTs(p_period, p_period->release);
+    OS_TICK next = p_period->release + p_period->period;
+    OS_TICK now = OSTimeGet(&err);
+    OS_TICK late = now - next;
+    CPU_INT32U skip = 0u;
+    CPU_TS jitter;
+    CPU_SR_ALLOC();
+
+    if (late < 0x80000000u) { /* 다음 릴리스가 이미 지남: 바로 실행, 한 주기 넘게 지난 것은 건너뜀 */
+        skip = late / p_period->period;
+        next += skip * p_period->period;
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_period->stats.releases++;
+    p_period->stats.skipped += skip;
+    p_period->stats.hist[APP_PERIOD_HIST_EXEC][Period_Bin(exec)]++;
+    if (exec > p_period->stats.exec_max) {
+        p_period->stats.exec_max = exec;
+    }
+    if (resp > (CPU_TS)p_period->period * PeriodTsPerTick) { /* 마감 = 다음 릴리스 (Note #3) */
+        p_period->stats.misses++;
+        Period_CfgMiss(now);
+    }
+    CPU_CRITICAL_EXIT();
+
+    OSTimeDly(next, OS_OPT_TIME_MATCH, &err); /* 지났으면 OS_ERR_TIME_ZERO_DLY, 바로 돌아옴 */
+
+    p_period->startTs = OS_TS_GET();
+    p_period->release = next;
+    jitter = p_period->startTs - Period_ReleaseTs(p_period, next);
+    if ((CPU_INT32S)jitter < 0) { /* 예측보다 일찍 깸: 기준을 당김 (Note #2) */
+        p_period->anchorTick = next;
+        p_period->anchorTs = p_period->startTs;
+        jitter = 0u;
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_period->stats.hist[APP_PERIOD_HIST_JITTER][Period_Bin(jitter)]++;
+    if (jitter > p_period->stats.jitter_max) {
+        p_period->stats.jitter_max = jitter;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                        AppPeriod_StatusGet()
+*
+* Description : Get a copy of the statistics of a registered periodic task.
+*
+* Argument(s) : ix          0 .. number of periodic tasks - 1, in registration order.
+*
+*               p_status    Pointer to the copy.
+*
+* Return(s)   : DEF_OK,   if 'ix' is a registered task.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppPeriod_StatusGet(CPU_INT08U ix, APP_PERIOD_STATUS *p_status) {
+    APP_PERIOD *p_period = PeriodHead;
+    CPU_SR_ALLOC();
+
+    while ((p_period != (APP_PERIOD *)0) && (ix-- != 0u)) {
+        p_period = p_period->next;
+    }
+    if (p_period == (APP_PERIOD *)0) {
+        return DEF_FAIL;
+    }
+
+    p_status->name = p_period->name;
+    p_status->period_us = (CPU_INT32U)(((CPU_INT64U)p_period->period * 1000000u) / OSCfg_TickRate_Hz);
+    CPU_CRITICAL_ENTER();
+    p_status->stats = p_period->stats;
+    CPU_CRITICAL_EXIT();
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                           AppPeriod_Clr()
+*
+* Description : Clear the statistics of every periodic task and the configuration change table.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppPeriod_Clr(void) {
+    CPU_SR_ALLOC();
+
+    for (APP_PERIOD *p_period = PeriodHead; p_period != (APP_PERIOD *)0; p_period = p_period->next) {
+        CPU_CRITICAL_ENTER();
+        Mem_Clr(&p_period->stats, sizeof p_period->stats);
+        CPU_CRITICAL_EXIT();
+    }
+    CPU_CRITICAL_ENTER();
+    Mem_Clr(PeriodCfg, sizeof PeriodCfg);
+    PeriodCfgLast = PERIOD_CFG_NONE;
+    CPU_CRITICAL_EXIT();
+}
+
+CPU_INT32U AppPeriod_TsToUs(CPU_TS ts) {
+    return (PeriodTsPerUs != 0u) ? (CPU_INT32U)(ts / PeriodTsPerUs) : 0u;
+}
+
+/* 구간 하한 (us), Note #3 */
+CPU_INT32U AppPeriod_BinLo(CPU_INT08U bin) {
+    return (bin == 0u) ? 0u : ((CPU_INT32U)1u << bin);
+}
+
+/*
+*********************************************************************************************************
+*                                         AppPeriod_CfgNote()
+*
+* Description : Note a configuration change, to which the misses that follow it are charged.
+*
+* Argument(s) : p_cmd       Command that changed the configuration.
+*
+*               p_arg       Its first argument, or a null pointer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Console_Exec().
+*
+* Note(s)     : (1) See Note #4 at the top of this file.  Changes are kept by "<command> <argument>" in a
+*                   table of APP_CFG_PERIOD_CFG_NBR entries; when it is full the least recent one goes.
+*********************************************************************************************************
+*/
+
+void AppPeriod_CfgNote(const CPU_CHAR *p_cmd, const CPU_CHAR *p_arg) {
+    OS_ERR err;
+    CPU_CHAR what[APP_PERIOD_CFG_NAME_LEN];
+    CPU_INT08U ix, old = 0u;
+    OS_TICK now;
+    CPU_SR_ALLOC();
+
+    snprintf(what, sizeof what, "%s%s%s", p_cmd, (p_arg != (CPU_CHAR *)0) ? " " : "",
+             (p_arg != (CPU_CHAR *)0) ? p_arg : "");
+
+    CPU_CRITICAL_ENTER();
+    now = OSTimeGet(&err);
+    for (ix = 0u; ix < APP_CFG_PERIOD_CFG_NBR; ix++) {
+        if ((PeriodCfg[ix].changes == 0u) || (Str_Cmp(PeriodCfg[ix].what, what) == 0)) {
+            break;
+        }
+        if (now - PeriodCfg[ix].tick > now - PeriodCfg[old].tick) {
+            old = ix;
+        }
+    }
+    if (ix == APP_CFG_PERIOD_CFG_NBR) { /* 가득 참: 가장 오래된 것을 씀 */
+        ix = old;
+        PeriodCfg[ix].changes = 0u;
+        PeriodCfg[ix].misses = 0u;
+    }
+    if (PeriodCfg[ix].changes == 0u) {
+        Mem_Copy(PeriodCfg[ix].what, what, sizeof what);
+    }
+    PeriodCfg[ix].changes++;
+    PeriodCfg[ix].tick = now;
+    PeriodCfgLast = ix;
+    CPU_CRITICAL_EXIT();
+}
+
+CPU_BOOLEAN AppPeriod_CfgGet(CPU_INT08U ix, APP_PERIOD_CFG *p_cfg) {
+    CPU_BOOLEAN ok = DEF_FAIL;
+    CPU_SR_ALLOC();
+
+    if (ix >= APP_CFG_PERIOD_CFG_NBR) {
+        return DEF_FAIL;
+    }
+    CPU_CRITICAL_ENTER();
+    if (PeriodCfg[ix].changes != 0u) {
+        *p_cfg = PeriodCfg[ix];
+        ok = DEF_OK;
+    }
+    CPU_CRITICAL_EXIT();
+    return ok;
+}
@@ -0,0 +1,98 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_period.h
+* Description   : Periodic task releases on absolute ticks, with a jitter and deadline miss monitor.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_PERIOD_MODULE_PRESENT
+#define  APP_PERIOD_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_PERIOD_HIST_JITTER                            0u   /* Release jitter.                                      */
+#define  APP_PERIOD_HIST_EXEC                              1u   /* Wake-up to AppPeriod_Wait(), preemption included.    */
+#define  APP_PERIOD_HIST_NBR                               2u
+
+#define  APP_PERIOD_CFG_NAME_LEN                          16u   /* "<command> <argument>", NUL included.                */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U  releases;    /* 실행한 릴리스                                     */
+    CPU_INT32U  misses;      /* 다음 릴리스 뒤에 끝난 실행                          */
+    CPU_INT32U  skipped;     /* 통째로 건너뛴 릴리스                                */
+    CPU_TS      jitter_max;  /* CPU_TS                                           */
+    CPU_TS      exec_max;
+    CPU_INT32U  hist[APP_PERIOD_HIST_NBR][APP_CFG_PERIOD_HIST_BINS]; /* 'app_period.c' Note #3 */
+} APP_PERIOD_STATS;
+
+typedef struct app_period {
+    const CPU_CHAR     *name;
+    OS_TICK             period;      /* tick                                    */
+    OS_TICK             release;     /* 이번 릴리스 tick                          */
+    OS_TICK             anchorTick;  /* anchorTs 에 해당하는 tick (Note #2)       */
+    CPU_TS              anchorTs;
+    CPU_TS              startTs;     /* 이번 실행이 깨어난 시각                    */
+    APP_PERIOD_STATS    stats;
+    struct app_period  *next;
+} APP_PERIOD;
+
+typedef struct {
+    const CPU_CHAR     *name;
+    CPU_INT32U          period_us;
+    APP_PERIOD_STATS    stats;
+} APP_PERIOD_STATUS;
+
+typedef struct {
+    CPU_CHAR    what[APP_PERIOD_CFG_NAME_LEN];
+    CPU_INT32U  changes;
+    CPU_INT32U  misses;      /* 바뀐 뒤 APP_CFG_PERIOD_CFG_WIN_MS 안의 미스         */
+    OS_TICK     tick;        /* 마지막으로 바뀐 tick                              */
+} APP_PERIOD_CFG;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppPeriod_Start      (APP_PERIOD          *p_period,
+                                   const CPU_CHAR      *p_name,
+                                   CPU_INT32U           period_ms);
+
+void         AppPeriod_Wait       (APP_PERIOD          *p_period);
+
+CPU_BOOLEAN  AppPeriod_StatusGet  (CPU_INT08U           ix,
+                                   APP_PERIOD_STATUS   *p_status);
+
+void         AppPeriod_Clr        (void);
+
+CPU_INT32U   AppPeriod_TsToUs     (CPU_TS               ts);
+
+CPU_INT32U   AppPeriod_BinLo      (CPU_INT08U           bin);
+
+void         AppPeriod_CfgNote    (const CPU_CHAR      *p_cmd,
+                                   const CPU_CHAR      *p_arg);
+
+CPU_BOOLEAN  AppPeriod_CfgGet     (CPU_INT08U           ix,
+                                   APP_PERIOD_CFG      *p_cfg);
+
+
+#endif
@@ -0,0 +1,693 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_replay.c
+* Description   : Journal of input events and RNG draws; deterministic record and replay of game sessions.
+*
+* Note(s)       : (1) A session is reproducible from two things : the input events AppTask_INPUT derives from
+*                     the joystick and the button (App_InputApply()), and the hardware RNG draws of
+*                     AppTask_GameLogic (Game_Rand()).  Both go through the hooks below, which append them to
+*                     a RAM journal while recording and hand them back while replaying.  Everything else
+*                     (rendering, statistics, LED) follows from the game tasks themselves.
+*
+*                 (2) Recording and replay start at a round boundary : AppReplay_RecStart() and
+*                     AppReplay_PlayStart() only arm, and AppTask_GameLogic starts them when it begins its
+*                     next round (AppReplay_RoundStart()).  Stopping a recording cuts the journal back to the
+*                     start of the unfinished round, so a journal always holds whole rounds and can be
+*                     replayed in a loop.
+*
+*                 (3) Journal : 'M', 'J', version, then one record per event :
+*
+*                         tag = kind << 5 | dt                dt = ticks since the previous record, 0 .. 30;
+*                         [varint dt - 31]                    dt = 31 : the rest follows (LEB128)
+*                         [payload]
+*
+*                         kind  0  LEFT
+*                               1  RIGHT
+*                               2  BTN
+*                               3  RNG      + 4 octets, draw, low octet first
+*                               4  RESULT   + 1 octet,  win | final door << 1
+*
+*                     A round is typically 15 to 25 octets: two RNG draws, a few moves, three presses and
+*                     the result.
+*
+*                 (4) Replay reads the journal with two cursors.  The input cursor is owned by the replay
+*                     task, which applies LEFT/RIGHT/BTN records through App_InputApply(), exactly as
+*                     AppTask_INPUT would; the hardware inputs are ignored meanwhile.  The logic cursor is
+*                     owned by AppTask_GameLogic, which takes its RNG draws from it and checks each round
+*                     result against the recorded RESULT (a difference counts as a mismatch).
+*
+*                 (5) In real-time replay the task waits for each input's recorded tick.  In fast replay it
+*                     does not wait at all, but it runs at APP_CFG_TASK_REPLAY_PRIO, below every game task,
+*                     so the next input is only applied once the logic and render tasks are blocked again.
+*                     That keeps replay deterministic at any speed.  The result LEDs stay off in fast
+*                     replay.  The kernel's statistics and timer tasks are below the replay task and do not
+*                     run during a fast replay.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_replay.h"
+
+#define REPLAY_VERSION     1u
+#define REPLAY_HDR_LEN     3u
+
+#define REPLAY_KIND_LEFT   0u
+#define REPLAY_KIND_RIGHT  1u
+#define REPLAY_KIND_BTN    2u
+#define REPLAY_KIND_RNG    3u
+#define REPLAY_KIND_RESULT 4u
+
+#define REPLAY_DT_EXT     31u
+#define REPLAY_REC_LEN_MAX 10u /* tag + varint dt (4) + RNG 4 + 여유 */
+
+typedef struct {
+    CPU_SIZE_T ix;    /* 다음 레코드 위치           */
+    OS_TICK tick;     /* 지금까지 dt 합 (저널 시간) */
+} REPLAY_CURSOR;
+
+BSP_CCM_DATA static OS_TCB ReplayTCB;
+BSP_CCM_DATA static CPU_STK ReplayStk[APP_CFG_TASK_REPLAY_STK_SIZE];
+
+static CPU_INT08U ReplayBuf[APP_CFG_REPLAY_BUF_SIZE];
+static APP_REPLAY_STATUS ReplayStatus;
+static CPU_SIZE_T ReplayRoundIx;      /* 녹화: 진행 중인 라운드의 시작 (Note #2) */
+static OS_TICK ReplayTickLast;        /* 녹화: 마지막 레코드의 tick               */
+static OS_TICK ReplayTickStart;       /* 녹화 / 재생 시작 tick                    */
+static OS_TICK ReplayTickBase;        /* 실시간 재생: 이번 반복의 시작 tick        */
+static REPLAY_CURSOR ReplayInCur;     /* 재생 태스크 전용 (Note #4)              */
+static REPLAY_CURSOR ReplayLogicCur;  /* AppTask_GameLogic 전용                 */
+
+/*-------------------------------------------------------------*/
+/*  저널 쓰기 / 읽기 (Note #3)                                   */
+/*-------------------------------------------------------------*/
+/* 녹화 중일 때만, 호출하는 쪽에서 CPU_CRITICAL_ENTER() */
+static void Replay_Append(CPU_INT08U kind, const CPU_INT08U *p_payload, CPU_SIZE_T n) {
+    OS_ERR err;
+    OS_TICK now = OSTimeGet(&err);
+    OS_TICK dt = now - ReplayTickLast;
+    CPU_SIZE_T ix = ReplayStatus.len;
+
+    if (ix + REPLAY_REC_LEN_MAX > APP_CFG_REPLAY_BUF_SIZE) { /* 가득 참: 끝난 라운드까지만 남김 */
+        ReplayStatus.len = ReplayRoundIx;
+        ReplayStatus.full = DEF_YES;
+        ReplayStatus.ticks = ReplayTickLast - ReplayTickStart;
+        ReplayStatus.state = APP_REPLAY_IDLE;
+        return;
+    }
+    ReplayTickLast = now;
+    if (dt < REPLAY_DT_EXT) {
+        ReplayBuf[ix++] = (CPU_INT08U)((kind << 5) | dt);
+    } else {
+        ReplayBuf[ix++] = (CPU_INT08U)((kind << 5) | REPLAY_DT_EXT);
+        dt -= REPLAY_DT_EXT;
+        while (dt >= 0x80u) {
+            ReplayBuf[ix++] = (CPU_INT08U)(dt | 0x80u);
+            dt >>= 7;
+        }
+        ReplayBuf[ix++] = (CPU_INT08U)dt;
+    }
+    while (n-- != 0u) {
+        ReplayBuf[ix++] = *p_payload++;
+    }
+    ReplayStatus.len = ix;
+}
+
+/* 다음 레코드 중 'kinds' (비트 마스크) 에 드는 것, 없으면 DEF_NO; 호출하는 쪽에서 CPU_CRITICAL_ENTER() */
+static CPU_BOOLEAN Replay_Next(REPLAY_CURSOR *p_cur, CPU_INT08U kinds, CPU_INT08U *p_kind, CPU_INT08U *p_payload) {
+    while (p_cur->ix < ReplayStatus.len) {
+        CPU_INT08U tag = ReplayBuf[p_cur->ix++];
+        CPU_INT08U kind = tag >> 5;
+        OS_TICK dt = tag & REPLAY_DT_EXT;
+        CPU_SIZE_T n = (kind == REPLAY_KIND_RNG) ? 4u : (kind == REPLAY_KIND_RESULT) ? 1u : 0u;
+
+        if (dt == REPLAY_DT_EXT) {
+            CPU_INT08U shift = 0u;
+            CPU_INT08U b;
+            do {
+                if ((p_cur->ix >= ReplayStatus.len) || (shift > 28u)) { /* 잘린 / 깨진 저널 */
+                    p_cur->ix = ReplayStatus.len;
+                    return DEF_NO;
+                }
+                b = ReplayBuf[p_cur->ix++];
+                dt += (OS_TICK)(b & 0x7Fu) << shift;
+                shift += 7u;
+            } while ((b & 0x80u) != 0u);
+        }
+        if (p_cur->ix + n > ReplayStatus.len) {
+            p_cur->ix = ReplayStatus.len;
+            return DEF_NO;
+        }
+        p_cur->tick += dt;
+        if ((kinds & (1u << kind)) != 0u) {
+            for (CPU_SIZE_T k = 0u; k < n; k++) {
+                p_payload[k] = ReplayBuf[p_cur->ix + k];
+            }
+            p_cur->ix += n;
+            *p_kind = kind;
+            return DEF_YES;
+        }
+        p_cur->ix += n;
+    }
+    return DEF_NO;
+}
+
+static void Replay_Rewind(void) {
+    OS_ERR err;
+
+    ReplayInCur.ix = REPLAY_HDR_LEN;
+    ReplayInCur.tick = 0u;
+    ReplayLogicCur = ReplayInCur;
+    ReplayTickBase = OSTimeGet(&err);
+}
+
+/*-------------------------------------------------------------*/
+/*  재생 태스크 (Note #4, #5)                                    */
+/*-------------------------------------------------------------*/
+static void AppTask_Replay(void *p_arg) {
+    OS_ERR err;
+    CPU_INT08U kind;
+    CPU_INT08U payload[4];
+    OS_TICK at, now;
+    CPU_BOOLEAN more;
+    CPU_SR_ALLOC();
+
+    (void)p_arg;
+
+    for (;;) {
+        OSTaskSemPend(0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err); /* 재생 시작 / 되감기 */
+
+        for (;;) {
+            CPU_CRITICAL_ENTER();
+            more = (ReplayStatus.state == APP_REPLAY_PLAY)
+                && Replay_Next(&ReplayInCur,
+                               (1u << REPLAY_KIND_LEFT) | (1u << REPLAY_KIND_RIGHT) | (1u << REPLAY_KIND_BTN),
+                               &kind, payload);
+            at = ReplayTickBase + ReplayInCur.tick;
+            CPU_CRITICAL_EXIT();
+            if (more == DEF_NO) {
+                break; /* 이번 반복의 입력 끝: 다음 라운드 시작에서 되감음 */
+            }
+
+            if (ReplayStatus.fast == DEF_NO) {
+                now = OSTimeGet(&err);
+                if ((OS_TICK)(at - now) < 0x80000000u && at != now) {
+                    OSTimeDly(at - now, OS_OPT_TIME_DLY, &err);
+                }
+                if (ReplayStatus.state != APP_REPLAY_PLAY) {
+                    break; /* 기다리는 동안 멈춤 */
+                }
+            }
+            App_InputApply((kind == REPLAY_KIND_LEFT)    ? APP_INPUT_LEFT
+                           : (kind == REPLAY_KIND_RIGHT) ? APP_INPUT_RIGHT
+                                                         : APP_INPUT_BTN);
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                          AppReplay_Init()
+*
+* Description : Create the replay task.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskCreate().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppReplay_Init(void) {
+    OS_ERR err;
+
+    OSTaskCreate(&ReplayTCB, "AppTask_Replay",
+                 AppTask_Replay, 0u,
+                 APP_CFG_TASK_REPLAY_PRIO,
+                 &ReplayStk[0],
+                 APP_CFG_TASK_REPLAY_STK_SIZE / 10u,
+                 APP_CFG_TASK_REPLAY_STK_SIZE,
+                 0u, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+}
+
+/*
+*********************************************************************************************************
+*                                        AppReplay_RecStart()
+*
+* Description : Start recording a new journal at the next round.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The journal in RAM is replaced once the next round starts.
+*********************************************************************************************************
+*/
+
+void AppReplay_RecStart(void) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    ReplayStatus.state = APP_REPLAY_REC_ARMED;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                       AppReplay_PlayStart()
+*
+* Description : Replay the journal from the next round on.
+*
+* Argument(s) : fast        DEF_YES to replay as fast as the game tasks run, DEF_NO for real time.
+*
+*               repeat      Number of times to replay the journal, or 0 to loop until AppReplay_Stop().
+*
+* Return(s)   : DEF_OK,   if the replay was armed.
+*
+*               DEF_FAIL, if there is no valid journal or a recording is in progress.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #5 at the top of this file.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppReplay_PlayStart(CPU_BOOLEAN fast, CPU_INT32U repeat) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if ((ReplayStatus.state == APP_REPLAY_REC) ||
+        (ReplayStatus.len <= REPLAY_HDR_LEN) ||
+        (ReplayBuf[0] != 'M') || (ReplayBuf[1] != 'J') || (ReplayBuf[2] != REPLAY_VERSION)) {
+        CPU_CRITICAL_EXIT();
+        return DEF_FAIL;
+    }
+    ReplayStatus.state = APP_REPLAY_PLAY_ARMED;
+    ReplayStatus.fast = fast;
+    ReplayStatus.repeat = repeat;
+    CPU_CRITICAL_EXIT();
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                          AppReplay_Stop()
+*
+* Description : Stop recording or replaying.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) A recording keeps its finished rounds only (see Note #2 at the top of this file).  A
+*                   stopped replay leaves the game waiting for live input.
+*********************************************************************************************************
+*/
+
+void AppReplay_Stop(void) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if (ReplayStatus.state == APP_REPLAY_REC) {
+        ReplayStatus.len = ReplayRoundIx;
+    }
+    if ((ReplayStatus.state == APP_REPLAY_REC) || (ReplayStatus.state == APP_REPLAY_PLAY)) {
+        ReplayStatus.ticks = OSTimeGet(&err) - ReplayTickStart;
+    }
+    ReplayStatus.state = APP_REPLAY_IDLE;
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                       AppReplay_StatusGet()
+*
+* Description : Get the state and counters of the last or current recording or replay.
+*
+* Argument(s) : p_status    Pointer to the status copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) While recording or replaying, 'ticks' is the time so far.
+*********************************************************************************************************
+*/
+
+void AppReplay_StatusGet(APP_REPLAY_STATUS *p_status) {
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_status = ReplayStatus;
+    if ((ReplayStatus.state == APP_REPLAY_REC) || (ReplayStatus.state == APP_REPLAY_PLAY)) {
+        p_status->ticks = OSTimeGet(&err) - ReplayTickStart;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                        AppReplay_Journal()
+*
+* Description : Get the journal, e.g. to save it on a host.
+*
+* Argument(s) : p_len       Pointer to a variable that receives the journal length, in octets.
+*
+* Return(s)   : Pointer to the journal.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The journal changes while a recording is in progress.
+*********************************************************************************************************
+*/
+
+const CPU_INT08U *AppReplay_Journal(CPU_SIZE_T *p_len) {
+    *p_len = ReplayStatus.len;
+    return &ReplayBuf[0];
+}
+
+/*
+*********************************************************************************************************
+*                                          AppReplay_Load()
+*
+* Description : Write part of a journal saved earlier.
+*
+* Argument(s) : offset      Offset of the octets in the journal; 0 starts a new journal.
+*
+*               p_data      Pointer to the octets.
+*
+*               len         Number of octets.
+*
+* Return(s)   : DEF_OK,   if the octets were written.
+*
+*               DEF_FAIL, if they do not fit, leave a gap, or a recording or replay is active or armed.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The journal is checked when the replay is started.
+*
+*               (2) Meant for console sized pieces: the octets are copied with interrupts disabled.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppReplay_Load(CPU_SIZE_T offset, const CPU_INT08U *p_data, CPU_SIZE_T len) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if ((ReplayStatus.state != APP_REPLAY_IDLE) ||
+        (offset > ReplayStatus.len) ||
+        (len > APP_CFG_REPLAY_BUF_SIZE - offset)) {
+        CPU_CRITICAL_EXIT();
+        return DEF_FAIL;
+    }
+    if (offset == 0u) {
+        ReplayStatus.len = 0u;
+        ReplayStatus.rounds = 0u;
+        ReplayStatus.full = DEF_NO;
+    }
+    Mem_Copy(&ReplayBuf[offset], p_data, len);
+    if (offset + len > ReplayStatus.len) {
+        ReplayStatus.len = offset + len;
+    }
+    CPU_CRITICAL_EXIT();
+    return DEF_OK;
+}
+
+/*
+*********************************************************************************************************
+*                                       AppReplay_RoundStart()
+*
+* Description : Start an armed recording or replay, or rewind a replay at its end.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_GameLogic(), before the round's first RNG draw.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppReplay_RoundStart(void) {
+    OS_ERR err;
+    CPU_BOOLEAN kick = DEF_NO;
+    REPLAY_CURSOR cur;
+    CPU_INT08U kind;
+    CPU_INT08U payload[4];
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    switch (ReplayStatus.state) {
+        case APP_REPLAY_REC_ARMED:
+            ReplayBuf[0] = 'M';
+            ReplayBuf[1] = 'J';
+            ReplayBuf[2] = REPLAY_VERSION;
+            ReplayStatus.len = REPLAY_HDR_LEN;
+            ReplayStatus.rounds = 0u;
+            ReplayStatus.full = DEF_NO;
+            ReplayTickStart = OSTimeGet(&err);
+            ReplayTickLast = ReplayTickStart;
+            ReplayRoundIx = REPLAY_HDR_LEN;
+            ReplayStatus.state = APP_REPLAY_REC;
+            break;
+
+        case APP_REPLAY_REC:
+            ReplayRoundIx = ReplayStatus.len; /* 앞 라운드가 다 끝남 */
+            ReplayStatus.rounds++;
+            break;
+
+        case APP_REPLAY_PLAY_ARMED:
+            ReplayStatus.rounds = 0u;
+            ReplayStatus.mismatches = 0u;
+            ReplayStatus.reps = 0u;
+            ReplayTickStart = OSTimeGet(&err);
+            Replay_Rewind();
+            ReplayStatus.state = APP_REPLAY_PLAY;
+            kick = DEF_YES;
+            break;
+
+        case APP_REPLAY_PLAY:
+            cur = ReplayLogicCur; /* 남은 RNG / RESULT 가 있으면 아직 이번 반복 안 */
+            if (Replay_Next(&cur, (1u << REPLAY_KIND_RNG) | (1u << REPLAY_KIND_RESULT), &kind, payload) == DEF_YES) {
+                break;
+            }
+            ReplayStatus.reps++; /* 저널 끝: 한 번 다 돎 */
+            if ((ReplayStatus.repeat != 0u) && (ReplayStatus.reps >= ReplayStatus.repeat)) {
+                ReplayStatus.ticks = OSTimeGet(&err) - ReplayTickStart;
+                ReplayStatus.state = APP_REPLAY_IDLE;
+                break;
+            }
+            Replay_Rewind();
+            kick = DEF_YES;
+            break;
+
+        default:
+            break;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (kick == DEF_YES) {
+        OSTaskSemPost(&ReplayTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                         AppReplay_Input()
+*
+* Description : Record an input event.
+*
+* Argument(s) : ev          Input event.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : App_InputApply().
+*
+* Note(s)     : (1) Events applied by the replay task are not recorded again: recording and replay never
+*                   run at the same time.
+*********************************************************************************************************
+*/
+
+void AppReplay_Input(APP_INPUT_EVENT ev) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if (ReplayStatus.state == APP_REPLAY_REC) {
+        Replay_Append((ev == APP_INPUT_LEFT)    ? REPLAY_KIND_LEFT
+                      : (ev == APP_INPUT_RIGHT) ? REPLAY_KIND_RIGHT
+                                                : REPLAY_KIND_BTN,
+                      (const CPU_INT08U *)0, 0u);
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                        AppReplay_RandGet()
+*
+* Description : Take the next RNG draw from the journal.
+*
+* Argument(s) : p_val       Pointer to a variable that receives the draw.
+*
+* Return(s)   : DEF_YES, if replaying; '*p_val' is the recorded draw.
+*
+*               DEF_NO,  otherwise; the caller draws from the hardware RNG and calls AppReplay_RandPut().
+*
+* Caller(s)   : Game_Rand().
+*
+* Note(s)     : (1) A journal that runs out of draws in the middle of a round ends the replay.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppReplay_RandGet(CPU_INT32U *p_val) {
+    CPU_INT08U kind;
+    CPU_INT08U b[4];
+    CPU_BOOLEAN found;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if (ReplayStatus.state != APP_REPLAY_PLAY) {
+        CPU_CRITICAL_EXIT();
+        return DEF_NO;
+    }
+    found = Replay_Next(&ReplayLogicCur, 1u << REPLAY_KIND_RNG, &kind, b);
+    if (found == DEF_NO) {
+        ReplayStatus.state = APP_REPLAY_IDLE;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (found == DEF_NO) {
+        return DEF_NO;
+    }
+    *p_val = (CPU_INT32U)b[0] | ((CPU_INT32U)b[1] << 8) | ((CPU_INT32U)b[2] << 16) | ((CPU_INT32U)b[3] << 24);
+    return DEF_YES;
+}
+
+/*
+*********************************************************************************************************
+*                                        AppReplay_RandPut()
+*
+* Description : Record a hardware RNG draw.
+*
+* Argument(s) : val         Draw.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Game_Rand().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppReplay_RandPut(CPU_INT32U val) {
+    CPU_INT08U b[4];
+    CPU_SR_ALLOC();
+
+    b[0] = (CPU_INT08U)val;
+    b[1] = (CPU_INT08U)(val >> 8);
+    b[2] = (CPU_INT08U)(val >> 16);
+    b[3] = (CPU_INT08U)(val >> 24);
+
+    CPU_CRITICAL_ENTER();
+    if (ReplayStatus.state == APP_REPLAY_REC) {
+        Replay_Append(REPLAY_KIND_RNG, b, 4u);
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                         AppReplay_Result()
+*
+* Description : Record a round result, or check it against the recorded one.
+*
+* Argument(s) : final_door  Door finally chosen, 1 .. 3.
+*
+*               win         DEF_YES if the round was won.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_GameLogic().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppReplay_Result(CPU_INT08U final_door, CPU_BOOLEAN win) {
+    CPU_INT08U res = (CPU_INT08U)((final_door << 1) | ((win == DEF_YES) ? 1u : 0u));
+    CPU_INT08U kind;
+    CPU_INT08U rec;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    if (ReplayStatus.state == APP_REPLAY_REC) {
+        Replay_Append(REPLAY_KIND_RESULT, &res, 1u);
+    } else if (ReplayStatus.state == APP_REPLAY_PLAY) {
+        if ((Replay_Next(&ReplayLogicCur, 1u << REPLAY_KIND_RESULT, &kind, &rec) == DEF_NO) || (rec != res)) {
+            ReplayStatus.mismatches++;
+        }
+        ReplayStatus.rounds++;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+/*
+*********************************************************************************************************
+*                                       AppReplay_IsPlaying()
+*
+* Description : Tell whether a replay is feeding the game.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_YES, if replaying; live inputs must then be ignored.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : AppTask_INPUT().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppReplay_IsPlaying(void) {
+    return (ReplayStatus.state == APP_REPLAY_PLAY) ? DEF_YES : DEF_NO;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppReplay_IsFast()
+*
+* Description : Tell whether a fast replay is running.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_YES, if a fast replay is running; the round results then do not light the LEDs.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : Led_Result() ('app.c').
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN AppReplay_IsFast(void) {
+    return ((ReplayStatus.state == APP_REPLAY_PLAY) && (ReplayStatus.fast == DEF_YES)) ? DEF_YES : DEF_NO;
+}
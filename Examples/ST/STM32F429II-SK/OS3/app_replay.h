@@ -0,0 +1,89 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_replay.h
+* Description   : Journal of input events and RNG draws; deterministic record and replay of game sessions.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_REPLAY_MODULE_PRESENT
+#define  APP_REPLAY_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_REPLAY_IDLE                                   0u
+#define  APP_REPLAY_REC_ARMED                              1u   /* Recording starts with the next round.                */
+#define  APP_REPLAY_REC                                    2u
+#define  APP_REPLAY_PLAY_ARMED                             3u   /* Replay starts with the next round.                   */
+#define  APP_REPLAY_PLAY                                   4u
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT08U  state;       /* APP_REPLAY_xxx                                 */
+    CPU_BOOLEAN fast;        /* 재생: DEF_YES = 최대 속도, DEF_NO = 실시간        */
+    CPU_BOOLEAN full;        /* 녹화가 버퍼를 채워 멈춤                          */
+    CPU_SIZE_T  len;         /* 저널 길이 (octet, 머리 포함)                     */
+    CPU_INT32U  rounds;      /* 녹화: 끝난 라운드, 재생: 재생한 라운드           */
+    CPU_INT32U  mismatches;  /* 재생: 녹화와 결과가 다른 라운드                   */
+    CPU_INT32U  reps;        /* 재생: 끝난 반복                                  */
+    CPU_INT32U  repeat;      /* 재생: 반복 횟수, 0 = 멈출 때까지                  */
+    OS_TICK     ticks;       /* 녹화 / 재생 시간                                 */
+} APP_REPLAY_STATUS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppReplay_Init       (void);
+
+void         AppReplay_RecStart   (void);
+
+CPU_BOOLEAN  AppReplay_PlayStart  (CPU_BOOLEAN          fast,
+                                   CPU_INT32U           repeat);
+
+void         AppReplay_Stop       (void);
+
+void         AppReplay_StatusGet  (APP_REPLAY_STATUS   *p_status);
+
+const CPU_INT08U  *AppReplay_Journal(CPU_SIZE_T        *p_len);
+
+CPU_BOOLEAN  AppReplay_Load       (CPU_SIZE_T           offset,
+                                   const CPU_INT08U    *p_data,
+                                   CPU_SIZE_T           len);
+
+                                                                /* Hooks called by the game tasks ('app.c').            */
+void         AppReplay_RoundStart (void);
+
+void         AppReplay_Input      (APP_INPUT_EVENT      ev);
+
+CPU_BOOLEAN  AppReplay_RandGet    (CPU_INT32U          *p_val);
+
+void         AppReplay_RandPut    (CPU_INT32U           val);
+
+void         AppReplay_Result     (CPU_INT08U           final_door,
+                                   CPU_BOOLEAN          win);
+
+CPU_BOOLEAN  AppReplay_IsPlaying  (void);
+
+CPU_BOOLEAN  AppReplay_IsFast     (void);
+
+
+#endif
@@ -0,0 +1,232 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_stats.c
+* Description   : 64-bit Monty Hall statistics per strategy and initial pick, with streaming moments and
+*                 Wilson confidence intervals.  Shards can be merged.
+*
+* Note(s)       : (1) The per-round outcome x is 0 (lose) or 1 (win).  For such data Welford's running state
+*                     (n, mean, M2) is an exact function of the integer counts (n, w) :
+*
+*                         mean = w / n          M2 = w * (n - w) / n
+*
+*                     so the fast path only keeps the two 64-bit counts (no division, no rounding) and the
+*                     moments are formed when a summary is requested.  Merging two shards with Chan's
+*                     parallel update reduces to adding their counts.
+*
+*                 (2) The Wilson score interval for a binomial proportion p = w / n is :
+*
+*                                    p + z^2 / 2n  -/+  z * sqrt(p(1 - p) / n + z^2 / 4n^2)
+*                         [lo, hi] = ---------------------------------------------------------
+*                                                       1 + z^2 / n
+*
+*                     with z = APP_CFG_STATS_Z_X100 / 100 (1.96 for 95 %).  Unlike p +/- z*sqrt(p(1-p)/n) it
+*                     stays inside [0, 1] and is usable for small n.
+*
+*                 (3) The summary is CPU_FP32.  The losses n - w are counted in 64-bit integers and only
+*                     then converted, so p = w / n and q = (n - w) / n each carry one rounding error of the
+*                     conversions and one of the division, and M2 = w * q a third: a relative error below
+*                     2^-22 for any count, including w or n - w small next to n > 2^24.  Forming q as 1 - p
+*                     instead would lose all of q's digits as p nears 1.  The integer product w * (n - w)
+*                     is not used because it overflows 64 bits once n > 2^32.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app_stats.h"
+
+/*
+*********************************************************************************************************
+*                                           AppStats_Clr()
+*
+* Description : Clear a statistics shard.
+*
+* Argument(s) : p_stats     Pointer to the shard.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppStats_Clr(APP_STATS *p_stats) {
+    Mem_Clr(p_stats, sizeof(*p_stats));
+}
+
+/*
+*********************************************************************************************************
+*                                          AppStats_Merge()
+*
+* Description : Add the counts of one shard to another.
+*
+* Argument(s) : p_dst       Pointer to the shard that receives the sum.
+*
+*               p_src       Pointer to the shard to add.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Note #1 at the top of this file; the merge is exact and order independent.
+*********************************************************************************************************
+*/
+
+void AppStats_Merge(APP_STATS *p_dst, const APP_STATS *p_src) {
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        for (CPU_INT08U i = 0u; i < APP_CFG_STATS_PICK_MAX; i++) {
+            p_dst->cell[s][i].rounds += p_src->cell[s][i].rounds;
+            p_dst->cell[s][i].wins   += p_src->cell[s][i].wins;
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                         AppStats_CellGet()
+*
+* Description : Get the counts for a strategy and initial pick, or a sum over them.
+*
+* Argument(s) : p_stats     Pointer to the shard.
+*
+*               strat       APP_STATS_STRAT_STAY, APP_STATS_STRAT_SWITCH or APP_STATS_ALL.
+*
+*               pick        Initial pick, 1 .. APP_CFG_STATS_PICK_MAX, or APP_STATS_ALL.
+*
+*               p_cell      Pointer to the cell that receives the counts.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppStats_CellGet(const APP_STATS *p_stats, CPU_INT08U strat, CPU_INT08U pick, APP_STATS_CELL *p_cell) {
+    p_cell->rounds = 0u;
+    p_cell->wins = 0u;
+    for (CPU_INT08U s = 0u; s < APP_STATS_STRAT_NBR; s++) {
+        if (strat != APP_STATS_ALL && strat != s) continue;
+        for (CPU_INT08U i = 0u; i < APP_CFG_STATS_PICK_MAX; i++) {
+            if (pick != APP_STATS_ALL && pick != i + 1u) continue;
+            p_cell->rounds += p_stats->cell[s][i].rounds;
+            p_cell->wins   += p_stats->cell[s][i].wins;
+        }
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                        AppStats_Summarize()
+*
+* Description : Compute the running moments and the Wilson confidence interval of a cell.
+*
+* Argument(s) : p_cell      Pointer to the counts.
+*
+*               p_sum       Pointer to the summary.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See Notes #1, #2 & #3 at the top of this file.  This is the slow path; it is only called
+*                   when statistics are displayed or dumped.
+*
+*               (2) An empty cell gives mean 0 and the uninformative interval [0, 1].
+*********************************************************************************************************
+*/
+
+void AppStats_Summarize(const APP_STATS_CELL *p_cell, APP_STATS_SUMMARY *p_sum) {
+    const CPU_FP32 z = (CPU_FP32)APP_CFG_STATS_Z_X100 / 100.0f;
+    CPU_FP32 n, p, q, z2n, denom, center, half;
+
+    p_sum->rounds = p_cell->rounds;
+    p_sum->wins = p_cell->wins;
+    if (p_cell->rounds == 0u) { /* See Note #2 */
+        p_sum->mean = 0.0f;
+        p_sum->m2 = 0.0f;
+        p_sum->var = 0.0f;
+        p_sum->ciLo = 0.0f;
+        p_sum->ciHi = 1.0f;
+        return;
+    }
+
+    n = (CPU_FP32)p_cell->rounds;
+    p = (CPU_FP32)p_cell->wins / n;
+    q = (CPU_FP32)(p_cell->rounds - p_cell->wins) / n; /* 1 - p 대신 정수로 (Note #3) */
+    p_sum->mean = p;
+    p_sum->m2 = (CPU_FP32)p_cell->wins * q; /* = w(n - w) / n */
+    p_sum->var = (p_cell->rounds > 1u) ? p_sum->m2 / (n - 1.0f) : 0.0f;
+
+    z2n = (z * z) / n;
+    denom = 1.0f + z2n;
+    center = (p + z2n / 2.0f) / denom;
+    half = (z * sqrtf(p * q / n + z2n / (4.0f * n))) / denom;
+    p_sum->ciLo = (center - half < 0.0f) ? 0.0f : center - half;
+    p_sum->ciHi = (center + half > 1.0f) ? 1.0f : center + half;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppStats_Permille()
+*
+* Description : Convert a ratio in [0, 1] to rounded per mille, for printing without floating point
+*               format support.
+*
+* Argument(s) : ratio       Ratio to convert.
+*
+* Return(s)   : 0 .. 1000.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U AppStats_Permille(CPU_FP32 ratio) {
+    if (ratio <= 0.0f) return 0u;
+    if (ratio >= 1.0f) return 1000u;
+    return (CPU_INT32U)(ratio * 1000.0f + 0.5f);
+}
+
+/*
+*********************************************************************************************************
+*                                         AppStats_U64ToStr()
+*
+* Description : Format a 64-bit unsigned value in decimal.
+*
+* Argument(s) : val         Value to format.
+*
+*               p_buf       Buffer of at least APP_STATS_U64_STR_LEN octets.
+*
+* Return(s)   : p_buf.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The C library's printf() on the target is not built with 'long long' support.
+*********************************************************************************************************
+*/
+
+char *AppStats_U64ToStr(CPU_INT64U val, char *p_buf) {
+    char tmp[APP_STATS_U64_STR_LEN];
+    CPU_INT08U len = 0u;
+    CPU_INT08U i;
+
+    do {
+        tmp[len++] = (char)('0' + (CPU_INT08U)(val % 10u));
+        val /= 10u;
+    } while (val != 0u);
+
+    for (i = 0u; i < len; i++) {
+        p_buf[i] = tmp[len - 1u - i];
+    }
+    p_buf[len] = '\0';
+    return p_buf;
+}
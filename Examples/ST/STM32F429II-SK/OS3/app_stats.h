@@ -0,0 +1,107 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_stats.h
+* Description   : 64-bit Monty Hall statistics per strategy and initial pick, with streaming moments and
+*                 Wilson confidence intervals.  Shards can be merged.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_STATS_MODULE_PRESENT
+#define  APP_STATS_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  APP_STATS_STRAT_STAY                              0u
+#define  APP_STATS_STRAT_SWITCH                            1u
+#define  APP_STATS_STRAT_NBR                               2u
+
+#define  APP_STATS_ALL                                  0xFFu   /* Sum over every strategy and/or initial pick.         */
+
+#define  APP_STATS_U64_STR_LEN                            21u   /* 20 digits + NUL.                                     */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*
+* Note(s) : (1) Each cell holds the rounds played & won for one (strategy, initial pick) pair.  Doors are
+*               numbered from 1; cell[s][0] is door 1.
+*
+*           (2) A shard is updated by a single task.  Merging shards (AppStats_Merge()) is exact since it
+*               only adds counts.
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT64U rounds;
+    CPU_INT64U wins;
+} APP_STATS_CELL;
+
+typedef struct {
+    APP_STATS_CELL cell[APP_STATS_STRAT_NBR][APP_CFG_STATS_PICK_MAX];
+} APP_STATS;
+
+typedef struct {
+    CPU_INT64U rounds;
+    CPU_INT64U wins;
+    CPU_FP32   mean;  /* Welford 평균 (= 승률)                */
+    CPU_FP32   m2;    /* Welford M2 (편차 제곱합)             */
+    CPU_FP32   var;   /* 표본 분산 = M2 / (n - 1)             */
+    CPU_FP32   ciLo;  /* Wilson 신뢰구간 하한                 */
+    CPU_FP32   ciHi;  /* Wilson 신뢰구간 상한                 */
+} APP_STATS_SUMMARY;
+
+
+/*
+*********************************************************************************************************
+*                                               MACROS
+*
+* Note(s) : (1) AppStats_Add() is the per-round fast path: two 64-bit additions, no branch and no
+*               division.  'pick' MUST be 1 .. APP_CFG_STATS_PICK_MAX and 'win' MUST be 0 or 1.
+*********************************************************************************************************
+*/
+
+static inline void AppStats_Add(APP_STATS *p_stats, CPU_INT08U strat, CPU_INT08U pick, CPU_INT08U win) {
+    APP_STATS_CELL *p_cell = &p_stats->cell[strat][pick - 1u];
+
+    p_cell->rounds++;
+    p_cell->wins += win;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppStats_Clr      (APP_STATS                *p_stats);
+
+void         AppStats_Merge    (APP_STATS                *p_dst,
+                                const APP_STATS          *p_src);
+
+void         AppStats_CellGet  (const APP_STATS          *p_stats,
+                                CPU_INT08U                strat,
+                                CPU_INT08U                pick,
+                                APP_STATS_CELL           *p_cell);
+
+void         AppStats_Summarize(const APP_STATS_CELL     *p_cell,
+                                APP_STATS_SUMMARY        *p_sum);
+
+CPU_INT32U   AppStats_Permille (CPU_FP32                  ratio);
+
+char        *AppStats_U64ToStr (CPU_INT64U                val,
+                                char                     *p_buf);
+
+
+#endif
@@ -0,0 +1,678 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_telem.c
+* Description   : Binary telemetry on COM1 : COBS framed, CRC checked, delta/varint encoded records.
+*
+* Note(s)       : (1) 'render telem' (App_RenderModeSet(APP_RENDER_TELEM)) replaces the ANSI screen by this
+*                     stream.  The game task stops drawing and console replies are sent as TRACE records
+*                     (Console_Printf()), so the telemetry task is the only writer on COM1.  It still takes
+*                     App_TermLock() per frame, so a mode change never cuts a frame or a reply in two.
+*
+*                 (2) Frame, before COBS :
+*
+*                         seq (1) | record | record | ... | CRC (2)
+*
+*                     'seq' counts frames modulo 256, so the decoder sees lost frames.  The CRC is
+*                     CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), low octet first, over 'seq' and the
+*                     records.  The frame is COBS encoded and ended by a 0x00 delimiter; a frame that starts
+*                     with a SYNC record is also preceded by a 0x00 so that any text already on the line is
+*                     cut off.  Records are packed into a frame up to APP_CFG_TELEM_FRAME_SIZE octets, and
+*                     the frame is sent when the next record might not fit or the task goes back to sleep.
+*
+*                 (3) Record : type (1) | dt | body.  'dt' is the number of ticks since the previous record.
+*                     All numbers are varints (LEB128, 7 bits per octet, low bits first); 'zz' marks a
+*                     signed value in zigzag form.  Bodies :
+*
+*                         SYNC       version, tick rate [Hz], CPU clock [Hz], tick, picks per strategy
+*                         ROUND      round delta (mod 2^24), win | strat << 1 | (pick - 1) << 2 | (prize - 1) << 5
+*                         STATS      cell mask, then per set bit (lowest first) zz rounds delta, zz wins delta
+*                         KERNEL     zz CPU usage delta, zz CPU usage peak delta, context switch delta,
+*                                    task count, drop delta
+*                         TASK       slot, prio, stack size, name length, name
+*                         TASK_STAT  slot, zz CPU usage delta, context switch delta, zz stack used delta
+*                         TRACE      stream offset, length, octets
+*                         PERIOD     slot, period [us], zz releases delta, zz misses delta, zz skipped delta,
+*                                    jitter max [us], exec max [us], name length, name
+*                         PERIOD_HIST slot, histogram (0 jitter, 1 exec), first bin, bin count,
+*                                    zz count delta per bin
+*
+*                     A delta is taken against the previous record of the same type (and slot).  SYNC
+*                     resets every delta base to 0, so the first records after it hold absolute values and
+*                     a decoder can start at any SYNC.  Statistics cell 'i' is strategy i / picks, door
+*                     i % picks + 1.  CPU usage is in 0.01 %, stack sizes in CPU_STK units.
+*                     Periodic task slots follow AppPeriod_StatusGet() ('app_period.c'); histogram bins
+*                     are log2 us, and only the parts of a histogram that changed are sent.
+*
+*                 (4) A round costs 4 or 5 octets of record, and a frame adds 5 (seq, CRC, COBS code and
+*                     delimiter); at 115200 bd that is 1000 to 2000 rounds/s, against some 20 ANSI screens/s.
+*                     STATS records go out once per APP_CFG_TELEM_PERIOD_MS and only for cells that
+*                     changed, KERNEL, TASK_STAT and PERIOD every APP_CFG_TELEM_KERNEL_DIV periods, and SYNC
+*                     (with the TASK records) every APP_CFG_TELEM_SYNC_DIV periods.
+*
+*                 (5) The trace stream is a ring of APP_CFG_TELEM_TRACE_BUF_SIZE octets.  AppTelem_TraceWrite()
+*                     never blocks: the console writes while holding COM1, so waiting for the telemetry task
+*                     to drain the ring would deadlock.  What does not fit is dropped and counted; the
+*                     decoder sees the gap in the TRACE offsets.
+*
+*                 (6) 'Tools/telem_decode.py' decodes the stream into one CSV file per record type.
+*********************************************************************************************************
+*/
+
+#include <includes.h>
+
+#include "app.h"
+#include "app_period.h"
+#include "app_telem.h"
+
+#define TELEM_MSG_KICK             0u   /* 트레이스가 쌓였음                    */
+#define TELEM_MSG_ROUND            1u   /* 메시지 포인터 = 라운드 (Note #3)      */
+
+#define TELEM_REC_LEN_MAX         80u   /* type + dt + 가장 긴 본문 (TRACE)      */
+#define TELEM_NAME_LEN_MAX        24u
+#define TELEM_TRACE_CHUNK         64u
+#define TELEM_STATS_CELL_NBR      (APP_STATS_STRAT_NBR * APP_CFG_STATS_PICK_MAX)
+#define TELEM_STATS_CELLS_PER_REC  3u   /* 셀 하나 최대 20 B                    */
+#define TELEM_PHIST_BINS_PER_REC   8u   /* 구간 하나 최대 5 B                    */
+
+#if (APP_CFG_TELEM_FRAME_SIZE < TELEM_REC_LEN_MAX + 3u) || (APP_CFG_TELEM_FRAME_SIZE > 254u)
+#error  "APP_CFG_TELEM_FRAME_SIZE        illegally #define'd in 'app_cfg.h' [MUST be 83 .. 254]"
+#endif
+
+#if ((APP_CFG_TELEM_TRACE_BUF_SIZE & (APP_CFG_TELEM_TRACE_BUF_SIZE - 1u)) != 0u)
+#error  "APP_CFG_TELEM_TRACE_BUF_SIZE    illegally #define'd in 'app_cfg.h' [MUST be a power of 2]"
+#endif
+
+#if (TELEM_STATS_CELL_NBR > 32u)
+#error  "APP_CFG_STATS_PICK_MAX          illegally #define'd in 'app_cfg.h' [MUST be <= 16 for telemetry]"
+#endif
+
+typedef struct {
+    OS_CPU_USAGE usage;
+    OS_CTX_SW_CTR ctxSw;
+    CPU_STK_SIZE stkUsed;
+} TELEM_TASK;
+
+BSP_CCM_DATA static OS_TCB TelemTCB;
+BSP_CCM_DATA static CPU_STK TelemStk[APP_CFG_TASK_TELEM_STK_SIZE];
+
+static CPU_INT08U TelemFrame[APP_CFG_TELEM_FRAME_SIZE];
+static CPU_SIZE_T TelemFrameLen;                                /* 0 = 빈 프레임 (seq 도 아직 없음) */
+static CPU_INT08U TelemCobs[1u + APP_CFG_TELEM_FRAME_SIZE + 1u + 1u]; /* 앞 0x00 + 코드 + 본문 + 뒤 0x00 */
+static CPU_INT08U TelemSeq;
+static CPU_BOOLEAN TelemLeadDelim;
+
+/* delta 기준값: Telem_Sync() 에서 0 으로 */
+static OS_TICK TelemTickLast;
+static CPU_INT32U TelemRoundLast;
+static APP_STATS TelemStatsLast;
+static APP_STATS TelemStatsCur;                                 /* 스택 대신 (256 B) */
+static OS_CPU_USAGE TelemUsageLast;
+static OS_CPU_USAGE TelemUsageMaxLast;
+static OS_CTX_SW_CTR TelemCtxSwLast;
+static CPU_INT32U TelemDropsLast;
+static CPU_INT08U TelemTaskNbr;
+static TELEM_TASK TelemTask[APP_CFG_TELEM_TASK_MAX];
+static OS_TCB *TelemTaskTcb[APP_CFG_TELEM_TASK_MAX];
+static APP_PERIOD_STATS TelemPeriodLast[APP_CFG_TELEM_PERIOD_MAX];
+static APP_PERIOD_STATUS TelemPeriodCur;                        /* 스택 대신 */
+
+static CPU_INT08U TelemTraceBuf[APP_CFG_TELEM_TRACE_BUF_SIZE];  /* Note #5 */
+static CPU_INT32U TelemTraceWr;                                 /* 쓴/읽은 바이트 누적 = 스트림 오프셋 */
+static CPU_INT32U TelemTraceRd;
+static CPU_BOOLEAN TelemKickPending;
+
+static APP_TELEM_STATS TelemCtr;
+
+/*-------------------------------------------------------------*/
+/*  인코딩 (Note #2, #3)                                        */
+/*-------------------------------------------------------------*/
+static inline void Telem_PutU8(CPU_INT08U v) {
+    TelemFrame[TelemFrameLen++] = v;
+}
+
+static void Telem_PutVar(CPU_INT64U v) {
+    while (v >= 0x80u) {
+        Telem_PutU8((CPU_INT08U)(v | 0x80u));
+        v >>= 7;
+    }
+    Telem_PutU8((CPU_INT08U)v);
+}
+
+static inline void Telem_PutZz(CPU_INT64S v) {
+    Telem_PutVar(((CPU_INT64U)v << 1) ^ (CPU_INT64U)(v >> 63));
+}
+
+/* CRC-16/CCITT-FALSE, 니블 테이블 */
+static CPU_INT16U Telem_Crc16(const CPU_INT08U *p_data, CPU_SIZE_T len) {
+    static const CPU_INT16U tbl[16] = {0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+                                       0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu};
+    CPU_INT16U crc = 0xFFFFu;
+
+    while (len-- != 0u) {
+        CPU_INT08U b = *p_data++;
+        crc = (CPU_INT16U)((crc << 4) ^ tbl[(crc >> 12) ^ (b >> 4)]);
+        crc = (CPU_INT16U)((crc << 4) ^ tbl[(crc >> 12) ^ (b & 0x0Fu)]);
+    }
+    return crc;
+}
+
+/* COBS, len < 255 이므로 코드 바이트는 0x00 마다 하나 + 맨 앞 하나 */
+static CPU_SIZE_T Telem_Cobs(const CPU_INT08U *p_src, CPU_SIZE_T len, CPU_INT08U *p_dst) {
+    CPU_SIZE_T codeIx = 0u;
+    CPU_SIZE_T n = 1u;
+    CPU_INT08U code = 1u;
+
+    while (len-- != 0u) {
+        CPU_INT08U b = *p_src++;
+        if (b == 0u) {
+            p_dst[codeIx] = code;
+            codeIx = n++;
+            code = 1u;
+        } else {
+            p_dst[n++] = b;
+            code++;
+        }
+    }
+    p_dst[codeIx] = code;
+    return n;
+}
+
+static void Telem_Flush(void) {
+    CPU_INT16U crc;
+    CPU_SIZE_T n = 0u;
+
+    if (TelemFrameLen == 0u) {
+        return;
+    }
+    crc = Telem_Crc16(TelemFrame, TelemFrameLen);
+    Telem_PutU8((CPU_INT08U)crc);
+    Telem_PutU8((CPU_INT08U)(crc >> 8));
+
+    if (TelemLeadDelim == DEF_YES) {
+        TelemLeadDelim = DEF_NO;
+        TelemCobs[n++] = 0x00u;
+    }
+    n += Telem_Cobs(TelemFrame, TelemFrameLen, &TelemCobs[n]);
+    TelemCobs[n++] = 0x00u;
+    TelemFrameLen = 0u;
+
+    App_TermLock();
+    send_bytes(TelemCobs, n);
+    App_TermUnlock();
+
+    TelemCtr.frames++;
+    TelemCtr.octets += n;
+}
+
+/* 레코드 머리: 자리가 모자랄 수 있으면 먼저 프레임을 보냄 */
+static void Telem_RecBegin(CPU_INT08U type) {
+    OS_ERR err;
+    OS_TICK now = OSTimeGet(&err);
+
+    if (TelemFrameLen + TELEM_REC_LEN_MAX + 2u > APP_CFG_TELEM_FRAME_SIZE) {
+        Telem_Flush();
+    }
+    if (TelemFrameLen == 0u) {
+        Telem_PutU8(TelemSeq++);
+    }
+    Telem_PutU8(type);
+    Telem_PutVar(now - TelemTickLast);
+    TelemTickLast = now;
+    TelemCtr.records++;
+}
+
+/*-------------------------------------------------------------*/
+/*  레코드                                                      */
+/*-------------------------------------------------------------*/
+static void Telem_RecSync(void) {
+    OS_ERR err;
+
+    Telem_Flush();
+    TelemLeadDelim = DEF_YES;
+
+    TelemTickLast = OSTimeGet(&err);
+    TelemRoundLast = 0u;
+    AppStats_Clr(&TelemStatsLast);
+    TelemUsageLast = 0u;
+    TelemUsageMaxLast = 0u;
+    TelemCtxSwLast = 0u;
+    TelemDropsLast = 0u;
+    TelemTaskNbr = 0u; /* 다음 KERNEL 레코드가 TASK 레코드를 다시 보냄 */
+    Mem_Clr(TelemPeriodLast, sizeof TelemPeriodLast);
+
+    Telem_RecBegin(APP_TELEM_REC_SYNC);
+    Telem_PutVar(APP_TELEM_VERSION);
+    Telem_PutVar(OSCfg_TickRate_Hz);
+    Telem_PutVar(BSP_CPU_ClkFreq());
+    Telem_PutVar(TelemTickLast);
+    Telem_PutVar(APP_CFG_STATS_PICK_MAX);
+}
+
+static void Telem_RecRound(CPU_INT32U msg) {
+    CPU_INT32U round = msg >> 8;
+
+    Telem_RecBegin(APP_TELEM_REC_ROUND);
+    Telem_PutVar((round - TelemRoundLast) & 0x00FFFFFFu);
+    Telem_PutVar(msg & 0xFFu);
+    TelemRoundLast = round;
+}
+
+static void Telem_RecStats(void) {
+    APP_STATS_CELL *p_cur = &TelemStatsCur.cell[0][0];
+    APP_STATS_CELL *p_last = &TelemStatsLast.cell[0][0];
+    CPU_INT32U mask = 0u;
+
+    App_StatsRead(&TelemStatsCur);
+    for (CPU_INT08U i = 0u; i < TELEM_STATS_CELL_NBR; i++) {
+        if ((p_cur[i].rounds != p_last[i].rounds) || (p_cur[i].wins != p_last[i].wins)) {
+            mask |= (CPU_INT32U)1u << i;
+        }
+    }
+
+    while (mask != 0u) { /* 레코드 하나에 셀 TELEM_STATS_CELLS_PER_REC 개까지 */
+        CPU_INT32U sub = 0u;
+
+        for (CPU_INT08U k = 0u; (k < TELEM_STATS_CELLS_PER_REC) && (mask != 0u); k++) {
+            CPU_INT32U bit = mask & (0u - mask);
+            sub |= bit;
+            mask &= ~bit;
+        }
+        Telem_RecBegin(APP_TELEM_REC_STATS);
+        Telem_PutVar(sub);
+        for (CPU_INT08U i = 0u; i < TELEM_STATS_CELL_NBR; i++) {
+            if ((sub & ((CPU_INT32U)1u << i)) != 0u) {
+                Telem_PutZz((CPU_INT64S)(p_cur[i].rounds - p_last[i].rounds));
+                Telem_PutZz((CPU_INT64S)(p_cur[i].wins - p_last[i].wins));
+                p_last[i] = p_cur[i];
+            }
+        }
+    }
+}
+
+static void Telem_RecTasks(void) {
+#if (OS_CFG_DBG_EN > 0u)
+    OS_TCB *p_tcb;
+    CPU_INT08U nbr = 0u;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    p_tcb = OSTaskDbgListPtr;
+    while ((p_tcb != (OS_TCB *)0) && (nbr < APP_CFG_TELEM_TASK_MAX)) {
+        TelemTaskTcb[nbr++] = p_tcb;
+        p_tcb = p_tcb->DbgNextPtr;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (nbr != TelemTaskNbr) { /* 태스크가 생김 (또는 SYNC): 슬롯을 다시 알림 */
+        TelemTaskNbr = nbr;
+        Mem_Clr(TelemTask, sizeof TelemTask);
+        for (CPU_INT08U i = 0u; i < nbr; i++) {
+            const CPU_CHAR *name = TelemTaskTcb[i]->NamePtr;
+            CPU_SIZE_T len = Str_Len_N(name, TELEM_NAME_LEN_MAX);
+
+            Telem_RecBegin(APP_TELEM_REC_TASK);
+            Telem_PutVar(i);
+            Telem_PutVar(TelemTaskTcb[i]->Prio);
+            Telem_PutVar(TelemTaskTcb[i]->StkSize);
+            Telem_PutVar(len);
+            for (CPU_SIZE_T k = 0u; k < len; k++) {
+                Telem_PutU8((CPU_INT08U)name[k]);
+            }
+        }
+    }
+
+    for (CPU_INT08U i = 0u; i < nbr; i++) {
+        TELEM_TASK cur = {0u, 0u, 0u};
+        OS_ERR err;
+
+#if (OS_CFG_TASK_PROFILE_EN > 0u)
+        CPU_CRITICAL_ENTER();
+        cur.usage = TelemTaskTcb[i]->CPUUsage;
+        cur.ctxSw = TelemTaskTcb[i]->CtxSwCtr;
+        CPU_CRITICAL_EXIT();
+#endif
+#if (OS_CFG_STAT_TASK_STK_CHK_EN > 0u)
+        CPU_STK_SIZE stkFree;
+        OSTaskStkChk(TelemTaskTcb[i], &stkFree, &cur.stkUsed, &err);
+        if (err != OS_ERR_NONE) {
+            cur.stkUsed = 0u; /* OS_OPT_TASK_STK_CHK 없이 만든 태스크 */
+        }
+#endif
+        Telem_RecBegin(APP_TELEM_REC_TASK_STAT);
+        Telem_PutVar(i);
+        Telem_PutZz((CPU_INT64S)cur.usage - (CPU_INT64S)TelemTask[i].usage);
+        Telem_PutVar((CPU_INT32U)(cur.ctxSw - TelemTask[i].ctxSw));
+        Telem_PutZz((CPU_INT64S)cur.stkUsed - (CPU_INT64S)TelemTask[i].stkUsed);
+        TelemTask[i] = cur;
+    }
+#endif
+}
+
+static void Telem_RecPeriods(void) {
+    APP_PERIOD_STATS *p_cur = &TelemPeriodCur.stats;
+    CPU_SIZE_T len;
+
+    for (CPU_INT08U i = 0u; i < APP_CFG_TELEM_PERIOD_MAX; i++) {
+        if (AppPeriod_StatusGet(i, &TelemPeriodCur) != DEF_OK) {
+            break;
+        }
+        APP_PERIOD_STATS *p_last = &TelemPeriodLast[i];
+
+        len = Str_Len_N(TelemPeriodCur.name, TELEM_NAME_LEN_MAX);
+        Telem_RecBegin(APP_TELEM_REC_PERIOD);
+        Telem_PutVar(i);
+        Telem_PutVar(TelemPeriodCur.period_us);
+        Telem_PutZz((CPU_INT64S)p_cur->releases - (CPU_INT64S)p_last->releases); /* 'period clear' 뒤엔 음수 */
+        Telem_PutZz((CPU_INT64S)p_cur->misses - (CPU_INT64S)p_last->misses);
+        Telem_PutZz((CPU_INT64S)p_cur->skipped - (CPU_INT64S)p_last->skipped);
+        Telem_PutVar(AppPeriod_TsToUs(p_cur->jitter_max));
+        Telem_PutVar(AppPeriod_TsToUs(p_cur->exec_max));
+        Telem_PutVar(len);
+        for (CPU_SIZE_T k = 0u; k < len; k++) {
+            Telem_PutU8((CPU_INT08U)TelemPeriodCur.name[k]);
+        }
+
+        for (CPU_INT08U h = 0u; h < APP_PERIOD_HIST_NBR; h++) {
+            for (CPU_INT08U b0 = 0u; b0 < APP_CFG_PERIOD_HIST_BINS; b0 += TELEM_PHIST_BINS_PER_REC) {
+                CPU_INT08U n = (CPU_INT08U)DEF_MIN(TELEM_PHIST_BINS_PER_REC, APP_CFG_PERIOD_HIST_BINS - b0);
+
+                if (Mem_Cmp(&p_cur->hist[h][b0], &p_last->hist[h][b0], n * sizeof(CPU_INT32U)) == DEF_YES) {
+                    continue; /* 바뀐 것만 */
+                }
+                Telem_RecBegin(APP_TELEM_REC_PERIOD_HIST);
+                Telem_PutVar(i);
+                Telem_PutVar(h);
+                Telem_PutVar(b0);
+                Telem_PutVar(n);
+                for (CPU_INT08U b = b0; b < b0 + n; b++) {
+                    Telem_PutZz((CPU_INT64S)p_cur->hist[h][b] - (CPU_INT64S)p_last->hist[h][b]);
+                }
+            }
+        }
+        *p_last = *p_cur;
+    }
+}
+
+static void Telem_RecKernel(void) {
+    OS_CPU_USAGE usage, usageMax;
+    OS_CTX_SW_CTR ctxSw;
+    CPU_INT32U drops;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    usage = OSStatTaskCPUUsage;
+    usageMax = OSStatTaskCPUUsageMax;
+    ctxSw = OSTaskCtxSwCtr;
+    drops = TelemCtr.roundDrops + TelemCtr.traceDrops;
+    CPU_CRITICAL_EXIT();
+
+    Telem_RecBegin(APP_TELEM_REC_KERNEL);
+    Telem_PutZz((CPU_INT64S)usage - (CPU_INT64S)TelemUsageLast);
+    Telem_PutZz((CPU_INT64S)usageMax - (CPU_INT64S)TelemUsageMaxLast);
+    Telem_PutVar((CPU_INT32U)(ctxSw - TelemCtxSwLast));
+    Telem_PutVar(OSTaskQty);
+    Telem_PutVar(drops - TelemDropsLast);
+    TelemUsageLast = usage;
+    TelemUsageMaxLast = usageMax;
+    TelemCtxSwLast = ctxSw;
+    TelemDropsLast = drops;
+
+    Telem_RecTasks();
+    Telem_RecPeriods();
+}
+
+static void Telem_RecTrace(void) {
+    CPU_INT32U rd, avail;
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    TelemKickPending = DEF_NO; /* 이후에 쓰면 다시 깨움 */
+    rd = TelemTraceRd;
+    avail = TelemTraceWr - rd;
+    CPU_CRITICAL_EXIT();
+
+    while (avail != 0u) {
+        CPU_INT32U n = (avail < TELEM_TRACE_CHUNK) ? avail : TELEM_TRACE_CHUNK;
+
+        Telem_RecBegin(APP_TELEM_REC_TRACE);
+        Telem_PutVar(rd);
+        Telem_PutVar(n);
+        for (CPU_INT32U k = 0u; k < n; k++) {
+            Telem_PutU8(TelemTraceBuf[(rd + k) & (APP_CFG_TELEM_TRACE_BUF_SIZE - 1u)]);
+        }
+        rd += n;
+        avail -= n;
+
+        CPU_CRITICAL_ENTER();
+        TelemTraceRd = rd;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+/*-------------------------------------------------------------*/
+/*  텔레메트리 태스크                                            */
+/*-------------------------------------------------------------*/
+static void AppTask_Telem(void *p_arg) {
+    OS_ERR err;
+    const OS_TICK period = (APP_CFG_TELEM_PERIOD_MS * OSCfg_TickRate_Hz + 999u) / 1000u;
+    OS_TICK next = OSTimeGet(&err) + period;
+    OS_TICK dly;
+    CPU_INT32U periods = 0u;
+    CPU_BOOLEAN on = DEF_NO;
+    OS_MSG_SIZE size;
+    void *p_msg;
+
+    (void)p_arg;
+
+    for (;;) {
+        dly = next - OSTimeGet(&err);
+        if ((dly == 0u) || (dly > period)) { /* 이미 지남 */
+            dly = 1u;
+        }
+        p_msg = OSTaskQPend(dly, OS_OPT_PEND_BLOCKING, &size, (CPU_TS *)0, &err);
+
+        if (App_RenderModeGet() != APP_RENDER_TELEM) { /* 꺼져 있으면 메시지는 버림 */
+            on = DEF_NO;
+            next = OSTimeGet(&err) + period;
+            continue;
+        }
+        if (on == DEF_NO) { /* 켜짐: SYNC 부터, 첫 주기에 KERNEL 레코드 */
+            on = DEF_YES;
+            Telem_RecSync();
+            periods = 0u;
+            next = OSTimeGet(&err);
+        }
+
+        while (err == OS_ERR_NONE) { /* 쌓인 라운드를 한 번에 */
+            if (size == TELEM_MSG_ROUND) {
+                Telem_RecRound((CPU_INT32U)(CPU_ADDR)p_msg);
+            }
+            p_msg = OSTaskQPend(0u, OS_OPT_PEND_NON_BLOCKING, &size, (CPU_TS *)0, &err);
+        }
+
+        if ((OS_TICK)(OSTimeGet(&err) - next) < 0x80000000u) {
+            next += period;
+            if (periods == APP_CFG_TELEM_SYNC_DIV) {
+                Telem_RecSync();
+                periods = 0u;
+            }
+            Telem_RecStats();
+            if ((periods % APP_CFG_TELEM_KERNEL_DIV) == 0u) {
+                Telem_RecKernel();
+            }
+            periods++;
+        }
+
+        Telem_RecTrace();
+        Telem_Flush();
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                           AppTelem_Init()
+*
+* Description : Create the telemetry task.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTaskCreate().
+*
+* Note(s)     : (1) The task sleeps in its message queue; it only encodes and sends while the render mode
+*                   is APP_RENDER_TELEM.
+*********************************************************************************************************
+*/
+
+void AppTelem_Init(void) {
+    OS_ERR err;
+
+    OSTaskCreate(&TelemTCB, "AppTask_Telem",
+                 AppTask_Telem, 0u,
+                 APP_CFG_TASK_TELEM_PRIO,
+                 &TelemStk[0],
+                 APP_CFG_TASK_TELEM_STK_SIZE / 10u,
+                 APP_CFG_TASK_TELEM_STK_SIZE,
+                 APP_CFG_TELEM_Q_SIZE, 0u, 0u,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+}
+
+/*
+*********************************************************************************************************
+*                                          AppTelem_Round()
+*
+* Description : Queue a ROUND record for a finished interactive round.
+*
+* Argument(s) : round       Round number (GameState_t.roundCount).
+*
+*               strat       APP_STATS_STRAT_STAY or APP_STATS_STRAT_SWITCH.
+*
+*               pick        First pick,  1 .. APP_CFG_STATS_PICK_MAX.
+*
+*               prize       Prize door,  1 .. APP_CFG_STATS_PICK_MAX.
+*
+*               win         1 if the round was won, 0 otherwise.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : AppTask_GameLogic().
+*
+* Note(s)     : (1) Does nothing unless the stream is on.  If the queue is full the round is dropped and
+*                   counted; the STATS records still carry it.
+*********************************************************************************************************
+*/
+
+void AppTelem_Round(CPU_INT32U round, CPU_INT08U strat, CPU_INT08U pick, CPU_INT08U prize, CPU_INT08U win) {
+    OS_ERR err;
+    CPU_INT32U msg;
+    CPU_SR_ALLOC();
+
+    if (App_RenderModeGet() != APP_RENDER_TELEM) {
+        return;
+    }
+    msg = (round << 8)
+        | (CPU_INT32U)win
+        | ((CPU_INT32U)strat << 1)
+        | ((CPU_INT32U)(pick - 1u) << 2)
+        | ((CPU_INT32U)(prize - 1u) << 5);
+    OSTaskQPost(&TelemTCB, (void *)(CPU_ADDR)msg, TELEM_MSG_ROUND, OS_OPT_POST_FIFO, &err);
+    if (err != OS_ERR_NONE) {
+        CPU_CRITICAL_ENTER();
+        TelemCtr.roundDrops++;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+/*
+*********************************************************************************************************
+*                                        AppTelem_TraceWrite()
+*
+* Description : Append octets to the trace stream.
+*
+* Argument(s) : p_data      Pointer to the octets.
+*
+*               len         Number of octets.
+*
+* Return(s)   : Number of octets taken; the rest is dropped.
+*
+* Caller(s)   : Console_Printf(), application tasks.
+*
+* Note(s)     : (1) Never blocks (see Note #5 at the top of this file).  Octets are copied at most
+*                   TELEM_TRACE_CHUNK at a time with interrupts disabled.
+*
+*               (2) Does nothing unless the stream is on.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T AppTelem_TraceWrite(const void *p_data, CPU_SIZE_T len) {
+    const CPU_INT08U *p_src = (const CPU_INT08U *)p_data;
+    CPU_SIZE_T taken = 0u;
+    CPU_BOOLEAN kick;
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    if (App_RenderModeGet() != APP_RENDER_TELEM) {
+        return 0u;
+    }
+    while (taken < len) {
+        CPU_SIZE_T n = len - taken;
+
+        CPU_CRITICAL_ENTER();
+        CPU_INT32U room = APP_CFG_TELEM_TRACE_BUF_SIZE - (TelemTraceWr - TelemTraceRd);
+        if (n > room) n = room;
+        if (n > TELEM_TRACE_CHUNK) n = TELEM_TRACE_CHUNK;
+        for (CPU_SIZE_T k = 0u; k < n; k++) {
+            TelemTraceBuf[(TelemTraceWr + k) & (APP_CFG_TELEM_TRACE_BUF_SIZE - 1u)] = p_src[taken + k];
+        }
+        TelemTraceWr += n;
+        CPU_CRITICAL_EXIT();
+
+        if (n == 0u) { /* 가득 참 */
+            break;
+        }
+        taken += n;
+    }
+
+    CPU_CRITICAL_ENTER();
+    TelemCtr.traceDrops += (CPU_INT32U)(len - taken);
+    kick = (taken != 0u) && (TelemKickPending == DEF_NO);
+    if (kick == DEF_YES) {
+        TelemKickPending = DEF_YES;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (kick == DEF_YES) {
+        OSTaskQPost(&TelemTCB, (void *)0, TELEM_MSG_KICK, OS_OPT_POST_FIFO, &err);
+    }
+    return taken;
+}
+
+/*
+*********************************************************************************************************
+*                                         AppTelem_StatsGet()
+*
+* Description : Get the telemetry counters.
+*
+* Argument(s) : p_stats     Pointer to the counter copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void AppTelem_StatsGet(APP_TELEM_STATS *p_stats) {
+    CPU_SR_ALLOC();
+
+    CPU_CRITICAL_ENTER();
+    *p_stats = TelemCtr;
+    CPU_CRITICAL_EXIT();
+}
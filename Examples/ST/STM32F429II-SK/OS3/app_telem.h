@@ -0,0 +1,74 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_telem.h
+* Description   : Binary telemetry on COM1 : COBS framed, CRC checked, delta/varint encoded records.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_TELEM_MODULE_PRESENT
+#define  APP_TELEM_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*
+* Note(s) : (1) Record types; see Note #3 at the top of 'app_telem.c' for the layout of each record.  The
+*               host decoder ('Tools/telem_decode.py') MUST be kept in step with these values.
+*********************************************************************************************************
+*/
+
+#define  APP_TELEM_VERSION                                 2u
+
+#define  APP_TELEM_REC_SYNC                                1u   /* Stream parameters, resets every delta.               */
+#define  APP_TELEM_REC_ROUND                               2u   /* One interactive game round.                          */
+#define  APP_TELEM_REC_STATS                               3u   /* Changed statistics cells.                            */
+#define  APP_TELEM_REC_KERNEL                              4u   /* OSStatTaskCPUUsage, context switches, drops.         */
+#define  APP_TELEM_REC_TASK                                5u   /* Task slot name, priority and stack size.             */
+#define  APP_TELEM_REC_TASK_STAT                           6u   /* Task slot CPU usage, context switches, stack used.   */
+#define  APP_TELEM_REC_TRACE                               7u   /* Chunk of the trace byte stream.                      */
+#define  APP_TELEM_REC_PERIOD                              8u   /* Periodic task releases, misses, worst times.         */
+#define  APP_TELEM_REC_PERIOD_HIST                         9u   /* Part of a periodic task jitter or exec. histogram.   */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U frames;      /* 보낸 프레임                             */
+    CPU_INT32U records;     /* 보낸 레코드                             */
+    CPU_INT32U octets;      /* COM1 에 쓴 바이트 (COBS, 구분자 포함)     */
+    CPU_INT32U roundDrops;  /* 큐가 차서 버린 라운드                    */
+    CPU_INT32U traceDrops;  /* 버퍼가 차서 버린 트레이스 바이트          */
+} APP_TELEM_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         AppTelem_Init      (void);
+
+void         AppTelem_Round     (CPU_INT32U          round,
+                                 CPU_INT08U          strat,
+                                 CPU_INT08U          pick,
+                                 CPU_INT08U          prize,
+                                 CPU_INT08U          win);
+
+CPU_SIZE_T   AppTelem_TraceWrite(const void         *p_data,
+                                 CPU_SIZE_T          len);
+
+void         AppTelem_StatsGet  (APP_TELEM_STATS    *p_stats);
+
+
+#endif
@@ -0,0 +1,134 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_zlat.c
+* Description   : Zero latency interrupt probe: worst-case entry latency of an ISR the kernel never masks.
+*
+* Note(s)       : (1) A basic timer (APP_CFG_BENCH_ZLAT_INT_ID) counts at the timer clock and raises its update
+*                     interrupt every APP_CFG_BENCH_ZLAT_PERIOD_US.  The ISR reads the counter first : the
+*                     count since the update event is the entry latency, vector to handler, including the
+*                     time the interrupt was held off by a masked section.  It is scaled to CPU clocks.
+*
+*                 (2) The ISR is registered with BSP_IntZeroLatSet().  With CPU_CFG_KA_IPL_BOUNDARY
+*                     #define'd in 'cpu_cfg.h' its level is above every kernel critical section and the
+*                     maximum only shows the short PRIMASK windows left (CPU_IntDis(), PendSV entry).
+*                     Without it, every critical section masks the probe and the maximum follows
+*                     CPU_IntDisMeasMaxGet().  Build both ways to compare (see 'app_bench.c  Note #4').
+*
+*                 (3) This file #define's BSP_INT_ZERO_LAT_FILE : a kernel call here does not compile.
+*                     The statistics are single words written only by the ISR; the 64-bit sum is only
+*                     read once the timer is stopped.
+*********************************************************************************************************
+*/
+
+#define  BSP_INT_ZERO_LAT_FILE                                  /* See Note #3.                                         */
+#include <includes.h>
+
+#include "app.h"
+#include "app_zlat.h"
+
+#if (APP_CFG_BENCH_EN == DEF_ENABLED)
+
+#if defined(CPU_CFG_KA_IPL_BOUNDARY) && (APP_CFG_BENCH_ZLAT_PRIO >= CPU_CFG_KA_IPL_BOUNDARY)
+#error  "APP_CFG_BENCH_ZLAT_PRIO MUST be above the kernel aware levels, i.e. < CPU_CFG_KA_IPL_BOUNDARY"
+#endif
+
+#define ZLAT_TIM  TIM6
+
+static volatile CPU_INT32U ZLatN;
+static volatile CPU_INT32U ZLatMin; /* 타이머 틱 */
+static volatile CPU_INT32U ZLatMax;
+static CPU_INT64U ZLatSum;
+static CPU_INT32U ZLatTimHz;
+
+/*-------------------------------------------------------------*/
+/*  프로브 ISR: 커널 호출 없음 (Note #3)                          */
+/*-------------------------------------------------------------*/
+static void ZLat_ISR(void) {
+    CPU_INT32U ticks = ZLAT_TIM->CNT; /* 갱신 이벤트 이후 흐른 틱 = 진입 지연 */
+
+    ZLAT_TIM->SR = (uint16_t)~TIM_IT_Update;
+    if (ticks < ZLatMin) ZLatMin = ticks;
+    if (ticks > ZLatMax) ZLatMax = ticks;
+    ZLatSum += ticks;
+    ZLatN++;
+}
+
+static CPU_INT32U ZLat_Cyc(CPU_INT64U ticks, CPU_INT32U cpu_hz) {
+    return (CPU_INT32U)((ticks * cpu_hz) / ZLatTimHz);
+}
+
+/*
+*********************************************************************************************************
+*                                           AppZLat_Start()
+*
+* Description : Clear the statistics and start the probe timer (see Note #1 at the top).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Bench_TaskCtrl().
+*
+* Note(s)     : (1) On STM32F4 the APB1 timers run at twice PCLK1 unless APB1 is not divided.
+*********************************************************************************************************
+*/
+void AppZLat_Start(void) {
+    RCC_ClocksTypeDef clk;
+    TIM_TimeBaseInitTypeDef tb;
+
+    RCC_GetClocksFreq(&clk);
+    ZLatTimHz = (clk.PCLK1_Frequency == clk.HCLK_Frequency) ? clk.PCLK1_Frequency
+                                                             : (2u * clk.PCLK1_Frequency); /* Note #1 */
+    ZLatN = 0u;
+    ZLatMin = DEF_INT_32U_MAX_VAL;
+    ZLatMax = 0u;
+    ZLatSum = 0u;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM6, ENABLE);
+    TIM_TimeBaseStructInit(&tb);
+    tb.TIM_Prescaler = 0u;
+    tb.TIM_Period = (ZLatTimHz / 1000000u) * APP_CFG_BENCH_ZLAT_PERIOD_US - 1u;
+    TIM_TimeBaseInit(ZLAT_TIM, &tb);
+    TIM_ClearITPendingBit(ZLAT_TIM, TIM_IT_Update);
+    TIM_ITConfig(ZLAT_TIM, TIM_IT_Update, ENABLE);
+
+    BSP_IntDis(APP_CFG_BENCH_ZLAT_INT_ID);
+    BSP_IntZeroLatSet(APP_CFG_BENCH_ZLAT_INT_ID, ZLat_ISR, APP_CFG_BENCH_ZLAT_PRIO);
+    BSP_IntEn(APP_CFG_BENCH_ZLAT_INT_ID);
+    TIM_Cmd(ZLAT_TIM, ENABLE);
+}
+
+/*
+*********************************************************************************************************
+*                                           AppZLat_Stop()
+*
+* Description : Stop the probe and return its statistics in CPU clocks.
+*
+* Argument(s) : p_stats     Where to store the statistics.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Bench_TaskCtrl().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+void AppZLat_Stop(APP_ZLAT_STATS *p_stats) {
+    CPU_INT32U cpu_hz = BSP_CPU_ClkFreq();
+
+    TIM_Cmd(ZLAT_TIM, DISABLE);
+    BSP_IntDis(APP_CFG_BENCH_ZLAT_INT_ID);
+    TIM_ITConfig(ZLAT_TIM, TIM_IT_Update, DISABLE);
+
+    p_stats->n = ZLatN;
+    p_stats->min = (ZLatN != 0u) ? ZLat_Cyc(ZLatMin, cpu_hz) : 0u;
+    p_stats->max = ZLat_Cyc(ZLatMax, cpu_hz);
+    p_stats->sum = (ZLatSum * cpu_hz) / ZLatTimHz;
+}
+
+#endif
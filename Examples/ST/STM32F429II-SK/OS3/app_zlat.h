@@ -0,0 +1,43 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                    STM32F429II-SK KICKSTART KIT
+*
+* Filename      : app_zlat.h
+* Description   : Zero latency interrupt probe: worst-case entry latency of an ISR the kernel never masks.
+*********************************************************************************************************
+*/
+
+#ifndef  APP_ZLAT_MODULE_PRESENT
+#define  APP_ZLAT_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    CPU_INT32U  n;     /* 측정한 인터럽트 수                  */
+    CPU_INT32U  min;   /* 진입 지연, CPU 클록 (CPU_TS 와 같은 단위) */
+    CPU_INT32U  max;
+    CPU_INT64U  sum;
+} APP_ZLAT_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+#if (APP_CFG_BENCH_EN == DEF_ENABLED)
+void  AppZLat_Start (void);
+void  AppZLat_Stop  (APP_ZLAT_STATS  *p_stats);
+#endif
+
+
+#endif
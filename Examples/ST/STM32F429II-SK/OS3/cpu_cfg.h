@@ -136,6 +136,61 @@
 #define  CPU_CFG_INT_DIS_MEAS_OVRHD_NBR                    1u   /* ... time measurements (see Note #1b).                */
 
 
+/*
+*********************************************************************************************************
+*                               CPU CRITICAL SECTION PROFILER CONFIGURATION
+*
+* Note(s) : (1) Configure CPU_CFG_CS_PROF_EN to attribute interrupts disabled & scheduler locked time
+*               to the code that caused it :
+*
+*               (a)  Enabled,       if CPU_CFG_CS_PROF_EN      #define'd in 'cpu_cfg.h'
+*
+*               (b) Disabled,       if CPU_CFG_CS_PROF_EN  NOT #define'd in 'cpu_cfg.h'
+*
+*               See also 'cpu_core.c  CPU CRITICAL SECTION PROFILER'.
+*
+*           (2) Configure CPU_CFG_CS_PROF_LOCK_SITES with the number of scheduler lock call sites that
+*               can be told apart.  Locks from further sites are counted but not attributed.
+*********************************************************************************************************
+*/
+
+#if 0                                                           /* Configure CPU critical section ...                   */
+#define  CPU_CFG_CS_PROF_EN                                     /* ... profiler (see Note #1).                          */
+#endif
+
+#define  CPU_CFG_CS_PROF_LOCK_SITES                       32u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                           CPU KERNEL AWARE INTERRUPT PRIORITY CONFIGURATION
+*
+* Note(s) : (1) Configure CPU_CFG_KA_IPL_BOUNDARY to select how critical sections mask interrupts :
+*
+*               (a) PRIMASK, if CPU_CFG_KA_IPL_BOUNDARY NOT #define'd in 'cpu_cfg.h' : every interrupt is
+*                   masked by every critical section.
+*
+*               (b) BASEPRI, if CPU_CFG_KA_IPL_BOUNDARY     #define'd in 'cpu_cfg.h' : critical sections only
+*                   mask priority levels CPU_CFG_KA_IPL_BOUNDARY and lower (numerically greater).  Those are
+*                   the kernel aware interrupts.  Levels 0 .. (CPU_CFG_KA_IPL_BOUNDARY - 1) are never masked
+*                   by the kernel and MUST NOT call any kernel service (see 'bsp.h  ZERO LATENCY ISR FILES').
+*
+*           (2) Configure CPU_CFG_NVIC_PRIO_BITS with the number of NVIC priority bits implemented by the
+*               device (4 on STM32F4xx, i.e. levels 0 .. 15).
+*
+*           (3) PRIMASK is the default.  Enable BASEPRI only on a build whose CPU_SR_SaveBasePri()/
+*               CPU_SR_RestoreBasePri() ('cpu_a') & PendSV prologue/epilogue ('os_cpu_a') have been
+*               assembled for the toolchain in use, & whose interrupt latency has been measured with the
+*               'zlat' benchmark ('app_zlat.c') against the PRIMASK build.
+*********************************************************************************************************
+*/
+
+#if 0                                                           /* Kernel aware levels: 4 .. 15 (see Notes #1 & #3).    */
+#define  CPU_CFG_KA_IPL_BOUNDARY                           4u
+#endif
+#define  CPU_CFG_NVIC_PRIO_BITS                            4u   /* See Note #2.                                         */
+
+
 /*
 *********************************************************************************************************
 *                                    CPU COUNT ZEROS CONFIGURATION
@@ -66,6 +66,7 @@
 #include  <lib_ascii.h>
 #include  <lib_math.h>
 #include  <lib_mem.h>
+#include  <lib_seqlock.h>
 #include  <lib_str.h>
 
 
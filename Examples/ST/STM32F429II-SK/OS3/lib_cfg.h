@@ -115,7 +115,8 @@
                                                                 /* Heap memory size (in bytes).                         */
                                                                 /* Configure the desired size of the heap memory. ...   */
                                                                 /* ... Set to 0 to disable heap allocation features.    */
-#define  LIB_MEM_CFG_HEAP_SIZE            (3u * 1024u)
+                                                                /* Nothing here allocates from it ('mem' command).      */
+#define  LIB_MEM_CFG_HEAP_SIZE                     0u
 
 
                                                                 /* Heap memory padding alignment (in bytes).            */
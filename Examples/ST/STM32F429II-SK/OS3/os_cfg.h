@@ -41,16 +41,20 @@
 #define OS_CFG_CALLED_FROM_ISR_CHK_EN   0u   /* Enable (1) or Disable (0) check for called from ISR                   */
 #define OS_CFG_DBG_EN                   1u   /* Enable (1) debug code/variables                                       */
 #define OS_CFG_ISR_POST_DEFERRED_EN     0u   /* Enable (1) or Disable (0) Deferred ISR posts                          */
+#define OS_CFG_OBJ_STAT_EN              0u   /* Enable (1) or Disable (0) per object contention statistics            */
 #define OS_CFG_OBJ_TYPE_CHK_EN          1u   /* Enable (1) or Disable (0) object type checking                        */
 #define OS_CFG_TS_EN                    1u   /* Enable (1) or Disable (0) time stamping                               */
 
 #define OS_CFG_PEND_MULTI_EN            0u   /* Enable (1) or Disable (0) code generation for multi-pend feature      */
 
 #define OS_CFG_PRIO_MAX                64u   /* Defines the maximum number of task priorities (see OS_PRIO data type) */
+                                             /* Costs 2 B per priority in every TCB (mutex group summary, see OS_TCB) */
 
 #define OS_CFG_SCHED_LOCK_TIME_MEAS_EN  1u   /* Include code to measure scheduler lock time                           */
 #define OS_CFG_SCHED_ROUND_ROBIN_EN     0u   /* Include code for Round-Robin scheduling                               */
 #define OS_CFG_STK_SIZE_MIN            64u   /* Minimum allowable task stack size                                     */
+#define OS_CFG_TICK_VIRT_EN             0u   /* Enable (1) or Disable (0) virtual time: the idle task ticks to the    */
+                                             /* next expiry and SysTick is not started (fast, repeatable benchmarks)  */
 
 
                                              /* ----------------------------- EVENT FLAGS --------------------------- */
@@ -42,7 +42,11 @@
 */
 
                                                             /* --------------------- MISCELLANEOUS ------------------ */
-#define  OS_CFG_MSG_POOL_SIZE            100u               /* Maximum number of messages                             */
+                                                            /* Messages only live in queues: the pool never needs ... */
+                                                            /* ... more than the sum of all queue sizes, i.e. ...     */
+                                                            /* ... APP_CFG_RENDER_REQ_Q_SIZE + APP_CFG_TELEM_Q_SIZE   */
+                                                            /* ... (+ 1 for the benchmark); 'mem size' checks it.     */
+#define  OS_CFG_MSG_POOL_SIZE             32u               /* Maximum number of messages (see above)                 */
 
 #define  OS_CFG_ISR_STK_SIZE             100u               /* Stack size of ISR stack (number of CPU_STK elements)   */
 
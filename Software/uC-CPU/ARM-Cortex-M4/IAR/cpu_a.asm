@@ -41,6 +41,8 @@
 
         PUBLIC  CPU_SR_Save
         PUBLIC  CPU_SR_Restore
+        PUBLIC  CPU_SR_SaveBasePri
+        PUBLIC  CPU_SR_RestoreBasePri
 
         PUBLIC  CPU_WaitForInt
         PUBLIC  CPU_WaitForExcept
@@ -72,6 +74,33 @@ CPU_IntDis
         BX      LR
 
 
+;********************************************************************************************************
+;                               KERNEL AWARE CRITICAL SECTION FUNCTIONS
+;
+; Description : Mask only the kernel aware interrupts, by raising BASEPRI, and restore the previous mask.
+;
+; Prototypes  : CPU_SR  CPU_SR_SaveBasePri   (CPU_SR  basepri);
+;               void    CPU_SR_RestoreBasePri(CPU_SR  cpu_sr);
+;
+; Note(s)     : (1) Used by CPU_INT_DIS()/CPU_INT_EN() when CPU_CFG_KA_IPL_BOUNDARY is #define'd (see
+;                   'cpu.h  CRITICAL SECTION CONFIGURATION  Note #4').  'basepri' is the boundary already
+;                   shifted into the implemented priority bits.
+;
+;               (2) BASEPRI_MAX only ever raises the mask, so a nested critical section (or one entered
+;                   from a kernel aware ISR) never unmasks anything its caller masked.
+;********************************************************************************************************
+
+CPU_SR_SaveBasePri
+        MOV     R1, R0
+        MRS     R0, BASEPRI                     ; Return the previous mask
+        MSR     BASEPRI_MAX, R1                 ; Mask kernel aware ints (see Note #2)
+        BX      LR
+
+CPU_SR_RestoreBasePri
+        MSR     BASEPRI, R0
+        BX      LR
+
+
 CPU_IntEn
         CPSIE   I
         BX      LR
@@ -301,6 +301,16 @@ typedef  CPU_ADDR                 CPU_STK_SIZE;                 /* Defines CPU s
 *
 *               (b) Configure 'CPU_SR' data type with the appropriate-sized CPU data type large enough to
 *                   completely store the CPU's/compiler's status word.
+*
+*           (4) If CPU_CFG_KA_IPL_BOUNDARY is #define'd in 'cpu_cfg.h', CPU_INT_DIS() raises BASEPRI to that
+*               priority level instead of setting PRIMASK.  'cpu_sr' then holds the previous BASEPRI, and
+*               interrupts at levels 0 .. (CPU_CFG_KA_IPL_BOUNDARY - 1) are never masked by a critical
+*               section.  CPU_IntDis()/CPU_IntEn() still use PRIMASK and mask everything.
+*
+*           (5) If CPU_CFG_CS_PROF_EN is #define'd in 'cpu_cfg.h', CPU_CRITICAL_ENTER() declares a static
+*               profiler site named by its file & line, & the critical section is timed & charged to it
+*               (see 'cpu_core.c  CPU CRITICAL SECTION PROFILER').  CPU_CS_PROF_CALLER() gives the return
+*               address that names a scheduler lock site.
 *********************************************************************************************************
 */
                                                                 /* Configure CPU critical method      (see Note #1) :   */
@@ -315,13 +325,29 @@ typedef  CPU_INT32U                 CPU_SR;                     /* Defines   CPU
 #define  CPU_SR_ALLOC()
 #endif
 
+#ifdef   CPU_CFG_KA_IPL_BOUNDARY                                        /* See Note #4.                                 */
+#define  CPU_CFG_KA_BASEPRI    ((CPU_SR)((CPU_CFG_KA_IPL_BOUNDARY) << (8u - (CPU_CFG_NVIC_PRIO_BITS))))
 
-
+#define  CPU_INT_DIS()         do { cpu_sr = CPU_SR_SaveBasePri(CPU_CFG_KA_BASEPRI); } while (0)
+#define  CPU_INT_EN()          do { CPU_SR_RestoreBasePri(cpu_sr); } while (0)
+#else
 #define  CPU_INT_DIS()         do { cpu_sr = CPU_SR_Save(); } while (0) /* Save    CPU status word & disable interrupts.*/
 #define  CPU_INT_EN()          do { CPU_SR_Restore(cpu_sr); } while (0) /* Restore CPU status word.                     */
+#endif
+
 
+#ifdef   CPU_CFG_CS_PROF_EN                                             /* See Note #5.                                 */
+                                                                        /* Disable interrupts & time crit sect.         */
+#define  CPU_CRITICAL_ENTER()  do { static  CPU_CS_SITE  cpu_cs_site = CPU_CS_SITE_INIT(__FILE__, __LINE__); \
+                                    CPU_INT_DIS();                                                              \
+                                    CPU_CS_ProfEnter(&cpu_cs_site); }  while (0)
+                                                                        /* Charge crit sect & re-enable interrupts.     */
+#define  CPU_CRITICAL_EXIT()   do { CPU_CS_ProfExit(); \
+                                    CPU_INT_EN();      }  while (0)
 
-#ifdef   CPU_CFG_INT_DIS_MEAS_EN
+#define  CPU_CS_PROF_CALLER()  ((void *)__return_address())
+
+#elif    defined(CPU_CFG_INT_DIS_MEAS_EN)
                                                                         /* Disable interrupts, ...                      */
                                                                         /* & start interrupts disabled time measurement.*/
 #define  CPU_CRITICAL_ENTER()  do { CPU_INT_DIS();         \
@@ -408,6 +434,11 @@ void        CPU_IntSrcPrioSet(CPU_INT08U  pos,
 CPU_SR      CPU_SR_Save      (void);
 void        CPU_SR_Restore   (CPU_SR      cpu_sr);
 
+#ifdef   CPU_CFG_KA_IPL_BOUNDARY
+CPU_SR      CPU_SR_SaveBasePri   (CPU_SR  basepri);
+void        CPU_SR_RestoreBasePri(CPU_SR  cpu_sr);
+#endif
+
 
 void        CPU_WaitForInt   (void);
 void        CPU_WaitForExcept(void);
@@ -658,6 +689,24 @@ void        CPU_BitBandSet   (CPU_ADDR    addr,
 #endif
 
 
+#ifdef   CPU_CFG_KA_IPL_BOUNDARY
+#ifndef  CPU_CFG_NVIC_PRIO_BITS
+#error  "CPU_CFG_NVIC_PRIO_BITS         not #define'd in 'cpu_cfg.h'           "
+#error  "                         [MUST be  1 .. 8 NVIC priority bits        ]"
+
+#elif  ((CPU_CFG_NVIC_PRIO_BITS < 1u) || \
+        (CPU_CFG_NVIC_PRIO_BITS > 8u))
+#error  "CPU_CFG_NVIC_PRIO_BITS   illegally #define'd in 'cpu_cfg.h'           "
+#error  "                         [MUST be  1 .. 8 NVIC priority bits        ]"
+
+#elif  ((CPU_CFG_KA_IPL_BOUNDARY < 1u) || \
+        (CPU_CFG_KA_IPL_BOUNDARY >= (1u << CPU_CFG_NVIC_PRIO_BITS)))
+#error  "CPU_CFG_KA_IPL_BOUNDARY  illegally #define'd in 'cpu_cfg.h'           "
+#error  "                         [MUST be  1 .. (2^CPU_CFG_NVIC_PRIO_BITS - 1)]"
+#endif
+#endif
+
+
 #ifndef  CPU_CFG_DATA_SIZE_MAX
 #error  "CPU_CFG_DATA_SIZE_MAX          not #define'd in 'cpu.h'               "
 #error  "                         [MUST be  CPU_WORD_SIZE_08   8-bit alignment]"
@@ -55,6 +55,8 @@
 *********************************************************************************************************
 */
 
+#define  CPU_CS_PROF_LOCK_PROBE_MAX                        4u   /* See 'CPU_CS_ProfLockStart()  Note #2'.               */
+
 
 /*
 *********************************************************************************************************
@@ -129,6 +131,17 @@ static  const  CPU_INT08U  CPU_CntLeadZerosTbl[256] = {
 CPU_INT32U  const  CPU_EndiannessTest = 0x12345678LU;               /* Variable to test CPU endianness.                 */
 
 
+#ifdef  CPU_CFG_CS_PROF_EN                                          /* ------------- CPU CRIT SECT PROFILER ----------- */
+static  CPU_INT16U   CPU_CS_ProfNestCtr;                            /* Nbr nested crit sects.                           */
+static  CPU_CS_SITE *CPU_CS_ProfSitePtr;                            /* Outermost crit sect's site & ...                 */
+static  CPU_TS_TMR   CPU_CS_ProfStart_cnts;                         /* ... start time.                                  */
+
+static  CPU_CS_SITE  CPU_CS_ProfLockTbl[CPU_CFG_CS_PROF_LOCK_SITES];
+static  CPU_CS_SITE *CPU_CS_ProfLockSitePtr;                        /* Outermost sched lock's site (0 if unknown) & ... */
+static  CPU_TS_TMR   CPU_CS_ProfLockStart_cnts;                     /* ... start time.                                  */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                      LOCAL FUNCTION PROTOTYPES
@@ -154,6 +167,12 @@ static  CPU_TS_TMR  CPU_IntDisMeasMaxCalc(CPU_TS_TMR  time_tot_cnts);
 #endif
 
 
+#ifdef  CPU_CFG_CS_PROF_EN                                          /* ---------- CPU CRIT SECT PROFILER FNCTS -------- */
+static  void        CPU_CS_ProfSiteUpdate(CPU_CS_SITE  *p_site,
+                                          CPU_TS_TMR    time_cnts);
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                     LOCAL CONFIGURATION ERRORS
@@ -1036,6 +1055,279 @@ void  CPU_IntDisMeasStop (void)
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                    CPU CRITICAL SECTION PROFILER
+*
+* Note(s) : (1) With CPU_CFG_CS_PROF_EN #define'd in 'cpu_cfg.h', CPU_CRITICAL_ENTER() & CPU_CRITICAL_EXIT()
+*               time every critical section & charge it to the site of its outermost CPU_CRITICAL_ENTER(),
+*               & OSSchedLock()/OSSchedUnlock() time every scheduler lock & charge it to the caller of its
+*               outermost OSSchedLock().  Each site keeps its number of entries & its total & maximum
+*               time (see 'cpu_core.h  CPU CRITICAL SECTION PROFILER SITE DATA TYPE').
+*
+*           (2) The cost is bounded : two timestamp reads & a few stores per critical section or scheduler
+*               lock, plus at most CPU_CS_PROF_LOCK_PROBE_MAX table probes per scheduler lock.  Each
+*               CPU_CRITICAL_ENTER() in the image holds a static site, about 40 octets of RAM & its file
+*               name in ROM.  The profiler's own cost is included in the times it reports.
+*
+*           (3) Critical sections MUST be entered & exited by the same task or ISR, without a context
+*               switch in between; this holds for uC/OS-III, whose context switch is pended until
+*               interrupts are re-enabled.  Interrupts at levels 0 .. (CPU_CFG_KA_IPL_BOUNDARY - 1), which
+*               critical sections do not mask, MUST NOT use critical sections (see 'cpu_cfg.h').
+*
+*           (4) No initialization : all state starts zeroed, & sites that run before CPU_Init() are kept.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         CPU_CS_ProfEnter()
+*
+* Description : Start timing a critical section.
+*
+* Argument(s) : p_site      Pointer to the site of the CPU_CRITICAL_ENTER().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : CPU_CRITICAL_ENTER(), with interrupts disabled.
+*
+*               This function is an INTERNAL CPU module function & MUST NOT be called by application
+*               function(s).
+*
+* Note(s)     : (1) A nested critical section is part of the outermost one & is not counted on its own.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfEnter (CPU_CS_SITE  *p_site)
+{
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    CPU_IntDisMeasStart();
+#endif
+    if (CPU_CS_ProfNestCtr == 0u) {                                 /* See Note #1.                                     */
+        if (p_site->Listed == DEF_NO) {                             /* Link site on its first entry.                    */
+            p_site->NextPtr       = CPU_CS_ProfIntListPtr;
+            p_site->Listed        = DEF_YES;
+            CPU_CS_ProfIntListPtr = p_site;
+        }
+        CPU_CS_ProfSitePtr    = p_site;
+        CPU_CS_ProfStart_cnts = CPU_TS_TmrRd();
+    }
+    CPU_CS_ProfNestCtr++;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_CS_ProfExit()
+*
+* Description : Stop timing a critical section & charge it to its site.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : CPU_CRITICAL_EXIT(), with interrupts disabled.
+*
+*               This function is an INTERNAL CPU module function & MUST NOT be called by application
+*               function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfExit (void)
+{
+    if (CPU_CS_ProfNestCtr > 0u) {
+        CPU_CS_ProfNestCtr--;
+        if (CPU_CS_ProfNestCtr == 0u) {
+            CPU_CS_ProfSiteUpdate(CPU_CS_ProfSitePtr, CPU_TS_TmrRd() - CPU_CS_ProfStart_cnts);
+        }
+    }
+#ifdef  CPU_CFG_INT_DIS_MEAS_EN
+    CPU_IntDisMeasStop();
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       CPU_CS_ProfLockStart()
+*
+* Description : Start timing a scheduler lock.
+*
+* Argument(s) : p_addr      Return address of the caller of the outermost OSSchedLock().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OSSchedLock(), with interrupts disabled.
+*
+*               This function is an INTERNAL CPU module function & MUST NOT be called by application
+*               function(s).
+*
+* Note(s)     : (1) Called for the outermost lock only : nested locks are part of it.
+*
+*               (2) Sites are hashed by address into CPU_CS_ProfLockTbl[] & looked up by linear probing,
+*                   CPU_CS_PROF_LOCK_PROBE_MAX entries at most.  A lock whose site is not found within
+*                   that many entries, nor given a free one, is counted in CPU_CS_ProfLockOvfCtr only.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfLockStart (void  *p_addr)
+{
+    CPU_CS_SITE  *p_site;
+    CPU_INT16U    ix;
+    CPU_INT08U    probe;
+
+
+    ix     = (CPU_INT16U)(((CPU_ADDR)p_addr >> 1u) % CPU_CFG_CS_PROF_LOCK_SITES);
+    p_site = (CPU_CS_SITE *)0;
+    for (probe = 0u; probe < CPU_CS_PROF_LOCK_PROBE_MAX; probe++) {     /* See Note #2.                             */
+        if (CPU_CS_ProfLockTbl[ix].Listed == DEF_NO) {              /* Free entry : give it to this site.               */
+            p_site                 = &CPU_CS_ProfLockTbl[ix];
+            p_site->AddrPtr        = p_addr;
+            p_site->NextPtr        = CPU_CS_ProfLockListPtr;
+            p_site->Listed         = DEF_YES;
+            CPU_CS_ProfLockListPtr = p_site;
+            break;
+        }
+        if (CPU_CS_ProfLockTbl[ix].AddrPtr == p_addr) {
+            p_site = &CPU_CS_ProfLockTbl[ix];
+            break;
+        }
+        ix++;
+        if (ix >= CPU_CFG_CS_PROF_LOCK_SITES) {
+            ix = 0u;
+        }
+    }
+    if (p_site == (CPU_CS_SITE *)0) {
+        CPU_CS_ProfLockOvfCtr++;
+    }
+
+    CPU_CS_ProfLockSitePtr    = p_site;
+    CPU_CS_ProfLockStart_cnts = CPU_TS_TmrRd();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        CPU_CS_ProfLockStop()
+*
+* Description : Stop timing a scheduler lock & charge it to its site.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OSSchedUnlock(), with interrupts disabled.
+*
+*               This function is an INTERNAL CPU module function & MUST NOT be called by application
+*               function(s).
+*
+* Note(s)     : (1) Called for the outermost unlock only.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfLockStop (void)
+{
+    if (CPU_CS_ProfLockSitePtr != (CPU_CS_SITE *)0) {
+        CPU_CS_ProfSiteUpdate(CPU_CS_ProfLockSitePtr, CPU_TS_TmrRd() - CPU_CS_ProfLockStart_cnts);
+        CPU_CS_ProfLockSitePtr = (CPU_CS_SITE *)0;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         CPU_CS_ProfSiteRd()
+*
+* Description : Read a consistent copy of a profiler site.
+*
+* Argument(s) : p_site      Pointer to a site of CPU_CS_ProfIntListPtr or CPU_CS_ProfLockListPtr.
+*
+*               p_copy      Pointer to the copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a CPU module application programming interface (API) function & MAY
+*               be called by application function(s).
+*
+* Note(s)     : (1) The lists may be walked without a critical section (see 'cpu_core.h  CPU CRITICAL
+*                   SECTION PROFILER SITE DATA TYPE  Note #2'); the counters of a site may not.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfSiteRd (CPU_CS_SITE  *p_site,
+                         CPU_CS_SITE  *p_copy)
+{
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+   *p_copy = *p_site;
+    CPU_CRITICAL_EXIT();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_CS_ProfClr()
+*
+* Description : Clear the counters of every profiler site.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a CPU module application programming interface (API) function & MAY
+*               be called by application function(s).
+*
+* Note(s)     : (1) Sites stay in their lists, & scheduler lock sites keep their table entry.  Each site
+*                   is cleared in a critical section of its own.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+void  CPU_CS_ProfClr (void)
+{
+    CPU_CS_SITE  *p_site;
+    CPU_SR_ALLOC();
+
+
+    for (p_site = CPU_CS_ProfIntListPtr; p_site != (CPU_CS_SITE *)0; p_site = p_site->NextPtr) {
+        CPU_CRITICAL_ENTER();
+        p_site->Ctr      = 0u;
+        p_site->Tot_cnts = 0u;
+        p_site->Max_cnts = 0u;
+        CPU_CRITICAL_EXIT();
+    }
+    for (p_site = CPU_CS_ProfLockListPtr; p_site != (CPU_CS_SITE *)0; p_site = p_site->NextPtr) {
+        CPU_CRITICAL_ENTER();
+        p_site->Ctr      = 0u;
+        p_site->Tot_cnts = 0u;
+        p_site->Max_cnts = 0u;
+        CPU_CRITICAL_EXIT();
+    }
+    CPU_CRITICAL_ENTER();
+    CPU_CS_ProfLockOvfCtr = 0u;
+    CPU_CRITICAL_EXIT();
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         CPU_CntLeadZeros()
@@ -2336,3 +2628,35 @@ static  CPU_TS_TMR  CPU_IntDisMeasMaxCalc (CPU_TS_TMR  time_tot_cnts)
 }
 #endif
 
+
+
+/*
+*********************************************************************************************************
+*                                       CPU_CS_ProfSiteUpdate()
+*
+* Description : Charge a critical section or a scheduler lock to its site.
+*
+* Argument(s) : p_site      Pointer to the site.
+*
+*               time_cnts   Time (in timestamp timer counts).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : CPU_CS_ProfExit(),
+*               CPU_CS_ProfLockStop().
+*
+* Note(s)     : (1) Called with interrupts disabled.
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+static  void  CPU_CS_ProfSiteUpdate (CPU_CS_SITE  *p_site,
+                                     CPU_TS_TMR    time_cnts)
+{
+    p_site->Ctr++;
+    p_site->Tot_cnts += time_cnts;
+    if (p_site->Max_cnts < time_cnts) {
+        p_site->Max_cnts = time_cnts;
+    }
+}
+#endif
@@ -141,7 +141,8 @@
 #endif
 
 #if    ((CPU_CFG_TS_EN == DEF_ENABLED) || \
-(defined(CPU_CFG_INT_DIS_MEAS_EN)))
+(defined(CPU_CFG_INT_DIS_MEAS_EN)) || \
+(defined(CPU_CFG_CS_PROF_EN)))
 #define  CPU_CFG_TS_TMR_EN                      DEF_ENABLED
 #else
 #define  CPU_CFG_TS_TMR_EN                      DEF_DISABLED
@@ -220,6 +221,42 @@ typedef  CPU_INT32U  CPU_TS_TMR;
 typedef  CPU_INT32U  CPU_TS_TMR_FREQ;
 
 
+/*
+*********************************************************************************************************
+*                                CPU CRITICAL SECTION PROFILER SITE DATA TYPE
+*
+* Note(s) : (1) A site is either :
+*
+*               (a) a CPU_CRITICAL_ENTER() in the source, named by its file & line, & allocated by the
+*                   macro itself as a static variable (see 'cpu.h  CRITICAL SECTION CONFIGURATION');
+*
+*               (b) a caller of OSSchedLock(), named by its return address, & allocated from a table
+*                   of CPU_CFG_CS_PROF_LOCK_SITES entries.
+*
+*           (2) Sites are linked into their list the first time they run & are never unlinked, so that
+*               the lists may be walked without a critical section.  Read the counters of a site with
+*               CPU_CS_ProfSiteRd().
+*********************************************************************************************************
+*/
+
+#ifdef  CPU_CFG_CS_PROF_EN
+typedef  struct  cpu_cs_site  CPU_CS_SITE;
+
+struct  cpu_cs_site {
+    const  CPU_CHAR     *FilePtr;                               /* Crit sect src file & ...      (see Note #1a).        */
+           CPU_INT32U    Line;                                  /* ... line.                                            */
+           void         *AddrPtr;                               /* Sched lock caller's ret addr  (see Note #1b).        */
+           CPU_INT32U    Ctr;                                   /* Nbr of entries.                                      */
+           CPU_INT64U    Tot_cnts;                              /* Tot time (in ts tmr cnts).                           */
+           CPU_TS_TMR    Max_cnts;                              /* Max time (in ts tmr cnts).                           */
+           CPU_BOOLEAN   Listed;                                /* Linked into its list          (see Note #2).         */
+           CPU_CS_SITE  *NextPtr;
+};
+                                                                /* Static init of a Note #1a site (all members named).  */
+#define  CPU_CS_SITE_INIT(file, line)  { (file), (line), (void *)0, 0u, 0u, 0u, DEF_NO, (CPU_CS_SITE *)0 }
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          GLOBAL VARIABLES
@@ -259,6 +296,12 @@ CPU_CORE_EXT  CPU_TS_TMR       CPU_IntDisMeasMaxCur_cnts;       /* ...     reset
 CPU_CORE_EXT  CPU_TS_TMR       CPU_IntDisMeasMax_cnts;          /* ... non-resetable max time dis'd.                    */
 #endif
 
+#ifdef  CPU_CFG_CS_PROF_EN
+CPU_CORE_EXT  CPU_CS_SITE     *CPU_CS_ProfIntListPtr;           /* Crit sect  sites (see 'CPU_CS_SITE  Note #2').       */
+CPU_CORE_EXT  CPU_CS_SITE     *CPU_CS_ProfLockListPtr;          /* Sched lock sites.                                    */
+CPU_CORE_EXT  CPU_INT32U       CPU_CS_ProfLockOvfCtr;           /* Sched locks from sites not in the tbl.               */
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -406,6 +449,30 @@ CPU_CORE_EXT  CPU_TS_TMR       CPU_IntDisMeasMax_cnts;          /* ... non-reset
 #define  CPU_VAL_IGNORED(val)       CPU_VAL_UNUSED(val)
 
 
+/*
+*********************************************************************************************************
+*                                        CPU_CS_PROF_CALLER()
+*
+* Description : Get the return address of the function that expands the macro.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Return address, as a pointer to void.
+*
+* Caller(s)   : OSSchedLock().
+*
+* Note(s)     : (1) Defined in 'cpu.h' by the ports whose compiler can tell; otherwise every scheduler
+*                   lock is attributed to the same site, at address 0.
+*********************************************************************************************************
+*/
+
+#ifdef   CPU_CFG_CS_PROF_EN
+#ifndef  CPU_CS_PROF_CALLER                                                     /* See Note #1.                         */
+#define  CPU_CS_PROF_CALLER()       ((void *)0)
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          CPU_TYPE_CREATE()
@@ -558,6 +625,25 @@ void             CPU_IntDisMeasStop       (void);
 
 
 
+#ifdef  CPU_CFG_CS_PROF_EN                                              /* -------- CPU CRIT SECT PROFILER FNCTS ------ */
+void             CPU_CS_ProfEnter         (CPU_CS_SITE      *p_site);
+
+void             CPU_CS_ProfExit          (void);
+
+
+void             CPU_CS_ProfLockStart     (void             *p_addr);
+
+void             CPU_CS_ProfLockStop      (void);
+
+
+void             CPU_CS_ProfSiteRd        (CPU_CS_SITE      *p_site,
+                                           CPU_CS_SITE      *p_copy);
+
+void             CPU_CS_ProfClr           (void);
+#endif
+
+
+
                                                                         /* ----------- CPU CNT ZEROS FNCTS ------------ */
 #ifdef  CPU_CFG_LEAD_ZEROS_ASM_PRESENT
 #ifdef __cplusplus
@@ -974,6 +1060,30 @@ CPU_INT64U  CPU_TS64_to_uSec(CPU_TS64  ts_cnts);
 
 
 
+#ifndef  CPU_CFG_CS_PROF_EN
+#if 0                                                           /* Optionally configured in 'cpu_cfg.h'; DO NOT MODIFY. */
+#error  "CPU_CFG_CS_PROF_EN                    not #define'd in 'cpu_cfg.h'"
+#endif
+
+#else
+
+#ifndef  CPU_CFG_CS_PROF_LOCK_SITES
+#error  "CPU_CFG_CS_PROF_LOCK_SITES            not #define'd in 'cpu_cfg.h'"
+#error  "                                [MUST be  >=   1]                 "
+#error  "                                [     ||  <= 255]                 "
+
+#elif   (DEF_CHK_VAL(CPU_CFG_CS_PROF_LOCK_SITES, 1, 255) != DEF_OK)
+#error  "CPU_CFG_CS_PROF_LOCK_SITES      illegally #define'd in 'cpu_cfg.h'"
+#error  "                                [MUST be  >=   1]                 "
+#error  "                                [     ||  <= 255]                 "
+
+#endif
+
+#endif
+
+
+
+
 #ifndef  CPU_CFG_LEAD_ZEROS_ASM_PRESENT
 #if 0                                                           /* Optionally configured in 'cpu_cfg.h'; DO NOT MODIFY. */
 #error  "CPU_CFG_LEAD_ZEROS_ASM_PRESENT        not #define'd in 'cpu.h'/'cpu_cfg.h'"
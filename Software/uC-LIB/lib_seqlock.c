@@ -0,0 +1,315 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                         SEQUENCE LOCK (SEQLOCK)
+*
+* Filename      : lib_seqlock.c
+* Version       : V1.38.01
+*********************************************************************************************************
+* Note(s)       : (1) See 'lib_seqlock.h  Note #1' for the protocol & 'lib_seqlock.h  Notes #2 & #3' for
+*                     the requirements on writers.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    LIB_SEQLOCK_MODULE
+#include  <lib_seqlock.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                           LOCAL CONSTANTS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL TABLES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                     LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                           SeqLock_Init()
+*
+* Description : Initialize a sequence lock.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) MUST be called before the lock is shared with any reader or writer.
+*********************************************************************************************************
+*/
+
+void  SeqLock_Init (SEQLOCK  *p_lock)
+{
+    p_lock->Seq = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          SeqLock_Barrier()
+*
+* Description : Compiler barrier for compilers without an inline barrier syntax.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : SEQLOCK_BARRIER().
+*
+* Note(s)     : (1) See 'lib_seqlock.h  SEQLOCK_BARRIER()  Note #2'.  The function MUST stay in its own
+*                   translation unit for the call to act as a barrier.
+*********************************************************************************************************
+*/
+
+void  SeqLock_Barrier (void)
+{
+}
+
+
+/*
+*********************************************************************************************************
+*                                          SeqLock_WrBegin()
+*
+* Description : Start an update of the data protected by a sequence lock.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The counter becomes odd BEFORE any of the protected data is modified.
+*
+*               (2) See 'lib_seqlock.h  Notes #2 & #3'.
+*********************************************************************************************************
+*/
+
+void  SeqLock_WrBegin (SEQLOCK  *p_lock)
+{
+    p_lock->Seq = p_lock->Seq + 1u;                             /* See Note #1.                                         */
+    SEQLOCK_BARRIER();
+}
+
+
+/*
+*********************************************************************************************************
+*                                           SeqLock_WrEnd()
+*
+* Description : Complete an update started by SeqLock_WrBegin().
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The counter becomes even AFTER all of the protected data is modified.
+*********************************************************************************************************
+*/
+
+void  SeqLock_WrEnd (SEQLOCK  *p_lock)
+{
+    SEQLOCK_BARRIER();
+    p_lock->Seq = p_lock->Seq + 1u;                             /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                            SeqLock_Wr()
+*
+* Description : Copy a block of data into the area protected by a sequence lock.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+*               p_dest      Pointer to the protected data.
+*
+*               p_src       Pointer to the new data.
+*
+*               size        Number of octets to copy.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) See 'lib_seqlock.h  Notes #2 & #3'.
+*********************************************************************************************************
+*/
+
+void  SeqLock_Wr (SEQLOCK      *p_lock,
+                  void         *p_dest,
+                  void  const  *p_src,
+                  CPU_SIZE_T    size)
+{
+    SeqLock_WrBegin(p_lock);
+    Mem_Copy(p_dest, p_src, size);
+    SeqLock_WrEnd(p_lock);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          SeqLock_RdBegin()
+*
+* Description : Start a read of the data protected by a sequence lock.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+* Return(s)   : Sequence value to pass to SeqLock_RdRetry().
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The function does NOT wait for an update in progress to complete; an odd sequence
+*                   value simply makes the following SeqLock_RdRetry() fail (see 'lib_seqlock.h  Note #3').
+*********************************************************************************************************
+*/
+
+SEQLOCK_SEQ  SeqLock_RdBegin (SEQLOCK  *p_lock)
+{
+    SEQLOCK_SEQ  seq;
+
+
+    seq = p_lock->Seq;
+    SEQLOCK_BARRIER();
+
+    return (seq);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          SeqLock_RdRetry()
+*
+* Description : Check whether the data read since SeqLock_RdBegin() is consistent.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+*               seq         Sequence value returned by SeqLock_RdBegin().
+*
+* Return(s)   : DEF_YES, if the data may be torn and MUST be read again.
+*
+*               DEF_NO,  if the data is consistent.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  SeqLock_RdRetry (SEQLOCK      *p_lock,
+                              SEQLOCK_SEQ   seq)
+{
+    SEQLOCK_BARRIER();
+    if ((seq & 1u) != 0u) {                                     /* Update was in progress at RdBegin().                 */
+        return (DEF_YES);
+    }
+    if (p_lock->Seq != seq) {                                   /* Update started since RdBegin().                      */
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            SeqLock_Rd()
+*
+* Description : Copy a consistent snapshot of the data protected by a sequence lock.
+*
+* Argument(s) : p_lock      Pointer to the sequence lock.
+*
+*               p_dest      Pointer to the buffer that receives the snapshot.
+*
+*               p_src       Pointer to the protected data.
+*
+*               size        Number of octets to copy.
+*
+* Return(s)   : Number of times the copy had to be retried.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Interrupts are NOT disabled; the copy is simply repeated until no update overlapped it.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  SeqLock_Rd (SEQLOCK      *p_lock,
+                        void         *p_dest,
+                        void  const  *p_src,
+                        CPU_SIZE_T    size)
+{
+    SEQLOCK_SEQ  seq;
+    CPU_INT32U   retry;
+
+
+    retry = 0u;
+    for (;;) {
+        seq = SeqLock_RdBegin(p_lock);
+        Mem_Copy(p_dest, p_src, size);
+        if (SeqLock_RdRetry(p_lock, seq) == DEF_NO) {
+            break;
+        }
+        retry++;
+    }
+
+    return (retry);
+}
+
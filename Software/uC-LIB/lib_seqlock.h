@@ -0,0 +1,189 @@
+/*
+*********************************************************************************************************
+*                                                uC/LIB
+*                                        CUSTOM LIBRARY MODULES
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                         SEQUENCE LOCK (SEQLOCK)
+*
+* Filename      : lib_seqlock.h
+* Version       : V1.38.01
+*********************************************************************************************************
+* Note(s)       : (1) A sequence lock publishes a block of data from writers to readers without ever
+*                     blocking or masking interrupts on the read side :
+*
+*                     (a) The writer increments the sequence counter before AND after modifying the data, so
+*                         the counter is odd while an update is in progress.
+*
+*                     (b) A reader samples the counter, copies the data & samples the counter again.  The copy
+*                         is consistent only if both samples are equal AND even; otherwise the reader retries.
+*
+*                 (2) Writers MUST be serialized with respect to each other by the caller.
+*
+*                 (3) A reader MUST NOT be able to preempt a writer in the middle of an update; on a single
+*                     CPU such a reader would retry forever since the writer cannot complete.  Either :
+*
+*                     (a) lock the scheduler around the update when readers are tasks; or
+*                     (b) perform the update at a higher priority (e.g. from an ISR) than every reader.
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_SEQLOCK_MODULE_PRESENT
+#define  LIB_SEQLOCK_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*                                               EXTERNS
+*********************************************************************************************************
+*/
+
+#ifdef   LIB_SEQLOCK_MODULE
+#define  LIB_SEQLOCK_EXT
+#else
+#define  LIB_SEQLOCK_EXT  extern
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*
+* Note(s) : (1) The sequence counter is a CPU_INT32U so that it is read & written with a single, atomic
+*               access on 32-bit CPUs.
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT32U  SEQLOCK_SEQ;
+
+typedef  struct  seqlock {
+    volatile  SEQLOCK_SEQ  Seq;                                 /* Odd while an update is in progress (see Note #1).    */
+} SEQLOCK;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                               MACROS
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          SEQLOCK_BARRIER()
+*
+* Description : Prevent the compiler from moving memory accesses across this point.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : SeqLock_xxx() functions.
+*
+* Note(s)     : (1) A compiler barrier is sufficient on a single CPU since the core observes its own
+*                   accesses in program order, as does any interrupt that preempts it.
+*
+*               (2) Compilers without a known barrier syntax call an external, empty function instead; the
+*                   compiler must then assume that the call may access any memory.
+*
+*               (3) SEQLOCK_BARRIER() may be #define'd in 'lib_cfg.h' to use a data memory barrier instead
+*                   (e.g. when the data is also read by a DMA master or by another core).
+*********************************************************************************************************
+*/
+
+#ifndef  SEQLOCK_BARRIER
+#if     (defined(__GNUC__) || defined(__clang__))
+#define  SEQLOCK_BARRIER()                                 __asm__  __volatile__("" : : : "memory")
+#else
+#define  SEQLOCK_BARRIER()                                 SeqLock_Barrier()
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         SeqLock_Init   (SEQLOCK      *p_lock);
+
+void         SeqLock_Barrier(void);
+
+                                                                /* ------------------ WR-SIDE FNCTS ------------------- */
+void         SeqLock_WrBegin(SEQLOCK      *p_lock);
+
+void         SeqLock_WrEnd  (SEQLOCK      *p_lock);
+
+void         SeqLock_Wr     (SEQLOCK      *p_lock,
+                             void         *p_dest,
+                             void  const  *p_src,
+                             CPU_SIZE_T    size);
+
+                                                                /* ------------------ RD-SIDE FNCTS ------------------- */
+SEQLOCK_SEQ  SeqLock_RdBegin(SEQLOCK      *p_lock);
+
+CPU_BOOLEAN  SeqLock_RdRetry(SEQLOCK      *p_lock,
+                             SEQLOCK_SEQ   seq);
+
+CPU_INT32U   SeqLock_Rd     (SEQLOCK      *p_lock,
+                             void         *p_dest,
+                             void  const  *p_src,
+                             CPU_SIZE_T    size);
+
+
+/*
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*
+* Note(s) : (1) See 'lib_seqlock.h  MODULE'.
+*********************************************************************************************************
+*/
+
+#endif                                                          /* End of lib seqlock module include.                   */
+
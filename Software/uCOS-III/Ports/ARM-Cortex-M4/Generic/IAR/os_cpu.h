@@ -65,6 +65,28 @@ extern  "C" {
 #endif
 #define  OS_CPU_ARM_FP_REG_NBR                           32u
 
+#define  OS_CPU_EXC_RETURN_THREAD_PSP           0xFFFFFFFDu   /* Thread mode, PSP, basic frame: first entry of a task  */
+
+
+/*
+*********************************************************************************************************
+*                                  FLOATING POINT CONTEXT CONFIGURATION
+*
+* Note(s) : (1) By default, the FP registers (S0-S31 & FPSCR) of the tasks created with OS_OPT_TASK_SAVE_FP
+*               are saved & restored by OSTaskSwHook() (OS_CPU_FP_Reg_Push()/OS_CPU_FP_Reg_Pop()) on every
+*               context switch, & OSStartHighRdy() clears ASPEN & LSPEN in FPCCR.
+*
+*           (2) With OS_CPU_CFG_FP_LAZY_EN #define'd, the hardware tracks FP use instead : OSStartHighRdy()
+*               sets ASPEN & LSPEN, each task frame carries its EXC_RETURN, & OS_CPU_PendSVHandler() saves
+*               S16-S31 only for the tasks that executed an FP instruction (FPSCR & S0-S15 are stacked
+*               lazily by the hardware).  OS_OPT_TASK_SAVE_FP is then ignored.
+*
+*           (3) 'os_cpu_a' does NOT include this file : OS_CPU_CFG_FP_LAZY_EN MUST be #define'd for both
+*               the C compiler & the assembler (-D in the assembler preprocessor options), or for neither.
+*********************************************************************************************************
+*/
+
+
 /*
 *********************************************************************************************************
 *                                               MACROS
@@ -126,10 +148,18 @@ extern  "C" {
 *                   tick interrupt, then the CPU/system is most likely over-burdened & can't be expected
 *                   to handle all its interrupts/tasks. The system time reference gets compromised as a
 *                   result of losing tick interrupts.
+*
+*           (3) With BASEPRI critical sections (CPU_CFG_KA_IPL_BOUNDARY #define'd in 'cpu_cfg.h') the tick
+*               interrupt calls the kernel, so it is placed on the highest kernel aware level.  The real-time
+*               interrupts of Note #2 go on the levels above it and are never masked by the kernel.
 *********************************************************************************************************
 */
 
+#ifdef   CPU_CFG_KA_IPL_BOUNDARY
+#define  OS_CPU_CFG_SYSTICK_PRIO           CPU_CFG_KA_BASEPRI   /* See Note #3.                                     */
+#else
 #define  OS_CPU_CFG_SYSTICK_PRIO           0u
+#endif
 
 
 /*
@@ -139,6 +169,7 @@ extern  "C" {
 */
 
 OS_CPU_EXT  CPU_STK  *OS_CPU_ExceptStkBase;
+OS_CPU_EXT  CPU_SR    OS_CPU_KA_BasePri;                  /* PendSV mask, 0 = PRIMASK only (see 'os_cpu_a')      */
 
 
 /*
@@ -157,7 +188,7 @@ void  OS_CPU_PendSVHandler (void);
 void  OS_CPU_SysTickHandler(void);
 void  OS_CPU_SysTickInit   (CPU_INT32U  cnts);
 
-#if (OS_CPU_ARM_FP_EN == DEF_ENABLED)
+#if (OS_CPU_ARM_FP_EN == DEF_ENABLED) && !defined(OS_CPU_CFG_FP_LAZY_EN)
 void  OS_CPU_FP_Reg_Push   (CPU_STK    *stkPtr);
 void  OS_CPU_FP_Reg_Pop    (CPU_STK    *stkPtr);
 #endif
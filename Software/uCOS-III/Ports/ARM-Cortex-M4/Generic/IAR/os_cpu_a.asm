@@ -33,6 +33,7 @@
     EXTERN  OSIntExit
     EXTERN  OSTaskSwHook
     EXTERN  OS_CPU_ExceptStkBase
+    EXTERN  OS_CPU_KA_BasePri
 
 
     PUBLIC  OSStartHighRdy                                      ; Functions declared in this file
@@ -40,7 +41,7 @@
     PUBLIC  OSIntCtxSw
     PUBLIC  OS_CPU_PendSVHandler
 
-#ifdef __ARMVFP__
+#if defined(__ARMVFP__) && !defined(OS_CPU_CFG_FP_LAZY_EN)
     PUBLIC  OS_CPU_FP_Reg_Push
     PUBLIC  OS_CPU_FP_Reg_Pop
 #endif
@@ -54,6 +55,8 @@ NVIC_INT_CTRL   EQU     0xE000ED04                              ; Interrupt cont
 NVIC_SYSPRI14   EQU     0xE000ED22                              ; System priority register (priority 14).
 NVIC_PENDSV_PRI EQU           0xFF                              ; PendSV priority value (lowest).
 NVIC_PENDSVSET  EQU     0x10000000                              ; Value to trigger PendSV exception.
+NVIC_FPCCR      EQU     0xE000EF34                              ; Floating-point context control register.
+NVIC_FPCCR_LAZY EQU     0xC0000000                              ; ASPEN | LSPEN: lazy FP state preservation.
 
 
 ;********************************************************************************************************
@@ -75,9 +78,11 @@ NVIC_PENDSVSET  EQU     0x10000000                              ; Value to trigg
 ;              b) Push value on process stack;
 ;              c) Push remaining regs S0-S31 on process stack;
 ;              d) Update OSTCBCurPtr->StkPtr;
+;
+;           3) Only used without OS_CPU_CFG_FP_LAZY_EN (see 'os_cpu.h  FLOATING POINT CONTEXT').
 ;********************************************************************************************************
 
-#ifdef __ARMVFP__
+#if defined(__ARMVFP__) && !defined(OS_CPU_CFG_FP_LAZY_EN)
 OS_CPU_FP_Reg_Push
     MRS     R1, PSP                                             ; PSP is process stack pointer
     CBZ     R1, OS_CPU_FP_nosave                                ; Skip FP register save the first time
@@ -103,9 +108,11 @@ OS_CPU_FP_nosave
 ;              a) Restore regs S0-S31 of new process stack;
 ;              b) Restore FPSCR reg value
 ;              c) Update OSTCBHighRdyPtr->StkPtr pointer of new proces stack;
+;
+;           3) Only used without OS_CPU_CFG_FP_LAZY_EN (see 'os_cpu.h  FLOATING POINT CONTEXT').
 ;********************************************************************************************************
 
-#ifdef __ARMVFP__
+#if defined(__ARMVFP__) && !defined(OS_CPU_CFG_FP_LAZY_EN)
 OS_CPU_FP_Reg_Pop
     VLDMIA  R0!, {S0-S31}
     LDMIA   R0!, {R1}
@@ -130,6 +137,10 @@ OS_CPU_FP_Reg_Pop
 ;              c) Set the main stack to OS_CPU_ExceptStkBase
 ;              d) Trigger PendSV exception;
 ;              e) Enable interrupts (tasks will run with interrupts enabled).
+;              f) Start the first task with no FP context active (CONTROL.FPCA = 0), with lazy FP
+;                 state preservation (ASPEN | LSPEN) enabled if OS_CPU_CFG_FP_LAZY_EN is #define'd
+;                 and disabled otherwise.  With OS_CPU_CFG_FP_LAZY_EN the first task's EXC_RETURN
+;                 slot is skipped; it is only used by OS_CPU_PendSVHandler().
 ;********************************************************************************************************
 
 OSStartHighRdy
@@ -155,12 +166,30 @@ OSStartHighRdy
     LDR     R0, [R2]                                            ; R0 is new process SP; SP = OSTCBHighRdyPtr->StkPtr;
     MSR     PSP, R0                                             ; Load PSP with new process SP
 
-    MRS     R0, CONTROL
+#ifdef __ARMVFP__
+    MOV32   R0, NVIC_FPCCR                                      ; ASPEN | LSPEN (see Note #2f)
+    MOV32   R1, NVIC_FPCCR_LAZY
+    LDR     R2, [R0]
+#ifdef OS_CPU_CFG_FP_LAZY_EN
+    ORR     R2, R2, R1                                          ; Lazy FP stacking on
+#else
+    BIC     R2, R2, R1                                          ; Basic frames only, OSTaskSwHook() saves FP
+#endif
+    STR     R2, [R0]
+#endif
+
+    MRS     R0, CONTROL                                         ; Thread mode uses PSP
     ORR     R0, R0, #2
+#ifdef __ARMVFP__
+    BIC     R0, R0, #4                                          ; No FP context active yet (FPCA = 0)
+#endif
     MSR     CONTROL, R0
     ISB                                                         ; Sync instruction stream
 
     LDMFD    SP!, {R4-R11}                                      ; Restore r4-11 from new process stack
+#ifdef OS_CPU_CFG_FP_LAZY_EN
+    ADD      SP, SP, #4                                         ; Skip EXC_RETURN, the task starts in Thread mode
+#endif
     LDMFD    SP!, {R0-R3}                                       ; Restore r0, r3
     LDMFD    SP!, {R12, LR}                                     ; Load R12 and LR
     LDMFD    SP!, {R1, R2}                                      ; Load PC and discard xPSR
@@ -209,19 +238,25 @@ OSIntCtxSw
 ;              a thread or occurs due to an interrupt or exception.
 ;
 ;           2) Pseudo-code is:
-;              a) Get the process SP, if 0 then skip (goto d) the saving part (first context switch);
-;              b) Save remaining regs r4-r11 on process stack;
+;              a) Get the process SP;
+;              b) Save remaining regs r4-r11 on process stack.  With OS_CPU_CFG_FP_LAZY_EN, first save
+;                 S16-S31 if the task used the FPU (EXC_RETURN bit 4 clear), and EXC_RETURN (LR) with r4-r11;
 ;              c) Save the process SP in its TCB, OSTCBCurPtr->OSTCBStkPtr = SP;
 ;              d) Call OSTaskSwHook();
 ;              e) Get current high priority, OSPrioCur = OSPrioHighRdy;
 ;              f) Get current ready thread TCB, OSTCBCurPtr = OSTCBHighRdyPtr;
 ;              g) Get new process SP from TCB, SP = OSTCBHighRdyPtr->OSTCBStkPtr;
-;              h) Restore R4-R11 from new process stack;
+;              h) Restore R4-R11 from new process stack.  With OS_CPU_CFG_FP_LAZY_EN, also restore
+;                 EXC_RETURN, then S16-S31 if that task's EXC_RETURN says its frame has FP state;
 ;              i) Perform exception return which will restore remaining context.
 ;
 ;           3) On entry into PendSV handler:
 ;              a) The following have been saved on the process stack (by processor):
 ;                 xPSR, PC, LR, R12, R0-R3
+;                 and, with OS_CPU_CFG_FP_LAZY_EN, if the task had an FP context active, also FPSCR
+;                 and S0-S15.  With lazy stacking (LSPEN) only the space is reserved; the hardware
+;                 writes S0-S15 the first time the FPU is touched again, i.e. by the VSTMDB below,
+;                 and never for tasks that did not use the FPU.
 ;              b) Processor mode is switched to Handler mode (from Thread mode)
 ;              c) Stack is Main stack (switched from Process stack)
 ;              d) OSTCBCurPtr      points to the OS_TCB of the task to suspend
@@ -230,19 +265,47 @@ OSIntCtxSw
 ;           4) Since PendSV is set to lowest priority in the system (by OSStartHighRdy() above), we
 ;              know that it will only be run when no other exception or interrupt is active, and
 ;              therefore safe to assume that context being switched out was using the process stack (PSP).
+;
+;           5) Without OS_CPU_CFG_FP_LAZY_EN (default), EXC_RETURN is forced to 0xFFFFFFFD (basic frame)
+;              and OSTaskSwHook() saves & restores S0-S31 and FPSCR of the tasks created with
+;              OS_OPT_TASK_SAVE_FP.  With it, EXC_RETURN is saved per task, so a task that used the FPU
+;              returns through the extended frame (0xFFFFFFED) and every other task through the basic
+;              frame; the hardware tracks FP use and OS_OPT_TASK_SAVE_FP is ignored.
+;
+;           6) OS_CPU_KA_BasePri is set by OSInitHook().  If it is non-zero (CPU_CFG_KA_IPL_BOUNDARY
+;              #define'd in 'cpu_cfg.h'), PRIMASK is only set for the few instructions needed to raise
+;              BASEPRI, so interrupts above the kernel aware boundary are never held off by a context
+;              switch, including OSTaskSwHook().
 ;********************************************************************************************************
 
 OS_CPU_PendSVHandler
     CPSID   I                                                   ; Prevent interruption during context switch
+    MOV32   R2, OS_CPU_KA_BasePri                               ; BASEPRI port: mask kernel aware ints only
+    LDR     R1, [R2]                                            ; (see Note #6)
+    CBZ     R1, OS_CPU_PendSV_Masked                            ; 0: PRIMASK port, stay masked
+    MSR     BASEPRI, R1
+    CPSIE   I
+OS_CPU_PendSV_Masked
     MRS     R0, PSP                                             ; PSP is process stack pointer
+#ifdef OS_CPU_CFG_FP_LAZY_EN
+#ifdef __ARMVFP__
+    TST     R14, #0x10                                          ; Task used the FPU? (EXC_RETURN bit 4 == 0)
+    IT      EQ
+    VSTMDBEQ R0!, {S16-S31}                                     ; Save s16-31, hardware stacks s0-15 lazily
+#endif
+    STMFD   R0!, {R4-R11, R14}                                  ; Save r4-11 and EXC_RETURN on process stack
+#else
     STMFD   R0!, {R4-R11}                                       ; Save remaining regs r4-11 on process stack
+#endif
 
     MOV32   R5, OSTCBCurPtr                                     ; OSTCBCurPtr->OSTCBStkPtr = SP;
     LDR     R6, [R5]
     STR     R0, [R6]                                            ; R0 is SP of process being switched out
 
                                                                 ; At this point, entire context of process has been saved
+#ifndef OS_CPU_CFG_FP_LAZY_EN
     MOV     R4, LR                                              ; Save LR exc_return value
+#endif
     BL      OSTaskSwHook                                        ; OSTaskSwHook();
 
     MOV32   R0, OSPrioCur                                       ; OSPrioCur   = OSPrioHighRdy;
@@ -254,10 +317,22 @@ OS_CPU_PendSVHandler
     LDR     R2, [R1]
     STR     R2, [R5]
 
+#ifdef OS_CPU_CFG_FP_LAZY_EN
+    LDR     R0, [R2]                                            ; R0 is new process SP; SP = OSTCBHighRdyPtr->StkPtr;
+    LDMFD   R0!, {R4-R11, R14}                                  ; Restore r4-11 and EXC_RETURN from new process stack
+#ifdef __ARMVFP__
+    TST     R14, #0x10                                          ; Task has FP state on its stack?
+    IT      EQ
+    VLDMIAEQ R0!, {S16-S31}                                     ; Restore s16-31, exception return restores s0-15
+#endif
+#else
     ORR     LR, R4, #0xF4                                       ; Ensure exception return uses process stack
     LDR     R0, [R2]                                            ; R0 is new process SP; SP = OSTCBHighRdyPtr->StkPtr;
     LDMFD   R0!, {R4-R11}                                       ; Restore r4-11 from new process stack
+#endif
     MSR     PSP, R0                                             ; Load PSP with new process SP
+    MOV     R2, #0                                              ; PendSV is only taken with BASEPRI = 0
+    MSR     BASEPRI, R2
     CPSIE   I
     BX      LR                                                  ; Exception return will restore remaining context
 
@@ -100,6 +100,12 @@ void  OSInitHook (void)
                                                                 /* 8-byte align the ISR stack.                            */    
     OS_CPU_ExceptStkBase = (CPU_STK *)(OSCfg_ISRStkBasePtr + OSCfg_ISRStkSize);
     OS_CPU_ExceptStkBase = (CPU_STK *)((CPU_STK)(OS_CPU_ExceptStkBase) & 0xFFFFFFF8);
+
+#ifdef  CPU_CFG_KA_IPL_BOUNDARY                                     /* PendSV masks kernel aware ints only.                   */
+    OS_CPU_KA_BasePri    = CPU_CFG_KA_BASEPRI;
+#else
+    OS_CPU_KA_BasePri    = (CPU_SR)0;
+#endif
 }
 
 
@@ -288,6 +294,12 @@ void  OSTaskReturnHook (OS_TCB  *p_tcb)
 *                                         +------------+
 *                                              (b)
 *
+*                  (c) With OS_CPU_CFG_FP_LAZY_EN #define'd (see 'os_cpu.h  FLOATING POINT CONTEXT') the frame
+*                      of diagram (a) carries the task's EXC_RETURN between R0 and R11 instead, & no FP register
+*                      is pre-stacked; OS_OPT_TASK_SAVE_FP is ignored.  A task that executes an FP instruction
+*                      gets FPSCR & S0-S15 in its exception frame (stacked lazily by the hardware, ASPEN & LSPEN
+*                      set in FPCCR) & S16-S31 below R4, & returns through EXC_RETURN 0xFFFFFFED.
+*
 *             (4) The SP must be 8-byte aligned in conforming to the Procedure Call Standard for the ARM architecture 
 *
 *                    (a) Section 2.1 of the  ABI for the ARM Architecture Advisory Note. SP must be 8-byte aligned 
@@ -373,6 +385,9 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *--p_stk = (CPU_STK)p_stk_limit;                            /* R1                                                     */
     *--p_stk = (CPU_STK)p_arg;                                  /* R0 : argument                                          */
                                                                 /* Remaining registers saved on process stack             */
+#ifdef  OS_CPU_CFG_FP_LAZY_EN
+    *--p_stk = (CPU_STK)OS_CPU_EXC_RETURN_THREAD_PSP;           /* EXC_RETURN (see Note #3)                               */
+#endif
     *--p_stk = (CPU_STK)0x11111111u;                            /* R11                                                    */
     *--p_stk = (CPU_STK)0x10101010u;                            /* R10                                                    */
     *--p_stk = (CPU_STK)0x09090909u;                            /* R9                                                     */
@@ -381,8 +396,8 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *--p_stk = (CPU_STK)0x06060606u;                            /* R6                                                     */
     *--p_stk = (CPU_STK)0x05050505u;                            /* R5                                                     */
     *--p_stk = (CPU_STK)0x04040404u;                            /* R4                                                     */
-    
-#if (OS_CPU_ARM_FP_EN == DEF_ENABLED)
+
+#if (OS_CPU_ARM_FP_EN == DEF_ENABLED) && !defined(OS_CPU_CFG_FP_LAZY_EN)
     if ((opt & OS_OPT_TASK_SAVE_FP) != (OS_OPT)0) {
         *--p_stk = (CPU_STK)0x02000000u;                        /* FPSCR                                                  */
                                                                 /* Initialize S0-S31 floating point registers             */
@@ -419,7 +434,7 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
         *--p_stk = (CPU_STK)0x3F800000u;                        /* S1                                                     */
         *--p_stk = (CPU_STK)0x00000000u;                        /* S0                                                     */
     }
-#endif    
+#endif
 
     return (p_stk);
 }
@@ -451,7 +466,7 @@ void  OSTaskSwHook (void)
 #endif
 
 
-#if (OS_CPU_ARM_FP_EN == DEF_ENABLED)
+#if (OS_CPU_ARM_FP_EN == DEF_ENABLED) && !defined(OS_CPU_CFG_FP_LAZY_EN)
     if ((OSTCBCurPtr->Opt & OS_OPT_TASK_SAVE_FP) != (OS_OPT)0) {
         OS_CPU_FP_Reg_Push(OSTCBCurPtr->StkPtr);
     }
@@ -530,6 +545,9 @@ void  OSTimeTickHook (void)
 * Arguments  : None.
 *
 * Note(s)    : 1) This function MUST be placed on entry 15 of the Cortex-M3 vector table.
+*
+*              2) OSIntEnter() rather than a direct increment of 'OSIntNestingCtr', so that the tick ISR is
+*                 counted as ISR time by task profiling (see OSIntEnter() Note #6).
 *********************************************************************************************************
 */
 
@@ -539,7 +557,7 @@ void  OS_CPU_SysTickHandler (void)
 
 
     CPU_CRITICAL_ENTER();
-    OSIntNestingCtr++;                                      /* Tell uC/OS-III that we are starting an ISR             */
+    OSIntEnter();                                           /* Tell uC/OS-III that we are starting an ISR             */
     CPU_CRITICAL_EXIT();
 
     OSTimeTick();                                           /* Call uC/OS-III's OSTimeTick()                          */
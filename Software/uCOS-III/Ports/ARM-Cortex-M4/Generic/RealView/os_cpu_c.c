@@ -100,6 +100,12 @@ void  OSInitHook (void)
                                                                     /* 8-byte align the ISR stack.                            */    
     OS_CPU_ExceptStkBase = (CPU_STK *)(OSCfg_ISRStkBasePtr + OSCfg_ISRStkSize);
     OS_CPU_ExceptStkBase = (CPU_STK *)((CPU_STK)(OS_CPU_ExceptStkBase) & 0xFFFFFFF8);
+
+#ifdef  CPU_CFG_KA_IPL_BOUNDARY                                     /* PendSV masks kernel aware ints only.                   */
+    OS_CPU_KA_BasePri    = CPU_CFG_KA_BASEPRI;
+#else
+    OS_CPU_KA_BasePri    = (CPU_SR)0;
+#endif
 }
 
 
@@ -224,6 +230,15 @@ void  OSTaskReturnHook (OS_TCB  *p_tcb)
 * Note(s)    : 1) Interrupts are enabled when task starts executing.
 *
 *              2) All tasks run in Thread mode, using process stack.
+*
+*              3) By default, S0-S31 and FPSCR are pre-stacked below R4 for a task created with
+*                 OS_OPT_TASK_SAVE_FP; OSTaskSwHook() saves & restores them on every switch.
+*
+*                 With OS_CPU_CFG_FP_LAZY_EN #define'd (see 'os_cpu.h  FLOATING POINT CONTEXT'), the frame
+*                 carries the task's EXC_RETURN between R0 and R11 instead, so OS_CPU_PendSVHandler()
+*                 returns each task through the frame type it was switched out with.  No FP registers
+*                 are pre-stacked: a task gets an FP frame (S16-S31 here, FPSCR and S0-S15 lazily by the
+*                 hardware) only once it has executed an FP instruction.  OS_OPT_TASK_SAVE_FP is ignored.
 **********************************************************************************************************
 */
 
@@ -252,6 +267,9 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *--p_stk = (CPU_STK)p_stk_limit;                            /* R1                                                     */
     *--p_stk = (CPU_STK)p_arg;                                  /* R0 : argument                                          */
                                                                 /* Remaining registers saved on process stack             */
+#ifdef  OS_CPU_CFG_FP_LAZY_EN
+    *--p_stk = (CPU_STK)OS_CPU_EXC_RETURN_THREAD_PSP;           /* EXC_RETURN (see Note #3)                               */
+#endif
     *--p_stk = (CPU_STK)0x11111111u;                            /* R11                                                    */
     *--p_stk = (CPU_STK)0x10101010u;                            /* R10                                                    */
     *--p_stk = (CPU_STK)0x09090909u;                            /* R9                                                     */
@@ -261,7 +279,7 @@ CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
     *--p_stk = (CPU_STK)0x05050505u;                            /* R5                                                     */
     *--p_stk = (CPU_STK)0x04040404u;                            /* R4                                                     */
 
-#if (OS_CPU_ARM_FP_EN == DEF_ENABLED)
+#if (OS_CPU_ARM_FP_EN == DEF_ENABLED) && !defined(OS_CPU_CFG_FP_LAZY_EN)
     if ((opt & OS_OPT_TASK_SAVE_FP) != (OS_OPT)0) {
         *--p_stk = (CPU_STK)0x02000000u;                        /* FPSCR                                                  */
                                                                 /* Initialize S0-S31 floating point registers             */
@@ -330,7 +348,7 @@ void  OSTaskSwHook (void)
 #endif
 
 
-#if (OS_CPU_ARM_FP_EN == DEF_ENABLED)
+#if (OS_CPU_ARM_FP_EN == DEF_ENABLED) && !defined(OS_CPU_CFG_FP_LAZY_EN)
     if ((OSTCBCurPtr->Opt & OS_OPT_TASK_SAVE_FP) != (OS_OPT)0) {
         OS_CPU_FP_Reg_Push(OSTCBCurPtr->StkPtr);
     }
@@ -409,6 +427,9 @@ void  OSTimeTickHook (void)
 * Arguments  : None.
 *
 * Note(s)    : 1) This function MUST be placed on entry 15 of the Cortex-M3 vector table.
+*
+*              2) OSIntEnter() rather than a direct increment of 'OSIntNestingCtr', so that the tick ISR is
+*                 counted as ISR time by task profiling (see OSIntEnter() Note #6).
 *********************************************************************************************************
 */
 
@@ -418,7 +439,7 @@ void  OS_CPU_SysTickHandler (void)
 
 
     CPU_CRITICAL_ENTER();
-    OSIntNestingCtr++;                                      /* Tell uC/OS-III that we are starting an ISR             */
+    OSIntEnter();                                           /* Tell uC/OS-III that we are starting an ISR             */
     CPU_CRITICAL_EXIT();
 
     OSTimeTick();                                           /* Call uC/OS-III's OSTimeTick()                          */
@@ -163,6 +163,15 @@
 
 #define  OS_MSG_EN                 (((OS_CFG_TASK_Q_EN > 0u) || (OS_CFG_Q_EN > 0u)) ? 1u : 0u)
 
+#define  OS_FLAG_NBR_BITS          (sizeof(OS_FLAGS) * DEF_OCTET_NBR_BITS)
+#define  OS_FLAG_WATCH_ANY         ((CPU_INT08U)0xFFu)      /* Task is on the 'several flags, any of them' list       */
+#define  OS_FLAG_WATCH_NONE        ((CPU_INT08U)0xFEu)      /* Task is on no watch list                               */
+
+#define  OS_STAT_CYCLES_EN         (((OS_CFG_STAT_TASK_EN > 0u) && (OS_CFG_TASK_PROFILE_EN > 0u) && (OS_CFG_DBG_EN > 0u)) \
+                                   ? 1u : 0u)               /* CPU usage from cycle counts, see OS_StatTask() Note #5 */
+#define  OS_STAT_LOAD_AVG_NBR      3u                       /* Load averages over 1 s, 10 s and 60 s                  */
+#define  OS_STAT_LOAD_AVG_USAGE(avg)  ((OS_CPU_USAGE)(((avg) + 0x8000u) >> 16u))  /* Load average to 0.00-100.00%      */
+
 #define  OS_OBJ_TYPE_REQ           (((OS_CFG_DBG_EN > 0u) || (OS_CFG_OBJ_TYPE_CHK_EN > 0u) || (OS_CFG_PEND_MULTI_EN > 0u) \
                                    || (OS_CFG_ISR_POST_DEFERRED_EN > 0u)) ? 1u : 0u)
 
@@ -636,6 +645,7 @@ typedef  enum  os_err {
 */
 
 typedef  struct  os_flag_grp         OS_FLAG_GRP;
+typedef  struct  os_flag_post_data   OS_FLAG_POST_DATA;
 
 typedef  struct  os_mem              OS_MEM;
 
@@ -647,6 +657,8 @@ typedef  struct  os_mutex            OS_MUTEX;
 
 typedef  struct  os_int_q            OS_INT_Q;
 
+typedef  struct  os_load             OS_LOAD;
+
 typedef  struct  os_q                OS_Q;
 
 typedef  struct  os_sem              OS_SEM;
@@ -676,6 +688,11 @@ typedef  struct  os_pend_data        OS_PEND_DATA;
 typedef  struct  os_pend_list        OS_PEND_LIST;
 typedef  struct  os_pend_obj         OS_PEND_OBJ;
 
+#if OS_CFG_OBJ_STAT_EN > 0u
+typedef  struct  os_obj_stat         OS_OBJ_STAT;
+typedef  struct  os_obj_stat_snap    OS_OBJ_STAT_SNAP;
+#endif
+
 #if OS_CFG_APP_HOOKS_EN > 0u
 typedef  void                      (*OS_APP_HOOK_VOID)(void);
 typedef  void                      (*OS_APP_HOOK_TCB)(OS_TCB *p_tcb);
@@ -747,6 +764,45 @@ struct  os_pend_list {
 };
 
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                              OBJECT CONTENTION STATISTICS
+*
+* Note(s) : (1) Every pend on a semaphore, mutex, queue or event flag group counts in 'PendCtr'.  It then either got
+*               the object at once ('PendNowCtr'), blocked in OS_Pend() ('PendBlkCtr') or returned without it
+*               (non-blocking pend, locked scheduler).
+*
+*           (2) A wait is the time from OS_Pend() to the post that readies the task, in CPU_TS.  Only waits ended
+*               by a post are counted in 'WaitCtr'; timeouts, aborts and deletions are blocks without a wait.
+*               Tasks pending on several objects with OSPendMulti() are not attributed to any of them.
+*
+*           (3) 'WaitersMax' is the longest the pend list has been, the blocking task included.
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+#if OS_CFG_OBJ_STAT_EN > 0u
+struct  os_obj_stat {
+    OS_CTR               PostCtr;                           /* Nbr of posts                                           */
+    OS_CTR               PendCtr;                           /* Nbr of pends (see Note #1)                             */
+    OS_CTR               PendNowCtr;                        /* Nbr of pends satisfied without blocking                */
+    OS_CTR               PendBlkCtr;                        /* Nbr of pends that blocked                              */
+    OS_CTR               WaitCtr;                           /* Nbr of waits ended by a post (see Note #2)             */
+    OS_OBJ_QTY           WaitersMax;                        /* Peak nbr of tasks pending (see Note #3)                */
+    CPU_TS               WaitMax;                           /* Longest wait                                           */
+    CPU_TS64             WaitTot;                           /* Sum of the waits counted in 'WaitCtr'                  */
+};
+
+
+struct  os_obj_stat_snap {                                  /* Entry filled by OSObjStatSnap()                        */
+    void                *ObjPtr;                            /* Pointer to the kernel object                           */
+    OS_OBJ_TYPE          Type;                              /* OS_OBJ_TYPE_SEM, _MUTEX, _Q or _FLAG                   */
+    CPU_CHAR            *NamePtr;
+    OS_OBJ_QTY           Waiters;                           /* Nbr of tasks pending at the time of the snapshot       */
+    OS_OBJ_STAT          Stat;
+};
+#endif
+
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                       PEND OBJ
@@ -775,6 +831,9 @@ struct  os_pend_obj {
     void                *DbgNextPtr;
     CPU_CHAR            *DbgNamePtr;
 #endif
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_OBJ_STAT          Stat;                              /* Contention statistics                                  */
+#endif
 };
 
 
@@ -800,9 +859,18 @@ struct  os_flag_grp {                                       /* Event Flag Group
     OS_FLAG_GRP         *DbgPrevPtr;
     OS_FLAG_GRP         *DbgNextPtr;
     CPU_CHAR            *DbgNamePtr;
+#endif
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_OBJ_STAT          Stat;                              /* Contention statistics                                  */
 #endif
                                                             /* ------------------ SPECIFIC MEMBERS ------------------ */
     OS_FLAGS             Flags;                             /* 8, 16 or 32 bit flags                                  */
+    OS_FLAGS             FlagsChk;                          /* Flags changed by a consuming pend since the last post  */
+                                                            /* WatchTbl costs one pointer per flag bit in every       */
+                                                            /* group: 128 bytes with 32-bit OS_FLAGS and pointers.    */
+    OS_TCB              *WatchTbl[OS_FLAG_NBR_BITS];        /* Waiters indexed by the flag bit that can wake them     */
+    OS_TCB              *WatchAnyPtr;                       /* Waiters for any of several flags                       */
+    OS_CTR               PendSeq;                           /* Pend order stamp given to the next waiter              */
     CPU_TS               TS;                                /* Timestamp of when last post occurred                   */
 #if (defined(TRACE_CFG_EN) && (TRACE_CFG_EN > 0u))
     CPU_INT32U           FlagID;                            /* Unique ID for third-party debuggers and tracers.       */
@@ -810,6 +878,13 @@ struct  os_flag_grp {                                       /* Event Flag Group
 };
 
 
+struct  os_flag_post_data {                                 /* Entry of a batch post, see OSFlagPostMulti()           */
+    OS_FLAG_GRP         *GrpPtr;                            /* Event flag group to post to                            */
+    OS_FLAGS             Flags;                             /* Flags to set or clear                                  */
+    OS_OPT               Opt;                               /* OS_OPT_POST_FLAG_SET or OS_OPT_POST_FLAG_CLR           */
+};
+
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                   MEMORY PARTITIONS
@@ -901,9 +976,13 @@ struct  os_mutex {                                          /* Mutual Exclusion
     OS_MUTEX            *DbgPrevPtr;
     OS_MUTEX            *DbgNextPtr;
     CPU_CHAR            *DbgNamePtr;
+#endif
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_OBJ_STAT          Stat;                              /* Contention statistics                                  */
 #endif
                                                             /* ------------------ SPECIFIC MEMBERS ------------------ */
     OS_MUTEX            *MutexGrpNextPtr;
+    OS_PRIO              GrpPrio;                           /* Prio of highest waiter as counted in owner's group     */
     OS_TCB              *OwnerTCBPtr;
     OS_NESTING_CTR       OwnerNestingCtr;                   /* Mutex is available when the counter is 0               */
     CPU_TS               TS;
@@ -934,6 +1013,9 @@ struct  os_q {                                              /* Message Queue
     OS_Q                *DbgPrevPtr;
     OS_Q                *DbgNextPtr;
     CPU_CHAR            *DbgNamePtr;
+#endif
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_OBJ_STAT          Stat;                              /* Contention statistics                                  */
 #endif
                                                             /* ------------------ SPECIFIC MEMBERS ------------------ */
     OS_MSG_Q             MsgQ;                              /* List of messages                                       */
@@ -964,6 +1046,9 @@ struct  os_sem {                                            /* Semaphore
     OS_SEM              *DbgPrevPtr;
     OS_SEM              *DbgNextPtr;
     CPU_CHAR            *DbgNamePtr;
+#endif
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_OBJ_STAT          Stat;                              /* Contention statistics                                  */
 #endif
                                                             /* ------------------ SPECIFIC MEMBERS ------------------ */
     OS_SEM_CTR           Ctr;
@@ -974,6 +1059,26 @@ struct  os_sem {                                            /* Semaphore
 };
 
 
+/*
+------------------------------------------------------------------------------------------------------------------------
+*                                                     LOAD ACCOUNT
+*
+* Note(s) : (1) A load account collects the cycles spent in one activity that is not a task, e.g. one interrupt source.
+*               Its owner adds to '.Cycles' (see OSStatLoadAdd()); the statistic task turns the counts into load averages
+*               (see OS_StatTask() Note #6).  Load averages are in 0.00-100.00% << 16; read them with
+*               OS_STAT_LOAD_AVG_USAGE().
+------------------------------------------------------------------------------------------------------------------------
+*/
+
+struct  os_load {
+    CPU_CHAR            *NamePtr;                           /* Pointer to name (NUL terminated ASCII)                 */
+    OS_CYCLES            Cycles;                            /* # cycles in the current statistic period               */
+    OS_CYCLES            CyclesWin;                         /* # cycles in the current 1 s window                     */
+    CPU_INT32U           Avg[OS_STAT_LOAD_AVG_NBR];         /* 1 s, 10 s and 60 s load averages                       */
+    OS_LOAD             *NextPtr;
+};
+
+
 /*
 ------------------------------------------------------------------------------------------------------------------------
 *                                                  TASK CONTROL BLOCK
@@ -1023,6 +1128,11 @@ struct os_tcb {
 #if OS_CFG_MUTEX_EN > 0u
     OS_PRIO              BasePrio;                          /* Base priority (Not inherited)                          */
     OS_MUTEX            *MutexGrpHeadPtr;                   /* Owned mutex group head pointer                         */
+                                                            /* The two tables below cost OS_PRIO_TBL_SIZE CPU_DATA    */
+                                                            /* plus OS_CFG_PRIO_MAX OS_OBJ_QTY per TCB: 136 bytes     */
+                                                            /* with 64 priorities and 32-bit CPU_DATA.                */
+    CPU_DATA             MutexGrpPrioTbl[OS_PRIO_TBL_SIZE]; /* Bitmap of prio waiting on any mutex of the group       */
+    OS_OBJ_QTY           MutexGrpPrioCtr[OS_CFG_PRIO_MAX];  /* Nbr of mutexes in the group with their HPT at prio     */
 #endif
 
 #if ((OS_CFG_DBG_EN > 0u) || (OS_CFG_STAT_TASK_STK_CHK_EN > 0u))
@@ -1033,6 +1143,9 @@ struct os_tcb {
     OS_OBJ_QTY           PendDataTblEntries;                /* Size of array of objects to pend on                    */
 
     CPU_TS               TS;                                /* Timestamp                                              */
+#if OS_CFG_OBJ_STAT_EN > 0u
+    CPU_TS               PendTS;                            /* When the task blocked in OS_Pend()                     */
+#endif
 #if (defined(TRACE_CFG_EN) && (TRACE_CFG_EN > 0u))
     CPU_INT08U           SemID;                             /* Unique ID for third-party debuggers and tracers.       */
 #endif
@@ -1068,6 +1181,10 @@ struct os_tcb {
     OS_FLAGS             FlagsPend;                         /* Event flag(s) to wait on                               */
     OS_FLAGS             FlagsRdy;                          /* Event flags that made task ready to run                */
     OS_OPT               FlagsOpt;                          /* Options (See OS_OPT_FLAG_xxx)                          */
+    OS_TCB              *FlagWatchNextPtr;                  /* Links in the watch list of the event flag group        */
+    OS_TCB              *FlagWatchPrevPtr;
+    CPU_INT08U           FlagWatchBit;                      /* Flag bit watched, OS_FLAG_WATCH_ANY or _NONE           */
+    OS_CTR               FlagPendSeq;                       /* Pend order in the event flag group                     */
 #endif
 
 #if OS_CFG_TASK_SUSPEND_EN > 0u
@@ -1082,6 +1199,10 @@ struct os_tcb {
     CPU_TS               CyclesStart;                       /* Snapshot of cycle counter at start of task resumption  */
     OS_CYCLES            CyclesTotal;                       /* Total number of # of cycles the task has been running  */
     OS_CYCLES            CyclesTotalPrev;                   /* Snapshot of previous # of cycles                       */
+#if OS_STAT_CYCLES_EN > 0u
+    OS_CYCLES            CyclesWin;                         /* # cycles in the current 1 s window                     */
+    CPU_INT32U           CPUUsageAvg[OS_STAT_LOAD_AVG_NBR]; /* 1 s, 10 s and 60 s load averages (see OS_LOAD Note #1) */
+#endif
 
     CPU_TS               SemPendTime;                       /* Time it took for signal to be received                 */
     CPU_TS               SemPendTimeMax;                    /* Max amount of time it took for signal to be received   */
@@ -1179,6 +1300,12 @@ OS_EXT            OS_TCB                    OSIdleTaskTCB;
 
                                                                         /* MISCELLANEOUS ---------------------------- */
 OS_EXT            OS_NESTING_CTR            OSIntNestingCtr;            /* Interrupt nesting level                    */
+#if OS_CFG_TASK_PROFILE_EN > 0u
+OS_EXT            CPU_TS                    OSIntCyclesStart;           /* Cycle counter at entry of outermost ISR    */
+OS_EXT            OS_CYCLES                 OSIntCyclesTotal;           /* # cycles spent in ISRs                     */
+OS_EXT            OS_CYCLES                 OSIntCyclesTotalPrev;       /* ... in the previous statistic period       */
+OS_EXT            OS_CPU_USAGE              OSIntCPUUsage;              /* CPU Usage of ISRs in %                     */
+#endif
 #ifdef CPU_CFG_INT_DIS_MEAS_EN
 OS_EXT            CPU_TS                    OSIntDisTimeMax;            /* Overall interrupt disable time             */
 #endif
@@ -1278,6 +1405,14 @@ OS_EXT            OS_TICK                   OSStatTaskCtr;
 OS_EXT            OS_TICK                   OSStatTaskCtrMax;
 OS_EXT            OS_TICK                   OSStatTaskCtrRun;
 OS_EXT            CPU_BOOLEAN               OSStatTaskRdy;
+#if OS_STAT_CYCLES_EN > 0u
+OS_EXT            CPU_INT32U                OSStatTaskCPUUsageAvg[OS_STAT_LOAD_AVG_NBR];/* CPU load averages          */
+OS_EXT            CPU_INT32U                OSIntCPUUsageAvg[OS_STAT_LOAD_AVG_NBR];     /* ISR load averages          */
+OS_EXT            OS_CYCLES                 OSStatCyclesWin;            /* # busy cycles in the current 1 s window    */
+OS_EXT            OS_CYCLES                 OSIntCyclesWin;             /* # ISR  cycles in the current 1 s window    */
+OS_EXT            OS_TICK                   OSStatWinCtr;               /* Statistic periods in the current window    */
+OS_EXT            OS_LOAD                  *OSStatLoadListPtr;          /* Load accounts, see OSStatLoadAdd()         */
+#endif
 OS_EXT            OS_TCB                    OSStatTaskTCB;
 OS_EXT            CPU_TS                    OSStatTaskTimeMax;
 #endif
@@ -1299,6 +1434,9 @@ OS_EXT            OS_TCB                    OSTickTaskTCB;
 OS_EXT            CPU_TS                    OSTickTaskTimeMax;
 OS_EXT            OS_TICK_LIST              OSTickListDly;
 OS_EXT            OS_TICK_LIST              OSTickListTimeout;
+#if OS_CFG_TICK_VIRT_EN > 0u
+OS_EXT            OS_TICK                   OSTickVirtCtr;              /* Ticks generated by the idle task           */
+#endif
 
 
 
@@ -1448,6 +1586,11 @@ OS_FLAGS      OSFlagPost                (OS_FLAG_GRP           *p_grp,
                                          OS_OPT                 opt,
                                          OS_ERR                *p_err);
 
+OS_OBJ_QTY    OSFlagPostMulti           (OS_FLAG_POST_DATA     *p_post_data_tbl,
+                                         OS_OBJ_QTY             tbl_size,
+                                         OS_OPT                 opt,
+                                         OS_ERR                *p_err);
+
 /* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
 
 void          OS_FlagClr                (OS_FLAG_GRP           *p_grp);
@@ -1475,6 +1618,11 @@ OS_FLAGS      OS_FlagPost               (OS_FLAG_GRP           *p_grp,
 void          OS_FlagTaskRdy            (OS_TCB                *p_tcb,
                                          OS_FLAGS               flags_rdy,
                                          CPU_TS                 ts);
+
+void          OS_FlagWatchInit          (OS_FLAG_GRP           *p_grp);
+
+void          OS_FlagWatchRemove        (OS_FLAG_GRP           *p_grp,
+                                         OS_TCB                *p_tcb);
 #endif
 
 
@@ -1563,6 +1711,8 @@ void          OS_MutexGrpRemove         (OS_TCB                *p_tcb,
 
 OS_PRIO       OS_MutexGrpPrioFindHighest(OS_TCB                *p_tcb);
 
+void          OS_MutexGrpPrioUpdate     (OS_MUTEX              *p_mutex);
+
 void          OS_MutexGrpPostAll        (OS_TCB                *p_tcb);
 
 
@@ -2005,10 +2155,24 @@ void          OSStart                   (OS_ERR                *p_err);
 void          OSStatReset               (OS_ERR                *p_err);
 
 void          OSStatTaskCPUUsageInit    (OS_ERR                *p_err);
+
+#if OS_STAT_CYCLES_EN > 0u
+void          OSStatLoadAdd             (OS_LOAD               *p_load,
+                                         CPU_CHAR              *p_name,
+                                         OS_ERR                *p_err);
+#endif
 #endif
 
 CPU_INT16U    OSVersion                 (OS_ERR                *p_err);
 
+#if (OS_CFG_OBJ_STAT_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+OS_OBJ_QTY    OSObjStatSnap             (OS_OBJ_STAT_SNAP      *p_tbl,
+                                         OS_OBJ_QTY             size,
+                                         OS_ERR                *p_err);
+
+void          OSObjStatReset            (OS_ERR                *p_err);
+#endif
+
 /* ------------------------------------------------ INTERNAL FUNCTIONS ---------------------------------------------- */
 
 void          OS_IdleTask               (void                  *p_arg);
@@ -2016,6 +2180,12 @@ void          OS_IdleTask               (void                  *p_arg);
 void          OS_IdleTaskInit           (OS_ERR                *p_err);
 
 #if OS_CFG_STAT_TASK_EN > 0u
+#if OS_STAT_CYCLES_EN > 0u
+void          OS_StatLoadAvg            (CPU_INT32U            *p_avg,
+                                         OS_CYCLES              cycles,
+                                         OS_CYCLES              cycles_total);
+#endif
+
 void          OS_StatTask               (void                  *p_arg);
 #endif
 
@@ -2119,6 +2289,13 @@ void          OS_MsgQPut                (OS_MSG_Q              *p_msg_q,
 
 /* ---------------------------------------------- PEND/POST MANAGEMENT ---------------------------------------------- */
 
+#if OS_CFG_OBJ_STAT_EN > 0u
+void          OS_ObjStatClr             (OS_OBJ_STAT           *p_stat);
+
+void          OS_ObjStatWaitEnd         (OS_PEND_OBJ           *p_obj,
+                                         OS_TCB                *p_tcb);
+#endif
+
 void          OS_Pend                   (OS_PEND_DATA          *p_pend_data,
                                          OS_PEND_OBJ           *p_obj,
                                          OS_STATE               pending_on,
@@ -2237,6 +2414,10 @@ void          OS_TickListRemove         (OS_TCB                *p_tcb);
 
 void          OS_TickListResetPeak      (void);
 
+#if OS_CFG_TICK_VIRT_EN > 0u
+CPU_BOOLEAN   OS_TickVirtAdvance        (void);
+#endif
+
 
 /*
 ************************************************************************************************************************
@@ -2281,11 +2462,31 @@ void          OS_TickListResetPeak      (void);
 #endif
 
 
+#ifndef OS_CFG_OBJ_STAT_EN
+#error  "OS_CFG.H, Missing OS_CFG_OBJ_STAT_EN: Enable (1) or Disable (0) per object contention statistics"
+#else
+    #if    (OS_CFG_OBJ_STAT_EN > 0u) && \
+           (OS_CFG_TS_EN       < 1u)
+    #error  "OS_CFG.H,         OS_CFG_TS_EN must be Enabled (1) to time waits on kernel objects"
+    #endif
+#endif
+
+
 #ifndef OS_CFG_PEND_MULTI_EN
 #error  "OS_CFG.H, Missing OS_CFG_PEND_MULTI_EN: Enable (1) or Disable (0) multi-pend feature"
 #endif
 
 
+#ifndef OS_CFG_TICK_VIRT_EN
+#error  "OS_CFG.H, Missing OS_CFG_TICK_VIRT_EN: Enable (1) or Disable (0) virtual time driven by the idle task"
+#else
+    #if    (OS_CFG_TICK_VIRT_EN         > 0u) && \
+           (OS_CFG_ISR_POST_DEFERRED_EN > 0u)
+    #error  "OS_CFG.H,         OS_CFG_TICK_VIRT_EN needs direct ISR posts (OS_CFG_ISR_POST_DEFERRED_EN set to 0)"
+    #endif
+#endif
+
+
 #if     OS_CFG_PRIO_MAX < 8u
 #error  "OS_CFG.H,         OS_CFG_PRIO_MAX must be >= 8"
 #endif
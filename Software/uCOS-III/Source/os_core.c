@@ -71,6 +71,11 @@ void  OSInit (OS_ERR  *p_err)
     OSInitHook();                                           /* Call port specific initialization code                 */
 
     OSIntNestingCtr                 = (OS_NESTING_CTR)0;    /* Clear the interrupt nesting counter                    */
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    OSIntCyclesTotal                = (OS_CYCLES)0;
+    OSIntCyclesTotalPrev            = (OS_CYCLES)0;
+    OSIntCPUUsage                   = (OS_CPU_USAGE)0;
+#endif
 
     OSRunning                       =  OS_STATE_OS_STOPPED; /* Indicate that multitasking not started                 */
 
@@ -262,11 +267,20 @@ void  OSInit (OS_ERR  *p_err)
 *                 at the end of the ISR.
 *
 *              5) You are allowed to nest interrupts up to 250 levels deep.
+*
+*              6) With task profiling, the outermost ISR stops charging the interrupted task here and starts the ISR
+*                 cycle count (see OSIntExit() Note #3).  ISRs MUST then call this function instead of incrementing
+*                 'OSIntNestingCtr' directly (Note #2), or the ISR cycle count is wrong.
 ************************************************************************************************************************
 */
 
 void  OSIntEnter (void)
 {
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    CPU_TS  ts;
+#endif
+
+
     if (OSRunning != OS_STATE_OS_RUNNING) {                 /* Is OS running?                                         */
         return;                                             /* No                                                     */
     }
@@ -275,6 +289,14 @@ void  OSIntEnter (void)
         return;                                             /* Yes                                                    */
     }
 
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    if (OSIntNestingCtr == (OS_NESTING_CTR)0) {             /* Outermost ISR: charge the interrupted task             */
+        ts                         = OS_TS_GET();
+        OSTCBCurPtr->CyclesTotal  += (OS_CYCLES)(ts - OSTCBCurPtr->CyclesStart);
+        OSIntCyclesStart           = ts;
+    }
+#endif
+
     OSIntNestingCtr++;                                      /* Increment ISR nesting level                            */
 }
 
@@ -296,11 +318,18 @@ void  OSIntEnter (void)
 *                 at the end of the ISR.
 *
 *              2) Rescheduling is prevented when the scheduler is locked (see OSSchedLock())
+*
+*              3) With task profiling, the cycles from OSIntEnter() of the outermost ISR to here are charged to ISRs,
+*                 and the task that runs next is charged again from here on.  If that is a new task, the few cycles
+*                 until the context switch completes are charged to the interrupted task (see OSTaskSwHook()).
 ************************************************************************************************************************
 */
 
 void  OSIntExit (void)
 {
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    CPU_TS  ts;
+#endif
     CPU_SR_ALLOC();
 
 
@@ -320,6 +349,12 @@ void  OSIntExit (void)
         return;
     }
 
+#if OS_CFG_TASK_PROFILE_EN > 0u
+    ts                        = OS_TS_GET();                /* Outermost ISR done: charge it, see Note #3             */
+    OSIntCyclesTotal         += (OS_CYCLES)(ts - OSIntCyclesStart);
+    OSTCBCurPtr->CyclesStart  = ts;
+#endif
+
     if (OSSchedLockNestingCtr > (OS_NESTING_CTR)0) {        /* Scheduler still locked?                                */
         CPU_INT_EN();                                       /* Yes                                                    */
         return;
@@ -347,6 +382,170 @@ void  OSIntExit (void)
 }
 
 
+/*
+************************************************************************************************************************
+*                                       SNAPSHOT OF THE OBJECT CONTENTION STATISTICS
+*
+* Description: This function copies the contention statistics of every semaphore, mutex, message queue and event flag
+*              group into a table supplied by the caller.
+*
+* Arguments  : p_tbl     is a pointer to the table to fill.
+*
+*              size      is the number of entries in 'p_tbl'.  Objects beyond that are left out.
+*
+*              p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE          the table was filled
+*                            OS_ERR_PTR_INVALID   if 'p_tbl' is a NULL pointer
+*
+* Returns    : The number of entries filled.
+*
+* Note(s)    : 1) The table is filled in a single critical section so that all the entries describe the same instant.
+*                 Interrupts stay disabled for the copy of up to 'size' entries, so keep 'size' to what is needed.
+*
+*              2) Objects are listed semaphores first, then mutexes, message queues and event flag groups, each in the
+*                 order of their debug list (most recently created first).
+*
+*              3) The objects are found through their debug lists, hence OS_CFG_DBG_EN.
+************************************************************************************************************************
+*/
+
+#if (OS_CFG_OBJ_STAT_EN > 0u) && (OS_CFG_DBG_EN > 0u)
+OS_OBJ_QTY  OSObjStatSnap (OS_OBJ_STAT_SNAP  *p_tbl,
+                           OS_OBJ_QTY         size,
+                           OS_ERR            *p_err)
+{
+    OS_PEND_OBJ  *p_list[4];
+    OS_PEND_OBJ  *p_obj;
+    OS_OBJ_QTY    nbr;
+    CPU_INT08U    i;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return ((OS_OBJ_QTY)0);
+    }
+#endif
+
+#if OS_CFG_ARG_CHK_EN > 0u
+    if (p_tbl == (OS_OBJ_STAT_SNAP *)0) {                   /* Validate 'p_tbl'                                       */
+       *p_err = OS_ERR_PTR_INVALID;
+        return ((OS_OBJ_QTY)0);
+    }
+#endif
+
+    nbr = (OS_OBJ_QTY)0;
+    CPU_CRITICAL_ENTER();
+#if OS_CFG_SEM_EN > 0u
+    p_list[0] = (OS_PEND_OBJ *)((void *)OSSemDbgListPtr);
+#else
+    p_list[0] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_MUTEX_EN > 0u
+    p_list[1] = (OS_PEND_OBJ *)((void *)OSMutexDbgListPtr);
+#else
+    p_list[1] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_Q_EN > 0u
+    p_list[2] = (OS_PEND_OBJ *)((void *)OSQDbgListPtr);
+#else
+    p_list[2] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_FLAG_EN > 0u
+    p_list[3] = (OS_PEND_OBJ *)((void *)OSFlagDbgListPtr);
+#else
+    p_list[3] = (OS_PEND_OBJ *)0;
+#endif
+    for (i = 0u; i < 4u; i++) {
+        p_obj = p_list[i];
+        while ((p_obj != (OS_PEND_OBJ *)0) &&               /* The generic members are laid out alike in all objects  */
+               (nbr   <  size)) {
+            p_tbl->ObjPtr  = (void *)p_obj;
+            p_tbl->Type    = p_obj->Type;
+            p_tbl->NamePtr = p_obj->NamePtr;
+            p_tbl->Waiters = p_obj->PendList.NbrEntries;
+            p_tbl->Stat    = p_obj->Stat;
+            p_tbl++;
+            nbr++;
+            p_obj          = (OS_PEND_OBJ *)p_obj->DbgNextPtr;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+    return (nbr);
+}
+
+
+/*
+************************************************************************************************************************
+*                                       RESET THE OBJECT CONTENTION STATISTICS
+*
+* Description: This function clears the contention statistics of every semaphore, mutex, message queue and event flag
+*              group.
+*
+* Arguments  : p_err     is a pointer to a variable that will contain an error code returned by this function.
+*
+*                            OS_ERR_NONE
+*
+* Returns    : none
+*
+* Note(s)    : 1) Tasks that are pending keep their start time, so their wait is still counted when they are posted.
+************************************************************************************************************************
+*/
+
+void  OSObjStatReset (OS_ERR  *p_err)
+{
+    OS_PEND_OBJ  *p_list[4];
+    OS_PEND_OBJ  *p_obj;
+    CPU_INT08U    i;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();
+#if OS_CFG_SEM_EN > 0u
+    p_list[0] = (OS_PEND_OBJ *)((void *)OSSemDbgListPtr);
+#else
+    p_list[0] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_MUTEX_EN > 0u
+    p_list[1] = (OS_PEND_OBJ *)((void *)OSMutexDbgListPtr);
+#else
+    p_list[1] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_Q_EN > 0u
+    p_list[2] = (OS_PEND_OBJ *)((void *)OSQDbgListPtr);
+#else
+    p_list[2] = (OS_PEND_OBJ *)0;
+#endif
+#if OS_CFG_FLAG_EN > 0u
+    p_list[3] = (OS_PEND_OBJ *)((void *)OSFlagDbgListPtr);
+#else
+    p_list[3] = (OS_PEND_OBJ *)0;
+#endif
+    for (i = 0u; i < 4u; i++) {
+        p_obj = p_list[i];
+        while (p_obj != (OS_PEND_OBJ *)0) {
+            OS_ObjStatClr(&p_obj->Stat);
+            p_obj = (OS_PEND_OBJ *)p_obj->DbgNextPtr;
+        }
+    }
+    CPU_CRITICAL_EXIT();
+   *p_err = OS_ERR_NONE;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                    INDICATE THAT IT'S NO LONGER SAFE TO CREATE OBJECTS
@@ -445,6 +644,9 @@ void  OSSched (void)
 *
 * Note(s)    : 1) You MUST invoke OSSchedLock() and OSSchedUnlock() in pair.  In other words, for every
 *                 call to OSSchedLock() you MUST have a call to OSSchedUnlock().
+*
+*              2) With CPU_CFG_CS_PROF_EN, the time the scheduler stays locked is charged to the return address
+*                 of the outermost OSSchedLock() (see 'cpu_core.c  CPU CRITICAL SECTION PROFILER').
 ************************************************************************************************************************
 */
 
@@ -482,6 +684,11 @@ void  OSSchedLock (OS_ERR  *p_err)
     OSSchedLockNestingCtr++;                                /* Increment lock nesting level                           */
 #if OS_CFG_SCHED_LOCK_TIME_MEAS_EN > 0u
     OS_SchedLockTimeMeasStart();
+#endif
+#ifdef CPU_CFG_CS_PROF_EN
+    if (OSSchedLockNestingCtr == 1u) {                      /* Charge the lock to our caller (see Note #2)            */
+        CPU_CS_ProfLockStart(CPU_CS_PROF_CALLER());
+    }
 #endif
     CPU_CRITICAL_EXIT();
    *p_err = OS_ERR_NONE;
@@ -550,6 +757,9 @@ void  OSSchedUnlock (OS_ERR  *p_err)
 #if OS_CFG_SCHED_LOCK_TIME_MEAS_EN > 0u
     OS_SchedLockTimeMeasStop();
 #endif
+#ifdef CPU_CFG_CS_PROF_EN
+    CPU_CS_ProfLockStop();
+#endif
 
     CPU_CRITICAL_EXIT();                                    /* Scheduler should be re-enabled                         */
     OSSched();                                              /* Run the scheduler                                      */
@@ -782,6 +992,10 @@ CPU_INT16U  OSVersion (OS_ERR  *p_err)
 *                 uC/OS-III would thus never recognize interrupts.
 *
 *              3) This hook has been added to allow you to do such things as STOP the CPU to conserve power.
+*
+*              4) With OS_CFG_TICK_VIRT_EN the idle task is the tick source (see OS_TickVirtAdvance()).  The hook is
+*                 only called when no delay, timeout or timer is pending, so stopping the CPU there still waits for an
+*                 interrupt that can ready a task.
 ************************************************************************************************************************
 */
 
@@ -801,6 +1015,11 @@ void  OS_IdleTask (void  *p_arg)
 #endif
         CPU_CRITICAL_EXIT();
 
+#if OS_CFG_TICK_VIRT_EN > 0u
+        if (OS_TickVirtAdvance() == DEF_YES) {              /* Every task is blocked, jump to the next expiry         */
+            continue;
+        }
+#endif
         OSIdleTaskHook();                                   /* Call user definable HOOK                               */
     }
 }
@@ -847,6 +1066,75 @@ void  OS_IdleTaskInit (OS_ERR  *p_err)
 }
 
 
+/*
+************************************************************************************************************************
+*                                        CLEAR THE CONTENTION STATISTICS OF AN OBJECT
+*
+* Description: This function is called by the OSxxxCreate() services and OSObjStatReset() to zero an object's
+*              contention statistics.
+*
+* Arguments  : p_stat    is a pointer to the statistics to clear.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+************************************************************************************************************************
+*/
+
+#if OS_CFG_OBJ_STAT_EN > 0u
+void  OS_ObjStatClr (OS_OBJ_STAT  *p_stat)
+{
+    p_stat->PostCtr    = (OS_CTR    )0;
+    p_stat->PendCtr    = (OS_CTR    )0;
+    p_stat->PendNowCtr = (OS_CTR    )0;
+    p_stat->PendBlkCtr = (OS_CTR    )0;
+    p_stat->WaitCtr    = (OS_CTR    )0;
+    p_stat->WaitersMax = (OS_OBJ_QTY)0;
+    p_stat->WaitMax    = (CPU_TS    )0;
+    p_stat->WaitTot    = (CPU_TS64  )0;
+}
+
+
+/*
+************************************************************************************************************************
+*                                          CHARGE A COMPLETED WAIT TO AN OBJECT
+*
+* Description: This function is called when a post readies a task that blocked on 'p_obj'.  The time since the task
+*              blocked in OS_Pend() is added to the object's wait statistics.
+*
+* Arguments  : p_obj     is a pointer to the object posted to.  Nothing is done if it's a NULL pointer (task semaphore
+*              -----     or task queue).
+*
+*              p_tcb     is a pointer to the TCB of the task being readied.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The end of the wait is read here rather than taken from the post's timestamp: a post can take its
+*                 timestamp before a higher priority task preempts it and blocks on the same object.
+************************************************************************************************************************
+*/
+
+void  OS_ObjStatWaitEnd (OS_PEND_OBJ  *p_obj,
+                         OS_TCB       *p_tcb)
+{
+    CPU_TS  wait;
+
+
+
+    if (p_obj != (OS_PEND_OBJ *)0) {
+        wait = OS_TS_GET() - p_tcb->PendTS;                 /* See Note #2                                            */
+        p_obj->Stat.WaitCtr++;
+        p_obj->Stat.WaitTot += (CPU_TS64)wait;
+        if (p_obj->Stat.WaitMax < wait) {
+            p_obj->Stat.WaitMax = wait;
+        }
+    }
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                             BLOCK A TASK PENDING ON EVENT
@@ -900,6 +1188,18 @@ void  OS_Pend (OS_PEND_DATA  *p_pend_data,
                         (OS_OBJ_QTY    )1);
         OS_PendListInsertPrio(p_pend_list,                   /* Insert in the pend list in priority order             */
                               p_pend_data);
+#if OS_CFG_OBJ_STAT_EN > 0u
+        OSTCBCurPtr->PendTS = OS_TS_GET();                   /* Start timing the wait                                 */
+        p_obj->Stat.PendBlkCtr++;
+        if (p_obj->Stat.WaitersMax < p_pend_list->NbrEntries) {
+            p_obj->Stat.WaitersMax = p_pend_list->NbrEntries;
+        }
+#endif
+#if OS_CFG_MUTEX_EN > 0u
+        if (pending_on == OS_TASK_PEND_ON_MUTEX) {           /* Update the priority summary of the mutex owner        */
+            OS_MutexGrpPrioUpdate((OS_MUTEX *)((void *)p_obj));
+        }
+#endif
     } else {
         OSTCBCurPtr->PendDataTblEntries = (OS_OBJ_QTY    )0; /* If no object being pended on the clear these fields   */
         OSTCBCurPtr->PendDataTblPtr     = (OS_PEND_DATA *)0; /* ... in the TCB                                        */
@@ -1303,6 +1603,11 @@ void  OS_PendListChangePrio (OS_TCB   *p_tcb)
             OS_PendListInsertPrio(p_pend_list,                      /* INSERT it back in the list                     */
                                   p_pend_data);
         }
+#if OS_CFG_MUTEX_EN > 0u
+        if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {               /* Head of a mutex pend list may have changed     */
+            OS_MutexGrpPrioUpdate((OS_MUTEX *)((void *)p_obj));
+        }
+#endif
         p_pend_data++;                                              /* Point to next wait list                        */
         n_pend_list--;
     }
@@ -1586,6 +1891,16 @@ void  OS_PendListRemove (OS_TCB  *p_tcb)
         p_pend_list = &p_obj->PendList;
         OS_PendListRemove1(p_pend_list,
                            p_pend_data);
+#if OS_CFG_MUTEX_EN > 0u
+        if (p_tcb->PendOn == OS_TASK_PEND_ON_MUTEX) {               /* Head of a mutex pend list may have changed     */
+            OS_MutexGrpPrioUpdate((OS_MUTEX *)((void *)p_obj));
+        }
+#endif
+#if OS_CFG_FLAG_EN > 0u
+        if (p_tcb->PendOn == OS_TASK_PEND_ON_FLAG) {                /* Remove from the event flag group's index       */
+            OS_FlagWatchRemove((OS_FLAG_GRP *)((void *)p_obj), p_tcb);
+        }
+#endif
         p_pend_data++;
         n_pend_list--;
     }
@@ -1876,6 +2191,10 @@ void  OS_Post (OS_PEND_OBJ  *p_obj,
                           msg_size,
                           ts);
              } else {
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 OS_ObjStatWaitEnd(p_obj,                        /* Charge the wait to the object                     */
+                                   p_tcb);
+#endif
 #if (OS_MSG_EN > 0u)
                  p_tcb->MsgPtr  = p_void;                        /* Deposit message in OS_TCB of task waiting         */
                  p_tcb->MsgSize = msg_size;                      /* ... assuming posting a message                    */
@@ -1907,6 +2226,10 @@ void  OS_Post (OS_PEND_OBJ  *p_obj,
                           msg_size,
                           ts);
              } else {
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 OS_ObjStatWaitEnd(p_obj,                        /* Charge the wait to the object                     */
+                                   p_tcb);
+#endif
 #if (OS_MSG_EN > 0u)
                  p_tcb->MsgPtr  = p_void;                        /* Deposit message in OS_TCB of task waiting         */
                  p_tcb->MsgSize = msg_size;                      /* ... assuming posting a message                    */
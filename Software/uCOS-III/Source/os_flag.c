@@ -42,6 +42,33 @@ const  CPU_CHAR  *os_flag__c = "$Id: $";
 
 #if OS_CFG_FLAG_EN > 0u
 
+/*
+************************************************************************************************************************
+*                                               LOCAL FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  OS_FlagTaskChk      (OS_FLAG_GRP  *p_grp,
+                                          OS_TCB       *p_tcb,
+                                          CPU_BOOLEAN  *p_rdy);
+
+static  OS_TCB      *OS_FlagRdyMerge     (OS_TCB       *p_list,
+                                          OS_TCB       *p_run);
+
+static  CPU_INT08U   OS_FlagWatchBitGet  (OS_FLAG_GRP  *p_grp,
+                                          OS_TCB       *p_tcb);
+
+static  void         OS_FlagWatchInsert  (OS_FLAG_GRP  *p_grp,
+                                          OS_TCB       *p_tcb);
+
+/*
+************************************************************************************************************************
+*                                                    LOCAL MACROS
+************************************************************************************************************************
+*/
+
+#define  OS_FLAG_SEQ_BEFORE(a, b)     ((CPU_INT32S)((OS_CTR)(a) - (OS_CTR)(b)) < 0)  /* Pend stamp 'a' older than 'b'  */
+
 /*
 ************************************************************************************************************************
 *                                                 CREATE AN EVENT FLAG
@@ -117,6 +144,10 @@ void  OSFlagCreate (OS_FLAG_GRP  *p_grp,
     p_grp->Flags   = flags;                                 /* Set to desired initial value                           */
     p_grp->TS      = (CPU_TS)0;
     OS_PendListInit(&p_grp->PendList);
+    OS_FlagWatchInit(p_grp);
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_ObjStatClr(&p_grp->Stat);
+#endif
 
 #if OS_CFG_DBG_EN > 0u
     OS_FlagDbgListAdd(p_grp);
@@ -424,14 +455,21 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
 
     mode = opt & OS_OPT_PEND_FLAG_MASK;
     CPU_CRITICAL_ENTER();
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_grp->Stat.PendCtr++;
+#endif
     switch (mode) {
         case OS_OPT_PEND_FLAG_SET_ALL:                      /* See if all required flags are set                      */
              flags_rdy = (OS_FLAGS)(p_grp->Flags & flags);  /* Extract only the bits we want                          */
              if (flags_rdy == flags) {                      /* Must match ALL the bits that we want                   */
                  if (consume == DEF_TRUE) {                 /* See if we need to consume the flags                    */
                      p_grp->Flags &= ~flags_rdy;            /* Clear ONLY the flags that we wanted                    */
+                     p_grp->FlagsChk |= flags_rdy;          /* Other waiters must be checked at the next post         */
                  }
                  OSTCBCurPtr->FlagsRdy = flags_rdy;         /* Save flags that were ready                             */
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 p_grp->Stat.PendNowCtr++;
+#endif
                  if (p_ts != (CPU_TS *)0) {
                     *p_ts  = p_grp->TS;
                  }
@@ -475,8 +513,12 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
              if (flags_rdy != (OS_FLAGS)0) {                /* See if any flag set                                    */
                  if (consume == DEF_TRUE) {                 /* See if we need to consume the flags                    */
                      p_grp->Flags &= ~flags_rdy;            /* Clear ONLY the flags that we got                       */
+                     p_grp->FlagsChk |= flags_rdy;          /* Other waiters must be checked at the next post         */
                  }
                  OSTCBCurPtr->FlagsRdy = flags_rdy;         /* Save flags that were ready                             */
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 p_grp->Stat.PendNowCtr++;
+#endif
                  if (p_ts != (CPU_TS *)0) {
                     *p_ts  = p_grp->TS;
                  }
@@ -515,8 +557,12 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
              if (flags_rdy == flags) {                      /* Must match ALL the bits that we want                   */
                  if (consume == DEF_TRUE) {                 /* See if we need to consume the flags                    */
                      p_grp->Flags |= flags_rdy;             /* Set ONLY the flags that we wanted                      */
+                     p_grp->FlagsChk |= flags_rdy;          /* Other waiters must be checked at the next post         */
                  }
                  OSTCBCurPtr->FlagsRdy = flags_rdy;         /* Save flags that were ready                             */
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 p_grp->Stat.PendNowCtr++;
+#endif
                  if (p_ts != (CPU_TS *)0) {
                     *p_ts  = p_grp->TS;
                  }
@@ -554,8 +600,12 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
              if (flags_rdy != (OS_FLAGS)0) {                /* See if any flag cleared                                */
                  if (consume == DEF_TRUE) {                 /* See if we need to consume the flags                    */
                      p_grp->Flags |= flags_rdy;             /* Set ONLY the flags that we got                         */
+                     p_grp->FlagsChk |= flags_rdy;          /* Other waiters must be checked at the next post         */
                  }
                  OSTCBCurPtr->FlagsRdy = flags_rdy;         /* Save flags that were ready                             */
+#if OS_CFG_OBJ_STAT_EN > 0u
+                 p_grp->Stat.PendNowCtr++;
+#endif
                  if (p_ts != (CPU_TS *)0) {
                     *p_ts  = p_grp->TS;
                  }
@@ -665,12 +715,14 @@ OS_FLAGS  OSFlagPend (OS_FLAG_GRP  *p_grp,
             case OS_OPT_PEND_FLAG_SET_ALL:
             case OS_OPT_PEND_FLAG_SET_ANY:                  /* Clear ONLY the flags we got                            */
                  p_grp->Flags &= ~flags_rdy;
+                 p_grp->FlagsChk |= flags_rdy;
                  break;
 
 #if OS_CFG_FLAG_MODE_CLR_EN > 0u
             case OS_OPT_PEND_FLAG_CLR_ALL:
             case OS_OPT_PEND_FLAG_CLR_ANY:                  /* Set   ONLY the flags we got                            */
                  p_grp->Flags |=  flags_rdy;
+                 p_grp->FlagsChk |= flags_rdy;
                  break;
 #endif
             default:
@@ -885,7 +937,7 @@ OS_FLAGS  OSFlagPendGetFlagsRdy (OS_ERR  *p_err)
 *
 * Returns    : the new value of the event flags bits that are still set.
 *
-* Note(s)    : 1) The execution time of this function depends on the number of tasks waiting on the event flag group.
+* Note(s)    : 1) The execution time of this function depends on the number of tasks waiting on the flags that changed.
 ************************************************************************************************************************
 */
 
@@ -975,6 +1027,126 @@ OS_FLAGS  OSFlagPost (OS_FLAG_GRP  *p_grp,
 }
 
 
+/*
+************************************************************************************************************************
+*                                         POST EVENT FLAG BITS TO SEVERAL GROUPS
+*
+* Description: This function is called to set or clear bits in several event flag groups and run the scheduler only once,
+*              after all the groups have been updated.
+*
+* Arguments  : p_post_data_tbl   is a pointer to a table of OS_FLAG_POST_DATA entries.  For each entry, '.GrpPtr' is the
+*                                event flag group, '.Flags' the bits to set or clear and '.Opt' either
+*                                OS_OPT_POST_FLAG_SET or OS_OPT_POST_FLAG_CLR.
+*
+*              tbl_size          is the number of entries in the table.  A table of 0 entries posts nothing.
+*
+*              opt               is an option you can specify:
+*
+*                                    OS_OPT_POST_NONE          Run the scheduler after the last group is posted
+*                                    OS_OPT_POST_NO_SCHED      Do not run the scheduler
+*
+*              p_err             is a pointer to an error code and can be:
+*
+*                                    OS_ERR_NONE                The call was successful
+*                                    OS_ERR_OBJ_PTR_NULL        'p_post_data_tbl' or one of the groups is a NULL pointer
+*                                    OS_ERR_OBJ_TYPE            One of the entries is not pointing to an event flag group
+*                                    OS_ERR_OPT_INVALID         You specified an invalid option
+*                                    OS_ERR_LOCK_NESTING_OVF    The scheduler could not be locked, nothing was posted
+*
+* Returns    : the number of groups posted to.  Posting stops at the first entry that fails.
+*
+* Note(s)    : 1) The scheduler is locked while the groups are posted so that a task readied by an early entry cannot run
+*                 before the later groups are updated, even if an interrupt occurs in the meantime.  It is not locked:
+*
+*                 (a) From an ISR, where no task runs before the ISR returns.
+*
+*                 (b) Before OSStart(), where no task runs at all.  OSSchedLock() fails with OS_ERR_OS_NOT_RUNNING and
+*                     the groups are posted without it.
+*
+*                 (c) With OS_OPT_POST_NO_SCHED.  The caller then runs the scheduler itself and, if a readied task must
+*                     not run before the last group is posted, locks the scheduler around the call.
+*
+*                 If the lock fails for any other reason (OS_ERR_LOCK_NESTING_OVF), nothing is posted.
+************************************************************************************************************************
+*/
+
+OS_OBJ_QTY  OSFlagPostMulti (OS_FLAG_POST_DATA  *p_post_data_tbl,
+                             OS_OBJ_QTY          tbl_size,
+                             OS_OPT              opt,
+                             OS_ERR             *p_err)
+{
+    OS_OBJ_QTY   nbr_posted;
+    CPU_BOOLEAN  sched_lock;
+    OS_ERR       err;
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return ((OS_OBJ_QTY)0);
+    }
+#endif
+
+#if OS_CFG_ARG_CHK_EN > 0u
+    if (p_post_data_tbl == (OS_FLAG_POST_DATA *)0) {        /* Validate 'p_post_data_tbl'                             */
+       *p_err = OS_ERR_OBJ_PTR_NULL;
+        return ((OS_OBJ_QTY)0);
+    }
+    switch (opt) {                                          /* Validate 'opt'                                         */
+        case OS_OPT_POST_NONE:
+        case OS_OPT_POST_NO_SCHED:
+             break;
+
+        default:
+            *p_err = OS_ERR_OPT_INVALID;
+             return ((OS_OBJ_QTY)0);
+    }
+#endif
+
+   *p_err = OS_ERR_NONE;
+    if (tbl_size == (OS_OBJ_QTY)0) {                        /* Nothing to post                                        */
+        return ((OS_OBJ_QTY)0);
+    }
+
+    sched_lock = DEF_NO;
+    if ((OSIntNestingCtr                  == (OS_NESTING_CTR)0) &&  /* From an ISR the scheduler only runs on exit    */
+        ((opt & OS_OPT_POST_NO_SCHED)     == (OS_OPT)0)) {
+        OSSchedLock(&err);
+        switch (err) {
+            case OS_ERR_NONE:
+                 sched_lock = DEF_YES;
+                 break;
+
+            case OS_ERR_OS_NOT_RUNNING:                     /* No task can run yet, see Note #1b                      */
+                 break;
+
+            default:
+                *p_err = err;
+                 return ((OS_OBJ_QTY)0);
+        }
+    }
+
+    nbr_posted = (OS_OBJ_QTY)0;
+    while (nbr_posted < tbl_size) {
+        (void)OSFlagPost(p_post_data_tbl->GrpPtr,
+                         p_post_data_tbl->Flags,
+                         p_post_data_tbl->Opt | OS_OPT_POST_NO_SCHED,
+                         p_err);
+        if (*p_err != OS_ERR_NONE) {
+            break;
+        }
+        p_post_data_tbl++;
+        nbr_posted++;
+    }
+
+    if (sched_lock == DEF_YES) {
+        OSSchedUnlock(&err);                                /* Runs the scheduler                                     */
+    }
+    return (nbr_posted);
+}
+
+
 /*
 ************************************************************************************************************************
 *                         SUSPEND TASK UNTIL EVENT FLAG(s) RECEIVED OR TIMEOUT OCCURS
@@ -1025,6 +1197,10 @@ void  OS_FlagBlock (OS_PEND_DATA  *p_pend_data,
             (OS_PEND_OBJ *)((void *)p_grp),
              OS_TASK_PEND_ON_FLAG,
              timeout);
+
+    OSTCBCurPtr->FlagPendSeq = p_grp->PendSeq;              /* Stamp the pend order (see OS_FlagPost() Note #2)       */
+    p_grp->PendSeq++;
+    OS_FlagWatchInsert(p_grp, OSTCBCurPtr);                 /* Index the task by the flag that can make it ready      */
 }
 
 
@@ -1058,6 +1234,7 @@ void  OS_FlagClr (OS_FLAG_GRP  *p_grp)
     p_grp->Flags            = (OS_FLAGS )0;
     p_pend_list             = &p_grp->PendList;
     OS_PendListInit(p_pend_list);
+    OS_FlagWatchInit(p_grp);
 }
 
 
@@ -1196,7 +1373,15 @@ void  OS_FlagDbgListRemove (OS_FLAG_GRP  *p_grp)
 *
 * Returns    : the new value of the event flags bits that are still set.
 *
-* Note(s)    : 1) The execution time of this function depends on the number of tasks waiting on the event flag group.
+* Note(s)    : 1) Only the tasks watching a flag that changed (see OS_FlagWatchInsert()) are checked, so the execution
+*                 time depends on the number of tasks that can be made ready, not on the number of tasks waiting.
+*
+*              2) The tasks made ready are readied in the order they pended, as when the whole pend list is walked, so
+*                 OS_RdyListInsert() orders tasks of equal priority the same way whichever flag woke them.  Each watch
+*                 list is kept sorted by the pend order stamp given in OS_FlagBlock(); the tasks found ready in one list
+*                 form a sorted run that is merged into the tasks found so far, and they are all readied once every list
+*                 has been visited.  A post that readies 'k' tasks from 'n' watch lists thus costs O(k * n) in the worst case
+*                 and O(k) when a single flag changes.
 ************************************************************************************************************************
 */
 
@@ -1207,17 +1392,23 @@ OS_FLAGS  OS_FlagPost (OS_FLAG_GRP  *p_grp,
                        OS_ERR       *p_err)
 {
     OS_FLAGS        flags_cur;
-    OS_FLAGS        flags_rdy;
-    OS_OPT          mode;
-    OS_PEND_DATA   *p_pend_data;
-    OS_PEND_DATA   *p_pend_data_next;
+    OS_FLAGS        flags_chg;
+    OS_FLAGS        flags_scan;
+    CPU_DATA        bit_nbr;
     OS_PEND_LIST   *p_pend_list;
     OS_TCB         *p_tcb;
+    OS_TCB         *p_tcb_next;
+    OS_TCB         *p_rdy_list;
+    OS_TCB         *p_run;
+    OS_TCB        **pp_run_tail;
+    CPU_BOOLEAN     rdy;
+    OS_ERR          err;
     CPU_SR_ALLOC();
 
 
 
     CPU_CRITICAL_ENTER();
+    flags_cur = p_grp->Flags;
     switch (opt) {
         case OS_OPT_POST_FLAG_SET:
         case OS_OPT_POST_FLAG_SET | OS_OPT_POST_NO_SCHED:
@@ -1234,69 +1425,75 @@ OS_FLAGS  OS_FlagPost (OS_FLAG_GRP  *p_grp,
             *p_err = OS_ERR_OPT_INVALID;
              return ((OS_FLAGS)0);
     }
-    p_grp->TS   = ts;
-    p_pend_list = &p_grp->PendList;
-    if (p_pend_list->NbrEntries == 0u) {                        /* Any task waiting on event flag group?              */
+    flags_chg       = (flags_cur ^ p_grp->Flags)            /* Only flags that changed can make a waiter ready        */
+                    |  p_grp->FlagsChk;
+    p_grp->FlagsChk = (OS_FLAGS)0;
+    p_grp->TS       = ts;
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_grp->Stat.PostCtr++;
+#endif
+    p_pend_list     = &p_grp->PendList;
+    if ((p_pend_list->NbrEntries == 0u) ||                      /* Any task waiting on event flag group?              */
+        (flags_chg               == (OS_FLAGS)0)) {             /* ... and anything that could ready it?              */
         CPU_CRITICAL_EXIT();                                    /* No                                                 */
        *p_err = OS_ERR_NONE;
         return (p_grp->Flags);
     }
 
     OS_CRITICAL_ENTER_CPU_EXIT();
-    p_pend_data = p_pend_list->HeadPtr;
-    p_tcb       = p_pend_data->TCBPtr;
-    while (p_tcb != (OS_TCB *)0) {                              /* Go through all tasks waiting on event flag(s)      */
-        p_pend_data_next = p_pend_data->NextPtr;
-        mode             = p_tcb->FlagsOpt & OS_OPT_PEND_FLAG_MASK;
-        switch (mode) {
-            case OS_OPT_PEND_FLAG_SET_ALL:                      /* See if all req. flags are set for current node     */
-                 flags_rdy = (OS_FLAGS)(p_grp->Flags & p_tcb->FlagsPend);
-                 if (flags_rdy == p_tcb->FlagsPend) {
-                     OS_FlagTaskRdy(p_tcb,                      /* Make task RTR, event(s) Rx'd                       */
-                                    flags_rdy,
-                                    ts);
-                 }
-                 break;
-
-            case OS_OPT_PEND_FLAG_SET_ANY:                      /* See if any flag set                                */
-                 flags_rdy = (OS_FLAGS)(p_grp->Flags & p_tcb->FlagsPend);
-                 if (flags_rdy != (OS_FLAGS)0) {
-                     OS_FlagTaskRdy(p_tcb,                      /* Make task RTR, event(s) Rx'd                       */
-                                    flags_rdy,
-                                    ts);
-                 }
-                 break;
-
-#if OS_CFG_FLAG_MODE_CLR_EN > 0u
-            case OS_OPT_PEND_FLAG_CLR_ALL:                      /* See if all req. flags are set for current node     */
-                 flags_rdy = (OS_FLAGS)(~p_grp->Flags & p_tcb->FlagsPend);
-                 if (flags_rdy == p_tcb->FlagsPend) {
-                     OS_FlagTaskRdy(p_tcb,                      /* Make task RTR, event(s) Rx'd                       */
-                                    flags_rdy,
-                                    ts);
-                 }
-                 break;
-
-            case OS_OPT_PEND_FLAG_CLR_ANY:                      /* See if any flag set                                */
-                 flags_rdy = (OS_FLAGS)(~p_grp->Flags & p_tcb->FlagsPend);
-                 if (flags_rdy != (OS_FLAGS)0) {
-                     OS_FlagTaskRdy(p_tcb,                      /* Make task RTR, event(s) Rx'd                       */
-                                    flags_rdy,
-                                    ts);
-                 }
-                 break;
-#endif
-            default:
-                 OS_CRITICAL_EXIT();
-                *p_err = OS_ERR_FLAG_PEND_OPT;
-                 return ((OS_FLAGS)0);
+    err        = OS_ERR_NONE;
+    p_rdy_list = (OS_TCB *)0;                                   /* Tasks to ready, in pend order (see Note #2)        */
+    flags_scan = flags_chg;
+    while (flags_scan != (OS_FLAGS)0) {                         /* Go through the tasks watching each changed flag    */
+        bit_nbr     = CPU_CntTrailZeros((CPU_DATA)flags_scan);
+        flags_scan &= (OS_FLAGS)~((OS_FLAGS)1u << bit_nbr);
+        p_run       = (OS_TCB *)0;
+        pp_run_tail = &p_run;
+        p_tcb       = p_grp->WatchTbl[bit_nbr];
+        while ((p_tcb != (OS_TCB *)0) && (err == OS_ERR_NONE)) {
+            p_tcb_next = p_tcb->FlagWatchNextPtr;
+            if (OS_FlagTaskChk(p_grp, p_tcb, &rdy) != DEF_OK) {
+                err = OS_ERR_FLAG_PEND_OPT;
+            } else if (rdy == DEF_YES) {
+                OS_FlagWatchRemove(p_grp, p_tcb);               /* Move the task to the run of this list              */
+               *pp_run_tail = p_tcb;
+                pp_run_tail = &p_tcb->FlagWatchNextPtr;
+            }
+            p_tcb = p_tcb_next;
         }
-        p_pend_data = p_pend_data_next;                         /* Point to next task waiting for event flag(s)       */
-        if (p_pend_data != (OS_PEND_DATA *)0) {
-            p_tcb = p_pend_data->TCBPtr;
-        } else {
-            p_tcb = (OS_TCB *)0;
+        p_rdy_list = OS_FlagRdyMerge(p_rdy_list, p_run);
+    }
+
+    p_run       = (OS_TCB *)0;
+    pp_run_tail = &p_run;
+    p_tcb       = p_grp->WatchAnyPtr;                           /* Go through the tasks waiting on several flags      */
+    while ((p_tcb != (OS_TCB *)0) && (err == OS_ERR_NONE)) {
+        p_tcb_next = p_tcb->FlagWatchNextPtr;
+        if ((p_tcb->FlagsPend & flags_chg) != (OS_FLAGS)0) {
+            if (OS_FlagTaskChk(p_grp, p_tcb, &rdy) != DEF_OK) {
+                err = OS_ERR_FLAG_PEND_OPT;
+            } else if (rdy == DEF_YES) {
+                OS_FlagWatchRemove(p_grp, p_tcb);
+               *pp_run_tail = p_tcb;
+                pp_run_tail = &p_tcb->FlagWatchNextPtr;
+            }
         }
+        p_tcb = p_tcb_next;
+    }
+    p_rdy_list = OS_FlagRdyMerge(p_rdy_list, p_run);
+
+    while (p_rdy_list != (OS_TCB *)0) {                         /* Ready the tasks in pend order                      */
+        p_tcb                   = p_rdy_list;
+        p_rdy_list              = p_tcb->FlagWatchNextPtr;
+        p_tcb->FlagWatchNextPtr = (OS_TCB *)0;
+        OS_FlagTaskRdy(p_tcb,                                   /* Make task RTR, event(s) Rx'd                       */
+                       p_tcb->FlagsRdy,
+                       ts);
+    }
+    if (err != OS_ERR_NONE) {
+        OS_CRITICAL_EXIT();
+       *p_err = err;
+        return ((OS_FLAGS)0);
     }
     OS_CRITICAL_EXIT_NO_SCHED();
 
@@ -1312,6 +1509,293 @@ OS_FLAGS  OS_FlagPost (OS_FLAG_GRP  *p_grp,
 }
 
 
+/*
+************************************************************************************************************************
+*                                    CHECK IF A TASK WAITING ON AN EVENT FLAG GROUP IS READY
+*
+* Description: This function evaluates the wait condition of a task pending on an event flag group.  If the condition is
+*              met, the flags that satisfy it are saved in the task's FlagsRdy and '*p_rdy' is set; the caller readies the
+*              task.  If the task is still waiting on all of several flags and the flag it was watching is now in the
+*              expected state, the task is moved to the watch list of a flag that is not.
+*
+* Arguments  : p_grp         is a pointer to the event flag group.
+*
+*              p_tcb         is a pointer to the OS_TCB of the task waiting on the group.
+*
+*              p_rdy         is a pointer to where DEF_YES is stored if the task is to be made ready, DEF_NO otherwise.
+*
+* Returns    : DEF_OK        if the wait condition was evaluated
+*              DEF_FAIL      if the task's wait option is invalid
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application should not call it.
+************************************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  OS_FlagTaskChk (OS_FLAG_GRP  *p_grp,
+                                     OS_TCB       *p_tcb,
+                                     CPU_BOOLEAN  *p_rdy)
+{
+    OS_FLAGS     flags_rdy;
+    OS_OPT       mode;
+    CPU_BOOLEAN  all;
+
+
+   *p_rdy = DEF_NO;
+    mode  = p_tcb->FlagsOpt & OS_OPT_PEND_FLAG_MASK;
+    switch (mode) {
+        case OS_OPT_PEND_FLAG_SET_ALL:                          /* See if all req. flags are set for current node     */
+        case OS_OPT_PEND_FLAG_SET_ANY:                          /* See if any flag set                                */
+             flags_rdy = (OS_FLAGS)(p_grp->Flags & p_tcb->FlagsPend);
+             all       = (mode == OS_OPT_PEND_FLAG_SET_ALL) ? DEF_YES : DEF_NO;
+             break;
+
+#if OS_CFG_FLAG_MODE_CLR_EN > 0u
+        case OS_OPT_PEND_FLAG_CLR_ALL:                          /* See if all req. flags are cleared                  */
+        case OS_OPT_PEND_FLAG_CLR_ANY:                          /* See if any flag cleared                            */
+             flags_rdy = (OS_FLAGS)(~p_grp->Flags & p_tcb->FlagsPend);
+             all       = (mode == OS_OPT_PEND_FLAG_CLR_ALL) ? DEF_YES : DEF_NO;
+             break;
+#endif
+
+        default:
+             return (DEF_FAIL);
+    }
+
+    if (all == DEF_NO) {
+        if (flags_rdy != (OS_FLAGS)0) {
+            p_tcb->FlagsRdy = flags_rdy;
+           *p_rdy           = DEF_YES;
+        }
+        return (DEF_OK);
+    }
+
+    if (flags_rdy == p_tcb->FlagsPend) {
+        p_tcb->FlagsRdy = flags_rdy;
+       *p_rdy           = DEF_YES;
+        return (DEF_OK);
+    }
+
+    if ((p_tcb->FlagWatchBit == OS_FLAG_WATCH_ANY) ||           /* Still waiting on ALL, is the watched flag ...      */
+        ((flags_rdy & ((OS_FLAGS)1u << p_tcb->FlagWatchBit)) != (OS_FLAGS)0)) {
+        OS_FlagWatchRemove(p_grp, p_tcb);                       /* ... now in place?  Yes, watch a missing one        */
+        OS_FlagWatchInsert(p_grp, p_tcb);
+    }
+    return (DEF_OK);
+}
+
+
+/*
+************************************************************************************************************************
+*                                     MERGE TASKS TO MAKE READY, IN PEND ORDER
+*
+* Description: This function merges a run of tasks found ready in one watch list into the tasks found ready so far.  Both
+*              are singly linked through FlagWatchNextPtr and sorted by pend order stamp (see OS_FlagPost() Note #2).
+*
+* Arguments  : p_list        is the head of the tasks found ready so far.
+*
+*              p_run         is the head of the run to merge.
+*
+* Returns    : the head of the merged list.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application should not call it.
+************************************************************************************************************************
+*/
+
+static  OS_TCB  *OS_FlagRdyMerge (OS_TCB  *p_list,
+                                  OS_TCB  *p_run)
+{
+    OS_TCB   *p_head;
+    OS_TCB  **pp_tail;
+
+
+    p_head  = (OS_TCB *)0;
+    pp_tail = &p_head;
+    while ((p_list != (OS_TCB *)0) && (p_run != (OS_TCB *)0)) {
+        if (OS_FLAG_SEQ_BEFORE(p_run->FlagPendSeq, p_list->FlagPendSeq)) {
+           *pp_tail = p_run;
+            p_run   = p_run->FlagWatchNextPtr;
+        } else {
+           *pp_tail = p_list;
+            p_list  = p_list->FlagWatchNextPtr;
+        }
+        pp_tail = &(*pp_tail)->FlagWatchNextPtr;
+    }
+   *pp_tail = (p_list != (OS_TCB *)0) ? p_list : p_run;
+    return (p_head);
+}
+
+
+/*
+************************************************************************************************************************
+*                                        EVENT FLAG GROUP WATCH LISTS MANAGEMENT
+*
+* Description: These functions maintain the index of the tasks waiting on an event flag group.  Each waiting task is
+*              linked in exactly one list:
+*
+*                  - WatchTbl[n]  if a change of flag 'n' is the only thing that can make the task ready.  This is
+*                                 the case when waiting on a single flag or, when waiting on ALL of several flags, for
+*                                 one flag that is not yet in the expected state (the task is moved to another such
+*                                 flag when that one changes but the wait condition is still not met).
+*
+*                  - WatchAnyPtr  if waiting on ANY of several flags.
+*
+*              OS_FlagPost() only visits the lists of the flags that changed, and the 'any' list entries whose flags
+*              intersect them, instead of every task in the pend list.  Each list is kept sorted by pend order stamp
+*              (the head's FlagWatchPrevPtr points to the tail) so that OS_FlagPost() can ready tasks in the order they
+*              pended.  A task that just pended has the newest stamp and is appended in constant time; a task waiting
+*              on ALL of several flags that is moved to another flag's list is put back in stamp order, which walks
+*              that list from its tail.
+*
+* Arguments  : p_grp         is a pointer to the event flag group.
+*
+*              p_tcb         is a pointer to the OS_TCB of the waiting task.
+*
+* Returns    : OS_FlagWatchBitGet() returns the flag to watch or OS_FLAG_WATCH_ANY.
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-III and your application should not call them.
+*
+*              2) OS_FlagWatchRemove() is called from OS_PendListRemove() for every task pending on an event flag group,
+*                 which covers posts, timeouts, pend aborts, deletion of the group and deletion of the task.  A task
+*                 already taken off its list by OS_FlagPost() has FlagWatchBit set to OS_FLAG_WATCH_NONE and is skipped.
+************************************************************************************************************************
+*/
+
+void  OS_FlagWatchInit (OS_FLAG_GRP  *p_grp)
+{
+    CPU_DATA  i;
+
+
+    p_grp->FlagsChk    = (OS_FLAGS)0;
+    p_grp->WatchAnyPtr = (OS_TCB *)0;
+    p_grp->PendSeq     = (OS_CTR  )0;
+    for (i = 0u; i < OS_FLAG_NBR_BITS; i++) {
+        p_grp->WatchTbl[i] = (OS_TCB *)0;
+    }
+}
+
+
+static  CPU_INT08U  OS_FlagWatchBitGet (OS_FLAG_GRP  *p_grp,
+                                        OS_TCB       *p_tcb)
+{
+    OS_FLAGS  flags;
+    OS_OPT    mode;
+
+
+    mode = p_tcb->FlagsOpt & OS_OPT_PEND_FLAG_MASK;
+    switch (mode) {
+        case OS_OPT_PEND_FLAG_SET_ALL:                          /* Watch one of the flags not set yet                 */
+             flags = p_tcb->FlagsPend & ~p_grp->Flags;
+             break;
+
+#if OS_CFG_FLAG_MODE_CLR_EN > 0u
+        case OS_OPT_PEND_FLAG_CLR_ALL:                          /* Watch one of the flags not cleared yet             */
+             flags = p_tcb->FlagsPend &  p_grp->Flags;
+             break;
+#endif
+
+        default:                                                /* ANY: only a single flag can be watched             */
+             flags = p_tcb->FlagsPend;
+             if ((flags & (flags - 1u)) != (OS_FLAGS)0) {
+                 flags = (OS_FLAGS)0;
+             }
+             break;
+    }
+
+    if (flags == (OS_FLAGS)0) {
+        return (OS_FLAG_WATCH_ANY);
+    }
+    return ((CPU_INT08U)CPU_CntTrailZeros((CPU_DATA)flags));
+}
+
+
+static  void  OS_FlagWatchInsert (OS_FLAG_GRP  *p_grp,
+                                  OS_TCB       *p_tcb)
+{
+    OS_TCB   **pp_head;
+    OS_TCB    *p_tail;
+    OS_TCB    *p_prev;
+    CPU_INT08U bit;
+
+
+    bit                 = OS_FlagWatchBitGet(p_grp, p_tcb);
+    p_tcb->FlagWatchBit = bit;
+    if (bit == OS_FLAG_WATCH_ANY) {
+        pp_head = &p_grp->WatchAnyPtr;
+    } else {
+        pp_head = &p_grp->WatchTbl[bit];
+    }
+
+    p_tcb->FlagWatchNextPtr = (OS_TCB *)0;
+    if (*pp_head == (OS_TCB *)0) {                              /* Empty list                                         */
+        p_tcb->FlagWatchPrevPtr = p_tcb;
+       *pp_head                 = p_tcb;
+        return;
+    }
+
+    p_tail = (*pp_head)->FlagWatchPrevPtr;
+    p_prev = p_tail;                                            /* Find the last task that pended before this one     */
+    while ((p_prev != *pp_head) &&
+           (OS_FLAG_SEQ_BEFORE(p_tcb->FlagPendSeq, p_prev->FlagPendSeq))) {
+        p_prev = p_prev->FlagWatchPrevPtr;
+    }
+
+    if ((p_prev == *pp_head) &&                                 /* Older than every task in the list?                 */
+        (OS_FLAG_SEQ_BEFORE(p_tcb->FlagPendSeq, p_prev->FlagPendSeq))) {
+        p_tcb->FlagWatchNextPtr       = *pp_head;               /* Yes, insert at the head                            */
+        p_tcb->FlagWatchPrevPtr       = p_tail;
+        (*pp_head)->FlagWatchPrevPtr  = p_tcb;
+       *pp_head                       = p_tcb;
+    } else if (p_prev == p_tail) {                              /* Append at the tail                                 */
+        p_tail->FlagWatchNextPtr      = p_tcb;
+        p_tcb->FlagWatchPrevPtr       = p_tail;
+        (*pp_head)->FlagWatchPrevPtr  = p_tcb;
+    } else {                                                    /* Insert after 'p_prev'                              */
+        p_tcb->FlagWatchNextPtr                    = p_prev->FlagWatchNextPtr;
+        p_tcb->FlagWatchPrevPtr                    = p_prev;
+        p_prev->FlagWatchNextPtr->FlagWatchPrevPtr = p_tcb;
+        p_prev->FlagWatchNextPtr                   = p_tcb;
+    }
+}
+
+
+void  OS_FlagWatchRemove (OS_FLAG_GRP  *p_grp,
+                          OS_TCB       *p_tcb)
+{
+    OS_TCB   **pp_head;
+    OS_TCB    *p_next;
+    OS_TCB    *p_prev;
+
+
+    if (p_tcb->FlagWatchBit == OS_FLAG_WATCH_NONE) {            /* Already off its list (see Note #2)                 */
+        return;
+    }
+    if (p_tcb->FlagWatchBit == OS_FLAG_WATCH_ANY) {
+        pp_head = &p_grp->WatchAnyPtr;
+    } else {
+        pp_head = &p_grp->WatchTbl[p_tcb->FlagWatchBit];
+    }
+
+    p_next = p_tcb->FlagWatchNextPtr;
+    p_prev = p_tcb->FlagWatchPrevPtr;
+    if (*pp_head == p_tcb) {                                    /* Removing the head?                                 */
+       *pp_head = p_next;
+        if (p_next != (OS_TCB *)0) {
+            p_next->FlagWatchPrevPtr = p_prev;                  /* New head points to the tail                        */
+        }
+    } else {
+        p_prev->FlagWatchNextPtr = p_next;
+        if (p_next != (OS_TCB *)0) {
+            p_next->FlagWatchPrevPtr = p_prev;
+        } else {
+            (*pp_head)->FlagWatchPrevPtr = p_prev;              /* Removed the tail                                   */
+        }
+    }
+    p_tcb->FlagWatchNextPtr = (OS_TCB *)0;
+    p_tcb->FlagWatchPrevPtr = (OS_TCB *)0;
+    p_tcb->FlagWatchBit     = OS_FLAG_WATCH_NONE;
+}
+
+
 /*
 ************************************************************************************************************************
 *                                        MAKE TASK READY-TO-RUN, EVENT(s) OCCURRED
@@ -1336,6 +1820,11 @@ void   OS_FlagTaskRdy (OS_TCB    *p_tcb,
                        OS_FLAGS   flags_rdy,
                        CPU_TS     ts)
 {
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_ObjStatWaitEnd(p_tcb->PendDataTblPtr->PendObjPtr,    /* Charge the wait to the group                           */
+                      p_tcb);
+#endif
+    OS_PendListRemove(p_tcb);                               /* Remove from the pend and watch lists                   */
     p_tcb->FlagsRdy   = flags_rdy;
     p_tcb->PendStatus = OS_STATUS_PEND_OK;                  /* Clear pend status                                      */
     p_tcb->PendOn     = OS_TASK_PEND_ON_NOTHING;            /* Indicate no longer pending                             */
@@ -1364,6 +1853,5 @@ void   OS_FlagTaskRdy (OS_TCB    *p_tcb,
         default:
              break;
     }
-    OS_PendListRemove(p_tcb);
 }
 #endif
@@ -41,6 +41,15 @@ const  CPU_CHAR  *os_mutex__c = "$Id: $";
 
 
 #if OS_CFG_MUTEX_EN > 0u
+/*
+************************************************************************************************************************
+*                                               LOCAL FUNCTION PROTOTYPES
+************************************************************************************************************************
+*/
+
+static  void  OS_MutexGrpPrioInsert (OS_TCB  *p_tcb, OS_PRIO  prio);
+static  void  OS_MutexGrpPrioRemove (OS_TCB  *p_tcb, OS_PRIO  prio);
+
 /*
 ************************************************************************************************************************
 *                                                   CREATE A MUTEX
@@ -112,10 +121,14 @@ void  OSMutexCreate (OS_MUTEX  *p_mutex,
     (void)&p_name;
 #endif
     p_mutex->MutexGrpNextPtr   = (OS_MUTEX     *)0;
+    p_mutex->GrpPrio           = (OS_PRIO       )OS_CFG_PRIO_MAX;   /* No task waiting                                */
     p_mutex->OwnerTCBPtr       = (OS_TCB       *)0;
     p_mutex->OwnerNestingCtr   = (OS_NESTING_CTR)0;         /* Mutex is available                                     */
     p_mutex->TS                = (CPU_TS        )0;
     OS_PendListInit(&p_mutex->PendList);                    /* Initialize the waiting list                            */
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_ObjStatClr(&p_mutex->Stat);
+#endif
 
 #if OS_CFG_DBG_EN > 0u
     OS_MutexDbgListAdd(p_mutex);
@@ -413,9 +426,15 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
     }
 
     CPU_CRITICAL_ENTER();
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_mutex->Stat.PendCtr++;
+#endif
     if (p_mutex->OwnerNestingCtr == (OS_NESTING_CTR)0) {    /* Resource available?                                    */
         p_mutex->OwnerTCBPtr       =  OSTCBCurPtr;          /* Yes, caller may proceed                                */
         p_mutex->OwnerNestingCtr   = (OS_NESTING_CTR)1;
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_mutex->Stat.PendNowCtr++;
+#endif
         if (p_ts != (CPU_TS *)0) {
            *p_ts  = p_mutex->TS;
         }
@@ -430,6 +449,9 @@ void  OSMutexPend (OS_MUTEX  *p_mutex,
 
     if (OSTCBCurPtr == p_mutex->OwnerTCBPtr) {              /* See if current task is already the owner of the mutex  */
         p_mutex->OwnerNestingCtr++;
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_mutex->Stat.PendNowCtr++;
+#endif
         if (p_ts != (CPU_TS *)0) {
            *p_ts  = p_mutex->TS;
         }
@@ -774,6 +796,9 @@ void  OSMutexPost (OS_MUTEX  *p_mutex,
     OS_CRITICAL_ENTER_CPU_EXIT();
     ts          = OS_TS_GET();                              /* Get timestamp                                          */
     p_mutex->TS = ts;
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_mutex->Stat.PostCtr++;
+#endif
     p_mutex->OwnerNestingCtr--;                             /* Decrement owner's nesting counter                      */
     if (p_mutex->OwnerNestingCtr > (OS_NESTING_CTR)0) {     /* Are we done with all nestings?                         */
         OS_CRITICAL_EXIT();                                 /* No                                                     */
@@ -853,6 +878,7 @@ void  OS_MutexClr (OS_MUTEX  *p_mutex)
     p_mutex->NamePtr           = (CPU_CHAR     *)((void *)"?MUTEX");
 #endif
     p_mutex->MutexGrpNextPtr   = (OS_MUTEX     *)0;
+    p_mutex->GrpPrio           = (OS_PRIO       )OS_CFG_PRIO_MAX;   /* No task waiting                                */
     p_mutex->OwnerTCBPtr       = (OS_TCB       *)0;
     p_mutex->OwnerNestingCtr   = (OS_NESTING_CTR)0;
     p_mutex->TS                = (CPU_TS        )0;
@@ -971,6 +997,9 @@ void  OS_MutexInit (OS_ERR  *p_err)
 * Returns    : none
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The priority of the highest task waiting on the mutex (if any) is added to the group priority
+*                 summary of the new owner.
 ************************************************************************************************************************
 */
 
@@ -978,6 +1007,10 @@ void  OS_MutexGrpAdd (OS_TCB  *p_tcb, OS_MUTEX  *p_mutex)
 {
     p_mutex->MutexGrpNextPtr = p_tcb->MutexGrpHeadPtr;      /* The mutex grp is not sorted add to head of list.       */
     p_tcb->MutexGrpHeadPtr   = p_mutex;
+
+    if (p_mutex->GrpPrio < OS_CFG_PRIO_MAX) {               /* Any task waiting on the mutex?                         */
+        OS_MutexGrpPrioInsert(p_tcb, p_mutex->GrpPrio);
+    }
 }
 
 
@@ -1010,6 +1043,10 @@ void  OS_MutexGrpRemove (OS_TCB  *p_tcb, OS_MUTEX  *p_mutex)
     }
 
     *pp_mutex = (*pp_mutex)->MutexGrpNextPtr;
+
+    if (p_mutex->GrpPrio < OS_CFG_PRIO_MAX) {               /* Was the mutex contributing to the summary?             */
+        OS_MutexGrpPrioRemove(p_tcb, p_mutex->GrpPrio);
+    }
 }
 
 
@@ -1026,32 +1063,138 @@ void  OS_MutexGrpRemove (OS_TCB  *p_tcb, OS_MUTEX  *p_mutex)
 * Returns    : Highest priority pending or OS_CFG_PRIO_MAX - 1u if none found.
 *
 * Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The group priority summary is kept up to date by OS_MutexGrpAdd(), OS_MutexGrpRemove() and
+*                 OS_MutexGrpPrioUpdate() so the lookup only scans the OS_PRIO_TBL_SIZE bitmap entries of the task,
+*                 regardless of how many mutexes it owns or how many tasks wait on them.
 ************************************************************************************************************************
 */
 
 OS_PRIO  OS_MutexGrpPrioFindHighest (OS_TCB  *p_tcb)
 {
-    OS_MUTEX     **pp_mutex;
-    OS_PRIO        highest_prio;
-    OS_PRIO        prio;
+    CPU_DATA  *p_tbl;
+    CPU_DATA   ix;
+    OS_PRIO    prio;
+
+
+    prio  = (OS_PRIO)0;
+    p_tbl = &p_tcb->MutexGrpPrioTbl[0];
+    ix    = 0u;
+    while ((ix < OS_PRIO_TBL_SIZE) &&                       /* Search the bitmap table for the highest priority       */
+           (*p_tbl == (CPU_DATA)0)) {
+        prio += DEF_INT_CPU_NBR_BITS;
+        p_tbl++;
+        ix++;
+    }
+    if (ix == OS_PRIO_TBL_SIZE) {                           /* No task waiting on any mutex of the group              */
+        return (OS_CFG_PRIO_MAX - 1u);
+    }
+    prio += (OS_PRIO)CPU_CntLeadZeros(*p_tbl);              /* Find the position of the first bit set at the entry    */
+    return (prio);
+}
+
+
+/*
+************************************************************************************************************************
+*                                           MUTEX GROUP PRIORITY SUMMARY UPDATE
+*
+* Description: This function is called by the kernel after the pend list of a mutex changed (a task started or stopped
+*              waiting on it, or the priority of a waiting task changed) to refresh the contribution of the mutex to
+*              the group priority summary of its owner.
+*
+
+* Argument(s): p_mutex      is a pointer to the mutex whose pend list changed.
+*
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The pend list is sorted by priority so the highest task waiting is always at the head.
+************************************************************************************************************************
+*/
+
+void  OS_MutexGrpPrioUpdate (OS_MUTEX  *p_mutex)
+{
     OS_PEND_DATA  *p_head;
+    OS_TCB        *p_tcb_owner;
+    OS_PRIO        prio;
 
 
-    highest_prio = OS_CFG_PRIO_MAX - 1u;
-    pp_mutex = &p_tcb->MutexGrpHeadPtr;
+    p_head = p_mutex->PendList.HeadPtr;
+    if (p_head != (OS_PEND_DATA *)0) {
+        prio = p_head->TCBPtr->Prio;
+    } else {
+        prio = (OS_PRIO)OS_CFG_PRIO_MAX;                    /* No task waiting                                        */
+    }
+
+    if (prio == p_mutex->GrpPrio) {                         /* Contribution unchanged?                                */
+        return;
+    }
 
-    while(*pp_mutex != (OS_MUTEX *)0) {
-        p_head = (*pp_mutex)->PendList.HeadPtr;
-        if (p_head!= (OS_PEND_DATA *)0) {
-            prio = p_head->TCBPtr->Prio;
-            if(prio < highest_prio) {
-                highest_prio = prio;
-            }
+    p_tcb_owner = p_mutex->OwnerTCBPtr;
+    if (p_tcb_owner != (OS_TCB *)0) {
+        if (p_mutex->GrpPrio < OS_CFG_PRIO_MAX) {
+            OS_MutexGrpPrioRemove(p_tcb_owner, p_mutex->GrpPrio);
+        }
+        if (prio < OS_CFG_PRIO_MAX) {
+            OS_MutexGrpPrioInsert(p_tcb_owner, prio);
         }
-        pp_mutex = &(*pp_mutex)->MutexGrpNextPtr;
     }
+    p_mutex->GrpPrio = prio;
+}
+
 
-    return (highest_prio);
+/*
+************************************************************************************************************************
+*                                     INSERT/REMOVE A PRIORITY IN A GROUP PRIORITY SUMMARY
+*
+* Description: These functions count how many mutexes of a task's group have their highest waiting task at 'prio' and
+*              keep the matching bit of the group bitmap set while that count is not zero.
+*
+* Argument(s): p_tcb        is a pointer to the tcb of the mutex owner.
+*
+*              prio         is the priority to insert/remove.
+*
+* Returns    : none
+*
+* Note(s)    : 1) These functions are INTERNAL to uC/OS-III and your application MUST NOT call them.
+************************************************************************************************************************
+*/
+
+static  void  OS_MutexGrpPrioInsert (OS_TCB  *p_tcb, OS_PRIO  prio)
+{
+    CPU_DATA  bit;
+    CPU_DATA  bit_nbr;
+    OS_PRIO   ix;
+
+
+    if (p_tcb->MutexGrpPrioCtr[prio] == (OS_OBJ_QTY)0) {
+        ix                          = prio / DEF_INT_CPU_NBR_BITS;
+        bit_nbr                     = (CPU_DATA)prio & (DEF_INT_CPU_NBR_BITS - 1u);
+        bit                         = 1u;
+        bit                       <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
+        p_tcb->MutexGrpPrioTbl[ix] |= bit;
+    }
+    p_tcb->MutexGrpPrioCtr[prio]++;
+}
+
+
+static  void  OS_MutexGrpPrioRemove (OS_TCB  *p_tcb, OS_PRIO  prio)
+{
+    CPU_DATA  bit;
+    CPU_DATA  bit_nbr;
+    OS_PRIO   ix;
+
+
+    p_tcb->MutexGrpPrioCtr[prio]--;
+    if (p_tcb->MutexGrpPrioCtr[prio] == (OS_OBJ_QTY)0) {
+        ix                          = prio / DEF_INT_CPU_NBR_BITS;
+        bit_nbr                     = (CPU_DATA)prio & (DEF_INT_CPU_NBR_BITS - 1u);
+        bit                         = 1u;
+        bit                       <<= (DEF_INT_CPU_NBR_BITS - 1u) - bit_nbr;
+        p_tcb->MutexGrpPrioTbl[ix] &= ~bit;
+    }
 }
 
 
@@ -1092,6 +1235,9 @@ void  OS_MutexGrpPostAll (OS_TCB  *p_tcb)
         p_mutex_next = p_mutex->MutexGrpNextPtr;
         ts           = OS_TS_GET();                             /* Get timestamp                                        */
         p_mutex->TS  = ts;
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_mutex->Stat.PostCtr++;
+#endif
         OS_MutexGrpRemove(p_tcb,  p_mutex);                     /* Remove mutex from owner's group                      */
 
         p_pend_list = &p_mutex->PendList;
@@ -1101,7 +1247,7 @@ void  OS_MutexGrpPostAll (OS_TCB  *p_tcb)
         } else {
                                                                 /* Get TCB from head of pend list                       */
             p_tcb_new = p_pend_list->HeadPtr->TCBPtr;
-            p_mutex->OwnerTCBPtr     = p_tcb;                   /* Give mutex to new owner                              */
+            p_mutex->OwnerTCBPtr     = p_tcb_new;               /* Give mutex to new owner                              */
             p_mutex->OwnerNestingCtr = 1u;
             OS_MutexGrpAdd(p_tcb_new, p_mutex);
                                                                 /* Post to mutex                                        */
@@ -124,6 +124,9 @@ void  OSQCreate (OS_Q        *p_q,
     OS_MsgQInit(&p_q->MsgQ,                                 /* Initialize the queue                                   */
                 max_qty);
     OS_PendListInit(&p_q->PendList);                        /* Initialize the waiting list                            */
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_ObjStatClr(&p_q->Stat);
+#endif
 
 #if OS_CFG_DBG_EN > 0u
     OS_QDbgListAdd(p_q);
@@ -473,11 +476,17 @@ void  *OSQPend (OS_Q         *p_q,
     }
 
     CPU_CRITICAL_ENTER();
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_q->Stat.PendCtr++;
+#endif
     p_void = OS_MsgQGet(&p_q->MsgQ,                         /* Any message waiting in the message queue?              */
                         p_msg_size,
                         p_ts,
                         p_err);
     if (*p_err == OS_ERR_NONE) {
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_q->Stat.PendNowCtr++;
+#endif
         CPU_CRITICAL_EXIT();
 #if (defined(TRACE_CFG_EN) && (TRACE_CFG_EN > 0u))
         TRACE_OS_Q_PEND(p_q);                               /* Record the event.                                      */
@@ -1026,10 +1035,18 @@ void  OS_QPost (OS_Q         *p_q,
                    post_type,
                    ts,
                    p_err);
+#if OS_CFG_OBJ_STAT_EN > 0u
+        if (*p_err == OS_ERR_NONE) {
+            p_q->Stat.PostCtr++;
+        }
+#endif
         OS_CRITICAL_EXIT();
         return;
     }
 
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_q->Stat.PostCtr++;
+#endif
     if ((opt & OS_OPT_POST_ALL) != (OS_OPT)0) {             /* Post message to all tasks waiting?                     */
         cnt = p_pend_list->NbrEntries;                      /* Yes                                                    */
     } else {
@@ -121,6 +121,9 @@ void  OSSemCreate (OS_SEM      *p_sem,
     (void)&p_name;
 #endif
     OS_PendListInit(&p_sem->PendList);                      /* Initialize the waiting list                            */
+#if OS_CFG_OBJ_STAT_EN > 0u
+    OS_ObjStatClr(&p_sem->Stat);
+#endif
 
 #if OS_CFG_DBG_EN > 0u
     OS_SemDbgListAdd(p_sem);
@@ -391,8 +394,14 @@ OS_SEM_CTR  OSSemPend (OS_SEM   *p_sem,
        *p_ts  = (CPU_TS)0;                                  /* Initialize the returned timestamp                      */
     }
     CPU_CRITICAL_ENTER();
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_sem->Stat.PendCtr++;
+#endif
     if (p_sem->Ctr > (OS_SEM_CTR)0) {                       /* Resource available?                                    */
         p_sem->Ctr--;                                       /* Yes, caller may proceed                                */
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_sem->Stat.PendNowCtr++;
+#endif
         if (p_ts != (CPU_TS *)0) {
            *p_ts  = p_sem->TS;                              /*      get timestamp of last post                        */
         }
@@ -1005,12 +1014,18 @@ OS_SEM_CTR  OS_SemPost (OS_SEM  *p_sem,
         p_sem->Ctr++;                                       /* No                                                     */
         ctr       = p_sem->Ctr;
         p_sem->TS = ts;                                     /* Save timestamp in semaphore control block              */
+#if OS_CFG_OBJ_STAT_EN > 0u
+        p_sem->Stat.PostCtr++;
+#endif
         CPU_CRITICAL_EXIT();
        *p_err     = OS_ERR_NONE;
         return (ctr);
     }
 
     OS_CRITICAL_ENTER_CPU_EXIT();
+#if OS_CFG_OBJ_STAT_EN > 0u
+    p_sem->Stat.PostCtr++;
+#endif
     if ((opt & OS_OPT_POST_ALL) != (OS_OPT)0) {             /* Post message to all tasks waiting?                     */
         cnt = p_pend_list->NbrEntries;                      /* Yes                                                    */
     } else {
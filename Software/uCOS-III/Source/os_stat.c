@@ -42,6 +42,103 @@ const  CPU_CHAR  *os_stat__c = "$Id: $";
 
 #if OS_CFG_STAT_TASK_EN > 0u
 
+/*
+************************************************************************************************************************
+*                                                    LOCAL CONSTANTS
+*
+* Note(s) : (1) Load average gains, applied once per second (see OS_StatLoadAvg()) : 65536 * (1 - e^(-1 s / T)) for
+*               T = 1 s, 10 s and 60 s.  A gain of 65536 makes the 1 s average the plain usage of the last second.
+************************************************************************************************************************
+*/
+
+#if OS_STAT_CYCLES_EN > 0u
+static  const  CPU_INT32U  OS_StatLoadAvgGain[OS_STAT_LOAD_AVG_NBR] = { 65536u, 6237u, 1083u };
+#endif
+
+
+/*
+************************************************************************************************************************
+*                                                 ADD A LOAD ACCOUNT
+*
+* Description: This function is called by your application to account for the cycles of an activity that is not a task,
+*              e.g. one interrupt source.  The owner adds the cycles it spends to 'p_load->Cycles'; the statistic task
+*              turns them into 1 s, 10 s and 60 s load averages in 'p_load->Avg[]' (see OS_LOAD Note #1).
+*
+* Arguments  : p_load     is a pointer to the load account to add.
+*
+*              p_name     is a pointer to an ASCII string used to name the account.
+*
+*              p_err      is a pointer to a variable that will contain an error code returned by this function.
+*
+*                             OS_ERR_NONE                     If the call was successful
+*                             OS_ERR_CREATE_ISR               If you called this function from an ISR
+*                             OS_ERR_ILLEGAL_CREATE_RUN_TIME  If you are trying to add an account after you called
+*                                                               OSSafetyCriticalStart()
+*                             OS_ERR_OBJ_PTR_NULL             If 'p_load' is a NULL pointer
+*
+* Returns    : none
+*
+* Note(s)    : 1) The cycles of a load account are also counted in the ISR or task they were spent in, so accounts do
+*                 not add up with the rest.  Add each account once; accounts cannot be removed.
+*
+*              2) Add to '.Cycles' with interrupts disabled, or from the only ISR that uses the account.
+************************************************************************************************************************
+*/
+
+#if OS_STAT_CYCLES_EN > 0u
+void  OSStatLoadAdd (OS_LOAD   *p_load,
+                     CPU_CHAR  *p_name,
+                     OS_ERR    *p_err)
+{
+    CPU_INT08U  i;
+    CPU_SR_ALLOC();
+
+
+
+#ifdef OS_SAFETY_CRITICAL
+    if (p_err == (OS_ERR *)0) {
+        OS_SAFETY_CRITICAL_EXCEPTION();
+        return;
+    }
+#endif
+
+#ifdef OS_SAFETY_CRITICAL_IEC61508
+    if (OSSafetyCriticalStartFlag == DEF_TRUE) {
+       *p_err = OS_ERR_ILLEGAL_CREATE_RUN_TIME;
+        return;
+    }
+#endif
+
+#if OS_CFG_CALLED_FROM_ISR_CHK_EN > 0u
+    if (OSIntNestingCtr > (OS_NESTING_CTR)0) {              /* Not allowed to be called from an ISR                   */
+       *p_err = OS_ERR_CREATE_ISR;
+        return;
+    }
+#endif
+
+#if OS_CFG_ARG_CHK_EN > 0u
+    if (p_load == (OS_LOAD *)0) {                           /* Validate 'p_load'                                      */
+       *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+#endif
+
+    p_load->NamePtr   = p_name;
+    p_load->Cycles    = (OS_CYCLES)0;
+    p_load->CyclesWin = (OS_CYCLES)0;
+    for (i = 0u; i < OS_STAT_LOAD_AVG_NBR; i++) {
+        p_load->Avg[i] = 0u;
+    }
+
+    CPU_CRITICAL_ENTER();
+    p_load->NextPtr   = OSStatLoadListPtr;                  /* Insert at the head of the list                         */
+    OSStatLoadListPtr = p_load;
+    CPU_CRITICAL_EXIT();
+   *p_err             = OS_ERR_NONE;
+}
+#endif
+
+
 /*
 ************************************************************************************************************************
 *                                                   RESET STATISTICS
@@ -66,6 +163,10 @@ void  OSStatReset (OS_ERR  *p_err)
 #if (OS_CFG_Q_EN > 0u)
     OS_Q        *p_q;
 #endif
+#endif
+#if OS_STAT_CYCLES_EN > 0u
+    OS_LOAD     *p_load;
+    CPU_INT08U   i;
 #endif
     CPU_SR_ALLOC();
 
@@ -89,6 +190,18 @@ void  OSStatReset (OS_ERR  *p_err)
     OSStatTaskTimeMax     = (CPU_TS)0;
 #endif
 
+#if OS_STAT_CYCLES_EN > 0u
+    OSIntCyclesTotal      = (OS_CYCLES)0;
+    OSIntCyclesTotalPrev  = (OS_CYCLES)0;
+    OSIntCyclesWin        = (OS_CYCLES)0;
+    OSStatCyclesWin       = (OS_CYCLES)0;
+    OSStatWinCtr          = (OS_TICK  )0;
+    for (i = 0u; i < OS_STAT_LOAD_AVG_NBR; i++) {
+        OSStatTaskCPUUsageAvg[i] = 0u;
+        OSIntCPUUsageAvg[i]      = 0u;
+    }
+#endif
+
     OSTickTaskTimeMax     = (CPU_TS)0;
 
 #if OS_CFG_TMR_EN > 0u
@@ -136,6 +249,13 @@ void  OSStatReset (OS_ERR  *p_err)
         p_tcb->CyclesStart      =  OS_TS_GET();
 #endif
 
+#if OS_STAT_CYCLES_EN > 0u
+        p_tcb->CyclesWin        = (OS_CYCLES   )0;
+        for (i = 0u; i < OS_STAT_LOAD_AVG_NBR; i++) {
+            p_tcb->CPUUsageAvg[i] = 0u;
+        }
+#endif
+
 #if OS_CFG_TASK_Q_EN > 0u
         p_msg_q                 = &p_tcb->MsgQ;
         p_msg_q->NbrEntriesMax  = (OS_MSG_QTY  )0;
@@ -158,6 +278,22 @@ void  OSStatReset (OS_ERR  *p_err)
     }
 #endif
 
+#if OS_STAT_CYCLES_EN > 0u
+    CPU_CRITICAL_ENTER();
+    p_load = OSStatLoadListPtr;
+    CPU_CRITICAL_EXIT();
+    while (p_load != (OS_LOAD *)0) {                        /* Reset load accounts                                    */
+        CPU_CRITICAL_ENTER();
+        p_load->Cycles    = (OS_CYCLES)0;
+        p_load->CyclesWin = (OS_CYCLES)0;
+        for (i = 0u; i < OS_STAT_LOAD_AVG_NBR; i++) {
+            p_load->Avg[i] = 0u;
+        }
+        p_load            = p_load->NextPtr;
+        CPU_CRITICAL_EXIT();
+    }
+#endif
+
     OS_TickListResetPeak();                                 /* Reset tick wheel statistics                            */
 
 #if OS_CFG_TMR_EN > 0u
@@ -187,14 +323,19 @@ void  OSStatReset (OS_ERR  *p_err)
 *                             OS_ERR_NONE
 *
 * Returns    : none
+*
+* Note(s)    : 1) When CPU usage is computed from cycle counts (see OS_StatTask() Note #5) there is nothing to calibrate:
+*                 this function returns at once and the application does not need to call it.
 ************************************************************************************************************************
 */
 
 void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
 {
+#if OS_STAT_CYCLES_EN == 0u
     OS_ERR   err;
     OS_TICK  dly;
     CPU_SR_ALLOC();
+#endif
 
 
 
@@ -205,6 +346,10 @@ void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
     }
 #endif
 
+#if OS_STAT_CYCLES_EN > 0u
+   *p_err = OS_ERR_NONE;                                    /* Nothing to calibrate, see Note #1                      */
+#else
+
 #if ((OS_CFG_TMR_EN > 0u) && (OS_CFG_TASK_SUSPEND_EN > 0u))
     OSTaskSuspend(&OSTmrTaskTCB, &err);
     if (err != OS_ERR_NONE) {
@@ -251,7 +396,51 @@ void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
     OSStatTaskRdy     = OS_STATE_RDY;
     CPU_CRITICAL_EXIT();
    *p_err             = OS_ERR_NONE;
+#endif
+}
+
+
+/*
+************************************************************************************************************************
+*                                                UPDATE LOAD AVERAGES
+*
+* Description: This function updates the 1 s, 10 s and 60 s load averages of a task, of ISRs or of a load account with
+*              the cycles of the last second.
+*
+* Arguments  : p_avg          is a pointer to the OS_STAT_LOAD_AVG_NBR load averages to update (0.00-100.00% << 16).
+*
+*              cycles         is the number of cycles the activity took in the last second.
+*
+*              cycles_total   is the number of cycles of the last second, all tasks and ISRs; MUST be non-zero.
+*
+* Returns    : none
+*
+* Note(s)    : 1) Each average moves toward the usage of the last second by its gain (see LOCAL CONSTANTS Note #1), like
+*                 an exponentially weighted moving average; averages start at 0% after OSStatReset().
+*
+*              2) This function is INTERNAL to uC/OS-III and your application should not call it.
+************************************************************************************************************************
+*/
+
+#if OS_STAT_CYCLES_EN > 0u
+void  OS_StatLoadAvg (CPU_INT32U  *p_avg,
+                      OS_CYCLES    cycles,
+                      OS_CYCLES    cycles_total)
+{
+    CPU_INT32U  usage;
+    CPU_INT08U  i;
+
+
+    usage = (CPU_INT32U)(((CPU_INT64U)cycles * ((CPU_INT64U)10000u << 16u)) / cycles_total);
+    for (i = 0u; i < OS_STAT_LOAD_AVG_NBR; i++) {
+        if (usage >= p_avg[i]) {
+            p_avg[i] += (CPU_INT32U)(((CPU_INT64U)(usage - p_avg[i]) * OS_StatLoadAvgGain[i]) >> 16u);
+        } else {
+            p_avg[i] -= (CPU_INT32U)(((CPU_INT64U)(p_avg[i] - usage) * OS_StatLoadAvgGain[i]) >> 16u);
+        }
+    }
 }
+#endif
 
 
 /*
@@ -277,6 +466,21 @@ void  OSStatTaskCPUUsageInit (OS_ERR  *p_err)
 *                 for the idle counter.
 *
 *              4) This function is INTERNAL to uC/OS-III and your application should not call it.
+*
+*              5) With task profiling and the debug task list (OS_STAT_CYCLES_EN), CPU usage comes from cycle counts
+*                 instead of the idle counter: the port charges each task with the cycles it ran between context
+*                 switches (OSTaskSwHook()), and OSIntEnter()/OSIntExit() charge the cycles of the outermost ISR to ISRs
+*                 rather than to the task it interrupted.  Then
+*
+*                                                    idle task cycles
+*                 OSStatTaskCPUUsage = 100 * (1 - ------------------)     (units are in %)
+*                                                     all  cycles
+*
+*                 and task and ISR shares add up to 100%.  Interrupts and other tasks cannot skew the result, so neither
+*                 the calibration of OSStatTaskCPUUsageInit() nor Note #3 apply.
+*
+*              6) Once a second (every OSCfg_StatTaskRate_Hz runs) the cycles of the last second update the 1 s, 10 s and
+*                 60 s load averages of the CPU, of ISRs, of each task and of each load account (see OS_StatLoadAvg()).
 ************************************************************************************************************************
 */
 
@@ -292,9 +496,13 @@ void  OS_StatTask (void  *p_arg)
 #endif
     OS_TCB      *p_tcb;
 #endif
+#if OS_STAT_CYCLES_EN > 0u
+    OS_LOAD     *p_load;
+#else
     OS_TICK      ctr_max;
     OS_TICK      ctr_mult;
     OS_TICK      ctr_div;
+#endif
     OS_ERR       err;
     OS_TICK      dly;
     CPU_TS       ts_start;
@@ -325,6 +533,7 @@ void  OS_StatTask (void  *p_arg)
         OSIntDisTimeMax = CPU_IntDisMeasMaxGet();
 #endif
 
+#if OS_STAT_CYCLES_EN == 0u
         CPU_CRITICAL_ENTER();                               /* ----------------- OVERALL CPU USAGE ------------------ */
         OSStatTaskCtrRun   = OSStatTaskCtr;                 /* Obtain the of the stat counter for the past .1 second  */
         OSStatTaskCtr      = (OS_TICK)0;                    /* Reset the stat counter for the next .1 second          */
@@ -355,6 +564,7 @@ void  OS_StatTask (void  *p_arg)
         } else {
             OSStatTaskCPUUsage = (OS_CPU_USAGE)10000u;
         }
+#endif
 
         OSStatTaskHook();                                   /* Invoke user definable hook                             */
 
@@ -367,17 +577,42 @@ void  OS_StatTask (void  *p_arg)
         p_tcb = OSTaskDbgListPtr;
         CPU_CRITICAL_EXIT();
         while (p_tcb != (OS_TCB *)0) {                      /* ----------------- TOTAL CYCLES COUNT ----------------- */
-            OS_CRITICAL_ENTER();
+            CPU_CRITICAL_ENTER();                           /* OSIntEnter() charges tasks from ISRs                   */
             p_tcb->CyclesTotalPrev =  p_tcb->CyclesTotal;   /* Save accumulated # cycles into a temp variable         */
             p_tcb->CyclesTotal     = (OS_CYCLES)0;          /* Reset total cycles for task for next run               */
-            OS_CRITICAL_EXIT();
+            CPU_CRITICAL_EXIT();
 
             cycles_total          += p_tcb->CyclesTotalPrev;/* Perform sum of all task # cycles                       */
+#if OS_STAT_CYCLES_EN > 0u
+            p_tcb->CyclesWin      += p_tcb->CyclesTotalPrev;
+#endif
 
             CPU_CRITICAL_ENTER();
             p_tcb                  = p_tcb->DbgNextPtr;
             CPU_CRITICAL_EXIT();
         }
+
+        CPU_CRITICAL_ENTER();                               /* Add the cycles of ISRs                                 */
+        OSIntCyclesTotalPrev = OSIntCyclesTotal;
+        OSIntCyclesTotal     = (OS_CYCLES)0;
+        CPU_CRITICAL_EXIT();
+        cycles_total        += OSIntCyclesTotalPrev;
+#endif
+
+#if OS_STAT_CYCLES_EN > 0u
+        OSIntCyclesWin  += OSIntCyclesTotalPrev;
+        OSStatCyclesWin += cycles_total;
+
+        CPU_CRITICAL_ENTER();
+        p_load = OSStatLoadListPtr;
+        CPU_CRITICAL_EXIT();
+        while (p_load != (OS_LOAD *)0) {                    /* Load accounts are part of the ISR or task cycles       */
+            CPU_CRITICAL_ENTER();
+            p_load->CyclesWin += p_load->Cycles;
+            p_load->Cycles     = (OS_CYCLES)0;
+            p_load             = p_load->NextPtr;
+            CPU_CRITICAL_EXIT();
+        }
 #endif
 
 
@@ -434,6 +669,49 @@ void  OS_StatTask (void  *p_arg)
         }
 #endif
 
+#if OS_STAT_CYCLES_EN > 0u                                  /* ---------- OVERALL CPU USAGE, see Note #5 ----------- */
+        OSIntCPUUsage      = (OS_CPU_USAGE)(cycles_mult * OSIntCyclesTotalPrev / cycles_max);
+        OSStatTaskCPUUsage = (OS_CPU_USAGE)((OS_CPU_USAGE)10000u - OSIdleTaskTCB.CPUUsage);
+        if (OSStatTaskCPUUsageMax < OSStatTaskCPUUsage) {
+            OSStatTaskCPUUsageMax = OSStatTaskCPUUsage;
+        }
+
+        OSStatWinCtr++;                                     /* ------------ LOAD AVERAGES, see Note #6 ------------- */
+        if (OSStatWinCtr >= (OS_TICK)OSCfg_StatTaskRate_Hz) {
+            OSStatWinCtr = (OS_TICK)0;
+            if (OSStatCyclesWin > (OS_CYCLES)0) {
+                OS_StatLoadAvg(&OSStatTaskCPUUsageAvg[0], OSStatCyclesWin - OSIdleTaskTCB.CyclesWin, OSStatCyclesWin);
+                OS_StatLoadAvg(&OSIntCPUUsageAvg[0],      OSIntCyclesWin,                            OSStatCyclesWin);
+
+                CPU_CRITICAL_ENTER();
+                p_tcb = OSTaskDbgListPtr;
+                CPU_CRITICAL_EXIT();
+                while (p_tcb != (OS_TCB *)0) {
+                    OS_StatLoadAvg(&p_tcb->CPUUsageAvg[0], p_tcb->CyclesWin, OSStatCyclesWin);
+                    p_tcb->CyclesWin = (OS_CYCLES)0;
+
+                    CPU_CRITICAL_ENTER();
+                    p_tcb = p_tcb->DbgNextPtr;
+                    CPU_CRITICAL_EXIT();
+                }
+
+                CPU_CRITICAL_ENTER();
+                p_load = OSStatLoadListPtr;
+                CPU_CRITICAL_EXIT();
+                while (p_load != (OS_LOAD *)0) {
+                    OS_StatLoadAvg(&p_load->Avg[0], p_load->CyclesWin, OSStatCyclesWin);
+                    p_load->CyclesWin = (OS_CYCLES)0;
+
+                    CPU_CRITICAL_ENTER();
+                    p_load = p_load->NextPtr;
+                    CPU_CRITICAL_EXIT();
+                }
+            }
+            OSIntCyclesWin  = (OS_CYCLES)0;
+            OSStatCyclesWin = (OS_CYCLES)0;
+        }
+#endif
+
         if (OSStatResetFlag == DEF_TRUE) {                  /* Check if need to reset statistics                      */
             OSStatResetFlag  = DEF_FALSE;
             OSStatReset(&err);
@@ -483,7 +761,12 @@ void  OS_StatTaskInit (OS_ERR  *p_err)
     OSStatTaskCtr    = (OS_TICK)0;
     OSStatTaskCtrRun = (OS_TICK)0;
     OSStatTaskCtrMax = (OS_TICK)0;
+#if OS_STAT_CYCLES_EN > 0u
+    OSStatTaskRdy     = OS_STATE_RDY;                       /* Nothing to calibrate, see OS_StatTask() Note #5        */
+    OSStatLoadListPtr = (OS_LOAD *)0;
+#else
     OSStatTaskRdy    = OS_STATE_NOT_RDY;                    /* Statistic task is not ready                            */
+#endif
     OSStatResetFlag  = DEF_FALSE;
 
                                                             /* ---------------- CREATE THE STAT TASK ---------------- */
@@ -2115,6 +2115,9 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
 #if OS_CFG_TASK_PROFILE_EN > 0u
     CPU_TS      ts;
 #endif
+#if OS_CFG_MUTEX_EN > 0u
+    CPU_DATA    i;
+#endif
 
 
     p_tcb->StkPtr             = (CPU_STK       *)0;
@@ -2169,6 +2172,10 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
     p_tcb->FlagsPend          = (OS_FLAGS       )0u;
     p_tcb->FlagsOpt           = (OS_OPT         )0u;
     p_tcb->FlagsRdy           = (OS_FLAGS       )0u;
+    p_tcb->FlagWatchNextPtr   = (OS_TCB        *)0;
+    p_tcb->FlagWatchPrevPtr   = (OS_TCB        *)0;
+    p_tcb->FlagWatchBit       = (CPU_INT08U     )OS_FLAG_WATCH_NONE;
+    p_tcb->FlagPendSeq        = (OS_CTR         )0u;
 #endif
 
 #if OS_CFG_TASK_REG_TBL_SIZE > 0u
@@ -2237,6 +2244,12 @@ void  OS_TaskInitTCB (OS_TCB  *p_tcb)
 #if OS_CFG_MUTEX_EN > 0u
     p_tcb->BasePrio           = (OS_PRIO        )OS_PRIO_INIT;
     p_tcb->MutexGrpHeadPtr    = (OS_MUTEX      *)0;
+    for (i = 0u; i < OS_PRIO_TBL_SIZE; i++) {
+        p_tcb->MutexGrpPrioTbl[i] = (CPU_DATA)0;
+    }
+    for (i = 0u; i < OS_CFG_PRIO_MAX; i++) {
+        p_tcb->MutexGrpPrioCtr[i] = (OS_OBJ_QTY)0;
+    }
 #endif
 
 #if OS_CFG_DBG_EN > 0u
@@ -2802,6 +2815,8 @@ void  OS_TaskChangePrio(OS_TCB  *p_tcb,
                                      TRACE_OS_MUTEX_TASK_PRIO_DISINHERIT(p_tcb_owner, prio_new);
 #endif
                                   }
+                              } else {                       /* No, owner's priority comes from elsewhere              */
+                                  p_tcb_owner = (OS_TCB *)0;
                               }
                           }
 #endif
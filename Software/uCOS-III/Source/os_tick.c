@@ -126,6 +126,9 @@ void  OS_TickTaskInit (OS_ERR  *p_err)
 #endif
 
     OSTickCtr                    = (OS_TICK)0u;                         /* Clear the tick counter                            */
+#if OS_CFG_TICK_VIRT_EN > 0u
+    OSTickVirtCtr                = (OS_TICK)0u;
+#endif
 
     OSTickListDly.TCB_Ptr        = (OS_TCB   *)0;
     OSTickListTimeout.TCB_Ptr    = (OS_TCB   *)0;
@@ -421,6 +424,116 @@ void  OS_TickListResetPeak (void)
 #endif
 }
 
+/*
+************************************************************************************************************************
+*                                            ADVANCE VIRTUAL TIME TO THE NEXT EXPIRY
+*
+* Description: This function is called by the idle task when OS_CFG_TICK_VIRT_EN is enabled.  Since the idle task only
+*              runs when every other task is blocked, nothing can happen before the next delay, timeout or timer expires.
+*              The ticks up to that point are accounted for at once and the expiring tick is signalled with
+*              OSTimeTick(), as the tick interrupt would.
+*
+* Arguments  : none
+*
+* Returns    : DEF_YES   if a tick was signalled.
+*
+*              DEF_NO    if nothing is waiting on time.  Only an interrupt can then make a task ready.
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-III and your application MUST NOT call it.
+*
+*              2) The head of each delta list holds the ticks until its first expiry.  Skipping 'n' ticks only
+*                 changes the two heads, so the cost doesn't depend on the number of delayed tasks.
+*
+*              3) Timers are updated by the timer task every OSTmrUpdateCnt ticks.  The timer with the least 'Remain'
+*                 expires at the 'Remain'th update, OSTmrUpdateCtr ticks from now for the first one.  Updates skipped
+*                 on the way are applied here by lowering every 'Remain'.  When a task holds the timer mutex the
+*                 timers are left alone and the jump stops at the next update.
+*
+*              4) OSTimeTickHook() is only called for the ticks that are signalled.  Time related statistics still
+*                 use CPU_TS and keep measuring CPU time, not virtual time.
+************************************************************************************************************************
+*/
+
+#if OS_CFG_TICK_VIRT_EN > 0u
+CPU_BOOLEAN  OS_TickVirtAdvance (void)
+{
+    OS_TICK   skip;
+    OS_TICK   remain;
+#if OS_CFG_TMR_EN > 0u
+    OS_TMR   *p_tmr;
+    OS_TICK   tmr_remain;
+    OS_CTR    tmr_ticks;
+    OS_CTR    tmr_left;
+#endif
+    CPU_SR_ALLOC();
+
+
+
+    CPU_CRITICAL_ENTER();
+    skip = (OS_TICK)0;                                                  /* 0 = nothing waiting on time                       */
+    if (OSTickListDly.TCB_Ptr != (OS_TCB *)0) {
+        skip = OSTickListDly.TCB_Ptr->TickRemain;                       /* See Note #2                                       */
+    }
+    if (OSTickListTimeout.TCB_Ptr != (OS_TCB *)0) {
+        remain = OSTickListTimeout.TCB_Ptr->TickRemain;
+        if ((skip == (OS_TICK)0) || (remain < skip)) {
+            skip = remain;
+        }
+    }
+#if OS_CFG_TMR_EN > 0u
+    remain = (OS_TICK)0;
+#if OS_CFG_MUTEX_EN > 0u
+    if (OSTmrMutex.OwnerNestingCtr > (OS_NESTING_CTR)0) {               /* Timers are being changed (see Note #3)            */
+        remain = (OS_TICK)OSTmrUpdateCtr;
+    } else
+#endif
+    if (OSTmrListPtr != (OS_TMR *)0) {
+        tmr_remain = OSTmrListPtr->Remain;
+        for (p_tmr = OSTmrListPtr->NextPtr; p_tmr != (OS_TMR *)0; p_tmr = p_tmr->NextPtr) {
+            if (tmr_remain > p_tmr->Remain) {
+                tmr_remain = p_tmr->Remain;
+            }
+        }
+        remain = (OS_TICK)OSTmrUpdateCtr + (tmr_remain - 1u) * (OS_TICK)OSTmrUpdateCnt;
+    }
+    if ((remain != (OS_TICK)0) && ((skip == (OS_TICK)0) || (remain < skip))) {
+        skip = remain;
+    }
+#endif
+    if (skip == (OS_TICK)0) {
+        CPU_CRITICAL_EXIT();
+        return (DEF_NO);
+    }
+
+    skip--;                                                             /* Account for all the ticks but the expiring one    */
+    OSTickCtr += skip;
+    if (OSTickListDly.TCB_Ptr != (OS_TCB *)0) {
+        OSTickListDly.TCB_Ptr->TickRemain     -= skip;
+    }
+    if (OSTickListTimeout.TCB_Ptr != (OS_TCB *)0) {
+        OSTickListTimeout.TCB_Ptr->TickRemain -= skip;
+    }
+#if OS_CFG_TMR_EN > 0u
+    if (skip >= (OS_TICK)OSTmrUpdateCtr) {                              /* Timer updates on the way?                         */
+        tmr_left       = (OS_CTR)(skip - (OS_TICK)OSTmrUpdateCtr);
+        tmr_ticks      = 1u + tmr_left / OSTmrUpdateCnt;
+        OSTmrUpdateCtr = OSTmrUpdateCnt - tmr_left % OSTmrUpdateCnt;
+        OSTmrTickCtr  += (OS_TICK)tmr_ticks;
+        for (p_tmr = OSTmrListPtr; p_tmr != (OS_TMR *)0; p_tmr = p_tmr->NextPtr) {
+            p_tmr->Remain -= (OS_TICK)tmr_ticks;                        /* None reaches 0 (see Note #3)                      */
+        }
+    } else {
+        OSTmrUpdateCtr -= (OS_CTR)skip;
+    }
+#endif
+    OSTickVirtCtr += skip + 1u;
+    CPU_CRITICAL_EXIT();
+
+    OSTimeTick();                                                       /* The expiring tick, readies the tick task          */
+    return (DEF_YES);
+}
+#endif
+
 /*
 ************************************************************************************************************************
 *                                           UPDATE THE LIST OF TASKS DELAYED
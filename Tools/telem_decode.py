@@ -0,0 +1,409 @@
+#!/usr/bin/env python3
+"""
+Monty Hall simulator - binary telemetry decoder.
+
+Reads the COBS framed stream that the board sends on COM1 after 'render telem'
+(see Examples/ST/STM32F429II-SK/OS3/app_telem.c) from a serial port or a
+capture file, checks every frame, undoes the delta encoding and writes one
+columnar file per record type into the output directory:
+
+    sync.csv        stream parameters, one row per SYNC record
+    rounds.csv      interactive rounds
+    stats.csv       statistics cells, absolute counts, one row per change
+    kernel.csv      CPU usage, context switches, drops
+    tasks.csv       task slots (name, priority, stack size)
+    task_stats.csv  per task CPU usage, context switches, stack used
+    periods.csv     periodic tasks: releases, deadline misses, worst jitter
+    period_hist.csv periodic task jitter / execution time histograms
+    trace.txt       the trace byte stream (console replies)
+
+With --parquet (needs pyarrow) the tables are also written as .parquet files.
+
+Usage:
+    telem_decode.py /dev/ttyACM0 -o out/            # live, Ctrl-C to stop
+    telem_decode.py capture.bin -o out/ --parquet    # offline
+
+Only the Python standard library is needed; the serial port is set up with
+termios (raw, 8N1).
+"""
+
+import argparse
+import csv
+import os
+import stat
+import sys
+
+VERSION = 2
+
+REC_SYNC = 1
+REC_ROUND = 2
+REC_STATS = 3
+REC_KERNEL = 4
+REC_TASK = 5
+REC_TASK_STAT = 6
+REC_TRACE = 7
+REC_PERIOD = 8
+REC_PERIOD_HIST = 9
+
+STRAT_NAME = ("stay", "switch")
+HIST_NAME = ("jitter", "exec")
+
+COLUMNS = {
+    "sync": ("tick", "time_s", "version", "tick_hz", "cpu_hz", "picks"),
+    "rounds": ("tick", "time_s", "round", "strategy", "pick", "prize", "win"),
+    "stats": ("tick", "time_s", "strategy", "pick", "rounds", "wins"),
+    "kernel": ("tick", "time_s", "cpu_pct", "cpu_pct_max", "ctx_sw", "tasks", "drops"),
+    "tasks": ("tick", "time_s", "slot", "name", "prio", "stk_size"),
+    "task_stats": ("tick", "time_s", "slot", "name", "cpu_pct", "ctx_sw", "stk_used"),
+    "periods": ("tick", "time_s", "slot", "name", "period_us", "releases", "misses", "skipped",
+                "jitter_max_us", "exec_max_us"),
+    "period_hist": ("tick", "time_s", "slot", "name", "hist", "bin_lo_us", "count"),
+}
+
+
+class DecodeError(Exception):
+    pass
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise DecodeError("bad COBS code")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Reader:
+    def __init__(self, buf):
+        self.buf = buf
+        self.ix = 0
+
+    def done(self):
+        return self.ix >= len(self.buf)
+
+    def u8(self):
+        if self.ix >= len(self.buf):
+            raise DecodeError("truncated record")
+        b = self.buf[self.ix]
+        self.ix += 1
+        return b
+
+    def var(self):
+        v = 0
+        shift = 0
+        while True:
+            b = self.u8()
+            v |= (b & 0x7F) << shift
+            if b < 0x80:
+                return v
+            shift += 7
+            if shift > 63:
+                raise DecodeError("varint too long")
+
+    def zz(self):
+        v = self.var()
+        return (v >> 1) ^ -(v & 1)
+
+    def raw(self, n):
+        if self.ix + n > len(self.buf):
+            raise DecodeError("truncated record")
+        b = self.buf[self.ix:self.ix + n]
+        self.ix += n
+        return b
+
+
+class Sink:
+    """One CSV per table, written row by row; columns kept for Parquet."""
+
+    def __init__(self, out_dir, parquet):
+        os.makedirs(out_dir, exist_ok=True)
+        self.out_dir = out_dir
+        self.parquet = parquet
+        self.files = {}
+        self.writers = {}
+        self.cols = {}
+        for name, cols in COLUMNS.items():
+            f = open(os.path.join(out_dir, name + ".csv"), "w", newline="")
+            w = csv.writer(f)
+            w.writerow(cols)
+            self.files[name] = f
+            self.writers[name] = w
+            self.cols[name] = {c: [] for c in cols}
+        self.trace = open(os.path.join(out_dir, "trace.txt"), "wb")
+
+    def row(self, name, *values):
+        self.writers[name].writerow(values)
+        if self.parquet:
+            for c, v in zip(COLUMNS[name], values):
+                self.cols[name][c].append(v)
+
+    def flush(self):
+        for f in self.files.values():
+            f.flush()
+        self.trace.flush()
+
+    def close(self):
+        for f in self.files.values():
+            f.close()
+        self.trace.close()
+        if self.parquet:
+            import pyarrow
+            import pyarrow.parquet
+            for name, cols in self.cols.items():
+                table = pyarrow.table(cols)
+                pyarrow.parquet.write_table(table, os.path.join(self.out_dir, name + ".parquet"))
+
+
+class Decoder:
+    def __init__(self, sink):
+        self.sink = sink
+        self.synced = False
+        self.seq = None
+        self.tick_hz = 1000
+        self.picks = 8
+        self.trace_pos = None
+        self.ctr = {"frames": 0, "records": 0, "crc_errors": 0, "cobs_errors": 0, "record_errors": 0,
+                    "lost_frames": 0, "trace_gaps": 0, "skipped": 0}
+        self.reset()
+
+    def reset(self):
+        self.tick = 0
+        self.round = 0
+        self.cells = {}
+        self.usage = 0
+        self.usage_max = 0
+        self.ctx_sw = 0
+        self.drops = 0
+        self.task_names = {}
+        self.task_state = {}
+        self.period_names = {}
+        self.period_state = {}
+        self.period_hist = {}
+
+    def frame(self, raw):
+        if not raw:
+            return
+        try:
+            frame = cobs_decode(raw)
+        except DecodeError:
+            self.ctr["cobs_errors"] += 1
+            self.synced = False
+            return
+        if len(frame) < 3 or crc16(frame[:-2]) != (frame[-2] | frame[-1] << 8):
+            self.ctr["crc_errors"] += 1
+            self.synced = False
+            return
+        self.ctr["frames"] += 1
+        seq = frame[0]
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.ctr["lost_frames"] += (seq - self.seq - 1) & 0xFF
+            self.synced = False
+        self.seq = seq
+
+        rd = Reader(frame[1:-2])
+        try:
+            while not rd.done():
+                self.record(rd)
+        except DecodeError:
+            self.ctr["record_errors"] += 1
+            self.synced = False
+
+    def record(self, rd):
+        rtype = rd.u8()
+        self.tick = (self.tick + rd.var()) & 0xFFFFFFFF
+        self.ctr["records"] += 1
+
+        if rtype == REC_SYNC:
+            self.reset()
+            version, self.tick_hz, cpu_hz, self.tick, self.picks = (rd.var() for _ in range(5))
+            if version != VERSION:
+                raise DecodeError("unknown stream version %d" % version)
+            self.synced = True
+            self.sink.row("sync", self.tick, self.time(), version, self.tick_hz, cpu_hz, self.picks)
+            return
+
+        if rtype == REC_TRACE:  # absolute offsets, usable without SYNC
+            pos = rd.var()
+            data = rd.raw(rd.var())
+            if self.trace_pos is not None and pos != self.trace_pos:
+                self.ctr["trace_gaps"] += 1
+            self.trace_pos = (pos + len(data)) & 0xFFFFFFFF
+            self.sink.trace.write(data)
+            return
+
+        body = {
+            REC_ROUND: self.rec_round,
+            REC_STATS: self.rec_stats,
+            REC_KERNEL: self.rec_kernel,
+            REC_TASK: self.rec_task,
+            REC_TASK_STAT: self.rec_task_stat,
+            REC_PERIOD: self.rec_period,
+            REC_PERIOD_HIST: self.rec_period_hist,
+        }.get(rtype)
+        if body is None:
+            raise DecodeError("unknown record type %d" % rtype)
+        body(rd)
+
+    def time(self):
+        return round(self.tick / self.tick_hz, 3)
+
+    def rec_round(self, rd):
+        self.round = (self.round + rd.var()) & 0xFFFFFF
+        packed = rd.var()
+        if not self.synced:
+            self.ctr["skipped"] += 1
+            return
+        self.sink.row("rounds", self.tick, self.time(), self.round, STRAT_NAME[(packed >> 1) & 1],
+                      ((packed >> 2) & 7) + 1, ((packed >> 5) & 7) + 1, packed & 1)
+
+    def rec_stats(self, rd):
+        mask = rd.var()
+        for i in range(32):
+            if mask & (1 << i):
+                r, w = self.cells.get(i, (0, 0))
+                r += rd.zz()
+                w += rd.zz()
+                self.cells[i] = (r, w)
+                if self.synced:
+                    self.sink.row("stats", self.tick, self.time(), STRAT_NAME[i // self.picks],
+                                  i % self.picks + 1, r, w)
+        if not self.synced:
+            self.ctr["skipped"] += 1
+
+    def rec_kernel(self, rd):
+        self.usage += rd.zz()
+        self.usage_max += rd.zz()
+        self.ctx_sw += rd.var()
+        tasks = rd.var()
+        self.drops += rd.var()
+        if not self.synced:
+            self.ctr["skipped"] += 1
+            return
+        self.sink.row("kernel", self.tick, self.time(), self.usage / 100.0, self.usage_max / 100.0,
+                      self.ctx_sw, tasks, self.drops)
+
+    def rec_task(self, rd):
+        slot, prio, stk_size = rd.var(), rd.var(), rd.var()
+        name = rd.raw(rd.var()).decode("ascii", "replace")
+        self.task_names[slot] = name
+        self.task_state[slot] = (0, 0, 0)  # the board restarts this slot's deltas
+        if self.synced:
+            self.sink.row("tasks", self.tick, self.time(), slot, name, prio, stk_size)
+
+    def rec_task_stat(self, rd):
+        slot = rd.var()
+        usage, ctx_sw, stk_used = self.task_state.get(slot, (0, 0, 0))
+        usage += rd.zz()
+        ctx_sw += rd.var()
+        stk_used += rd.zz()
+        self.task_state[slot] = (usage, ctx_sw, stk_used)
+        if not self.synced or slot not in self.task_names:
+            self.ctr["skipped"] += 1
+            return
+        self.sink.row("task_stats", self.tick, self.time(), slot, self.task_names[slot],
+                      usage / 100.0, ctx_sw, stk_used)
+
+    def rec_period(self, rd):
+        slot, period_us = rd.var(), rd.var()
+        releases, misses, skipped = self.period_state.get(slot, (0, 0, 0))
+        releases += rd.zz()
+        misses += rd.zz()
+        skipped += rd.zz()
+        jitter_max, exec_max = rd.var(), rd.var()
+        name = rd.raw(rd.var()).decode("ascii", "replace")
+        self.period_state[slot] = (releases, misses, skipped)
+        self.period_names[slot] = name
+        if not self.synced:
+            self.ctr["skipped"] += 1
+            return
+        self.sink.row("periods", self.tick, self.time(), slot, name, period_us, releases, misses, skipped,
+                      jitter_max, exec_max)
+
+    def rec_period_hist(self, rd):
+        slot, hist, first, n = rd.var(), rd.var(), rd.var(), rd.var()
+        bins = self.period_hist.setdefault((slot, hist), {})
+        for b in range(first, first + n):
+            bins[b] = bins.get(b, 0) + rd.zz()
+        if not self.synced or slot not in self.period_names or hist >= len(HIST_NAME):
+            self.ctr["skipped"] += 1
+            return
+        for b in range(first, first + n):
+            self.sink.row("period_hist", self.tick, self.time(), slot, self.period_names[slot], HIST_NAME[hist],
+                          (1 << b) if b else 0, bins[b])
+
+
+def open_input(path, baud):
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if stat.S_ISCHR(os.fstat(fd).st_mode) and os.isatty(fd):
+        import termios
+        speed = getattr(termios, "B%d" % baud)
+        attr = termios.tcgetattr(fd)
+        attr[0] = 0                                          # iflag: no translation
+        attr[1] = 0                                          # oflag
+        attr[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attr[3] = 0                                          # lflag: raw
+        attr[4] = attr[5] = speed
+        attr[6][termios.VMIN] = 1
+        attr[6][termios.VTIME] = 0
+        termios.tcsetattr(fd, termios.TCSANOW, attr)
+    return fd
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[1].strip(),
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="serial device or capture file")
+    ap.add_argument("-o", "--out", default="telem_out", help="output directory (default: %(default)s)")
+    ap.add_argument("-b", "--baud", type=int, default=115200, help="serial baud rate (default: %(default)s)")
+    ap.add_argument("--parquet", action="store_true", help="also write .parquet files (needs pyarrow)")
+    args = ap.parse_args()
+
+    if args.parquet:
+        try:
+            import pyarrow.parquet  # noqa: F401
+        except ImportError:
+            ap.error("--parquet needs pyarrow")
+
+    sink = Sink(args.out, args.parquet)
+    dec = Decoder(sink)
+    fd = open_input(args.input, args.baud)
+    pending = bytearray()
+    try:
+        while True:
+            chunk = os.read(fd, 4096)
+            if not chunk:
+                break
+            pending += chunk
+            *frames, pending = pending.split(b"\x00")
+            pending = bytearray(pending)
+            for raw in frames:
+                dec.frame(bytes(raw))
+            sink.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+        sink.close()
+
+    print(", ".join("%s %d" % kv for kv in dec.ctr.items()), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
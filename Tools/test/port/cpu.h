@@ -0,0 +1,33 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                            HOST UNIT TEST
+*
+* Filename      : cpu.h
+* Description   : The target's uC/CPU port header, minus the instructions a host cannot assemble.
+*
+* Note(s)       : (1) Found before 'uC-CPU/ARM-Cortex-M4/GNU' on the include path of the kernel tests (see
+*                     'run.sh').  Data types, critical sections and configuration stay the target's; the
+*                     barriers become compiler barriers and the count-leading/trailing-zeros functions
+*                     come from the C versions in 'cpu_core.c'.
+*********************************************************************************************************
+*/
+
+#ifndef  TEST_CPU_MODULE_PRESENT
+#define  TEST_CPU_MODULE_PRESENT
+
+#include  "../../../Software/uC-CPU/ARM-Cortex-M4/GNU/cpu.h"
+
+#undef   CPU_MB
+#undef   CPU_RMB
+#undef   CPU_WMB
+#define  CPU_MB()       __asm__ __volatile__ ("" : : : "memory")
+#define  CPU_RMB()      __asm__ __volatile__ ("" : : : "memory")
+#define  CPU_WMB()      __asm__ __volatile__ ("" : : : "memory")
+
+#undef   CPU_CFG_LEAD_ZEROS_ASM_PRESENT
+#undef   CPU_CFG_TRAIL_ZEROS_ASM_PRESENT
+
+#endif
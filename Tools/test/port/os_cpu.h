@@ -0,0 +1,24 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                            HOST UNIT TEST
+*
+* Filename      : os_cpu.h
+* Description   : The target's uC/OS-III port header, minus the instructions a host cannot assemble.
+*
+* Note(s)       : (1) See 'cpu.h' in this directory.  The port functions themselves (OSCtxSw() & co.) are
+*                     provided by each kernel test.
+*********************************************************************************************************
+*/
+
+#ifndef  TEST_OS_CPU_H
+#define  TEST_OS_CPU_H
+
+#include  "../../../Software/uCOS-III/Ports/ARM-Cortex-M4/Generic/GNU/os_cpu.h"
+
+#undef   OS_TASK_SW_SYNC
+#define  OS_TASK_SW_SYNC()      __asm__ __volatile__ ("" : : : "memory")
+
+#endif
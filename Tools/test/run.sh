@@ -0,0 +1,52 @@
+#!/bin/sh
+#
+# Host unit tests.  Builds every test with the host gcc and runs it; exits non-zero if one fails.
+#
+#     Tools/test/run.sh [test ...]        e.g. Tools/test/run.sh test_bsp_clk
+#
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+OUT=${OUT:-/tmp/monty_host_test}
+CC=${CC:-gcc}
+E=$ROOT/Examples/ST/STM32F429II-SK
+
+CFLAGS="-std=gnu99 -g -O0 -Wall -Wno-unused-function -Wno-pointer-to-int-cast -Wno-int-to-pointer-cast"
+CFLAGS="$CFLAGS -DSTM32F42_43xxx -DUSE_STDPERIPH_DRIVER"
+
+                                                # Target headers: register blocks and BSP types only.
+INC_BSP="-I$E/OS3 -I$E/BSP -I$E/BSP/ST/STM32F4xx/inc -I$E/BSP/TrueSTUDIO -I$ROOT/Software/uC-CPU/ARM-Cortex-M4/GNU
+         -I$ROOT/Software/uC-CPU -I$ROOT/Software/uC-LIB -I$ROOT/Software/uCOS-III/Ports/ARM-Cortex-M4/Generic/GNU
+         -I$ROOT/Software/uCOS-III/Source"
+
+build_test_bsp_clk () {
+    $CC $CFLAGS $INC_BSP -o "$OUT/test_bsp_clk" "$ROOT/Tools/test/test_bsp_clk.c"
+}
+
+build_test_console () {
+    $CC $CFLAGS $INC_BSP -o "$OUT/test_console" "$ROOT/Tools/test/test_console.c" \
+        "$ROOT/Software/uC-LIB/lib_str.c" "$ROOT/Software/uC-LIB/lib_ascii.c"
+}
+
+                                                # Kernel tests: the real uC/OS-III on the host, with the
+                                                # port's asm replaced (see 'port/' and the test's stubs).
+build_test_os_task_prio () {
+    $CC $CFLAGS -I$ROOT/Tools/test/port $INC_BSP -o "$OUT/test_os_task_prio" "$ROOT/Tools/test/test_os_task_prio.c" \
+        $ROOT/Software/uCOS-III/Source/os_*.c "$ROOT/Software/uC-CPU/cpu_core.c" "$ROOT/Software/uC-LIB/lib_mem.c" \
+        "$ROOT/Software/uC-LIB/lib_str.c" "$ROOT/Software/uC-LIB/lib_ascii.c"
+}
+
+TESTS=${*:-"test_bsp_clk test_console test_os_task_prio"}
+
+mkdir -p "$OUT"
+fail=0
+for t in $TESTS; do
+    echo "== $t"
+    if ! build_$t; then
+        echo "$t: BUILD FAILED"
+        fail=1
+        continue
+    fi
+    "$OUT/$t" || fail=1
+done
+
+exit $fail
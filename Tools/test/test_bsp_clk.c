@@ -0,0 +1,339 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                            HOST UNIT TEST
+*
+* Filename      : test_bsp_clk.c
+* Description   : BSP_ClkCfgApply() against RCC, FLASH and PWR blocks in RAM.
+*
+* Note(s)       : (1) 'bsp_clk.c' is included with BSP_CLK_REG_RD() / BSP_CLK_REG_WR() routed here (see
+*                     'bsp_clk.c  Note #2').  Every write is logged in order, then Test_HwUpdate() plays the
+*                     ready flags the way the device does : HSIRDY/HSERDY/PLLRDY follow their ON bits, SWS
+*                     follows SW, ODRDY/ODSWRDY follow ODEN/ODSWEN.  TestHseOk and TestWsStuck break the HSE
+*                     or the flash latency for the failure cases.
+*
+*                 (2) The checked order is the one of 'bsp_clk.c  Note #3' : HSE ready before the PLL is
+*                     configured, over-drive before the wait states, wait states before the ART caches,
+*                     caches and bus dividers before SYSCLK switches to the PLL.
+*
+*                 (3) Built and run by 'run.sh'.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <stdint.h>
+#include  <string.h>
+
+static  uint32_t  Test_RegRd (volatile  uint32_t  *p_reg);
+static  void      Test_RegWr (volatile  uint32_t  *p_reg,
+                              uint32_t            val);
+
+#define  BSP_CLK_REG_RD(reg)                      Test_RegRd(&(reg))
+#define  BSP_CLK_REG_WR(reg, val)                 Test_RegWr(&(reg), (val))
+
+#include  "bsp_clk.c"
+
+
+/*
+*********************************************************************************************************
+*                                          FAKE REGISTER BLOCKS
+*********************************************************************************************************
+*/
+
+#define  TEST_LOG_MAX                                    64u
+
+typedef  struct  test_wr {
+    volatile  uint32_t  *RegPtr;
+              uint32_t   Val;
+              uint32_t   CR;                                    /* RCC_CR when the write happened.                      */
+} TEST_WR;
+
+static  RCC_TypeDef    TestRCC;
+static  FLASH_TypeDef  TestFLASH;
+static  PWR_TypeDef    TestPWR;
+
+static  const  BSP_CLK_REGS  TestRegs = {
+    &TestRCC,
+    &TestFLASH,
+    &TestPWR
+};
+
+static  TEST_WR      TestLog[TEST_LOG_MAX];
+static  CPU_INT32U   TestLogQty;
+static  CPU_BOOLEAN  TestHseOk;                                 /* HSE starts when enabled.                             */
+static  CPU_BOOLEAN  TestWsStuck;                               /* Flash latency ignores writes.                        */
+static  CPU_INT32U   TestFailQty;
+
+
+#define  TEST_CHK(cond)     do {                                                                  \
+                                if (!(cond)) {                                                    \
+                                    printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+                                    TestFailQty++;                                                \
+                                }                                                                 \
+                            } while (0)
+
+
+static  void  Test_HwUpdate (void)
+{
+    uint32_t  cr;
+    uint32_t  csr;
+
+
+    cr = TestRCC.CR & ~(BSP_CLK_BIT_RCC_CR_HSIRDY | BSP_CLK_BIT_RCC_CR_HSERDY | BSP_CLK_BIT_RCC_CR_PLLRDY);
+    if ((cr & BSP_CLK_BIT_RCC_CR_HSION) != 0u) {
+        cr |= BSP_CLK_BIT_RCC_CR_HSIRDY;
+    }
+    if (((cr & BSP_CLK_BIT_RCC_CR_HSEON) != 0u) && (TestHseOk == DEF_YES)) {
+        cr |= BSP_CLK_BIT_RCC_CR_HSERDY;
+    }
+    if ((cr & BSP_CLK_BIT_RCC_CR_PLLON) != 0u) {
+        cr |= BSP_CLK_BIT_RCC_CR_PLLRDY;
+    }
+    TestRCC.CR   = cr;
+
+    TestRCC.CFGR = (TestRCC.CFGR & ~BSP_CLK_MSK_RCC_CFGR_SWS)
+                 | ((TestRCC.CFGR & BSP_CLK_MSK_RCC_CFGR_SW) << 2u);
+
+    csr = 0u;
+    if ((TestPWR.CR & BSP_CLK_BIT_PWR_CR_ODEN) != 0u) {
+        csr |= BSP_CLK_BIT_PWR_CSR_ODRDY;
+        if ((TestPWR.CR & BSP_CLK_BIT_PWR_CR_ODSWEN) != 0u) {
+            csr |= BSP_CLK_BIT_PWR_CSR_ODSWRDY;
+        }
+    }
+    TestPWR.CSR = csr;
+}
+
+
+static  uint32_t  Test_RegRd (volatile  uint32_t  *p_reg)
+{
+    return (*p_reg);
+}
+
+
+static  void  Test_RegWr (volatile  uint32_t  *p_reg,
+                          uint32_t            val)
+{
+    if (TestLogQty < TEST_LOG_MAX) {
+        TestLog[TestLogQty].RegPtr = p_reg;
+        TestLog[TestLogQty].Val    = val;
+        TestLog[TestLogQty].CR     = TestRCC.CR;
+        TestLogQty++;
+    }
+    if ((p_reg == &TestFLASH.ACR) && (TestWsStuck == DEF_YES)) {
+        val = (val & ~BSP_CLK_MSK_FLASH_ACR_LATENCY) | (*p_reg & BSP_CLK_MSK_FLASH_ACR_LATENCY);
+    }
+   *p_reg = val;
+    Test_HwUpdate();
+}
+
+
+static  void  Test_Reset (CPU_BOOLEAN  hse_ok,
+                          uint32_t     sw)
+{
+    memset(&TestRCC,   0, sizeof(TestRCC));
+    memset(&TestFLASH, 0, sizeof(TestFLASH));
+    memset(&TestPWR,   0, sizeof(TestPWR));
+    TestRCC.CR   = BSP_CLK_BIT_RCC_CR_HSION;                    /* Reset state: HSI on, SYSCLK from the HSI.            */
+    TestRCC.CFGR = sw;
+    TestHseOk    = hse_ok;
+    TestWsStuck  = DEF_NO;
+    Test_HwUpdate();
+    TestLogQty   = 0u;
+}
+
+
+                                                                /* Index of the first write to 'p_reg' from 'start' on  */
+                                                                /* with (val & msk) == match, or TEST_LOG_MAX.          */
+static  CPU_INT32U  Test_Find (volatile  uint32_t  *p_reg,
+                               uint32_t            msk,
+                               uint32_t            match,
+                               CPU_INT32U          start)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = start; ix < TestLogQty; ix++) {
+        if ((TestLog[ix].RegPtr == p_reg) && ((TestLog[ix].Val & msk) == match)) {
+            return (ix);
+        }
+    }
+
+    return (TEST_LOG_MAX);
+}
+
+
+/*
+*********************************************************************************************************
+*                                               TESTS
+*********************************************************************************************************
+*/
+
+static  void  Test_HSE_Order (void)
+{
+    BSP_CLK_ERR  err;
+    CPU_INT32U   hz;
+    CPU_INT32U   i_hse;
+    CPU_INT32U   i_pll_off;
+    CPU_INT32U   i_vos;
+    CPU_INT32U   i_pll_cfg;
+    CPU_INT32U   i_pll_on;
+    CPU_INT32U   i_od;
+    CPU_INT32U   i_odsw;
+    CPU_INT32U   i_ws;
+    CPU_INT32U   i_rst;
+    CPU_INT32U   i_art;
+    CPU_INT32U   i_pre;
+    CPU_INT32U   i_sw;
+
+
+    printf("hse_order\n");
+    Test_Reset(DEF_YES, BSP_CLK_MSK_RCC_CFGR_SW_HSI);
+    hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSE_180MHz, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_NONE);
+    TEST_CHK(hz  == 180000000u);
+
+    i_hse     = Test_Find(&TestRCC.CR,      BSP_CLK_BIT_RCC_CR_HSEON,       BSP_CLK_BIT_RCC_CR_HSEON,       0u);
+    i_pll_off = Test_Find(&TestRCC.CR,      BSP_CLK_BIT_RCC_CR_PLLON,       0u,                             i_hse + 1u);
+    i_vos     = Test_Find(&TestPWR.CR,      BSP_CLK_MSK_PWR_CR_VOS,         BSP_CLK_MSK_PWR_CR_VOS_SCALE1,  0u);
+    i_pll_cfg = Test_Find(&TestRCC.PLLCFGR, 0u,                             0u,                             0u);
+    i_pll_on  = Test_Find(&TestRCC.CR,      BSP_CLK_BIT_RCC_CR_PLLON,       BSP_CLK_BIT_RCC_CR_PLLON,       0u);
+    i_od      = Test_Find(&TestPWR.CR,      BSP_CLK_BIT_PWR_CR_ODEN,        BSP_CLK_BIT_PWR_CR_ODEN,        0u);
+    i_odsw    = Test_Find(&TestPWR.CR,      BSP_CLK_BIT_PWR_CR_ODSWEN,      BSP_CLK_BIT_PWR_CR_ODSWEN,      0u);
+    i_ws      = Test_Find(&TestFLASH.ACR,   BSP_CLK_MSK_FLASH_ACR_LATENCY,  5u,                             0u);
+    i_rst     = Test_Find(&TestFLASH.ACR,   BSP_CLK_BIT_FLASH_ACR_ICRST | BSP_CLK_BIT_FLASH_ACR_DCRST,
+                                            BSP_CLK_BIT_FLASH_ACR_ICRST | BSP_CLK_BIT_FLASH_ACR_DCRST,      0u);
+    i_art     = Test_Find(&TestFLASH.ACR,   BSP_CLK_BIT_FLASH_ACR_PRFTEN | BSP_CLK_BIT_FLASH_ACR_ICEN | BSP_CLK_BIT_FLASH_ACR_DCEN,
+                                            BSP_CLK_BIT_FLASH_ACR_PRFTEN | BSP_CLK_BIT_FLASH_ACR_ICEN | BSP_CLK_BIT_FLASH_ACR_DCEN, 0u);
+    i_pre     = Test_Find(&TestRCC.CFGR,    BSP_CLK_MSK_RCC_CFGR_PPRE1 | BSP_CLK_MSK_RCC_CFGR_PPRE2,
+                                            (5u << 10u) | (4u << 13u),                                      0u);
+    i_sw      = Test_Find(&TestRCC.CFGR,    BSP_CLK_MSK_RCC_CFGR_SW,        BSP_CLK_MSK_RCC_CFGR_SW_PLL,    0u);
+
+    TEST_CHK(i_sw < TEST_LOG_MAX);                              /* Every step happened ...                              */
+    TEST_CHK(i_hse < i_pll_off);                                /* ... in the order of Note #2.                         */
+    TEST_CHK(i_pll_off < i_vos);
+    TEST_CHK(i_vos < i_pll_cfg);
+    TEST_CHK(i_pll_cfg < i_pll_on);
+    TEST_CHK(i_pll_on < i_od);
+    TEST_CHK(i_od < i_odsw);
+    TEST_CHK(i_odsw < i_ws);
+    TEST_CHK(i_ws < i_rst);
+    TEST_CHK(i_rst < i_art);
+    TEST_CHK(i_art < i_pre);
+    TEST_CHK(i_pre < i_sw);
+
+    if (i_pll_cfg < TEST_LOG_MAX) {
+        TEST_CHK((TestLog[i_pll_cfg].CR & BSP_CLK_BIT_RCC_CR_HSERDY) != 0u);
+        TEST_CHK((TestLog[i_pll_cfg].CR & BSP_CLK_BIT_RCC_CR_PLLRDY) == 0u);
+        TEST_CHK(TestLog[i_pll_cfg].Val == (4u | (180u << 6u) | (0u << 16u) | (8u << 24u) | BSP_CLK_BIT_RCC_PLLCFGR_PLLSRC_HSE));
+    }
+    TEST_CHK((TestRCC.CR & BSP_CLK_BIT_RCC_CR_HSEBYP) != 0u);
+    TEST_CHK((TestFLASH.ACR & BSP_CLK_MSK_FLASH_ACR_LATENCY) == 5u);
+    TEST_CHK((TestRCC.CFGR & BSP_CLK_MSK_RCC_CFGR_HPRE) == 0u);
+    TEST_CHK((TestRCC.CFGR & BSP_CLK_MSK_RCC_CFGR_SWS) == BSP_CLK_MSK_RCC_CFGR_SWS_PLL);
+    TEST_CHK((TestRCC.APB1ENR & BSP_CLK_BIT_RCC_APB1ENR_PWREN) != 0u);
+}
+
+
+static  void  Test_Reapply_FromPLL (void)
+{
+    BSP_CLK_ERR  err;
+    CPU_INT32U   i_hsi;
+    CPU_INT32U   i_pll_off;
+
+
+    printf("reapply_from_pll\n");
+    Test_Reset(DEF_YES, BSP_CLK_MSK_RCC_CFGR_SW_PLL);
+    TestRCC.CR |= BSP_CLK_BIT_RCC_CR_PLLON;
+    Test_HwUpdate();
+    (void)BSP_ClkCfgApply(&BSP_ClkCfg_HSE_180MHz, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_NONE);
+
+    i_hsi     = Test_Find(&TestRCC.CFGR, BSP_CLK_MSK_RCC_CFGR_SW,  BSP_CLK_MSK_RCC_CFGR_SW_HSI, 0u);
+    i_pll_off = Test_Find(&TestRCC.CR,   BSP_CLK_BIT_RCC_CR_PLLON, 0u,                          0u);
+    TEST_CHK(i_hsi < i_pll_off);                                /* PLL never stopped while it drives SYSCLK.            */
+}
+
+
+static  void  Test_HSI_Fallback (void)
+{
+    BSP_CLK_ERR  err;
+    CPU_INT32U   hz;
+    CPU_INT32U   i_pll_cfg;
+
+
+    printf("hsi_fallback\n");
+    Test_Reset(DEF_NO, BSP_CLK_MSK_RCC_CFGR_SW_HSI);            /* HSE never becomes ready.                             */
+    hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSE_180MHz, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_HSE_TIMEOUT);
+    TEST_CHK(hz  == 0u);
+    TEST_CHK((TestRCC.CR & BSP_CLK_BIT_RCC_CR_HSEON) == 0u);    /* HSE left off ...                                     */
+    TEST_CHK(Test_Find(&TestRCC.PLLCFGR, 0u, 0u, 0u) == TEST_LOG_MAX);
+    TEST_CHK((TestRCC.CFGR & BSP_CLK_MSK_RCC_CFGR_SWS) == BSP_CLK_MSK_RCC_CFGR_SWS_HSI);
+
+    TestLogQty = 0u;                                            /* ... and BSP_Init() retries from the HSI.             */
+    hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSI_180MHz, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_NONE);
+    TEST_CHK(hz  == 180000000u);
+    TEST_CHK(Test_Find(&TestRCC.CR, BSP_CLK_BIT_RCC_CR_HSEON, BSP_CLK_BIT_RCC_CR_HSEON, 0u) == TEST_LOG_MAX);
+    i_pll_cfg = Test_Find(&TestRCC.PLLCFGR, 0u, 0u, 0u);
+    TEST_CHK(i_pll_cfg < TEST_LOG_MAX);
+    if (i_pll_cfg < TEST_LOG_MAX) {
+        TEST_CHK(TestLog[i_pll_cfg].Val == (8u | (180u << 6u) | (0u << 16u) | (8u << 24u)));
+    }
+    TEST_CHK((TestRCC.CFGR & BSP_CLK_MSK_RCC_CFGR_SWS) == BSP_CLK_MSK_RCC_CFGR_SWS_PLL);
+}
+
+
+static  void  Test_Flash_Stuck (void)
+{
+    BSP_CLK_ERR  err;
+    CPU_INT32U   hz;
+
+
+    printf("flash_ws_stuck\n");
+    Test_Reset(DEF_YES, BSP_CLK_MSK_RCC_CFGR_SW_HSI);
+    TestWsStuck = DEF_YES;
+    hz = BSP_ClkCfgApply(&BSP_ClkCfg_HSE_180MHz, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_FLASH);
+    TEST_CHK(hz  == 0u);
+    TEST_CHK(Test_Find(&TestRCC.CFGR, BSP_CLK_MSK_RCC_CFGR_SW, BSP_CLK_MSK_RCC_CFGR_SW_PLL, 0u) == TEST_LOG_MAX);
+    TEST_CHK((TestFLASH.ACR & (BSP_CLK_BIT_FLASH_ACR_ICEN | BSP_CLK_BIT_FLASH_ACR_DCEN)) == 0u);
+}
+
+
+static  void  Test_Cfg_Invalid (void)
+{
+    BSP_CLK_CFG  cfg;
+    BSP_CLK_ERR  err;
+    CPU_INT32U   hz;
+
+
+    printf("cfg_invalid\n");
+    Test_Reset(DEF_YES, BSP_CLK_MSK_RCC_CFGR_SW_HSI);
+    cfg           = BSP_ClkCfg_HSE_180MHz;
+    cfg.OverDrive = DEF_DISABLED;                               /* 180 MHz needs over-drive.                            */
+    hz = BSP_ClkCfgApply(&cfg, &TestRegs, &err);
+    TEST_CHK(err == BSP_CLK_ERR_CFG);
+    TEST_CHK(hz  == 0u);
+    TEST_CHK(TestLogQty == 0u);                                 /* Nothing touched.                                     */
+}
+
+
+int  main (void)
+{
+    Test_HSE_Order();
+    Test_Reapply_FromPLL();
+    Test_HSI_Fallback();
+    Test_Flash_Stuck();
+    Test_Cfg_Invalid();
+
+    if (TestFailQty != 0u) {
+        printf("test_bsp_clk: %u FAILED\n", (unsigned)TestFailQty);
+        return (1);
+    }
+    printf("test_bsp_clk: OK\n");
+    return (0);
+}
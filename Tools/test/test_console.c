@@ -0,0 +1,379 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                            HOST UNIT TEST
+*
+* Filename      : test_console.c
+* Description   : Console receive path: AppConsole_FakeRx() -> AppConsole_RxNotify() -> AppConsole_RxDrain().
+*
+* Note(s)       : (1) 'app_console.c' is included with APP_CFG_CONSOLE_FAKE_UART_EN forced on, and drained
+*                     directly without a kernel (see 'app_console.c  Note #3').  Replies sent through
+*                     send_string() are captured and compared line by line.
+*
+*                 (2) The other application modules, the kernel calls and the critical section are stubs.
+*                     Only 'doors' and 'strategy' are used as commands; their stubs keep the last argument.
+*
+*                 (3) Built and run by 'run.sh'.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <string.h>
+
+#include  <includes.h>
+
+#undef   APP_CFG_CONSOLE_FAKE_UART_EN                           /* See Note #1.                                         */
+#define  APP_CFG_CONSOLE_FAKE_UART_EN             DEF_ENABLED
+
+#include  "app_console.c"
+
+
+/*
+*********************************************************************************************************
+*                                            TEST HELPERS
+*********************************************************************************************************
+*/
+
+#define  TEST_BUF_SIZE                  APP_CFG_CONSOLE_RX_BUF_SIZE
+
+static  CPU_CHAR     TestOut[4096];                             /* Replies since the last Test_Out().                   */
+static  CPU_INT32U   TestPostQty;                               /* OSTaskSemPost() to the console task.                 */
+static  CPU_INT08U   TestDoors;
+static  CPU_INT08U   TestStrat;
+static  CPU_INT32U   TestFailQty;
+
+
+#define  TEST_CHK(cond)     do {                                                                  \
+                                if (!(cond)) {                                                    \
+                                    printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+                                    TestFailQty++;                                                \
+                                }                                                                 \
+                            } while (0)
+
+
+static  void  Test_Rx (const  CPU_CHAR  *p_str)
+{
+    AppConsole_FakeRx(p_str, strlen(p_str));
+}
+
+
+                                                                /* Replies since the last call must be 'p_exp'.         */
+static  CPU_BOOLEAN  Test_Out (const  CPU_CHAR  *p_exp)
+{
+    CPU_BOOLEAN  ok;
+
+
+    ok = (strcmp(TestOut, p_exp) == 0) ? DEF_OK : DEF_FAIL;
+    if (ok != DEF_OK) {
+        printf("  got \"%s\"\n  exp \"%s\"\n", TestOut, p_exp);
+    }
+    TestOut[0] = '\0';
+    return (ok);
+}
+
+
+static  void  Test_Fill (CPU_SIZE_T  wr_ix)                     /* Blank lines until the write index is 'wr_ix'.        */
+{
+    CPU_CHAR    pad[TEST_BUF_SIZE];
+    CPU_SIZE_T  len;
+
+
+    len = (wr_ix + TEST_BUF_SIZE - ConsoleRxWrIx) % TEST_BUF_SIZE;
+    if (len != 0u) {
+        memset(pad, '\n', len);
+        AppConsole_FakeRx(pad, len);
+        AppConsole_RxDrain();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                               TESTS
+*********************************************************************************************************
+*/
+
+static  void  Test_Lines (void)
+{
+    APP_CONSOLE_STATS  stats;
+
+
+    printf("lines\n");
+    Test_Rx("doors 5\r\n");
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 5u);
+
+    Test_Rx("strategy switch\nSTRATEGY stay\rbogus\r\n\r\n");    /* CR, LF, CRLF; blank lines are not commands.          */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\nOK\r\nERR unknown command 'bogus' (try help)\r\n") == DEF_OK);
+    TEST_CHK(TestStrat == APP_BATCH_STRAT_STAY);
+
+    Test_Rx("doo");                                             /* A line split over two receptions.                    */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("") == DEF_OK);
+    Test_Rx("rs 6\r");
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 6u);
+
+    AppConsole_StatsGet(&stats);
+    TEST_CHK(stats.lines   == 5u);
+    TEST_CHK(stats.rxBytes == ConsoleRxWrPos);
+}
+
+
+static  void  Test_Backspace (void)
+{
+    printf("backspace\n");
+    Test_Rx("\b\x7F" "doorx\bs 3\r\n");                         /* Nothing to erase, then one BS.                       */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 3u);
+
+    Test_Rx("doors 44\x7F\r\n");                                /* DEL works the same.                                  */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 4u);
+
+    Test_Rx("x\b\b\r\n");                                       /* Erased to empty: no command, no reply.               */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("") == DEF_OK);
+}
+
+
+static  void  Test_Lap (void)
+{
+    CPU_INT32U  pos;
+    CPU_INT32U  posts;
+
+
+    printf("lap\n");
+    Test_Fill(TEST_BUF_SIZE - 4u);                              /* "doors 7\r\n" straddles the buffer end.              */
+    TEST_CHK(Test_Out("") == DEF_OK);
+    pos   = ConsoleRxWrPos;
+    posts = TestPostQty;
+    Test_Rx("doors 7\r\n");
+    TEST_CHK(ConsoleRxWrIx  == 5u);
+    TEST_CHK(ConsoleRxWrPos == pos + 9u);                       /* Counted across the wrap ...                          */
+    TEST_CHK(TestPostQty    == posts + 2u);                     /* ... from the end of lap and idle-line notifies.      */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 7u);
+    TEST_CHK(ConsoleRxRdIx == ConsoleRxWrIx);
+
+    Test_Fill(TEST_BUF_SIZE - 3u);                              /* Played by hand: the index goes backwards.            */
+    pos = ConsoleRxWrPos;
+    memcpy(&ConsoleRxBuf[TEST_BUF_SIZE - 3u], "doo", 3u);
+    memcpy(&ConsoleRxBuf[0], "rs 3\r\n", 6u);
+    AppConsole_RxNotify(6u);
+    TEST_CHK(ConsoleRxWrPos == pos + 9u);
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 3u);
+
+    posts = TestPostQty;
+    AppConsole_RxNotify(ConsoleRxWrIx);                         /* Same index: nothing new, no post.                    */
+    TEST_CHK(TestPostQty == posts);
+    Test_Fill(TEST_BUF_SIZE - 2u);
+    pos = ConsoleRxWrPos;
+    memcpy(&ConsoleRxBuf[TEST_BUF_SIZE - 2u], "\r\n", 2u);
+    AppConsole_RxNotify(TEST_BUF_SIZE);                         /* NDTR reload: index 'size' reads as 0.                */
+    TEST_CHK(ConsoleRxWrIx  == 0u);
+    TEST_CHK(ConsoleRxWrPos == pos + 2u);
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("") == DEF_OK);
+}
+
+
+static  void  Test_Overrun (void)
+{
+    APP_CONSOLE_STATS  before;
+    APP_CONSOLE_STATS  after;
+    CPU_CHAR           junk[TEST_BUF_SIZE + 100u];
+    CPU_INT08U         doors;
+
+
+    printf("overrun\n");
+    AppConsole_StatsGet(&before);
+    doors = TestDoors;
+    memset(junk, 'x', sizeof(junk));                            /* More than a lap, never drained.                      */
+    memcpy(&junk[sizeof(junk) - 8u], "doors 8\n", 8u);
+    AppConsole_FakeRx(junk, sizeof(junk));
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("ERR rx overrun\r\n") == DEF_OK);         /* All unread data is dropped, whole lines included.    */
+    TEST_CHK(TestDoors == doors);
+    AppConsole_StatsGet(&after);
+    TEST_CHK(after.overruns == before.overruns + 1u);
+    TEST_CHK(ConsoleRxRdPos == ConsoleRxWrPos);
+
+    Test_Rx("s 5\r\n");                                         /* Tail of a line whose start was lost ...              */
+    Test_Rx("doors 8\r\n");                                     /* ... and the next whole line.                         */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 8u);
+
+    Test_Rx("doors 4\r\n");                                     /* Back in step.                                        */
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("OK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 4u);
+}
+
+
+static  void  Test_LongLine (void)
+{
+    APP_CONSOLE_STATS  before;
+    APP_CONSOLE_STATS  after;
+    CPU_CHAR           line[APP_CFG_CONSOLE_LINE_SIZE + 10u];
+
+
+    printf("long_line\n");
+    AppConsole_StatsGet(&before);
+    memset(line, 'y', sizeof(line));
+    memcpy(line, "doors 6 ", 8u);
+    AppConsole_FakeRx(line, sizeof(line));
+    Test_Rx("\b\b\r\n");                                        /* BS doesn't bring a long line back.                   */
+    Test_Rx("doors 5\r\n");
+    AppConsole_RxDrain();
+    TEST_CHK(Test_Out("ERR line too long\r\nOK\r\n") == DEF_OK);
+    TEST_CHK(TestDoors == 5u);
+    AppConsole_StatsGet(&after);
+    TEST_CHK(after.longLines == before.longLines + 1u);
+
+    memset(line, 'z', APP_CFG_CONSOLE_LINE_SIZE - 1u);          /* Longest line that fits.                              */
+    line[APP_CFG_CONSOLE_LINE_SIZE - 1u] = '\n';
+    AppConsole_FakeRx(line, APP_CFG_CONSOLE_LINE_SIZE);
+    AppConsole_RxDrain();
+    TEST_CHK(strncmp(TestOut, "ERR unknown command 'zzz", 24u) == 0);
+    TestOut[0] = '\0';
+}
+
+
+int  main (void)
+{
+    Test_Lines();
+    Test_Backspace();
+    Test_Lap();
+    Test_Overrun();
+    Test_LongLine();
+
+    if (TestFailQty != 0u) {
+        printf("test_console: %u FAILED\n", (unsigned)TestFailQty);
+        return (1);
+    }
+    printf("test_console: OK\n");
+    return (0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                                STUBS
+*
+* Note(s) : See Note #2 at the top of this file.
+*********************************************************************************************************
+*/
+
+void  send_string (const  char  *str)
+{
+    strncat(TestOut, str, sizeof(TestOut) - strlen(TestOut) - 1u);
+}
+
+OS_SEM_CTR  OSTaskSemPost (OS_TCB  *p_tcb, OS_OPT  opt, OS_ERR  *p_err)
+{
+    (void)opt;
+    if (p_tcb == &ConsoleTCB) {
+        TestPostQty++;
+    }
+   *p_err = OS_ERR_NONE;
+    return (0u);
+}
+
+CPU_BOOLEAN  AppBatch_DoorsSet (CPU_INT08U  doors)
+{
+    if ((doors < APP_BATCH_DOORS_MIN) || (doors > APP_BATCH_DOORS_MAX)) {
+        return (DEF_FAIL);
+    }
+    TestDoors = doors;
+    return (DEF_OK);
+}
+
+CPU_BOOLEAN  AppBatch_StratSet (CPU_INT08U  strat)
+{
+    if (strat > APP_BATCH_STRAT_MIX) {
+        return (DEF_FAIL);
+    }
+    TestStrat = strat;
+    return (DEF_OK);
+}
+
+void             Mem_Copy             (void *pdest, const void *psrc, CPU_SIZE_T size) { memmove(pdest, psrc, size); }   /* Assembly on the target. */
+CPU_SR           CPU_SR_Save          (void)                      { return (0u); }
+void             CPU_SR_Restore       (CPU_SR  cpu_sr)            { (void)cpu_sr; }
+void             App_TermLock         (void)                      { }
+void             App_TermUnlock       (void)                      { }
+APP_RENDER_MODE  App_RenderModeGet    (void)                      { return (APP_RENDER_OFF); }
+void             AppPeriod_CfgNote    (const CPU_CHAR *p_cmd, const CPU_CHAR *p_arg) { (void)p_cmd; (void)p_arg; }
+
+                                                                /* Not reached by the tests.                            */
+void         AppBatch_EstGet      (APP_BATCH_EST *p_est) { (void)p_est; }
+CPU_BOOLEAN  AppBatch_EstSummarize(const APP_BATCH_EST *p_est, CPU_INT08U what, APP_BATCH_EST_SUMMARY *p_sum) { (void)p_est; (void)what; (void)p_sum; return (DEF_FAIL); }
+void         AppBatch_PrecSet     (CPU_INT32U prec) { (void)prec; }
+CPU_BOOLEAN  AppBatch_SampleSet   (CPU_INT08U sample) { (void)sample; return (DEF_FAIL); }
+CPU_BOOLEAN  AppBatch_Start       (CPU_INT64U target, CPU_INT32U seed) { (void)target; (void)seed; return (DEF_FAIL); }
+void         AppBatch_StatusGet   (APP_BATCH_STATUS *p_status) { memset(p_status, 0, sizeof(*p_status)); }
+void         AppBatch_Stop        (void) { }
+void         AppBatch_TolSet      (CPU_INT32U tol) { (void)tol; }
+void         AppBg_Clr            (void) { }
+CPU_INT32U   AppBg_Rate           (const APP_BG_STATUS *p_status, CPU_INT08U cls) { (void)p_status; (void)cls; return (0u); }
+void         AppBg_Set            (CPU_BOOLEAN on) { (void)on; }
+void         AppBg_StatusGet      (APP_BG_STATUS *p_status) { memset(p_status, 0, sizeof(*p_status)); }
+void         AppExact_Check       (const APP_EXACT_RATIO *p_exact, const APP_STATS_CELL *p_cell, CPU_INT32U tol, APP_EXACT_CHECK *p_chk) { (void)p_exact; (void)p_cell; (void)tol; memset(p_chk, 0, sizeof(*p_chk)); }
+CPU_BOOLEAN  AppExact_Eval        (const APP_EXACT_MODEL *p_model, CPU_INT08U pick, APP_EXACT_RESULT *p_result) { (void)p_model; (void)pick; (void)p_result; return (DEF_FAIL); }
+void         AppExact_ModelInit   (APP_EXACT_MODEL *p_model, CPU_INT08U doors) { (void)doors; memset(p_model, 0, sizeof(*p_model)); }
+CPU_INT32U   AppExact_Ppm         (const APP_EXACT_RATIO *p_ratio) { (void)p_ratio; return (0u); }
+CPU_BOOLEAN  AppInit_ReportGet    (CPU_INT08U id, APP_INIT_REPORT *p_rpt) { (void)id; (void)p_rpt; return (DEF_FAIL); }
+void         AppInit_StatusGet    (APP_INIT_STATUS *p_status) { memset(p_status, 0, sizeof(*p_status)); }
+void         AppLed_ErrCode       (CPU_INT08U code) { (void)code; }
+void         AppLed_Play          (const APP_LED_PATTERN *p_pat) { (void)p_pat; }
+void         AppLed_StatusGet     (APP_LED_STATUS *p_status) { memset(p_status, 0, sizeof(*p_status)); }
+void         AppLed_Stop          (void) { }
+void         AppMem_Walk          (APP_MEM_FNCT fnct) { (void)fnct; }
+CPU_INT32U   AppPeriod_BinLo      (CPU_INT08U bin) { (void)bin; return (0u); }
+CPU_BOOLEAN  AppPeriod_CfgGet     (CPU_INT08U ix, APP_PERIOD_CFG *p_cfg) { (void)ix; (void)p_cfg; return (DEF_FAIL); }
+void         AppPeriod_Clr        (void) { }
+CPU_BOOLEAN  AppPeriod_StatusGet  (CPU_INT08U ix, APP_PERIOD_STATUS *p_status) { (void)ix; (void)p_status; return (DEF_FAIL); }
+CPU_INT32U   AppPeriod_TsToUs     (CPU_TS ts) { return ((CPU_INT32U)ts); }
+const CPU_INT08U *AppReplay_Journal(CPU_SIZE_T *p_len) { *p_len = 0u; return ((const CPU_INT08U *)0); }
+CPU_BOOLEAN  AppReplay_Load       (CPU_SIZE_T offset, const CPU_INT08U *p_data, CPU_SIZE_T len) { (void)offset; (void)p_data; (void)len; return (DEF_FAIL); }
+CPU_BOOLEAN  AppReplay_PlayStart  (CPU_BOOLEAN fast, CPU_INT32U repeat) { (void)fast; (void)repeat; return (DEF_FAIL); }
+void         AppReplay_RecStart   (void) { }
+void         AppReplay_StatusGet  (APP_REPLAY_STATUS *p_status) { memset(p_status, 0, sizeof(*p_status)); }
+void         AppReplay_Stop       (void) { }
+void         AppStats_CellGet     (const APP_STATS *p_stats, CPU_INT08U strat, CPU_INT08U pick, APP_STATS_CELL *p_cell) { (void)p_stats; (void)strat; (void)pick; memset(p_cell, 0, sizeof(*p_cell)); }
+CPU_INT32U   AppStats_Permille    (CPU_FP32 ratio) { return ((CPU_INT32U)(ratio * 1000.0f)); }
+void         AppStats_Summarize   (const APP_STATS_CELL *p_cell, APP_STATS_SUMMARY *p_sum) { (void)p_cell; memset(p_sum, 0, sizeof(*p_sum)); }
+char        *AppStats_U64ToStr    (CPU_INT64U val, char *p_buf) { sprintf(p_buf, "%llu", (unsigned long long)val); return (p_buf); }
+void         AppTelem_StatsGet    (APP_TELEM_STATS *p_stats) { memset(p_stats, 0, sizeof(*p_stats)); }
+CPU_SIZE_T   AppTelem_TraceWrite  (const void *p_data, CPU_SIZE_T len) { (void)p_data; return (len); }
+void         App_LedNeed          (void) { }
+CPU_INT32U   App_Rand32           (void) { return (0u); }
+void         App_RenderModeSet    (APP_RENDER_MODE mode) { (void)mode; }
+void         App_StatsClr         (void) { }
+void         App_StatsRead        (APP_STATS *p_snap) { memset(p_snap, 0, sizeof(*p_snap)); }
+CPU_INT32U   BSP_CPU_ClkFreq      (void) { return (180000000u); }
+CPU_TS_TMR_FREQ  CPU_TS_TmrFreqGet(CPU_ERR *p_err) { *p_err = CPU_ERR_NONE; return (180000000u); }
+void         OSTaskCreate         (OS_TCB *p_tcb, CPU_CHAR *p_name, OS_TASK_PTR p_task, void *p_arg, OS_PRIO prio, CPU_STK *p_stk_base, CPU_STK_SIZE stk_limit, CPU_STK_SIZE stk_size, OS_MSG_QTY q_size, OS_TICK time_quanta, void *p_ext, OS_OPT opt, OS_ERR *p_err) { (void)p_tcb; (void)p_name; (void)p_task; (void)p_arg; (void)prio; (void)p_stk_base; (void)stk_limit; (void)stk_size; (void)q_size; (void)time_quanta; (void)p_ext; (void)opt; *p_err = OS_ERR_NONE; }
+OS_SEM_CTR   OSTaskSemPend        (OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err) { (void)timeout; (void)opt; (void)p_ts; *p_err = OS_ERR_NONE; return (0u); }
+OS_TICK      OSTimeGet            (OS_ERR *p_err) { *p_err = OS_ERR_NONE; return (0u); }
+
+const  APP_LED_PATTERN  AppLed_PatWin;
+const  APP_LED_PATTERN  AppLed_PatLose;
+const  APP_LED_PATTERN  AppLed_PatStreak;
+OS_RATE_HZ   const OSCfg_TickRate_Hz = 1000u;
+CPU_INT32U   OSStatTaskCPUUsageAvg[OS_STAT_LOAD_AVG_NBR];
+CPU_INT32U   OSIntCPUUsageAvg[OS_STAT_LOAD_AVG_NBR];
+OS_LOAD     *OSStatLoadListPtr;
+OS_TCB      *OSTaskDbgListPtr;
@@ -0,0 +1,250 @@
+/*
+*********************************************************************************************************
+*
+*                                         MONTY HALL SIMULATOR
+*
+*                                            HOST UNIT TEST
+*
+* Filename      : test_os_task_prio.c
+* Description   : Priority inheritance when OSTaskChangePrio() re-prioritizes a task pending on a mutex.
+*
+* Note(s)       : (1) The kernel runs on the host without switching contexts.  A test picks the running task
+*                     by setting OSTCBCurPtr and calls the API on its behalf.  OSCtxSw() only records the
+*                     switch the scheduler asked for.  All the kernel data the tests check is the real one.
+*
+*                     OSMutexPend() keeps the waiter's OS_PEND_DATA on the waiter's stack, which is gone
+*                     once the call returns here.  Test_Pend() therefore does what OSMutexPend() does when
+*                     the mutex is owned -- inherit, then OS_Pend() -- with the pend data in a static table.
+*
+*                 (2) OS_TaskChangePrio() used to walk from a waiter to the mutex owner every time the waiter
+*                     was lowered, and give the owner the waiter's new priority even when the owner's
+*                     priority never came from that waiter.  Test_LowerOtherWaiter() is that case: it ends
+*                     with the owner below its base priority on the old code.
+*
+*                 (3) Built and run by 'run.sh'.
+*********************************************************************************************************
+*/
+
+#include  <stdio.h>
+#include  <string.h>
+
+#include  <os.h>
+
+
+/*
+*********************************************************************************************************
+*                                            TEST HELPERS
+*********************************************************************************************************
+*/
+
+#define  TEST_STK_SIZE                                  128u
+
+static  OS_TCB        TestOwnerTCB;
+static  OS_TCB        TestLoTCB;
+static  OS_TCB        TestHiTCB;
+static  CPU_STK       TestOwnerStk[TEST_STK_SIZE];
+static  CPU_STK       TestLoStk[TEST_STK_SIZE];
+static  CPU_STK       TestHiStk[TEST_STK_SIZE];
+static  OS_PEND_DATA  TestPendData[2];
+static  OS_MUTEX      TestMutex;
+static  CPU_INT32U    TestFailQty;
+
+
+#define  TEST_CHK(cond)     do {                                                                  \
+                                if (!(cond)) {                                                    \
+                                    printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+                                    TestFailQty++;                                                \
+                                }                                                                 \
+                            } while (0)
+
+
+static  void  Test_Task (void  *p_arg)
+{
+    (void)p_arg;                                                /* Never runs (see Note #1).                            */
+}
+
+
+static  void  Test_Create (OS_TCB   *p_tcb,
+                           CPU_STK  *p_stk,
+                           OS_PRIO   prio)
+{
+    OS_ERR  err;
+
+
+    OSTaskCreate(p_tcb, "Test", Test_Task, 0, prio,
+                 p_stk, TEST_STK_SIZE / 10u, TEST_STK_SIZE,
+                 0u, 0u, 0, OS_OPT_NONE, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+}
+
+
+static  void  Test_RunAs (OS_TCB  *p_tcb)                       /* Make 'p_tcb' the running task (see Note #1).         */
+{
+    OSTCBCurPtr = p_tcb;
+    OSPrioCur   = p_tcb->Prio;
+}
+
+
+static  void  Test_Pend (OS_TCB        *p_tcb,                 /* Block 'p_tcb' on the owned mutex (see Note #1).      */
+                         OS_PEND_DATA  *p_pend_data)
+{
+    OS_TCB  *p_tcb_owner;
+    CPU_SR_ALLOC();
+
+
+    Test_RunAs(p_tcb);
+    CPU_CRITICAL_ENTER();
+    p_tcb_owner = TestMutex.OwnerTCBPtr;
+    if (p_tcb_owner->Prio > p_tcb->Prio) {
+        OS_TaskChangePrio(p_tcb_owner, p_tcb->Prio);
+    }
+    OS_Pend(p_pend_data, (OS_PEND_OBJ *)((void *)&TestMutex), OS_TASK_PEND_ON_MUTEX, 0u);
+    CPU_CRITICAL_EXIT();
+    OSSched();
+}
+
+
+                                                                /* Owner 10 holds the mutex, nobody else exists yet.    */
+static  void  Test_Setup (void)
+{
+    OS_ERR  err;
+
+
+    OSInit(&err);
+    TEST_CHK(err == OS_ERR_NONE);
+    OSMutexCreate(&TestMutex, "Test Mutex", &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    Test_Create(&TestOwnerTCB, &TestOwnerStk[0], 10u);
+    OSRunning = OS_STATE_OS_RUNNING;
+
+    Test_RunAs(&TestOwnerTCB);
+    (void)OSMutexPend(&TestMutex, 0u, OS_OPT_PEND_BLOCKING, (CPU_TS *)0, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestMutex.OwnerTCBPtr == &TestOwnerTCB);
+}
+
+
+/*
+*********************************************************************************************************
+*                                               TESTS
+*********************************************************************************************************
+*/
+
+static  void  Test_LowerOtherWaiter (void)                      /* See Note #2.                                         */
+{
+    OS_ERR  err;
+
+
+    printf("lower_waiter_below_owner\n");
+    Test_Setup();
+    Test_Create(&TestLoTCB, &TestLoStk[0], 20u);
+    Test_Pend(&TestLoTCB, &TestPendData[0]);
+    TEST_CHK(TestLoTCB.TaskState == OS_TASK_STATE_PEND);
+    TEST_CHK(TestOwnerTCB.Prio   == 10u);                       /* 20 gives the owner nothing.                          */
+
+    Test_RunAs(&TestOwnerTCB);
+    OSTaskChangePrio(&TestLoTCB, 30u, &err);
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestLoTCB.Prio     == 30u);
+    TEST_CHK(TestOwnerTCB.Prio  == 10u);                        /* Old code: 30, below the base priority.               */
+    TEST_CHK(TestOwnerTCB.BasePrio == 10u);
+}
+
+
+static  void  Test_LowerInheritedWaiter (void)
+{
+    OS_ERR  err;
+
+
+    printf("lower_inherited_waiter\n");
+    Test_Setup();
+    Test_Create(&TestLoTCB, &TestLoStk[0], 30u);
+    Test_Create(&TestHiTCB, &TestHiStk[0],  5u);
+    Test_Pend(&TestLoTCB, &TestPendData[0]);
+    Test_Pend(&TestHiTCB, &TestPendData[1]);
+    TEST_CHK(TestOwnerTCB.Prio == 5u);                          /* Inherited from the waiter at 5.                      */
+
+    Test_RunAs(&TestOwnerTCB);
+    OSTaskChangePrio(&TestHiTCB, 8u, &err);                     /* Still above the base: the owner follows.             */
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestOwnerTCB.Prio == 8u);
+
+    OSTaskChangePrio(&TestHiTCB, 30u, &err);                    /* Below the base: back to the base, not to 30.         */
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestOwnerTCB.Prio == 10u);
+
+    OSTaskChangePrio(&TestHiTCB, 7u, &err);                     /* And up again.                                        */
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestOwnerTCB.Prio == 7u);
+
+    OSTaskChangePrio(&TestLoTCB, 40u, &err);                    /* The other waiter never mattered.                     */
+    TEST_CHK(err == OS_ERR_NONE);
+    TEST_CHK(TestOwnerTCB.Prio == 7u);
+}
+
+
+int  main (void)
+{
+    Test_LowerOtherWaiter();
+    Test_LowerInheritedWaiter();
+
+    if (TestFailQty != 0u) {
+        printf("test_os_task_prio: %u FAILED\n", (unsigned)TestFailQty);
+        return (1);
+    }
+    printf("test_os_task_prio: OK\n");
+    return (0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             PORT STUBS
+*
+* Note(s) : See Note #1 at the top of this file.
+*********************************************************************************************************
+*/
+
+void  OSCtxSw (void)
+{
+    OSTCBCurPtr = OSTCBHighRdyPtr;
+    OSPrioCur   = OSPrioHighRdy;
+}
+
+void  OSIntCtxSw (void)
+{
+    OSCtxSw();
+}
+
+void  OSStartHighRdy (void)
+{
+}
+
+CPU_STK  *OSTaskStkInit (OS_TASK_PTR    p_task,
+                         void          *p_arg,
+                         CPU_STK       *p_stk_base,
+                         CPU_STK       *p_stk_limit,
+                         CPU_STK_SIZE   stk_size,
+                         OS_OPT         opt)
+{
+    (void)p_task;
+    (void)p_arg;
+    (void)p_stk_limit;
+    (void)opt;
+    return (&p_stk_base[stk_size - 1u]);
+}
+
+void  OSInitHook         (void)                                 { }
+void  OSIdleTaskHook     (void)                                 { }
+void  OSStatTaskHook     (void)                                 { }
+void  OSTaskCreateHook   (OS_TCB  *p_tcb)                       { (void)p_tcb; }
+void  OSTaskDelHook      (OS_TCB  *p_tcb)                       { (void)p_tcb; }
+void  OSTaskReturnHook   (OS_TCB  *p_tcb)                       { (void)p_tcb; }
+void  OSTaskSwHook       (void)                                 { }
+void  OSTimeTickHook     (void)                                 { }
+
+void             Mem_Copy          (void *pdest, const void *psrc, CPU_SIZE_T size) { memmove(pdest, psrc, size); }   /* Assembly on the target. */
+CPU_SR           CPU_SR_Save       (void)                       { return (0u); }
+void             CPU_SR_Restore    (CPU_SR  cpu_sr)             { (void)cpu_sr; }
+void             CPU_TS_TmrInit    (void)                       { }
+CPU_TS_TMR       CPU_TS_TmrRd      (void)                       { return (0u); }